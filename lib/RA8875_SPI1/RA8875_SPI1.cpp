@@ -89,6 +89,27 @@ RA8875_SPI1::RA8875_SPI1(uint8_t cs, uint8_t rst, SPIClass *spiInstance)
   _width = 800;
   _height = 480;
   _textScale = 0;
+  _mwcr0 = 0;
+
+  _async = false;
+  _ops = nullptr;
+  _opHead = 0;
+  _opTail = 0;
+  _running = false;
+  _parked = false;
+  _blockingBuf = nullptr;
+  _blockingRx = nullptr;
+  _blockingCount = 0;
+  _arena = nullptr;
+  _arenaInPSRAM = false;
+  _arenaSize = 0;
+  _arenaHead = 0;
+  _arenaTail = 0;
+  _runOp = nullptr;
+  _dmaBuf = nullptr;
+  _dmaAlloc = nullptr;
+  _busyStart = 0;
+  resetStats();
 }
 
 boolean RA8875_SPI1::begin(enum RA8875sizes s) {
@@ -267,6 +288,9 @@ boolean RA8875_SPI1::begin(enum RA8875sizes s) {
   writeReg(RA8875_PWRR, 0x80);
   delay(1);
 
+  // From here on text/graphics mode switches use the shadow copy
+  _mwcr0 = readReg(RA8875_MWCR0);
+
   Serial.println("[RA8875] Initialization complete - SUCCESS!");
   return true;
 }
@@ -274,8 +298,10 @@ boolean RA8875_SPI1::begin(enum RA8875sizes s) {
 void RA8875_SPI1::softReset(void) {
   writeCommand(RA8875_PWRR);
   writeData(0x01);
+  waitIdle();
   delay(1);
   writeData(0x00);
+  waitIdle();
   delay(100);
 }
 
@@ -313,11 +339,7 @@ void RA8875_SPI1::drawPixel(int16_t x, int16_t y, uint16_t color) {
 
   // Write pixel
   writeCommand(RA8875_MRWC);
-  spiBegin();
-  spiTransfer(0x00);  // Data write
-  spiTransfer(color >> 8);
-  spiTransfer(color & 0xFF);
-  spiEnd();
+  writePixels(&color, 1);
 }
 
 void RA8875_SPI1::drawPixels(uint16_t *p, uint32_t count, int16_t x, int16_t y) {
@@ -334,15 +356,8 @@ void RA8875_SPI1::drawPixels(uint16_t *p, uint32_t count, int16_t x, int16_t y)
   // Start memory write command
   writeCommand(RA8875_MRWC);
 
-  // Stream all pixels in one SPI transaction
-  spiBegin();
-  spiTransfer(0x00);  // Data write mode
-  while (count--) {
-    spiTransfer(*p >> 8);
-    spiTransfer(*p & 0xFF);
-    p++;
-  }
-  spiEnd();
+  // Stream all pixels (one transaction, or DMA chunks when async)
+  writePixels(p, count);
 }
 
 void RA8875_SPI1::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *data) {
@@ -369,16 +384,8 @@ void RA8875_SPI1::drawImage(int16_t x, int16_t y, int16_t w, int16_t h, const ui
   // Start memory write command
   writeCommand(RA8875_MRWC);
 
-  // Stream entire image in one SPI transaction
-  uint32_t count = (uint32_t)w * h;
-  spiBegin();
-  spiTransfer(0x00);  // Data write mode
-  while (count--) {
-    spiTransfer(*data >> 8);
-    spiTransfer(*data & 0xFF);
-    data++;
-  }
-  spiEnd();
+  // Stream entire image (one transaction, or DMA chunks when async)
+  writePixels(data, (uint32_t)w * h);
 
   // Restore active window to full screen
   writeReg(RA8875_HSAW0, 0x00);
@@ -594,10 +601,10 @@ void RA8875_SPI1::fillCurve(int16_t xCenter, int16_t yCenter, int16_t longAxis,
 }
 
 void RA8875_SPI1::textMode(void) {
-  writeCommand(RA8875_MWCR0);
-  uint8_t temp = readData();
-  temp |= 0x80;  // Set text mode
-  writeData(temp);
+  if (!(_mwcr0 & 0x80)) {
+    _mwcr0 |= 0x80;  // Set text mode
+    writeReg(RA8875_MWCR0, _mwcr0);
+  }
 
   // Set internal font
   writeReg(RA8875_FNCR0, 0x00);
@@ -657,10 +664,10 @@ void RA8875_SPI1::textWrite(const char *buffer, uint16_t len) {
 }
 
 void RA8875_SPI1::graphicsMode(void) {
-  writeCommand(RA8875_MWCR0);
-  uint8_t temp = readData();
-  temp &= ~0x80;  // Clear text mode bit
-  writeData(temp);
+  if (_mwcr0 & 0x80) {
+    _mwcr0 &= ~0x80;  // Clear text mode bit
+    writeReg(RA8875_MWCR0, _mwcr0);
+  }
 }
 
 void RA8875_SPI1::PWM1config(boolean on, uint8_t clock) {
@@ -696,6 +703,11 @@ void RA8875_SPI1::GPIOX(boolean on) {
 }
 
 void RA8875_SPI1::writeReg(uint8_t reg, uint8_t val) {
+  if (_async) {
+    queueRegBytes(0x80, reg);
+    queueRegBytes(0x00, val);
+    return;
+  }
   writeCommand(reg);
   writeData(val);
 }
@@ -706,6 +718,10 @@ uint8_t RA8875_SPI1::readReg(uint8_t reg) {
 }
 
 void RA8875_SPI1::writeData(uint8_t d) {
+  if (_async) {
+    queueRegBytes(0x00, d);
+    return;
+  }
   spiBegin();
   spiTransfer(0x00);  // Data write mode
   spiTransfer(d);
@@ -713,6 +729,7 @@ void RA8875_SPI1::writeData(uint8_t d) {
 }
 
 uint8_t RA8875_SPI1::readData(void) {
+  waitIdle();  // The command it answers may still be queued
   spiBegin();
   spiTransfer(0x40);  // Data read mode
   uint8_t x = spiTransfer(0x00);  // Dummy read
@@ -721,6 +738,10 @@ uint8_t RA8875_SPI1::readData(void) {
 }
 
 void RA8875_SPI1::writeCommand(uint8_t d) {
+  if (_async) {
+    queueRegBytes(0x80, d);
+    return;
+  }
   spiBegin();
   spiTransfer(0x80);  // Command write mode
   spiTransfer(d);
@@ -728,6 +749,7 @@ void RA8875_SPI1::writeCommand(uint8_t d) {
 }
 
 uint8_t RA8875_SPI1::readStatus(void) {
+  waitIdle();
   spiBegin();
   spiTransfer(0xC0);  // Status read mode
   uint8_t x = spiTransfer(0x00);
@@ -736,23 +758,35 @@ uint8_t RA8875_SPI1::readStatus(void) {
 }
 
 void RA8875_SPI1::waitPoll(uint8_t r, uint8_t f) {
+  if (_async) {
+    queueOp(OP_POLL_REG, r, f);
+    return;
+  }
+  unsigned long start = micros();
   while (1) {
+    if (micros() - start > POLL_TIMEOUT_US) return;
     uint8_t temp = readReg(r);
     if (!(temp & f)) break;
   }
 }
 
 void RA8875_SPI1::waitBusy(uint8_t res) {
+  if (_async) {
+    queueOp(OP_POLL_STATUS, 0, res);
+    return;
+  }
+
   uint8_t temp;
   unsigned long start = millis();
 
   do {
-    if (millis() - start > 10) return;  // Timeout after 10ms
+    if (millis() - start > POLL_TIMEOUT_US / 1000) return;  // Timeout after 10ms
     temp = readStatus();
   } while ((temp & res) == res);
 }
 
 void RA8875_SPI1::spiBegin() {
+  _busyStart = ARM_DWT_CYCCNT;
   _spi->beginTransaction(SPISettings(RA8875_SPI_SPEED, MSBFIRST, SPI_MODE0));
   digitalWrite(_cs, LOW);
 }
@@ -760,8 +794,401 @@ void RA8875_SPI1::spiBegin() {
 void RA8875_SPI1::spiEnd() {
   digitalWrite(_cs, HIGH);
   _spi->endTransaction();
+  _stats.busyCycles += ARM_DWT_CYCCNT - _busyStart;
 }
 
 uint8_t RA8875_SPI1::spiTransfer(uint8_t data) {
   return _spi->transfer(data);
 }
+
+void RA8875_SPI1::writePixels(const uint16_t *p, uint32_t count) {
+  if (!_async) {
+    spiBegin();
+    spiTransfer(0x00);  // Data write mode
+    while (count--) {
+      spiTransfer(*p >> 8);
+      spiTransfer(*p & 0xFF);
+      p++;
+    }
+    spiEnd();
+    return;
+  }
+
+  // The memory write continues across transactions while MRWC stays
+  // selected, so large bursts are split into arena-sized chunks
+  while (count > 0) {
+    uint32_t n = (CHUNK_BYTES - 1) / 2;
+    if (n > count) n = count;
+
+    Op *op = reserveOp();
+    uint8_t *dst = reserveArena(op, 1 + n * 2);
+    *dst++ = 0x00;  // Data write mode
+    for (uint32_t i = 0; i < n; i++) {
+      *dst++ = p[i] >> 8;
+      *dst++ = p[i] & 0xFF;
+    }
+    op->type = OP_BYTES;
+    commitOp();
+
+    p += n;
+    count -= n;
+  }
+}
+
+// ============================================
+// Asynchronous transport
+// ============================================
+
+bool RA8875_SPI1::beginAsync(uint32_t arenaBytes) {
+  if (_async) return true;
+
+  _ops = (Op *)malloc(QUEUE_OPS * sizeof(Op));
+  _dmaAlloc = malloc(64 + 31);
+  _arena = (uint8_t *)extmem_malloc(arenaBytes);
+  _arenaInPSRAM = _arena != nullptr;
+  if (!_arena) {
+    // Keep at least a few chunks - the list still runs, it just stalls sooner
+    arenaBytes = CHUNK_BYTES * 4;
+    _arena = (uint8_t *)malloc(arenaBytes);
+  }
+
+  if (!_ops || !_dmaAlloc || !_arena) {
+    Serial.println("[RA8875] ERROR: Async transport allocation failed - staying synchronous");
+    free(_ops);
+    free(_dmaAlloc);
+    if (_arenaInPSRAM) extmem_free(_arena); else free(_arena);
+    _ops = nullptr;
+    _dmaAlloc = nullptr;
+    _arena = nullptr;
+    return false;
+  }
+
+  // DMA receive invalidates whole cache lines - keep rx on its own line
+  _dmaBuf = (uint8_t *)(((uintptr_t)_dmaAlloc + 31) & ~(uintptr_t)31);
+  _arenaSize = arenaBytes;
+  _arenaHead = 0;
+  _arenaTail = 0;
+  _runOp = nullptr;
+  _opHead = 0;
+  _opTail = 0;
+
+  _event.setContext(this);
+  _event.attachImmediate(dmaEvent);
+
+  _async = true;
+  resetStats();
+  Serial.printf("[RA8875] Async DMA transport: %u ops, %lu byte arena (%s)\n",
+                QUEUE_OPS, _arenaSize, _arenaInPSRAM ? "PSRAM" : "heap");
+  return true;
+}
+
+void RA8875_SPI1::waitIdle() {
+  if (!_async) return;
+  closeRun();
+  if (isIdle()) return;
+
+  uint32_t start = ARM_DWT_CYCCNT;
+  _stats.drains++;
+  while (!isIdle()) {
+    service();
+  }
+  _stats.busyCycles += ARM_DWT_CYCCNT - start;
+}
+
+void RA8875_SPI1::queueOp(uint8_t type, uint8_t reg, uint8_t value) {
+  Op *op = reserveOp();
+  op->type = type;
+  op->reg = reg;
+  op->value = value;
+  commitOp();
+}
+
+void RA8875_SPI1::queueRegBytes(uint8_t mode, uint8_t value) {
+  // Consecutive register writes fill one run; it is queued when another op
+  // follows, when it is full, or on the next service()/waitIdle()
+  if (_runOp && _runOp->length + 2 > RUN_BYTES) {
+    closeRun();
+  }
+  if (!_runOp) {
+    Op *op = reserveOp();
+    reserveArena(op, RUN_BYTES);
+    op->type = OP_REG_RUN;
+    op->length = 0;
+    _runOp = op;
+  }
+
+  uint8_t *dst = _arena + ((_runOp->arenaStart + _runOp->length) % _arenaSize);
+  dst[0] = mode;
+  dst[1] = value;
+  _runOp->length += 2;
+}
+
+void RA8875_SPI1::closeRun() {
+  if (!_runOp) return;
+
+  // Hand back the unused part of the reservation, then publish
+  Op *op = _runOp;
+  _runOp = nullptr;
+  op->arenaEnd = op->arenaStart + op->length;
+  _arenaHead = op->arenaEnd;
+  commitOp();
+}
+
+RA8875_SPI1::Op *RA8875_SPI1::reserveOp() {
+  // The open run sits in the next slot - queue it first to keep the order
+  closeRun();
+
+  if (_opHead - _opTail >= QUEUE_OPS) {
+    uint32_t start = ARM_DWT_CYCCNT;
+    _stats.stalls++;
+    while (_opHead - _opTail >= QUEUE_OPS) {
+      service();
+    }
+    _stats.busyCycles += ARM_DWT_CYCCNT - start;
+  }
+
+  Op *op = &_ops[_opHead & (QUEUE_OPS - 1)];
+  op->phase = 0;
+  op->ownsArena = false;
+  op->length = 0;
+  op->startUs = 0;
+  return op;
+}
+
+uint8_t *RA8875_SPI1::reserveArena(Op *op, uint32_t length) {
+  // Spans are contiguous: one that would wrap starts over at offset 0
+  uint32_t offset = _arenaHead % _arenaSize;
+  uint32_t pad = (offset + length > _arenaSize) ? _arenaSize - offset : 0;
+  uint32_t needed = pad + length;
+
+  if (_arenaSize - (_arenaHead - _arenaTail) < needed) {
+    uint32_t start = ARM_DWT_CYCCNT;
+    _stats.stalls++;
+    while (_arenaSize - (_arenaHead - _arenaTail) < needed) {
+      service();
+    }
+    _stats.busyCycles += ARM_DWT_CYCCNT - start;
+  }
+
+  op->ownsArena = true;
+  op->arenaStart = _arenaHead + pad;
+  op->arenaEnd = op->arenaStart + length;
+  op->length = length;
+  _arenaHead = op->arenaEnd;
+  return _arena + (op->arenaStart % _arenaSize);
+}
+
+void RA8875_SPI1::commitOp() {
+  // Publish only after the entry is filled
+  _opHead = _opHead + 1;
+
+  uint16_t queued = _opHead - _opTail;
+  if (queued > _stats.maxQueued) {
+    _stats.maxQueued = queued;
+  }
+  kick();
+}
+
+void RA8875_SPI1::kick() {
+  // The DMA interrupt clears _running only when it finds the list empty, so
+  // an entry published before this check is always picked up by one side
+  bool start = false;
+  __disable_irq();
+  if (!_running) {
+    _running = true;
+    start = true;
+  }
+  __enable_irq();
+
+  if (start) {
+    _spi->beginTransaction(SPISettings(RA8875_SPI_SPEED, MSBFIRST, SPI_MODE0));
+    pump(false);
+  }
+}
+
+void RA8875_SPI1::service() {
+  if (!_async) return;
+  closeRun();
+
+  // Nothing is in flight while parked, so the main loop owns the list here
+  if (!_parked) return;
+  _parked = false;
+
+  if (_blockingCount) {
+    // The transfer the interrupt could not start on DMA
+    _spi->transfer(_blockingBuf, _blockingRx, _blockingCount);
+    _blockingCount = 0;
+    if (finishTransfer()) {
+      _parked = true;
+      return;
+    }
+  }
+  pump(false);
+}
+
+void RA8875_SPI1::pump(bool fromIsr) {
+  // Runs from kick(), service() or the DMA interrupt; starts the next transfer,
+  // goes idle, or parks the list for service()
+  while (true) {
+    if (_opTail == _opHead) {
+      _spi->endTransaction();
+      _running = false;
+      return;
+    }
+
+    Op &op = _ops[_opTail & (QUEUE_OPS - 1)];
+    if (startTransfer(op)) {
+      if (!_blockingCount) return;
+      if (fromIsr) {
+        // No DMA channel - never spin on SPI in the interrupt
+        _stats.parks++;
+        _parked = true;
+        return;
+      }
+      // No DMA channel - send it in the foreground
+      _spi->transfer(_blockingBuf, _blockingRx, _blockingCount);
+      _blockingCount = 0;
+      if (finishTransfer()) {
+        _parked = true;
+        return;
+      }
+      continue;
+    }
+
+    if (op.ownsArena) {
+      _arenaTail = op.arenaEnd;
+    }
+    _stats.ops++;
+    _opTail = _opTail + 1;
+  }
+}
+
+bool RA8875_SPI1::startTransfer(Op &op) {
+  uint8_t *tx = _dmaBuf;
+  uint8_t *rx = _dmaBuf + 32;
+
+  switch (op.type) {
+    case OP_REG_RUN: {
+      // CS has to rise between transactions, so one transfer per pair
+      uint32_t offset = (uint32_t)op.phase * 2;
+      if (offset >= op.length) return false;
+      op.phase++;
+      sendDma(_arena + ((op.arenaStart + offset) % _arenaSize), nullptr, 2);
+      return true;
+    }
+
+    case OP_POLL_REG:
+      // Phase 0 selects the register, then data reads until the flag clears
+      // (finishTransfer steps the phase back while it is still set)
+      if (op.phase > 1) return false;
+      if (op.startUs == 0) op.startUs = micros() | 1;
+      if (op.phase == 0) {
+        tx[0] = 0x80;
+        tx[1] = op.reg;
+        op.phase++;
+        sendDma(tx, nullptr, 2);
+        return true;
+      }
+      tx[0] = 0x40;
+      tx[1] = 0x00;
+      op.phase++;
+      sendDma(tx, rx, 2);
+      return true;
+
+    case OP_POLL_STATUS:
+      if (op.phase > 0) return false;
+      if (op.startUs == 0) op.startUs = micros() | 1;
+      tx[0] = 0xC0;
+      tx[1] = 0x00;
+      op.phase++;
+      sendDma(tx, rx, 2);
+      return true;
+
+    case OP_BYTES:
+      if (op.phase > 0) return false;
+      op.phase++;
+      sendDma(_arena + (op.arenaStart % _arenaSize), nullptr, op.length);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void RA8875_SPI1::sendDma(const uint8_t *buf, uint8_t *rx, uint32_t count) {
+  _stats.transfers++;
+  _stats.bytes += count;
+  digitalWrite(_cs, LOW);
+
+  if (!_spi->transfer(buf, rx, count, _event)) {
+    // DMA channel unavailable - pump() or service() sends it blocking
+    _stats.dmaErrors++;
+    _blockingBuf = buf;
+    _blockingRx = rx;
+    _blockingCount = count;
+  }
+}
+
+void RA8875_SPI1::dmaEvent(EventResponderRef event) {
+  RA8875_SPI1 *self = (RA8875_SPI1 *)event.getContext();
+  uint32_t start = ARM_DWT_CYCCNT;
+  self->onTransferDone();
+  self->_stats.isrCycles += ARM_DWT_CYCCNT - start;
+}
+
+void RA8875_SPI1::onTransferDone() {
+  if (finishTransfer()) {
+    // Engine still busy - re-read from the main loop rather than re-arming
+    // a 2-byte transfer from every interrupt until it clears
+    _stats.parks++;
+    _parked = true;
+    return;
+  }
+  pump(true);
+}
+
+bool RA8875_SPI1::finishTransfer() {
+  // Returns true when a poll must read again
+  digitalWrite(_cs, HIGH);
+
+  Op &op = _ops[_opTail & (QUEUE_OPS - 1)];
+  uint8_t value = _dmaBuf[32 + 1];
+
+  if (op.type == OP_POLL_REG && op.phase == 2 && (value & op.value) &&
+      micros() - op.startUs < POLL_TIMEOUT_US) {
+    op.phase = 1;  // Engine still busy - read again
+    return true;
+  }
+  if (op.type == OP_POLL_STATUS && (value & op.value) == op.value &&
+      micros() - op.startUs < POLL_TIMEOUT_US) {
+    op.phase = 0;
+    return true;
+  }
+  return false;
+}
+
+void RA8875_SPI1::resetStats() {
+  memset(&_stats, 0, sizeof(_stats));
+  _stats.sinceMs = millis();
+}
+
+void RA8875_SPI1::printStats() {
+  uint32_t elapsedMs = millis() - _stats.sinceMs;
+  if (elapsedMs == 0) elapsedMs = 1;
+  uint32_t cyclesPerUs = F_CPU_ACTUAL / 1000000;
+  uint32_t busyUs = (uint32_t)(_stats.busyCycles / cyclesPerUs);
+  uint32_t isrUs = (uint32_t)(_stats.isrCycles / cyclesPerUs);
+
+  Serial.println("=== RA8875 Transport Stats ===");
+  Serial.printf("Mode: %s\n", _async ? "async DMA" : "synchronous");
+  Serial.printf("Window: %lu ms, %lu ops, %lu transfers, %lu bytes\n",
+                elapsedMs, _stats.ops, _stats.transfers, _stats.bytes);
+  Serial.printf("CPU on display I/O: %lu us/s blocked + %lu us/s in DMA interrupt\n",
+                (uint32_t)((uint64_t)busyUs * 1000 / elapsedMs),
+                (uint32_t)((uint64_t)isrUs * 1000 / elapsedMs));
+  Serial.printf("Stalls: %lu, drains: %lu, DMA fallbacks: %lu, max queued: %u\n",
+                _stats.stalls, _stats.drains, _stats.dmaErrors, _stats.maxQueued);
+  Serial.printf("Parked for main loop: %lu (busy polls, fallbacks)\n", _stats.parks);
+  Serial.println("==============================");
+  resetStats();
+}
@@ -6,6 +6,28 @@
  *
  * This wrapper allows you to specify which SPIClass to use (SPI, SPI1, SPI2)
  * when initializing the RA8875 display controller.
+ *
+ * Asynchronous transport (beginAsync):
+ * Every write - register writes, pixel bursts, text - is appended to a
+ * command list that SPI DMA executes in the background. Each RA8875
+ * transaction (CS low, mode byte, payload, CS high) is one DMA transfer, and
+ * the DMA completion interrupt starts the next one. The register polls the
+ * drawing engine needs (waitPoll/waitBusy) run inside the command list too,
+ * so callers never wait on the display. Both polls give up after 10ms.
+ *
+ * Consecutive register writes share one list entry: their 2-byte transactions
+ * are packed into one arena run. CS is a GPIO and the RA8875 only decodes the
+ * mode byte after a CS edge, so each transaction in a run is still its own
+ * DMA transfer.
+ *
+ * The interrupt only chains plain transfers. Anything that could spin -
+ * re-reading a busy flag, the blocking fallback when no DMA channel is free -
+ * parks the list instead, and service() picks it up from the main loop.
+ *
+ * Pixel data is copied into a transport-owned arena already in wire order
+ * (mode byte + big-endian RGB565), so callers can free or reuse their buffer
+ * as soon as the call returns. A caller only blocks when the command list or
+ * arena is full, or when it reads a register (reads drain the list first).
  */
 
 #ifndef _RA8875_SPI1_H
@@ -14,6 +36,7 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include <Adafruit_GFX.h>
+#include <EventResponder.h>
 
 // RA8875 display sizes
 enum RA8875sizes {
@@ -90,20 +113,126 @@ public:
   void writeCommand(uint8_t d);
   uint8_t readStatus(void);
 
+  // Asynchronous transport
+  struct TransportStats {
+    uint32_t ops;            // Command list entries executed
+    uint32_t transfers;      // DMA transfers (one per RA8875 transaction)
+    uint32_t bytes;
+    uint32_t stalls;         // Writes that waited for queue/arena space
+    uint32_t drains;         // Reads that waited for the list to empty
+    uint32_t dmaErrors;      // Transfers that fell back to blocking SPI
+    uint32_t parks;          // Times the interrupt handed the list to service()
+    uint16_t maxQueued;      // High-water mark of the command list
+    uint64_t busyCycles;     // CPU blocked on the display (sync SPI, stalls, drains)
+    uint64_t isrCycles;      // CPU in the DMA completion interrupt
+    uint32_t sinceMs;        // Start of this measurement window
+  };
+
+  /**
+   * Switch to the DMA command list (after begin())
+   * @param arenaBytes Pixel arena size (PSRAM, heap fallback)
+   * @return false if allocation failed - the driver stays synchronous
+   */
+  bool beginAsync(uint32_t arenaBytes = 65536);
+  bool isAsync() const { return _async; }
+
+  /**
+   * Block until every queued command has been sent
+   */
+  void waitIdle();
+  bool isIdle() const { return _opTail == _opHead && !_running && !_runOp; }
+
+  /**
+   * Send the open register run and continue a parked command list
+   * (call every main loop pass)
+   */
+  void service();
+
+  const TransportStats &getStats() const { return _stats; }
+  void resetStats();
+  void printStats();
+
 private:
   SPIClass *_spi;
   uint8_t _cs, _rst;
   uint16_t _width, _height;
   uint8_t _textScale;
+  uint8_t _mwcr0;            // Shadow of MWCR0 (text/graphics mode) - avoids a read per draw
 
   void waitPoll(uint8_t r, uint8_t f);
   void waitBusy(uint8_t res);
   void writeRegData(uint8_t reg, uint8_t val);
+  void writePixels(const uint16_t *p, uint32_t count);
 
   // SPI transaction helpers
   void spiBegin();
   void spiEnd();
   uint8_t spiTransfer(uint8_t data);
+
+  // Command list
+  enum OpType : uint8_t {
+    OP_REG_RUN,              // Arena run of 2-byte transactions (mode, byte), one transfer each
+    OP_POLL_REG,             // Select reg, re-read until (data & value) == 0 (10ms timeout)
+    OP_POLL_STATUS,          // Re-read status while (status & value) == value (10ms timeout)
+    OP_BYTES                 // Arena span, mode byte included
+  };
+
+  struct Op {
+    uint8_t type;
+    uint8_t reg;
+    uint8_t value;
+    uint8_t phase;           // Transactions issued so far
+    bool ownsArena;
+    uint16_t length;
+    uint32_t arenaStart;     // Monotonic arena offsets
+    uint32_t arenaEnd;
+    uint32_t startUs;        // Poll timeout
+  };
+
+  static const uint16_t QUEUE_OPS = 512;             // Power of 2
+  static const uint16_t CHUNK_BYTES = 4096;          // Largest single pixel transfer
+  static const uint16_t RUN_BYTES = 64;              // Register writes per run x 2
+  static const uint32_t POLL_TIMEOUT_US = 10000;
+
+  Op *reserveOp();
+  void commitOp();
+  uint8_t *reserveArena(Op *op, uint32_t length);
+  void queueOp(uint8_t type, uint8_t reg, uint8_t value);
+  void queueRegBytes(uint8_t mode, uint8_t value);
+  void closeRun();
+  void kick();
+  void pump(bool fromIsr);
+  bool startTransfer(Op &op);
+  void sendDma(const uint8_t *buf, uint8_t *rx, uint32_t count);
+  void onTransferDone();
+  bool finishTransfer();
+  static void dmaEvent(EventResponderRef event);
+
+  bool _async;
+  Op *_ops;
+  volatile uint32_t _opHead;                         // Written by main loop
+  volatile uint32_t _opTail;                         // Written by DMA interrupt
+  volatile bool _running;                            // DMA chain active (holds the SPI transaction)
+  volatile bool _parked;                             // Interrupt stopped the chain for service()
+
+  // Transfer that found no DMA channel, sent blocking from the main loop
+  const uint8_t *_blockingBuf;
+  uint8_t *_blockingRx;
+  uint32_t _blockingCount;
+
+  uint8_t *_arena;
+  bool _arenaInPSRAM;
+  uint32_t _arenaSize;
+  uint32_t _arenaHead;                               // Main loop
+  volatile uint32_t _arenaTail;                      // DMA interrupt
+  Op *_runOp;                                        // Register run still being filled (not yet queued)
+
+  uint8_t *_dmaBuf;                                  // 32-byte aligned: tx[0..1], rx at +32
+  void *_dmaAlloc;
+  EventResponder _event;
+  uint32_t _busyStart;
+
+  TransportStats _stats;
 };
 
 // PWM clock values
@@ -32,6 +32,16 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA */
 	#define SPC_MORE_ACCURACY 0
 #endif
 
+// Skips over timer/port polling loops instead of interpreting every iteration
+// (see SPC_CPU.h). Define as 0 to run the plain interpreter for comparison.
+#ifndef SPC_IDLE_LOOP_CACHE
+	#if SPC_MORE_ACCURACY || defined (SPC_CPU_OPCODE_HOOK)
+		#define SPC_IDLE_LOOP_CACHE 0
+	#else
+		#define SPC_IDLE_LOOP_CACHE 1
+	#endif
+#endif
+
 #ifdef BLARGG_ENABLE_OPTIMIZER
 	#include BLARGG_ENABLE_OPTIMIZER
 #endif
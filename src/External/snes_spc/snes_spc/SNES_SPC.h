@@ -59,6 +59,11 @@ public:
 	enum { voice_count = 8 };
 	void mute_voices( int mask );
 
+	// Sets per-voice output tap (see SPC_DSP::set_voice_tap). Tap frames stay
+	// aligned with output samples, including any samples held over in extra.
+	void set_voice_tap( sample_t* tap, int tap_frames );
+	unsigned voice_tap_count() const;
+
 	// If true, prevents channels and global volumes from being phase-negated.
 	// Only supported by fast DSP.
 	void disable_surround( bool disable = true );
@@ -129,6 +134,25 @@ public:
 
 	enum { signature_size = 35 };
 
+	// Pre-decoded two-instruction polling loop, e.g. "loop: MOV A,$FD / BEQ loop"
+	// (see SPC_CPU.h). Keyed by pc and checked against the code bytes it was
+	// decoded from, so self-modifying code and DSP echo writes can't leave it stale.
+	struct idle_loop_t
+	{
+		uint16_t pc;        // address of the read instruction
+		uint16_t dp;        // direct page it was decoded with (0 or 0x100)
+		uint16_t addr;      // address the loop reads
+		uint8_t  size;      // loop size in bytes (read instruction + branch)
+		uint8_t  code [5];
+		uint8_t  kind;      // idle_none, idle_timer or idle_const
+		uint8_t  reg;       // idle_a, idle_x, idle_y or idle_cmp
+		uint8_t  read_time; // clocks from loop start to the read
+		uint8_t  loop_time; // clocks per iteration with the branch taken
+	};
+	enum { idle_loop_count = 32 };
+	enum { idle_none, idle_timer, idle_const };
+	enum { idle_a, idle_x, idle_y, idle_cmp };
+
 private:
 	SPC_DSP dsp;
 
@@ -174,6 +198,8 @@ private:
 
 		unsigned char cycle_table [256];
 
+		idle_loop_t idle_loops [idle_loop_count];
+
 		struct
 		{
 			// padding to neutralize address overflow
@@ -225,6 +251,7 @@ private:
 	int cpu_read_smp_reg   ( int i, rel_time_t );
 	int cpu_read           ( int addr, rel_time_t );
 	unsigned CPU_mem_bit   ( uint8_t const* pc, rel_time_t );
+	idle_loop_t const* find_idle_loop( int addr, int dp, int size );
 
 	bool check_echo_access ( int addr );
 	uint8_t* run_until_( time_t end_time );
@@ -270,6 +297,10 @@ inline void SNES_SPC::write_port( time_t t, int port, int data )
 
 inline void SNES_SPC::mute_voices( int mask ) { dsp.mute_voices( mask ); }
 
+inline void SNES_SPC::set_voice_tap( sample_t* tap, int tap_frames ) { dsp.set_voice_tap( tap, tap_frames ); }
+
+inline unsigned SNES_SPC::voice_tap_count() const { return dsp.voice_tap_count(); }
+
 inline void SNES_SPC::disable_surround( bool disable ) { dsp.disable_surround( disable ); }
 
 #if !SPC_NO_COPY_STATE_FUNCS
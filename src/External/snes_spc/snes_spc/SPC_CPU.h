@@ -128,6 +128,79 @@ unsigned SNES_SPC::CPU_mem_bit( uint8_t const* pc, rel_time_t rel_time )
 	return t << 8 & 0x100;
 }
 
+//// Idle loop cache
+
+// Sound drivers spend most of their time in a loop that reads a timer output
+// or CPU port and branches back to the read until it changes. Such a loop is
+// decoded once, then whole iterations are skipped in one step:
+//
+// - Timer ($FD-$FF): while the counter is 0, each read returns 0 and only moves
+//   the prescaler, which run_timer_() catches up on later with the same
+//   result. Iterations are skipped up to the read that would see the counter
+//   increment.
+// - Anything else but $F3: nothing the loop does can change the value it
+//   reads (ports only change between run_until_() calls and the DSP isn't run
+//   by the loop), so iterations are skipped up to the end of the time slice.
+//
+// Only a taken BEQ/BNE back over exactly one MOV/CMP is considered. Register
+// state after a skip is exactly what the last skipped iteration would leave.
+
+SNES_SPC::idle_loop_t const* SNES_SPC::find_idle_loop( int addr, int dp, int size )
+{
+	if ( size == 5 )
+		dp = 0; // absolute addressing
+	uint8_t const* code = &RAM [addr];
+	idle_loop_t* e = &m.idle_loops [(addr ^ (addr >> 7)) & (idle_loop_count - 1)];
+	if ( e->pc == addr && e->size == size && e->dp == dp && !memcmp( e->code, code, size ) )
+		return (e->kind != idle_none ? e : 0);
+
+	e->pc   = addr;
+	e->size = size;
+	e->dp   = dp;
+	memcpy( e->code, code, size );
+	e->kind = idle_none;
+
+	int operand;
+	int branch = code [size - 2];
+	if ( size == 4 )
+	{
+		operand = dp + code [1];
+		switch ( code [0] )
+		{
+			case 0xE4: e->reg = idle_a;   break; // MOV A,dp
+			case 0xF8: e->reg = idle_x;   break; // MOV X,dp
+			case 0xEB: e->reg = idle_y;   break; // MOV Y,dp
+			case 0x64: e->reg = idle_cmp; break; // CMP A,dp
+			default:   return 0;
+		}
+	}
+	else if ( code [0] == 0xEC ) // MOV Y,abs
+	{
+		e->reg = idle_y;
+		operand = GET_LE16( code + 1 );
+	}
+	else
+	{
+		return 0;
+	}
+
+	e->addr      = operand;
+	e->read_time = m.cycle_table [code [0]];
+	e->loop_time = e->read_time + m.cycle_table [branch];
+
+	if ( (unsigned) (operand - (r_t0out + 0xF0)) < timer_count )
+	{
+		// Waiting for a tick: "MOV reg,$FD / BEQ"
+		if ( branch == 0xF0 && e->reg != idle_cmp )
+			e->kind = idle_timer;
+	}
+	else if ( operand != r_dspdata + 0xF0 )
+	{
+		e->kind = idle_const;
+	}
+	return (e->kind != idle_none ? e : 0);
+}
+
 //// Status flag handling
 
 // Hex value in name to clarify code and bit shifting.
@@ -235,11 +308,96 @@ loop:
 	goto loop;\
 }
 
+#if SPC_IDLE_LOOP_CACHE
+// Taken branch back over exactly one 2- or 3-byte instruction may be a polling loop
+#define IDLE_BRANCH( cond )\
+{\
+	pc++;\
+	pc += (BOOST::int8_t) data;\
+	if ( cond )\
+	{\
+		if ( (uint8_t) (data + 5) <= 1 )\
+			goto idle_loop;\
+		goto loop;\
+	}\
+	pc -= (BOOST::int8_t) data;\
+	rel_time -= 2;\
+	goto loop;\
+}
+#else
+	#define IDLE_BRANCH( cond ) BRANCH( cond )
+#endif
+
 	case 0xF0: // BEQ
-		BRANCH( !(uint8_t) nz ) // 89% taken
+		IDLE_BRANCH( !(uint8_t) nz ) // 89% taken
 
 	case 0xD0: // BNE
-		BRANCH( (uint8_t) nz )
+		IDLE_BRANCH( (uint8_t) nz )
+
+#if SPC_IDLE_LOOP_CACHE
+	idle_loop: {
+		// pc is back at the read; rel_time is the start of the next iteration
+		idle_loop_t const* e = find_idle_loop( GET_PC(), dp, 0x100 - data );
+		if ( !e )
+			goto loop;
+
+		int count = -rel_time / e->loop_time; // whole iterations left in slice
+		int value;
+		if ( e->kind == idle_timer )
+		{
+			Timer* t = &m.timers [e->addr - (r_t0out + 0xF0)];
+			if ( t->counter )
+				goto loop;
+
+			if ( t->enabled )
+			{
+				// First read time at which the counter is non-zero
+				rel_time_t tick = t->next_time +
+						TIMER_MUL( t, IF_0_THEN_256( t->period - t->divider ) - 1 );
+				int before = tick - (rel_time + e->read_time);
+				if ( before <= 0 )
+					goto loop;
+				before = (before + e->loop_time - 1) / e->loop_time;
+				if ( count > before )
+					count = before;
+			}
+			value = 0;
+		}
+		else
+		{
+			value = RAM [e->addr];
+			int i = e->addr - 0xF0;
+			if ( (unsigned) i < reg_count )
+				value = cpu_read_smp_reg( i, rel_time + e->read_time );
+		}
+
+		if ( count <= 0 )
+			goto loop;
+
+		// Result of one iteration, which must take the branch again
+		int new_nz = value;
+		int new_c  = c;
+		if ( e->reg == idle_cmp )
+		{
+			new_nz = a - value;
+			new_c  = ~new_nz;
+			new_nz &= 0xFF;
+		}
+		if ( !(uint8_t) new_nz != (e->code [e->size - 2] == 0xF0) )
+			goto loop;
+
+		switch ( e->reg )
+		{
+			case idle_a: a = value; break;
+			case idle_x: x = value; break;
+			case idle_y: y = value; break;
+		}
+		nz = new_nz;
+		c  = new_c;
+		rel_time += count * e->loop_time;
+		goto loop;
+	}
+#endif
 
 	case 0x3F:{// CALL
 		int old_addr = GET_PC() + 2;
@@ -85,6 +85,15 @@ void SPC_DSP::set_output( sample_t* out, int size )
 	m.out_end   = out + size;
 }
 
+void SPC_DSP::set_voice_tap( sample_t* tap, int tap_frames )
+{
+	require( !tap || (tap_frames & (tap_frames - 1)) == 0 ); // must be power of 2
+	memset( m.t_voice_out, 0, sizeof m.t_voice_out );
+	m.voice_tap       = tap;
+	m.voice_tap_mask  = tap ? tap_frames - 1 : 0;
+	m.voice_tap_count = 0;
+}
+
 // Volume registers and efb are signed! Easy to forget int8_t cast.
 // Prefixes are to avoid accidental use of locals with same names.
 
@@ -491,6 +500,10 @@ inline void SPC_DSP::voice_output( voice_t const* v, int ch )
 	m.t_main_out [ch] += amp;
 	CLAMP16( m.t_main_out [ch] );
 
+	// Each voice outputs once per sample, so the tap just latches its value
+	if ( m.voice_tap )
+		m.t_voice_out [v - m.voices] [ch] = amp;
+
 	// Optionally add to echo total
 	if ( m.t_eon & v->vbit )
 	{
@@ -683,6 +696,23 @@ ECHO_CLOCK( 27 )
 	m.t_main_out [0] = 0;
 	m.t_main_out [1] = 0;
 
+	// Per-voice tap, scaled by master volume like the main output above
+	if ( m.voice_tap )
+	{
+		sample_t* tap = &m.voice_tap [(m.voice_tap_count & m.voice_tap_mask) * voice_count * 2];
+		bool muted = (REG(flg) & 0x40) != 0;
+		for ( int i = 0; i < voice_count; i++ )
+		{
+			for ( int ch = 0; ch < 2; ch++ )
+			{
+				int s = (m.t_voice_out [i] [ch] * (int8_t) REG(mvoll + ch * 0x10)) >> 7;
+				CLAMP16( s );
+				*tap++ = (sample_t) (muted ? 0 : s);
+			}
+		}
+		m.voice_tap_count++;
+	}
+
 	// TODO: global muting isn't this simple (turns DAC on and off
 	// or something, causing small ~37-sample pulse when first muted)
 	if ( REG(flg) & 0x40 )
@@ -811,6 +841,7 @@ void SPC_DSP::init( void* ram_64k )
 {
 	m.ram = (uint8_t*) ram_64k;
 	mute_voices( 0 );
+	set_voice_tap( 0, 0 );
 	disable_surround( false );
 	set_output( 0, 0 );
 	reset();
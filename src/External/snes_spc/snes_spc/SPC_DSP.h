@@ -51,6 +51,15 @@ public:
 	enum { voice_count = 8 };
 	void mute_voices( int mask );
 
+	// Sets optional per-voice output tap. For every output sample, voice_count L/R
+	// pairs of each voice's output (after master volume, before echo) are written
+	// to tap, treated as a ring of tap_frames frames (must be a power of 2).
+	// NULL disables the tap.
+	void set_voice_tap( sample_t* tap, int tap_frames );
+
+	// Number of frames written to the voice tap since it was set
+	unsigned voice_tap_count() const;
+
 // State
 
 	// Resets DSP and uses supplied values to initialize registers
@@ -184,6 +193,12 @@ private:
 		sample_t* out_end;
 		sample_t* out_begin;
 		sample_t extra [extra_size];
+
+		// voice tap (see set_voice_tap)
+		int t_voice_out [voice_count] [2];
+		sample_t* voice_tap;
+		unsigned voice_tap_mask;
+		unsigned voice_tap_count;
 	};
 	state_t m;
 
@@ -273,6 +288,8 @@ inline void SPC_DSP::write( int addr, int data )
 
 inline void SPC_DSP::mute_voices( int mask ) { m.mute_mask = mask; }
 
+inline unsigned SPC_DSP::voice_tap_count() const { return m.voice_tap_count; }
+
 inline bool SPC_DSP::check_kon()
 {
 	bool old = m.kon_check;
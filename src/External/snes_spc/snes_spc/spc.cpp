@@ -52,6 +52,8 @@ int  spc_read_port       ( SNES_SPC* s, spc_time_t t, int p )           { return
 void spc_write_port      ( SNES_SPC* s, spc_time_t t, int p, int d )    { s->write_port( t, p, d ); }
 void spc_end_frame       ( SNES_SPC* s, spc_time_t t )                  { s->end_frame( t ); }
 void spc_mute_voices     ( SNES_SPC* s, int mask )                      { s->mute_voices( mask ); }
+void spc_set_voice_tap   ( SNES_SPC* s, spc_sample_t* tap, int frames ) { s->set_voice_tap( tap, frames ); }
+unsigned spc_voice_tap_count( SNES_SPC const* s )                        { return s->voice_tap_count(); }
 void spc_disable_surround( SNES_SPC* s, int disable )                   { s->disable_surround( disable ); }
 void spc_set_tempo       ( SNES_SPC* s, int tempo )                     { s->set_tempo( tempo ); }
 spc_err_t spc_load_spc   ( SNES_SPC* s, void const* p, long n )         { return s->load_spc( p, n ); }
@@ -67,6 +67,12 @@ void spc_end_frame( SNES_SPC*, spc_time_t end_time );
 enum { spc_voice_count = 8 };
 void spc_mute_voices( SNES_SPC*, int mask );
 
+/* Sets per-voice output tap: every output sample also writes spc_voice_count
+L/R pairs of per-voice output into tap, a ring of tap_frames frames (power of 2).
+NULL disables. spc_voice_tap_count() returns frames written since it was set. */
+void spc_set_voice_tap( SNES_SPC*, spc_sample_t* tap, int tap_frames );
+unsigned spc_voice_tap_count( SNES_SPC const* );
+
 /* If true, prevents channels and global volumes from being phase-negated.
 Only supported by fast DSP; has no effect on accurate DSP. */
 void spc_disable_surround( SNES_SPC*, int disable );
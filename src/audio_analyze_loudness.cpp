@@ -0,0 +1,345 @@
+/**
+ * @file audio_analyze_loudness.cpp
+ * @brief Implementation of AudioAnalyzeLoudness
+ */
+
+#include "audio_analyze_loudness.h"
+#include <math.h>
+
+static const float SAMPLE_SCALE = 1.0f / 32768.0f;
+
+// BS.1770 gating-block loudness of a mean square (channel weights are 1.0 for L/R)
+static inline float energyToLufs(double energy) {
+    return -0.691f + 10.0f * log10f((float)energy);
+}
+
+static inline double lufsToEnergy(float lufs) {
+    return pow(10.0, (lufs + 0.691) / 10.0);
+}
+
+AudioAnalyzeLoudness::AudioAnalyzeLoudness()
+    : AudioStream(2, inputQueueArray_)
+    , queue_(nullptr)
+    , queueInPSRAM_(false)
+    , queueBlocks_(0)
+    , head_(0)
+    , tail_(0)
+    , capturing_(false)
+    , droppedBlocks_(0)
+    , running_(false) {
+    designFilters();
+    resetMeasurement();
+}
+
+AudioAnalyzeLoudness::~AudioAnalyzeLoudness() {
+    capturing_ = false;
+    if (queue_) {
+        if (queueInPSRAM_) {
+            extmem_free(queue_);
+        } else {
+            free(queue_);
+        }
+        queue_ = nullptr;
+    }
+}
+
+void AudioAnalyzeLoudness::designFilters() {
+    const double fs = AUDIO_SAMPLE_RATE_EXACT;
+
+    // K-weighting, BS.1770 pre-filter re-derived for the codec rate
+    // (the standard only tabulates coefficients for 48kHz)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        double k = tan(M_PI * f0 / fs);
+        double vh = pow(10.0, gainDb / 20.0);
+        double vb = pow(vh, 0.4996667741545416);
+        double a0 = 1.0 + k / q + k * k;
+        stages_[0].b0 = (float)((vh + vb * k / q + k * k) / a0);
+        stages_[0].b1 = (float)(2.0 * (k * k - vh) / a0);
+        stages_[0].b2 = (float)((vh - vb * k / q + k * k) / a0);
+        stages_[0].a1 = (float)(2.0 * (k * k - 1.0) / a0);
+        stages_[0].a2 = (float)((1.0 - k / q + k * k) / a0);
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        double k = tan(M_PI * f0 / fs);
+        double a0 = 1.0 + k / q + k * k;
+        stages_[1].b0 = 1.0f;
+        stages_[1].b1 = -2.0f;
+        stages_[1].b2 = 1.0f;
+        stages_[1].a1 = (float)(2.0 * (k * k - 1.0) / a0);
+        stages_[1].a2 = (float)((1.0 - k / q + k * k) / a0);
+    }
+
+    // True-peak interpolator: 48-tap Hann-windowed sinc at the original
+    // Nyquist, split into 4 phases, each normalized to unity DC gain
+    const int taps = OVERSAMPLE * PHASE_TAPS;
+    const double center = (taps - 1) / 2.0;
+    for (uint8_t p = 0; p < OVERSAMPLE; p++) {
+        double sum = 0.0;
+        double h[PHASE_TAPS];
+        for (uint8_t j = 0; j < PHASE_TAPS; j++) {
+            int n = p + j * OVERSAMPLE;
+            double t = (n - center) / OVERSAMPLE;
+            double sinc = (t == 0.0) ? 1.0 : sin(M_PI * t) / (M_PI * t);
+            double window = 0.5 - 0.5 * cos(2.0 * M_PI * (n + 0.5) / taps);
+            h[j] = sinc * window;
+            sum += h[j];
+        }
+        for (uint8_t j = 0; j < PHASE_TAPS; j++) {
+            phases_[p][j] = (float)(h[j] / sum);
+        }
+    }
+
+    subBlockFrames_ = (uint16_t)(fs * 0.1 + 0.5);
+}
+
+bool AudioAnalyzeLoudness::begin() {
+    if (queue_) return true;
+
+    const size_t blockBytes = FRAMES_PER_BLOCK * 2 * sizeof(int16_t);
+    queue_ = (int16_t*)extmem_malloc((size_t)QUEUE_BLOCKS * blockBytes);
+    if (queue_) {
+        queueInPSRAM_ = true;
+        queueBlocks_ = QUEUE_BLOCKS;
+        return true;
+    }
+
+    // No PSRAM - service() runs every loop pass, so a short queue still keeps up
+    queue_ = (int16_t*)malloc((size_t)QUEUE_BLOCKS_FALLBACK * blockBytes);
+    if (queue_) {
+        queueInPSRAM_ = false;
+        queueBlocks_ = QUEUE_BLOCKS_FALLBACK;
+        Serial.println("[Loudness] WARNING: No PSRAM, using a short heap queue");
+        return true;
+    }
+
+    Serial.println("[Loudness] ERROR: Failed to allocate block queue");
+    return false;
+}
+
+// ============================================
+// AUDIO ISR
+// ============================================
+
+void AudioAnalyzeLoudness::update() {
+    audio_block_t* left = receiveReadOnly(0);
+    audio_block_t* right = receiveReadOnly(1);
+
+    if (capturing_) {
+        uint32_t head = head_;
+        if (head - tail_ >= queueBlocks_) {
+            droppedBlocks_ = droppedBlocks_ + 1;
+        } else {
+            int16_t* dst = queue_ + (head & (queueBlocks_ - 1)) * FRAMES_PER_BLOCK * 2;
+            for (int n = 0; n < FRAMES_PER_BLOCK; n++) {
+                dst[n * 2] = left ? left->data[n] : 0;
+                dst[n * 2 + 1] = right ? right->data[n] : 0;
+            }
+            // Publish only after the slot is filled
+            head_ = head + 1;
+        }
+    }
+
+    if (left) release(left);
+    if (right) release(right);
+}
+
+// ============================================
+// CONTROL (main loop)
+// ============================================
+
+void AudioAnalyzeLoudness::start() {
+    if (!queue_) return;
+
+    capturing_ = false;
+    tail_ = head_;
+    resetMeasurement();
+    running_ = true;
+    capturing_ = true;
+}
+
+void AudioAnalyzeLoudness::stop() {
+    if (!running_) return;
+
+    capturing_ = false;
+    drain(queueBlocks_);
+    running_ = false;
+}
+
+void AudioAnalyzeLoudness::setPaused(bool paused) {
+    if (!running_ || paused == !capturing_) return;
+
+    if (paused) {
+        capturing_ = false;
+        // Finish what was captured before the pause, then start the next
+        // gating block from scratch
+        drain(queueBlocks_);
+        resetGating();
+    } else {
+        capturing_ = true;
+    }
+}
+
+void AudioAnalyzeLoudness::resetMeasurement() {
+    memset(channels_, 0, sizeof(channels_));
+    memset(histogram_, 0, sizeof(histogram_));
+    framesAnalyzed_ = 0;
+    peak_ = 0.0f;
+    droppedBlocks_ = 0;
+    resetGating();
+}
+
+void AudioAnalyzeLoudness::resetGating() {
+    subBlockFill_ = 0;
+    subBlockEnergy_ = 0.0;
+    recentCount_ = 0;
+    recentPos_ = 0;
+}
+
+// ============================================
+// ANALYSIS (main loop)
+// ============================================
+
+void AudioAnalyzeLoudness::service() {
+    if (!running_) return;
+    drain(MAX_BLOCKS_PER_SERVICE);
+}
+
+void AudioAnalyzeLoudness::drain(uint32_t maxBlocks) {
+    uint32_t tail = tail_;
+    uint32_t available = head_ - tail;
+    if (available > maxBlocks) {
+        available = maxBlocks;
+    }
+
+    for (uint32_t i = 0; i < available; i++) {
+        analyzeBlock(queue_ + ((tail + i) & (queueBlocks_ - 1)) * FRAMES_PER_BLOCK * 2);
+    }
+    tail_ = tail + available;
+}
+
+float AudioAnalyzeLoudness::truePeak(Channel& ch, float sample) {
+    // Push into the mirrored ring so history + pos is always contiguous
+    ch.pos = (ch.pos == 0) ? PHASE_TAPS - 1 : ch.pos - 1;
+    ch.history[ch.pos] = sample;
+    ch.history[ch.pos + PHASE_TAPS] = sample;
+    const float* x = ch.history + ch.pos;
+
+    float peak = 0.0f;
+    for (uint8_t p = 0; p < OVERSAMPLE; p++) {
+        const float* h = phases_[p];
+        float y = 0.0f;
+        for (uint8_t j = 0; j < PHASE_TAPS; j++) {
+            y += h[j] * x[j];
+        }
+        y = fabsf(y);
+        if (y > peak) peak = y;
+    }
+    return peak;
+}
+
+void AudioAnalyzeLoudness::analyzeBlock(const int16_t* frames) {
+    for (int n = 0; n < FRAMES_PER_BLOCK; n++) {
+        float energy = 0.0f;
+        for (uint8_t c = 0; c < 2; c++) {
+            Channel& ch = channels_[c];
+            float x = frames[n * 2 + c] * SAMPLE_SCALE;
+
+            float peak = truePeak(ch, x);
+            if (peak > peak_) peak_ = peak;
+
+            // Direct form II transposed, shelf then high-pass
+            float y = x;
+            for (uint8_t s = 0; s < 2; s++) {
+                const Biquad& bq = stages_[s];
+                float out = bq.b0 * y + ch.z1[s];
+                ch.z1[s] = bq.b1 * y - bq.a1 * out + ch.z2[s];
+                ch.z2[s] = bq.b2 * y - bq.a2 * out;
+                y = out;
+            }
+            energy += y * y;
+        }
+
+        subBlockEnergy_ += energy;
+        if (++subBlockFill_ == subBlockFrames_) {
+            closeSubBlock();
+        }
+    }
+    framesAnalyzed_ += FRAMES_PER_BLOCK;
+}
+
+void AudioAnalyzeLoudness::closeSubBlock() {
+    recentEnergy_[recentPos_] = subBlockEnergy_ / subBlockFrames_;
+    recentPos_ = (recentPos_ + 1) & 3;
+    if (recentCount_ < 4) recentCount_++;
+    subBlockEnergy_ = 0.0;
+    subBlockFill_ = 0;
+
+    // A 400ms gating block completes every 100ms (75% overlap)
+    if (recentCount_ < 4) return;
+
+    double energy = (recentEnergy_[0] + recentEnergy_[1] + recentEnergy_[2] + recentEnergy_[3]) * 0.25;
+    if (energy <= 0.0) return;
+
+    float lufs = energyToLufs(energy);
+    if (lufs < ABSOLUTE_GATE_LUFS) return;
+
+    int bin = (int)((lufs - ABSOLUTE_GATE_LUFS) * 10.0f);
+    if (bin >= HISTOGRAM_BINS) bin = HISTOGRAM_BINS - 1;
+    histogram_[bin]++;
+}
+
+AudioAnalyzeLoudness::Result AudioAnalyzeLoudness::getResult() const {
+    Result result;
+    result.valid = false;
+    result.integratedLufs = ABSOLUTE_GATE_LUFS;
+    result.truePeakDbtp = (peak_ > 0.0f) ? 20.0f * log10f(peak_) : -120.0f;
+    result.measuredSeconds = framesAnalyzed_ / AUDIO_SAMPLE_RATE_EXACT;
+
+    // Bin centers stand in for the block energies (0.05 LU worst case)
+    uint32_t count = 0;
+    double sum = 0.0;
+    for (uint16_t b = 0; b < HISTOGRAM_BINS; b++) {
+        if (!histogram_[b]) continue;
+        count += histogram_[b];
+        sum += histogram_[b] * lufsToEnergy(ABSOLUTE_GATE_LUFS + (b + 0.5f) * 0.1f);
+    }
+    if (!count) return result;
+
+    float relativeGate = energyToLufs(sum / count) + RELATIVE_GATE_LU;
+    int first = (int)ceilf((relativeGate - ABSOLUTE_GATE_LUFS) * 10.0f - 0.5f);
+    if (first < 0) first = 0;
+
+    count = 0;
+    sum = 0.0;
+    for (int b = first; b < HISTOGRAM_BINS; b++) {
+        if (!histogram_[b]) continue;
+        count += histogram_[b];
+        sum += histogram_[b] * lufsToEnergy(ABSOLUTE_GATE_LUFS + (b + 0.5f) * 0.1f);
+    }
+    if (!count) return result;
+
+    result.valid = true;
+    result.integratedLufs = energyToLufs(sum / count);
+    return result;
+}
+
+void AudioAnalyzeLoudness::printStats() const {
+    Result r = getResult();
+    Serial.println("=== Loudness Meter Stats ===");
+    Serial.printf("State: %s\n", !running_ ? "idle" : (capturing_ ? "measuring" : "paused"));
+    if (r.valid) {
+        Serial.printf("Integrated: %.1f LUFS, true peak: %.1f dBTP over %.1f s\n",
+                      r.integratedLufs, r.truePeakDbtp, r.measuredSeconds);
+    } else {
+        Serial.printf("Integrated: - (%.1f s analyzed)\n", r.measuredSeconds);
+    }
+    Serial.printf("Queue: %u blocks %s, depth %lu, dropped %lu\n",
+                  queueBlocks_, queueInPSRAM_ ? "PSRAM" : "heap",
+                  head_ - tail_, droppedBlocks_);
+    Serial.println("============================");
+}
@@ -0,0 +1,148 @@
+/**
+ * @file audio_analyze_loudness.h
+ * @brief Background ITU-R BS.1770 loudness / true-peak meter for the final mix
+ *
+ * Taps outputMixer like the recorder does, so it measures what the device
+ * actually plays: the software engines and the line-in OPL3/Genesis boards
+ * alike. LoudnessIndex runs it on tracks that have no index entry yet and
+ * stores the result, so later plays get their gain from the index and pay
+ * nothing for analysis.
+ *
+ * Data path:
+ *   audio ISR  -> copies each 64-frame stereo block into a PSRAM block queue
+ *                 (same single producer / single consumer scheme as AudioRecordMix)
+ *   main loop  -> service() runs the K-weighting filters, the 400ms / 75%
+ *                 overlap gating blocks and the 4x oversampled true-peak
+ *                 detector over the queued blocks
+ *
+ * Integrated loudness uses the BS.1770-4 gates (absolute -70 LUFS, relative
+ * -10 LU). Gating blocks are kept as a 0.1 LU histogram rather than a list,
+ * so a track of any length costs the same 3KB.
+ */
+
+#ifndef AUDIO_ANALYZE_LOUDNESS_H
+#define AUDIO_ANALYZE_LOUDNESS_H
+
+#include <Audio.h>
+#include <stdint.h>
+
+/**
+ * @class AudioAnalyzeLoudness
+ * @brief Stereo-in, no-output AudioStream with a main-loop loudness meter
+ *
+ * Thread Safety:
+ * - update() (ISR) fills the slot at head_, then publishes head_ + 1
+ * - service() (main loop) consumes slots from tail_, then publishes the new tail_
+ * - start()/stop()/setPaused() run in the main loop; capturing_ gates the ISR
+ */
+class AudioAnalyzeLoudness : public AudioStream {
+public:
+    static const uint16_t QUEUE_BLOCKS = 512;            // 743ms in PSRAM (128KB)
+    static const uint16_t QUEUE_BLOCKS_FALLBACK = 64;    // 93ms on the heap (16KB)
+    static const uint8_t MAX_BLOCKS_PER_SERVICE = 16;    // Bounds one service() call (~0.3ms)
+
+    static constexpr float ABSOLUTE_GATE_LUFS = -70.0f;
+    static constexpr float RELATIVE_GATE_LU = -10.0f;
+    static constexpr float HISTOGRAM_MAX_LUFS = 5.0f;
+    static const uint16_t HISTOGRAM_BINS = 750;          // 0.1 LU from -70 to +5 LUFS
+
+    static const uint8_t OVERSAMPLE = 4;                 // True-peak interpolation factor
+    static const uint8_t PHASE_TAPS = 12;                // FIR taps per phase (48 total)
+
+    struct Result {
+        bool valid;                  // At least one gating block passed the gates
+        float integratedLufs;
+        float truePeakDbtp;
+        float measuredSeconds;       // Audio actually analyzed (pauses excluded)
+    };
+
+    AudioAnalyzeLoudness();
+    virtual ~AudioAnalyzeLoudness();
+
+    virtual void update() override;
+
+    /**
+     * Allocate the block queue (main loop, once)
+     */
+    bool begin();
+
+    /**
+     * Clear all measurements and start capturing
+     */
+    void start();
+
+    /**
+     * Stop capturing and analyze whatever is still queued
+     */
+    void stop();
+
+    /**
+     * Exclude audio from the measurement (pause, fade-out) without losing it
+     * Gating blocks never straddle a paused stretch.
+     */
+    void setPaused(bool paused);
+
+    /**
+     * Analyze queued blocks (call from main loop)
+     */
+    void service();
+
+    bool isRunning() const { return running_; }
+    Result getResult() const;
+
+    uint32_t getDroppedBlocks() const { return droppedBlocks_; }
+    void printStats() const;
+
+private:
+    static const uint16_t FRAMES_PER_BLOCK = AUDIO_BLOCK_SAMPLES;
+
+    struct Biquad {
+        float b0, b1, b2, a1, a2;
+    };
+
+    struct Channel {
+        float z1[2];                     // Direct form II transposed state, per stage
+        float z2[2];
+        float history[PHASE_TAPS * 2];   // Mirrored ring: history + pos is newest-first
+        uint8_t pos;
+    };
+
+    void designFilters();
+    void resetMeasurement();
+    void resetGating();
+    void drain(uint32_t maxBlocks);
+    void analyzeBlock(const int16_t* frames);
+    void closeSubBlock();
+    float truePeak(Channel& ch, float sample);
+
+    audio_block_t* inputQueueArray_[2];
+
+    // Block queue (interleaved L/R)
+    int16_t* queue_;
+    bool queueInPSRAM_;
+    uint16_t queueBlocks_;                   // Power of 2
+    volatile uint32_t head_;                 // Written by ISR
+    volatile uint32_t tail_;                 // Written by main loop
+    volatile bool capturing_;
+    volatile uint32_t droppedBlocks_;
+    bool running_;
+
+    // K-weighting (shelf, then high-pass) and true-peak interpolator
+    Biquad stages_[2];
+    float phases_[OVERSAMPLE][PHASE_TAPS];
+    Channel channels_[2];
+
+    // Gating: 100ms sub-blocks, a gating block is the last four
+    uint16_t subBlockFrames_;
+    uint16_t subBlockFill_;
+    double subBlockEnergy_;
+    double recentEnergy_[4];
+    uint8_t recentCount_;
+    uint8_t recentPos_;
+
+    uint32_t histogram_[HISTOGRAM_BINS];     // Gating blocks per 0.1 LU
+    uint32_t framesAnalyzed_;
+    float peak_;                             // Linear, full scale = 1.0
+};
+
+#endif // AUDIO_ANALYZE_LOUDNESS_H
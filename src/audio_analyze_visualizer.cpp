@@ -0,0 +1,180 @@
+/**
+ * @file audio_analyze_visualizer.cpp
+ * @brief Implementation of AudioAnalyzeVisualizer
+ */
+
+#include "audio_analyze_visualizer.h"
+#include <math.h>
+
+AudioAnalyzeVisualizer::AudioAnalyzeVisualizer()
+    : AudioStream(2, inputQueueArray_)
+    , enabled_(false)
+    , writeCount_(0)
+    , lastAnalyzedCount_(0) {
+    memset(ring_, 0, sizeof(ring_));
+    memset(bands_, 0, sizeof(bands_));
+    memset(scope_, 0, sizeof(scope_));
+
+    for (uint16_t n = 0; n < FFT_SIZE; n++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * n / FFT_SIZE);
+        window_[n] = (int16_t)(w * 32767.0f);
+    }
+    for (uint16_t k = 0; k < FFT_SIZE / 2; k++) {
+        float angle = 2.0f * (float)M_PI * k / FFT_SIZE;
+        cos_[k] = (int16_t)(cosf(angle) * 32767.0f);
+        sin_[k] = (int16_t)(sinf(angle) * 32767.0f);
+    }
+
+    // Log-spaced bands over bins 1..63, at least one bin each
+    const uint16_t lastBin = FFT_SIZE / 2;
+    bandEdges_[0] = 1;
+    for (uint8_t b = 1; b <= BANDS; b++) {
+        uint16_t edge = (uint16_t)(powf((float)lastBin, (float)b / BANDS) + 0.5f);
+        if (edge <= bandEdges_[b - 1]) edge = bandEdges_[b - 1] + 1;
+        if (edge > lastBin) edge = lastBin;
+        bandEdges_[b] = (uint8_t)edge;
+    }
+}
+
+void AudioAnalyzeVisualizer::setEnabled(bool enabled) {
+    if (enabled && !enabled_) {
+        // Start from silence rather than whatever was in the ring last time
+        memset(bands_, 0, sizeof(bands_));
+        memset(scope_, 0, sizeof(scope_));
+        lastAnalyzedCount_ = writeCount_;
+    }
+    enabled_ = enabled;
+}
+
+// ============================================
+// AUDIO ISR
+// ============================================
+
+void AudioAnalyzeVisualizer::update() {
+    audio_block_t* left = receiveReadOnly(0);
+    audio_block_t* right = receiveReadOnly(1);
+
+    if (enabled_) {
+        uint32_t count = writeCount_;
+        for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n += DECIMATION) {
+            int32_t sum = 0;
+            for (int i = 0; i < DECIMATION; i++) {
+                if (left) sum += left->data[n + i];
+                if (right) sum += right->data[n + i];
+            }
+            ring_[count & (RING_SIZE - 1)] = (int16_t)(sum / (2 * DECIMATION));
+            count++;
+        }
+        writeCount_ = count;
+    }
+
+    if (left) release(left);
+    if (right) release(right);
+}
+
+// ============================================
+// ANALYSIS (main loop)
+// ============================================
+
+uint16_t AudioAnalyzeVisualizer::log2Q4(uint32_t value) {
+    // log2 in 1/16 steps: integer part from the leading one, fraction from the next 4 bits
+    if (value == 0) return 0;
+    uint32_t n = 31 - __builtin_clz(value);
+    uint32_t frac = (n >= 4) ? (value >> (n - 4)) & 0x0F : (value << (4 - n)) & 0x0F;
+    return (uint16_t)(n * 16 + frac);
+}
+
+void AudioAnalyzeVisualizer::fft() {
+    // Bit-reverse reorder (imaginary part is all zero on entry)
+    for (uint16_t i = 1, j = 0; i < FFT_SIZE; i++) {
+        uint16_t bit = FFT_SIZE >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) {
+            int32_t t = re_[i];
+            re_[i] = re_[j];
+            re_[j] = t;
+        }
+    }
+
+    // Radix-2 DIT, unscaled: 32-bit data holds 2^15 * 2^7, products go through 64 bits
+    for (uint8_t stage = 1; stage <= FFT_LOG2; stage++) {
+        uint16_t half = 1 << (stage - 1);
+        uint16_t twiddleStep = FFT_SIZE >> stage;
+        for (uint16_t start = 0; start < FFT_SIZE; start += half * 2) {
+            for (uint16_t k = 0; k < half; k++) {
+                uint16_t a = start + k;
+                uint16_t b = a + half;
+                int32_t wr = cos_[k * twiddleStep];
+                int32_t wi = sin_[k * twiddleStep];
+                int32_t tr = (int32_t)(((int64_t)re_[b] * wr + (int64_t)im_[b] * wi) >> 15);
+                int32_t ti = (int32_t)(((int64_t)im_[b] * wr - (int64_t)re_[b] * wi) >> 15);
+                re_[b] = re_[a] - tr;
+                im_[b] = im_[a] - ti;
+                re_[a] += tr;
+                im_[a] += ti;
+            }
+        }
+    }
+}
+
+bool AudioAnalyzeVisualizer::analyze() {
+    uint32_t end = writeCount_;
+    if (end == lastAnalyzedCount_ || end < FFT_SIZE) {
+        return false;
+    }
+    lastAnalyzedCount_ = end;
+
+    int16_t samples[FFT_SIZE];
+    uint32_t first = end - FFT_SIZE;
+    for (uint16_t i = 0; i < FFT_SIZE; i++) {
+        samples[i] = ring_[(first + i) & (RING_SIZE - 1)];
+    }
+
+    // Scope: start at the first rising zero crossing so the trace stands still
+    uint16_t trigger = 0;
+    for (uint16_t i = 1; i < FFT_SIZE - SCOPE_POINTS; i++) {
+        if (samples[i - 1] < 0 && samples[i] >= 0) {
+            trigger = i;
+            break;
+        }
+    }
+    for (uint8_t i = 0; i < SCOPE_POINTS; i++) {
+        scope_[i] = (int8_t)(samples[trigger + i] >> 8);
+    }
+
+    // Spectrum
+    for (uint16_t i = 0; i < FFT_SIZE; i++) {
+        re_[i] = ((int32_t)samples[i] * window_[i]) >> 15;
+        im_[i] = 0;
+    }
+    fft();
+
+    for (uint8_t b = 0; b < BANDS; b++) {
+        uint32_t peak = 0;
+        for (uint16_t bin = bandEdges_[b]; bin < bandEdges_[b + 1]; bin++) {
+            // Alpha-max-beta-min magnitude: |z| ~= max + 3/8 min (within 7%)
+            uint32_t ar = (uint32_t)abs(re_[bin]);
+            uint32_t ai = (uint32_t)abs(im_[bin]);
+            uint32_t hi = ar > ai ? ar : ai;
+            uint32_t lo = ar > ai ? ai : ar;
+            uint32_t mag = hi + (lo >> 2) + (lo >> 3);
+            if (mag > peak) peak = mag;
+        }
+
+        int32_t level = (int32_t)log2Q4(peak) - FLOOR_LOG2_Q4;
+        if (level < 0) level = 0;
+        level = level * LEVEL_MAX / RANGE_LOG2_Q4;
+        if (level > LEVEL_MAX) level = LEVEL_MAX;
+
+        // Instant attack, linear falloff
+        if (level >= bands_[b]) {
+            bands_[b] = (uint8_t)level;
+        } else {
+            int32_t fallen = (int32_t)bands_[b] - LEVEL_FALLOFF;
+            bands_[b] = (uint8_t)(fallen > level ? fallen : level);
+        }
+    }
+
+    return true;
+}
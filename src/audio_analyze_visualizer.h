@@ -0,0 +1,96 @@
+/**
+ * @file audio_analyze_visualizer.h
+ * @brief Low-cost spectrum/scope tap on the final mix for the Now Playing screen
+ *
+ * The audio ISR only decimates: it sums L+R and averages groups of
+ * DECIMATION samples into a small ring (16 stores per block). Everything
+ * else - trigger search, window, a 128-point fixed-point FFT and the band
+ * levels - runs in the main loop when analyze() is called, so the cost is
+ * paid only at the display frame rate and only while a view is enabled.
+ *
+ * At 44.1kHz / 4 the analysis covers DC..5.5kHz in 86Hz bins, which is
+ * where almost all of the chip music energy sits. The boxcar decimator lets
+ * some content above 5.5kHz fold back - harmless for a visualizer.
+ */
+
+#ifndef AUDIO_ANALYZE_VISUALIZER_H
+#define AUDIO_ANALYZE_VISUALIZER_H
+
+#include <Audio.h>
+#include <stdint.h>
+
+/**
+ * @class AudioAnalyzeVisualizer
+ * @brief Stereo-in, no-output AudioStream producing band levels and a scope trace
+ *
+ * Thread Safety:
+ * - update() (ISR) writes ring_ and then publishes writeCount_
+ * - analyze() (main loop) copies the newest FFT_SIZE samples; the ring holds
+ *   twice that, so a copy is never overtaken by the ISR
+ */
+class AudioAnalyzeVisualizer : public AudioStream {
+public:
+    static const uint8_t DECIMATION = 4;             // 44.1kHz -> 11.025kHz
+    static const uint16_t FFT_SIZE = 128;            // 86Hz bins, 11.6ms window
+    static const uint8_t BANDS = 16;                 // Log-spaced bars
+    static const uint8_t SCOPE_POINTS = 60;          // 5.4ms of waveform
+    static const uint8_t LEVEL_MAX = 255;
+
+    AudioAnalyzeVisualizer();
+
+    virtual void update() override;
+
+    /**
+     * Enable/disable the ISR decimator (disabled = receive and release only)
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * Analyze the newest window (main loop only)
+     * @return false if no new audio arrived since the last call
+     */
+    bool analyze();
+
+    /**
+     * Band levels 0..LEVEL_MAX (log scale, ~60dB range) with falloff
+     */
+    const uint8_t* getBandLevels() const { return bands_; }
+
+    /**
+     * Scope trace, triggered on a rising zero crossing (-128..127)
+     */
+    const int8_t* getScope() const { return scope_; }
+
+private:
+    static const uint16_t RING_SIZE = FFT_SIZE * 2;
+    static const uint8_t FFT_LOG2 = 7;
+    static const uint8_t LEVEL_FALLOFF = 10;         // Per analyze() call
+    static const uint16_t FLOOR_LOG2_Q4 = 10 * 16;   // Magnitudes below 2^10 show as empty
+    static const uint16_t RANGE_LOG2_Q4 = 10 * 16;   // 2^10..2^20 spans the bar (~60dB)
+
+    void fft();
+    static uint16_t log2Q4(uint32_t value);
+
+    audio_block_t* inputQueueArray_[2];
+
+    volatile bool enabled_;
+    int16_t ring_[RING_SIZE];
+    volatile uint32_t writeCount_;                   // Decimated samples written (ISR)
+    uint32_t lastAnalyzedCount_;
+
+    // Tables (built once in the constructor)
+    int16_t window_[FFT_SIZE];                       // Hann, Q15
+    int16_t cos_[FFT_SIZE / 2];                      // Twiddles, Q15
+    int16_t sin_[FFT_SIZE / 2];
+    uint8_t bandEdges_[BANDS + 1];                   // First bin of each band
+
+    // Work buffers (main loop)
+    int32_t re_[FFT_SIZE];
+    int32_t im_[FFT_SIZE];
+
+    uint8_t bands_[BANDS];
+    int8_t scope_[SCOPE_POINTS];
+};
+
+#endif // AUDIO_ANALYZE_VISUALIZER_H
@@ -20,10 +20,11 @@ AudioConnection* AudioConnectionManager::connect(AudioStream& source, uint8_t so
 }
 
 bool AudioConnectionManager::connectStereo(AudioStream& source,
-                                          AudioMixer4& destLeft, AudioMixer4& destRight,
+                                          AudioStream& destLeft, AudioStream& destRight,
                                           uint8_t destChannel) {
+    uint8_t rightChannel = (&destLeft == &destRight) ? destChannel + 1 : destChannel;
     AudioConnection* left = connect(source, 0, destLeft, destChannel);
-    AudioConnection* right = connect(source, 1, destRight, destChannel);
+    AudioConnection* right = connect(source, 1, destRight, rightChannel);
 
     bool success = (left != nullptr && right != nullptr);
     // Serial.printf("[AudioConnMgr] Stereo connection %s (channel %d, total: %d)\n",
@@ -31,7 +32,7 @@ bool AudioConnectionManager::connectStereo(AudioStream& source,
     return success;
 }
 
-void AudioConnectionManager::muteAndDisconnect(AudioMixer4& fadeMixerLeft, AudioMixer4& fadeMixerRight) {
+void AudioConnectionManager::muteAndDisconnect(AudioMixerStage& fadeMixerLeft, AudioMixerStage& fadeMixerRight) {
     if (connections_.empty()) {
         // // Serial.println("[AudioConnMgr] No connections to disconnect");
         return;
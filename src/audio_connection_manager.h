@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <Audio.h>
+#include "audio_mixer_fused.h"
 #include <vector>
 
 /**
@@ -62,16 +63,17 @@ public:
      * Create stereo pair of connections
      *
      * @param source Source audio stream (must have 2 outputs)
-     * @param destLeft Left channel destination (usually mixerLeft)
-     * @param destRight Right channel destination (usually mixerRight)
-     * @param destChannel Mixer channel to use (0-3)
+     * @param destLeft Left channel destination (usually outputMixer)
+     * @param destRight Right channel destination (usually outputMixer)
+     * @param destChannel Input port to use (left port; right uses destChannel + 1 when
+     *                    both destinations are the same stream)
      * @return true if both connections created successfully
      *
      * Common usage:
-     *   connectStereo(*spcPlayer, mixerLeft, mixerRight, 1);
+     *   connectStereo(*spcPlayer, outputMixer, outputMixer, 12);
      */
     bool connectStereo(AudioStream& source,
-                      AudioMixer4& destLeft, AudioMixer4& destRight,
+                      AudioStream& destLeft, AudioStream& destRight,
                       uint8_t destChannel);
 
     // ============================================
@@ -97,7 +99,7 @@ public:
      * - Audio ISR cannot access deleted connections due to delays
      * - Muting ensures no pops/clicks during disconnection
      */
-    void muteAndDisconnect(AudioMixer4& fadeMixerLeft, AudioMixer4& fadeMixerRight);
+    void muteAndDisconnect(AudioMixerStage& fadeMixerLeft, AudioMixerStage& fadeMixerRight);
 
     /**
      * Disconnect all connections without muting
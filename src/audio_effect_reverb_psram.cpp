@@ -0,0 +1,278 @@
+/**
+ * @file audio_effect_reverb_psram.cpp
+ * @brief Implementation of AudioEffectReverbPSRAM
+ */
+
+#include "audio_effect_reverb_psram.h"
+
+// Freeverb tunings at 44.1kHz (every other comb, the two longest allpasses)
+const uint16_t AudioEffectReverbPSRAM::COMB_TUNING[COMBS] = {1116, 1277, 1422, 1557};
+const uint16_t AudioEffectReverbPSRAM::ALLPASS_TUNING[ALLPASSES] = {556, 341};
+
+static_assert(AUDIO_BLOCK_SAMPLES <= 341, "every delay must hold a whole block");
+
+// Freeverb parameter mapping
+static const float SCALE_ROOM = 0.28f;
+static const float OFFSET_ROOM = 0.7f;
+static const float SCALE_DAMP = 0.4f;
+
+static inline int16_t saturate16(int32_t value) {
+    if (value > 32767) return 32767;
+    if (value < -32768) return -32768;
+    return (int16_t)value;
+}
+
+// Truncate toward zero - rounding toward -inf (a plain shift) leaves the comb
+// feedback loops idling in a small DC limit cycle instead of decaying to 0
+static inline int32_t mulQ15(int32_t a, int32_t b) {
+    int32_t p = a * b;
+    return p >= 0 ? (p >> 15) : -((-p) >> 15);
+}
+
+static inline int32_t toQ15(float level) {
+    if (level < 0.0f) level = 0.0f;
+    if (level > 1.0f) level = 1.0f;
+    return (int32_t)(level * 32768.0f + 0.5f);
+}
+
+AudioEffectReverbPSRAM::AudioEffectReverbPSRAM()
+    : AudioStream(4, inputQueueArray_)
+    , memory_(nullptr)
+    , delayBytes_(0)
+    , enabled_(false)
+    , active_(false)
+    , feedback_(0)
+    , damp_(0) {
+    for (uint8_t c = 0; c < 2; c++) {
+        Line* line = &lines_[c * (COMBS + ALLPASSES)];
+        for (uint8_t i = 0; i < COMBS; i++) {
+            line->length = COMB_TUNING[i] + c * STEREO_SPREAD;
+            line++;
+        }
+        for (uint8_t i = 0; i < ALLPASSES; i++) {
+            line->length = ALLPASS_TUNING[i] + c * STEREO_SPREAD;
+            line++;
+        }
+    }
+    for (uint8_t i = 0; i < LINES; i++) {
+        lines_[i].buffer = nullptr;
+        lines_[i].pos = 0;
+        lines_[i].filter = 0;
+    }
+
+    roomsize(0.6f);
+    damping(0.55f);
+    send_[SEND_LINE_IN] = toQ15(1.0f);
+    send_[SEND_DRUMS] = toQ15(0.5f);
+}
+
+bool AudioEffectReverbPSRAM::begin() {
+    if (memory_) return true;
+
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < LINES; i++) {
+        samples += lines_[i].length;
+    }
+
+    // RAM would defeat the point - this replaced 50KB of Freeverb in RAM1
+    memory_ = (int16_t*)extmem_malloc(samples * sizeof(int16_t));
+    if (!memory_) {
+        Serial.println("[Reverb] WARNING: No PSRAM - reverb unavailable");
+        return false;
+    }
+    delayBytes_ = samples * sizeof(int16_t);
+
+    int16_t* next = memory_;
+    for (uint8_t i = 0; i < LINES; i++) {
+        lines_[i].buffer = next;
+        next += lines_[i].length;
+    }
+    clearLines();
+
+    Serial.printf("[Reverb] %lu bytes of delay lines in PSRAM\n", delayBytes_);
+    return true;
+}
+
+// ============================================
+// CONTROL (main loop)
+// ============================================
+
+void AudioEffectReverbPSRAM::setEnabled(bool enabled) {
+    if (!memory_) return;
+
+    if (enabled && !enabled_ && !active_) {
+        // Idle since the last fade-out - drop the old tail before restarting
+        clearLines();
+    }
+    enabled_ = enabled;
+}
+
+void AudioEffectReverbPSRAM::roomsize(float size) {
+    if (size < 0.0f) size = 0.0f;
+    if (size > 1.0f) size = 1.0f;
+    feedback_ = toQ15(size * SCALE_ROOM + OFFSET_ROOM);
+}
+
+void AudioEffectReverbPSRAM::damping(float amount) {
+    if (amount < 0.0f) amount = 0.0f;
+    if (amount > 1.0f) amount = 1.0f;
+    damp_ = toQ15(amount * SCALE_DAMP);
+}
+
+void AudioEffectReverbPSRAM::setSendLevel(SendInput input, float level) {
+    if (input > SEND_DRUMS) return;
+    send_[input] = toQ15(level);
+}
+
+void AudioEffectReverbPSRAM::clearLines() {
+    if (memory_) {
+        memset(memory_, 0, delayBytes_);
+    }
+    for (uint8_t i = 0; i < LINES; i++) {
+        lines_[i].pos = 0;
+        lines_[i].filter = 0;
+    }
+}
+
+void AudioEffectReverbPSRAM::printStats() {
+    Serial.println("=== Reverb Stats ===");
+    Serial.printf("State: %s\n", !memory_ ? "unavailable" : (enabled_ ? "enabled" : "disabled"));
+    Serial.printf("Delay lines: %lu bytes PSRAM, scratch: %u bytes RAM\n",
+                  delayBytes_, (unsigned)(sizeof(input_) + sizeof(run_) + sizeof(sum_) + sizeof(lines_)));
+    // Audio library per-object profiling: percent of one block period
+    Serial.printf("ISR load: %.2f%% (peak %.2f%%)\n", processorUsage(), processorUsageMax());
+    processorUsageMaxReset();
+    Serial.println("====================");
+}
+
+// ============================================
+// AUDIO ISR
+// ============================================
+
+void AudioEffectReverbPSRAM::readRun(const Line& line) {
+    // The oldest block in the line - one sequential burst, two at the wrap
+    uint16_t first = line.length - line.pos;
+    if (first >= AUDIO_BLOCK_SAMPLES) {
+        memcpy(run_, line.buffer + line.pos, AUDIO_BLOCK_SAMPLES * sizeof(int16_t));
+    } else {
+        memcpy(run_, line.buffer + line.pos, first * sizeof(int16_t));
+        memcpy(run_ + first, line.buffer, (AUDIO_BLOCK_SAMPLES - first) * sizeof(int16_t));
+    }
+}
+
+void AudioEffectReverbPSRAM::writeRun(Line& line) {
+    // New samples go over the run just read
+    uint16_t first = line.length - line.pos;
+    if (first >= AUDIO_BLOCK_SAMPLES) {
+        memcpy(line.buffer + line.pos, run_, AUDIO_BLOCK_SAMPLES * sizeof(int16_t));
+        line.pos += AUDIO_BLOCK_SAMPLES;
+        if (line.pos == line.length) line.pos = 0;
+    } else {
+        memcpy(line.buffer + line.pos, run_, first * sizeof(int16_t));
+        memcpy(line.buffer, run_ + first, (AUDIO_BLOCK_SAMPLES - first) * sizeof(int16_t));
+        line.pos = AUDIO_BLOCK_SAMPLES - first;
+    }
+}
+
+void AudioEffectReverbPSRAM::processComb(Line& line, int32_t feedback, int32_t damp1, int32_t damp2) {
+    readRun(line);
+
+    int32_t filter = line.filter;
+    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+        int32_t out = run_[n];
+        // damp1 + damp2 = 1.0, so the state stays in 16-bit range
+        filter = mulQ15(out, damp2) + mulQ15(filter, damp1);
+        sum_[n] += out;
+        run_[n] = saturate16(input_[n] + mulQ15(filter, feedback));
+    }
+    line.filter = filter;
+
+    writeRun(line);
+}
+
+void AudioEffectReverbPSRAM::processAllpass(Line& line, int16_t* data) {
+    readRun(line);
+
+    // Freeverb allpass, feedback 0.5 (halved toward zero, see mulQ15)
+    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+        int32_t in = data[n];
+        int32_t delayed = run_[n];
+        data[n] = saturate16(delayed - in);
+        run_[n] = saturate16(in + delayed / 2);
+    }
+
+    writeRun(line);
+}
+
+void AudioEffectReverbPSRAM::renderChannel(uint8_t channel, int16_t* out,
+                                           int32_t feedback, int32_t damp1, int32_t damp2) {
+    Line* line = &lines_[channel * (COMBS + ALLPASSES)];
+
+    memset(sum_, 0, sizeof(sum_));
+    for (uint8_t i = 0; i < COMBS; i++) {
+        processComb(*line++, feedback, damp1, damp2);
+    }
+
+    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+        out[n] = saturate16(sum_[n]);
+    }
+
+    for (uint8_t i = 0; i < ALLPASSES; i++) {
+        processAllpass(*line++, out);
+    }
+}
+
+void AudioEffectReverbPSRAM::update() {
+    audio_block_t* in[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        in[i] = receiveReadOnly(i);
+    }
+
+    bool enabled = enabled_;
+    audio_block_t* outLeft = nullptr;
+    audio_block_t* outRight = nullptr;
+
+    if (enabled || active_) {
+        outLeft = allocate();
+        outRight = allocate();
+    }
+
+    if (outLeft && outRight) {
+        active_ = true;
+
+        // Mono send, pre-scaled by 1/8: 1/4 for the four summed combs, 1/2 headroom
+        // for the comb resonance (the sum is restored at the comb output)
+        int32_t sendLine = send_[SEND_LINE_IN];
+        int32_t sendDrums = send_[SEND_DRUMS];
+        for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+            int32_t line = (in[0] ? in[0]->data[n] : 0) + (in[1] ? in[1]->data[n] : 0);
+            int32_t drums = (in[2] ? in[2]->data[n] : 0) + (in[3] ? in[3]->data[n] : 0);
+            input_[n] = (int16_t)(((line * sendLine) >> 19) + ((drums * sendDrums) >> 19));
+        }
+
+        int32_t feedback = feedback_;
+        int32_t damp1 = damp_;
+        int32_t damp2 = 32768 - damp1;
+        renderChannel(0, outLeft->data, feedback, damp1, damp2);
+        renderChannel(1, outRight->data, feedback, damp1, damp2);
+
+        if (!enabled) {
+            // Disabled: ramp the last block to silence, then go idle
+            for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+                int32_t scale = AUDIO_BLOCK_SAMPLES - 1 - n;
+                outLeft->data[n] = (outLeft->data[n] * scale) / AUDIO_BLOCK_SAMPLES;
+                outRight->data[n] = (outRight->data[n] * scale) / AUDIO_BLOCK_SAMPLES;
+            }
+            active_ = false;
+        }
+
+        transmit(outLeft, 0);
+        transmit(outRight, 1);
+    }
+
+    if (outLeft) release(outLeft);
+    if (outRight) release(outRight);
+    for (uint8_t i = 0; i < 4; i++) {
+        if (in[i]) release(in[i]);
+    }
+}
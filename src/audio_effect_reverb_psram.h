@@ -0,0 +1,121 @@
+/**
+ * @file audio_effect_reverb_psram.h
+ * @brief Fixed-point Schroeder reverb for the MIDI path with its delay lines in PSRAM
+ *
+ * The two AudioEffectFreeverb objects were removed because each kept ~25KB of
+ * delay lines in RAM1. This reverb uses the same Freeverb topology (parallel
+ * damped combs into series allpasses, right channel offset by STEREO_SPREAD)
+ * at half the comb count, in Q15, with every delay line in PSRAM.
+ *
+ * PSRAM is only fast when accessed sequentially, so each line is processed a
+ * whole block at a time: every delay is at least AUDIO_BLOCK_SAMPLES long,
+ * which means the block of samples a line returns was fully written before
+ * this update started. update() copies that run into a RAM scratch block
+ * (one or two sequential bursts at the wrap point), processes it, and writes
+ * the new run back over the same addresses. RAM use is the scratch blocks
+ * plus the line table - under 1KB.
+ *
+ * Input is a mono send of the OPL3 line-in and the drum sampler; output is
+ * the wet signal only (stereo). The dry/wet blend is finalMixer ch0/ch1, as
+ * it was with Freeverb. Disabled, update() just releases its inputs.
+ *
+ * Off by default (g_reverbEnabled, Settings > MIDI Audio): its audio
+ * interrupt cost on the board, PSRAM traffic included, has not been measured.
+ * printStats() reports processorUsage()/Max() for that (printed on MIDI stop
+ * with DEBUG_AUDIO_SYSTEM); turn the default on once the peak is known.
+ */
+
+#ifndef AUDIO_EFFECT_REVERB_PSRAM_H
+#define AUDIO_EFFECT_REVERB_PSRAM_H
+
+#include <Audio.h>
+#include <stdint.h>
+
+/**
+ * @class AudioEffectReverbPSRAM
+ * @brief 4-in (line-in L/R, drums L/R), 2-out (wet L/R) reverb
+ *
+ * Thread Safety:
+ * - roomsize()/damping()/setSendLevel() write whole 32-bit values read once
+ *   per update()
+ * - setEnabled(false) lets update() fade out one last block, then go idle;
+ *   setEnabled(true) only clears the delay lines once update() is idle
+ */
+class AudioEffectReverbPSRAM : public AudioStream {
+public:
+    static const uint8_t COMBS = 4;                  // Per channel
+    static const uint8_t ALLPASSES = 2;              // Per channel
+    static const uint8_t LINES = (COMBS + ALLPASSES) * 2;
+    static const uint16_t STEREO_SPREAD = 23;        // Right channel delay offset (samples)
+
+    enum SendInput : uint8_t {
+        SEND_LINE_IN = 0,                            // Inputs 0/1 (OPL3)
+        SEND_DRUMS = 1                               // Inputs 2/3 (drum sampler)
+    };
+
+    AudioEffectReverbPSRAM();
+
+    virtual void update() override;
+
+    /**
+     * Allocate the delay lines in PSRAM (main loop, once)
+     * @return false without PSRAM - the reverb then stays disabled
+     */
+    bool begin();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+    bool isAvailable() const { return memory_ != nullptr; }
+
+    /**
+     * Same ranges and mapping as AudioEffectFreeverb (0.0 - 1.0)
+     */
+    void roomsize(float size);
+    void damping(float amount);
+
+    /**
+     * Level of an input pair in the mono send (0.0 - 1.0)
+     */
+    void setSendLevel(SendInput input, float level);
+
+    uint32_t getDelayBytes() const { return delayBytes_; }
+    void printStats();
+
+private:
+    struct Line {
+        int16_t* buffer;                             // PSRAM
+        uint16_t length;
+        uint16_t pos;                                // Next block starts here
+        int32_t filter;                              // Comb damping state
+    };
+
+    static const uint16_t COMB_TUNING[COMBS];
+    static const uint16_t ALLPASS_TUNING[ALLPASSES];
+
+    void clearLines();
+    void readRun(const Line& line);
+    void writeRun(Line& line);
+    void processComb(Line& line, int32_t feedback, int32_t damp1, int32_t damp2);
+    void processAllpass(Line& line, int16_t* data);
+    void renderChannel(uint8_t channel, int16_t* out, int32_t feedback, int32_t damp1, int32_t damp2);
+
+    audio_block_t* inputQueueArray_[4];
+
+    int16_t* memory_;                                // All lines, one PSRAM allocation
+    uint32_t delayBytes_;
+    Line lines_[LINES];                              // Left combs, left allpasses, then right
+
+    volatile bool enabled_;
+    volatile bool active_;                           // update() still touching the lines
+
+    volatile int32_t feedback_;                      // Q15
+    volatile int32_t damp_;                          // Q15
+    volatile int32_t send_[2];                       // Q15, per SendInput
+
+    // RAM scratch (one block each)
+    int16_t input_[AUDIO_BLOCK_SAMPLES];             // Mono send
+    int16_t run_[AUDIO_BLOCK_SAMPLES];               // Current line's run
+    int32_t sum_[AUDIO_BLOCK_SAMPLES];               // Comb outputs
+};
+
+#endif // AUDIO_EFFECT_REVERB_PSRAM_H
@@ -2,6 +2,11 @@
 #define AUDIO_GLOBALS_H
 
 #include <Audio.h>
+#include "audio_mixer_fused.h"
+#include "audio_analyze_visualizer.h"
+#include "audio_record_mix.h"
+#include "audio_effect_reverb_psram.h"
+#include "audio_sample_clock.h"
 
 /**
  * Global Audio Objects
@@ -10,18 +15,30 @@
  * They are defined in main.cpp and declared as extern here for access by other modules.
  */
 
+// Master sample clock (I2S samples output - schedule chip writes against this)
+extern AudioSampleClock         audioClock;
+
 // Audio I/O
 extern AudioInputI2S            i2sIn;
 extern AudioOutputI2S           i2sOut;
 extern AudioControlSGTL5000     audioShield;
 
-// Mixers
-extern AudioMixer4              mixerLeft;
-extern AudioMixer4              mixerRight;
-extern AudioMixer4              finalMixerLeft;
-extern AudioMixer4              finalMixerRight;
-extern AudioMixer4              fadeMixerLeft;    // Final fade stage (VGM loop fadeout)
-extern AudioMixer4              fadeMixerRight;   // Final fade stage (VGM loop fadeout)
+// Output mixer - every source connects here, the stages below only hold gains
+extern AudioMixerFused          outputMixer;
+
+// Spectrum/scope tap on the final mix (Now Playing visualizer)
+extern AudioAnalyzeVisualizer   mixVisualizer;
+
+// Final-mix WAV recorder (service() runs in the main loop)
+extern AudioRecordMix           mixRecorder;
+
+// Mixer stages (gain-only, see audio_mixer_fused.h)
+extern AudioMixerStage          mixerLeft;
+extern AudioMixerStage          mixerRight;
+extern AudioMixerStage          finalMixerLeft;
+extern AudioMixerStage          finalMixerRight;
+extern AudioMixerStage          fadeMixerLeft;    // Final fade stage (VGM loop fadeout)
+extern AudioMixerStage          fadeMixerRight;   // Final fade stage (VGM loop fadeout)
 
 // DAC/NES Pre-mixer (combines DAC Prerender and NES APU before submixer)
 // Solves conflict where both sources were connected to same submixer channel
@@ -30,8 +47,8 @@ extern AudioMixer4              fadeMixerRight;   // Final fade stage (VGM loop
 // Channel 2: S3M PCM
 // Channel 3: FM9 WAV (embedded audio)
 // Output feeds into mixerChannel1Left/Right channel 0
-extern AudioMixer4              dacNesMixerLeft;
-extern AudioMixer4              dacNesMixerRight;
+extern AudioMixerStage          dacNesMixerLeft;
+extern AudioMixerStage          dacNesMixerRight;
 
 // FM9 WAV player (embedded audio from FM9 extended VGM files)
 // Uses custom AudioStream with sync support and PSRAM buffering
@@ -40,8 +57,7 @@ extern AudioStreamFM9Wav        g_fm9WavStream_obj;
 extern AudioStreamFM9Wav*       g_fm9WavStream;
 
 // Effects
-extern AudioEffectFreeverb      reverbLeft;
-extern AudioEffectFreeverb      reverbRight;
+extern AudioEffectReverbPSRAM   midiReverb;       // Wet return on finalMixer ch1 (MIDI only)
 
 // Persistent AudioConnection pointers for dynamic audio sources
 // These stay allocated for the entire program lifetime to avoid
@@ -0,0 +1,223 @@
+/**
+ * @file audio_mixer_fused.cpp
+ * @brief Implementation of AudioMixerFused / AudioMixerStage
+ */
+
+#include "audio_mixer_fused.h"
+
+// ============================================
+// AudioMixerStage
+// ============================================
+
+AudioMixerStage::AudioMixerStage()
+    : owner_(nullptr) {
+    for (uint8_t i = 0; i < CHANNELS; i++) {
+        gain_[i] = 1.0f;
+    }
+}
+
+void AudioMixerStage::gain(unsigned int channel, float level) {
+    if (channel >= CHANNELS) return;
+    if (gain_[channel] == level) return;
+
+    gain_[channel] = level;
+    if (owner_) {
+        owner_->recompute();
+    }
+}
+
+// ============================================
+// AudioMixerFused - control (main loop)
+// ============================================
+
+AudioMixerFused::AudioMixerFused()
+    : AudioStream(NUM_INPUTS, inputQueueArray_)
+    , outputGain_(1.0f) {
+    for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+        inputGain_[i] = 1.0f;
+        inputPan_[i] = 0.0f;
+        inputMute_[i] = false;
+        for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+            paths_[i][o].hopCount = 0;
+            paths_[i][o].routed = false;
+            target_[i][o] = 0;
+            current_[i][o] = 0;
+        }
+    }
+}
+
+bool AudioMixerFused::route(uint8_t input, uint8_t output, std::initializer_list<Hop> hops) {
+    if (input >= NUM_INPUTS || output >= NUM_OUTPUTS || hops.size() > MAX_HOPS) {
+        return false;
+    }
+
+    Path& path = paths_[input][output];
+    path.hopCount = 0;
+    for (const Hop& hop : hops) {
+        if (!hop.stage || hop.channel >= AudioMixerStage::CHANNELS) {
+            path.routed = false;
+            recompute();
+            return false;
+        }
+        hop.stage->owner_ = this;
+        path.hops[path.hopCount++] = hop;
+    }
+    path.routed = true;
+
+    recompute();
+    return true;
+}
+
+void AudioMixerFused::unroute(uint8_t input, uint8_t output) {
+    if (input >= NUM_INPUTS || output >= NUM_OUTPUTS) return;
+    paths_[input][output].routed = false;
+    recompute();
+}
+
+void AudioMixerFused::setInputGain(uint8_t input, float level) {
+    if (input >= NUM_INPUTS) return;
+    inputGain_[input] = level;
+    recompute();
+}
+
+void AudioMixerFused::setInputPan(uint8_t input, float pan) {
+    if (input >= NUM_INPUTS) return;
+    if (pan < -1.0f) pan = -1.0f;
+    if (pan > 1.0f) pan = 1.0f;
+    inputPan_[input] = pan;
+    recompute();
+}
+
+void AudioMixerFused::setInputMute(uint8_t input, bool mute) {
+    if (input >= NUM_INPUTS) return;
+    inputMute_[input] = mute;
+    recompute();
+}
+
+void AudioMixerFused::setOutputGain(float level) {
+    if (level < 0.0f) level = 0.0f;
+    if (outputGain_ == level) return;
+    outputGain_ = level;
+    recompute();
+}
+
+int32_t AudioMixerFused::getTargetGain(uint8_t input, uint8_t output) const {
+    if (input >= NUM_INPUTS || output >= NUM_OUTPUTS) return 0;
+    return target_[input][output];
+}
+
+void AudioMixerFused::printStats() {
+    Serial.println("=== Output Mixer Stats ===");
+    // Audio library profiling: percent of one block period
+    Serial.printf("Mixer ISR load: %.2f%% (peak %.2f%%)\n", processorUsage(), processorUsageMax());
+    Serial.printf("All audio ISR: %.2f%% (peak %.2f%%), blocks %u (peak %u)\n",
+                  AudioProcessorUsage(), AudioProcessorUsageMax(),
+                  AudioMemoryUsage(), AudioMemoryUsageMax());
+    processorUsageMaxReset();
+    Serial.println("==========================");
+}
+
+int32_t AudioMixerFused::toQ15(float level) {
+    float scaled = level * (float)UNITY_Q15;
+    if (scaled > (float)MAX_GAIN_Q15) return MAX_GAIN_Q15;
+    if (scaled < -(float)MAX_GAIN_Q15) return -MAX_GAIN_Q15;
+    return (int32_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+void AudioMixerFused::recompute() {
+    // At most 18 inputs x 2 outputs x 6 hops - cheap enough to redo on every gain() call
+    for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+        for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+            const Path& path = paths_[i][o];
+            if (!path.routed || inputMute_[i]) {
+                target_[i][o] = 0;
+                continue;
+            }
+
+            float level = inputGain_[i] * outputGain_;
+            for (uint8_t h = 0; h < path.hopCount; h++) {
+                level *= path.hops[h].stage->gain_[path.hops[h].channel];
+            }
+
+            // Linear balance: panning toward one side attenuates the other
+            float pan = inputPan_[i];
+            if (o == 0 && pan > 0.0f) level *= 1.0f - pan;
+            if (o == 1 && pan < 0.0f) level *= 1.0f + pan;
+
+            target_[i][o] = toQ15(level);
+        }
+    }
+}
+
+// ============================================
+// AudioMixerFused - audio ISR
+// ============================================
+
+static inline int16_t saturate16(int32_t value) {
+    if (value > 32767) return 32767;
+    if (value < -32768) return -32768;
+    return (int16_t)value;
+}
+
+void AudioMixerFused::update() {
+    int32_t acc[NUM_OUTPUTS][AUDIO_BLOCK_SAMPLES];
+    bool active[NUM_OUTPUTS] = {false, false};
+
+    for (uint8_t i = 0; i < NUM_INPUTS; i++) {
+        audio_block_t* in = receiveReadOnly(i);
+
+        for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+            int32_t target = target_[i][o];
+            int32_t gain = current_[i][o];
+            current_[i][o] = target;
+
+            // Skip path: idle source, or silent both before and after this block
+            if (!in || (gain == 0 && target == 0)) continue;
+
+            const int16_t* src = in->data;
+            int32_t* dst = acc[o];
+            bool first = !active[o];
+            active[o] = true;
+
+            if (gain != target) {
+                // Ramp from the previous gain to the new one across the block,
+                // interpolated so the last sample lands exactly on the target
+                int32_t delta = target - gain;
+                for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+                    int32_t g = gain + delta * (n + 1) / AUDIO_BLOCK_SAMPLES;
+                    int32_t s = ((int32_t)src[n] * g) >> 15;
+                    dst[n] = first ? s : dst[n] + s;
+                }
+            } else if (gain == UNITY_Q15) {
+                if (first) {
+                    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) dst[n] = src[n];
+                } else {
+                    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) dst[n] += src[n];
+                }
+            } else {
+                if (first) {
+                    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) dst[n] = ((int32_t)src[n] * gain) >> 15;
+                } else {
+                    for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) dst[n] += ((int32_t)src[n] * gain) >> 15;
+                }
+            }
+        }
+
+        if (in) {
+            release(in);
+        }
+    }
+
+    for (uint8_t o = 0; o < NUM_OUTPUTS; o++) {
+        if (!active[o]) continue;
+
+        audio_block_t* out = allocate();
+        if (!out) continue;
+
+        for (int n = 0; n < AUDIO_BLOCK_SAMPLES; n++) {
+            out->data[n] = saturate16(acc[o][n]);
+        }
+        transmit(out, o);
+        release(out);
+    }
+}
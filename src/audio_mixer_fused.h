@@ -0,0 +1,154 @@
+/**
+ * @file audio_mixer_fused.h
+ * @brief Single-node stereo output mixer replacing the cascaded AudioMixer4 chain
+ *
+ * The output path used to be six AudioMixer4 pairs deep (fm9AudioMixer ->
+ * dacNesMixer -> mixerChannel1 -> mixer -> finalMixer -> fadeMixer). Every
+ * stage allocated, scaled and transmitted its own block each update, and
+ * because the stages were constructed in a different order than they were
+ * chained, each hop also parked a block in the next stage's queue until the
+ * following interrupt.
+ *
+ * AudioMixerFused takes every source directly and multiplies each sample once
+ * by the product of all the gains the old chain would have applied.
+ * AudioMixerStage keeps the AudioMixer4 gain() interface so the players still
+ * control "their" stage channels, but a stage is only a set of four numbers:
+ * changing one recomputes the fused per-input gains.
+ */
+
+#ifndef AUDIO_MIXER_FUSED_H
+#define AUDIO_MIXER_FUSED_H
+
+#include <Audio.h>
+#include <initializer_list>
+
+class AudioMixerFused;
+
+/**
+ * @class AudioMixerStage
+ * @brief Gain-only stand-in for one AudioMixer4 of the old output chain
+ *
+ * Not an AudioStream - nothing can be connected to it. Routes through it are
+ * declared with AudioMixerFused::route(). Like AudioMixer4, every channel
+ * starts at unity gain.
+ */
+class AudioMixerStage {
+public:
+    static const uint8_t CHANNELS = 4;
+
+    AudioMixerStage();
+
+    /**
+     * Set a channel gain (same semantics as AudioMixer4::gain)
+     * Takes effect in the fused mixer on the next update, ramped over one block.
+     */
+    void gain(unsigned int channel, float level);
+
+    float getGain(unsigned int channel) const {
+        return (channel < CHANNELS) ? gain_[channel] : 0.0f;
+    }
+
+private:
+    friend class AudioMixerFused;
+
+    float gain_[CHANNELS];
+    AudioMixerFused* owner_;   // Set by the first route() through this stage
+};
+
+/**
+ * @class AudioMixerFused
+ * @brief N-input stereo mixer with Q15 gains, ramped gain changes and a skip path
+ *
+ * Inputs are mono ports (stereo sources use an even/odd pair by convention).
+ * Each input can feed output 0 (left) and output 1 (right) through its own
+ * chain of stage channels, plus a per-input gain, pan and mute.
+ *
+ * Per update, an input costs nothing when its block is absent (source idle)
+ * or both its gains are zero; a unity gain is a plain add. Gains ramp
+ * linearly across one block when they change, so fades and mutes don't click.
+ * The output sum saturates once at the end instead of at every stage.
+ *
+ * Thread Safety:
+ * - gain()/route()/setInput*() run in the main loop and only write whole
+ *   32-bit targets, which update() picks up atomically
+ */
+class AudioMixerFused : public AudioStream {
+public:
+    static const uint8_t NUM_INPUTS = 18;
+    static const uint8_t NUM_OUTPUTS = 2;
+    static const uint8_t MAX_HOPS = 6;               // Deepest path in the old chain (FM9 audio)
+    static const int32_t UNITY_Q15 = 32768;
+    static const int32_t MAX_GAIN_Q15 = 65535;       // Just under 2.0 - keeps sample * gain in 32 bits
+
+    struct Hop {
+        AudioMixerStage* stage;
+        uint8_t channel;
+    };
+
+    AudioMixerFused();
+
+    virtual void update() override;
+
+    /**
+     * Route an input port to an output through a chain of stage channels
+     * The effective gain is the product of all hop gains (an empty chain is
+     * unity). Routing the same input/output pair again replaces the chain.
+     * @return false if a port is out of range or the chain is too long
+     */
+    bool route(uint8_t input, uint8_t output, std::initializer_list<Hop> hops);
+
+    /**
+     * Remove an input's route to an output
+     */
+    void unroute(uint8_t input, uint8_t output);
+
+    // ========== Per-input controls (applied on top of the route gains) ==========
+
+    void setInputGain(uint8_t input, float level);
+    void setInputPan(uint8_t input, float pan);      // -1.0 = left only, 0 = center, 1.0 = right only
+    void setInputMute(uint8_t input, bool mute);
+
+    /**
+     * Gain applied to every input on top of everything else (loudness
+     * normalization). Ramped like any other gain change.
+     */
+    void setOutputGain(float level);
+    float getOutputGain() const { return outputGain_; }
+
+    /**
+     * Current target gain for an input/output pair in Q15 (for diagnostics)
+     */
+    int32_t getTargetGain(uint8_t input, uint8_t output) const;
+
+    /**
+     * ISR load of this node and of the whole audio graph, plus block usage
+     * (resets the peaks). Taken with and without the fused mixer, these are
+     * the before/after figures for the AudioMixer4 chain it replaced.
+     */
+    void printStats();
+
+private:
+    friend class AudioMixerStage;
+
+    struct Path {
+        Hop hops[MAX_HOPS];
+        uint8_t hopCount;
+        bool routed;
+    };
+
+    void recompute();
+    static int32_t toQ15(float level);
+
+    audio_block_t* inputQueueArray_[NUM_INPUTS];
+
+    Path paths_[NUM_INPUTS][NUM_OUTPUTS];
+    float inputGain_[NUM_INPUTS];
+    float inputPan_[NUM_INPUTS];
+    bool inputMute_[NUM_INPUTS];
+    float outputGain_;
+
+    volatile int32_t target_[NUM_INPUTS][NUM_OUTPUTS];   // Written by main loop
+    int32_t current_[NUM_INPUTS][NUM_OUTPUTS];           // Owned by update()
+};
+
+#endif // AUDIO_MIXER_FUSED_H
@@ -232,6 +232,17 @@ public:
      */
     virtual float getProgress() const = 0;
 
+    /**
+     * Jump forward to a position as fast as the engine allows (used by resume)
+     *
+     * @param positionMs Target in the same units getPositionMs() reports
+     * @return true if playback is now at the target
+     *
+     * NOTE: Only valid while PLAYING or PAUSED. Players without a fast path
+     * keep this default and carry on from where they are.
+     */
+    virtual bool seekToMs(uint32_t positionMs) { (void)positionMs; return false; }
+
     // ============================================
     // METADATA
     // ============================================
@@ -0,0 +1,294 @@
+/**
+ * @file audio_record_mix.cpp
+ * @brief Implementation of AudioRecordMix
+ */
+
+#include "audio_record_mix.h"
+
+static const char* RECORD_DIR = "/RECORD";
+// The codec runs at AUDIO_SAMPLE_RATE_EXACT (44117.647Hz), not 44100 - the header
+// carries it rounded, so the file plays back at the pitch and speed it was heard
+static const uint32_t RECORD_SAMPLE_RATE = (uint32_t)(AUDIO_SAMPLE_RATE_EXACT + 0.5f);
+
+AudioRecordMix::AudioRecordMix()
+    : AudioStream(2, inputQueueArray_)
+    , queue_(nullptr)
+    , queueInPSRAM_(false)
+    , queueBlocks_(0)
+    , head_(0)
+    , tail_(0)
+    , recording_(false)
+    , fileOpen_(false)
+    , dataBytes_(0)
+    , totalWriteUs_(0) {
+    path_[0] = '\0';
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+AudioRecordMix::~AudioRecordMix() {
+    if (recording_ || fileOpen_) {
+        stop();
+    }
+    if (queue_) {
+        if (queueInPSRAM_) {
+            extmem_free(queue_);
+        } else {
+            free(queue_);
+        }
+        queue_ = nullptr;
+    }
+}
+
+// ============================================
+// AUDIO ISR
+// ============================================
+
+void AudioRecordMix::update() {
+    audio_block_t* left = receiveReadOnly(0);
+    audio_block_t* right = receiveReadOnly(1);
+
+    if (recording_) {
+        uint32_t head = head_;
+        uint32_t depth = head - tail_;
+
+        if (depth >= queueBlocks_) {
+            stats_.droppedBlocks++;
+        } else {
+            int16_t* dst = queue_ + (head & (queueBlocks_ - 1)) * FRAMES_PER_BLOCK * 2;
+            for (int n = 0; n < FRAMES_PER_BLOCK; n++) {
+                dst[n * 2] = left ? left->data[n] : 0;
+                dst[n * 2 + 1] = right ? right->data[n] : 0;
+            }
+
+            // Publish only after the slot is filled
+            head_ = head + 1;
+            stats_.blocksRecorded++;
+            if (depth + 1 > stats_.maxQueueDepth) {
+                stats_.maxQueueDepth = depth + 1;
+            }
+        }
+    }
+
+    if (left) release(left);
+    if (right) release(right);
+}
+
+// ============================================
+// CONTROL (main loop)
+// ============================================
+
+bool AudioRecordMix::allocateQueue() {
+    if (queue_) return true;
+
+    queue_ = (int16_t*)extmem_malloc((size_t)QUEUE_BLOCKS * BLOCK_BYTES);
+    if (queue_) {
+        queueInPSRAM_ = true;
+        queueBlocks_ = QUEUE_BLOCKS;
+        return true;
+    }
+
+    // No PSRAM - a short queue still works when nothing else is hitting the card
+    queue_ = (int16_t*)malloc((size_t)QUEUE_BLOCKS_FALLBACK * BLOCK_BYTES);
+    if (queue_) {
+        queueInPSRAM_ = false;
+        queueBlocks_ = QUEUE_BLOCKS_FALLBACK;
+        Serial.println("[AudioRecordMix] WARNING: No PSRAM, using a short heap queue");
+        return true;
+    }
+
+    Serial.println("[AudioRecordMix] ERROR: Failed to allocate block queue");
+    return false;
+}
+
+bool AudioRecordMix::nextFreePath() {
+    for (uint16_t i = 1; i <= 9999; i++) {
+        snprintf(path_, sizeof(path_), "%s/REC%04u.WAV", RECORD_DIR, i);
+        if (!SD.exists(path_)) {
+            return true;
+        }
+    }
+    Serial.println("[AudioRecordMix] ERROR: No free recording file name");
+    return false;
+}
+
+bool AudioRecordMix::start(const char* path, uint32_t preallocSeconds) {
+    if (recording_ || fileOpen_) {
+        return false;
+    }
+    if (!allocateQueue()) {
+        return false;
+    }
+
+    if (!SD.exists(RECORD_DIR)) {
+        SD.mkdir(RECORD_DIR);
+    }
+    if (path) {
+        strncpy(path_, path, sizeof(path_) - 1);
+        path_[sizeof(path_) - 1] = '\0';
+    } else if (!nextFreePath()) {
+        return false;
+    }
+
+    file_ = SD.sdfs.open(path_, O_RDWR | O_CREAT | O_TRUNC);
+    if (!file_) {
+        Serial.printf("[AudioRecordMix] ERROR: Failed to create %s\n", path_);
+        return false;
+    }
+    fileOpen_ = true;
+
+    memset(&stats_, 0, sizeof(stats_));
+    stats_.queueBlocks = queueBlocks_;
+    dataBytes_ = 0;
+    totalWriteUs_ = 0;
+
+    // Reserve the first stretch so early writes never wait on cluster allocation.
+    // This is one blocking call (see start() in the header) - allocMs is logged below.
+    uint64_t reserveBytes = HEADER_SIZE + (uint64_t)preallocSeconds * RECORD_SAMPLE_RATE * 2 * sizeof(int16_t);
+    uint32_t allocStart = millis();
+    if (file_.preAllocate(reserveBytes)) {
+        stats_.contiguous = file_.isContiguous();
+    } else {
+        Serial.println("[AudioRecordMix] WARNING: Preallocation failed - file will grow as it records");
+    }
+    uint32_t allocMs = millis() - allocStart;
+
+    if (!writeHeader(0)) {
+        file_.close();
+        fileOpen_ = false;
+        return false;
+    }
+
+    head_ = 0;
+    tail_ = 0;
+    recording_ = true;
+
+    Serial.printf("[AudioRecordMix] Recording to %s (%lu MB reserved in %lu ms, %s, queue %u blocks in %s)\n",
+                  path_, (uint32_t)(reserveBytes >> 20), allocMs,
+                  stats_.contiguous ? "contiguous" : "fragmented",
+                  queueBlocks_, queueInPSRAM_ ? "PSRAM" : "RAM");
+    return true;
+}
+
+bool AudioRecordMix::stop() {
+    if (!fileOpen_) return false;
+
+    // The ISR can't be mid-update here (it preempts us), so nothing is queued after this
+    recording_ = false;
+
+    bool ok = true;
+    while (ok && head_ != tail_) {
+        uint32_t pending = head_ - tail_;
+        ok = writeBlocks(pending < WRITE_BLOCKS ? pending : WRITE_BLOCKS);
+    }
+
+    // Patch the sizes and give back the unused preallocation
+    if (!writeHeader(dataBytes_)) ok = false;
+    if (!file_.truncate(HEADER_SIZE + dataBytes_)) ok = false;
+    file_.sync();
+    file_.close();
+    fileOpen_ = false;
+
+    Serial.printf("[AudioRecordMix] Stopped %s: %lu ms, %lu blocks written, %lu dropped\n",
+                  path_, getRecordedMs(), stats_.blocksWritten, stats_.droppedBlocks);
+    Serial.printf("[AudioRecordMix]   queue high-water %u/%u blocks, SD write avg %lu us / max %lu us, %lu errors\n",
+                  stats_.maxQueueDepth, stats_.queueBlocks, stats_.avgWriteUs, stats_.maxWriteUs,
+                  stats_.writeErrors);
+    return ok;
+}
+
+void AudioRecordMix::service() {
+    if (!fileOpen_) return;
+    if (!recording_) {
+        // A write failed - finalize what made it to the card
+        stop();
+        return;
+    }
+
+    // One 16KB write per call keeps each main-loop stall short; catch up harder
+    // only when the queue is past half full
+    uint32_t pending = head_ - tail_;
+    if (pending < WRITE_BLOCKS) return;
+    if (!writeBlocks(WRITE_BLOCKS)) return;
+
+    while ((head_ - tail_) > queueBlocks_ / 2) {
+        if (!writeBlocks(WRITE_BLOCKS)) return;
+    }
+}
+
+uint32_t AudioRecordMix::getRecordedMs() const {
+    return (uint32_t)((double)stats_.blocksRecorded * FRAMES_PER_BLOCK * 1000.0 / AUDIO_SAMPLE_RATE_EXACT);
+}
+
+// ============================================
+// FILE I/O
+// ============================================
+
+bool AudioRecordMix::writeBlocks(uint32_t count) {
+    uint32_t tail = tail_;
+    uint32_t slot = tail & (queueBlocks_ - 1);
+
+    // Never straddle the end of the ring (tail moves in WRITE_BLOCKS steps, so this
+    // only trims the final drain in stop())
+    if (slot + count > queueBlocks_) {
+        count = queueBlocks_ - slot;
+    }
+
+    const uint8_t* src = (const uint8_t*)(queue_ + slot * FRAMES_PER_BLOCK * 2);
+    size_t bytes = (size_t)count * BLOCK_BYTES;
+
+    uint32_t start = micros();
+    size_t written = file_.write(src, bytes);
+    uint32_t elapsed = micros() - start;
+
+    stats_.writes++;
+    totalWriteUs_ += elapsed;
+    stats_.avgWriteUs = (uint32_t)(totalWriteUs_ / stats_.writes);
+    if (elapsed > stats_.maxWriteUs) {
+        stats_.maxWriteUs = elapsed;
+    }
+
+    if (written != bytes) {
+        stats_.writeErrors++;
+        Serial.println("[AudioRecordMix] ERROR: SD write failed - stopping");
+        recording_ = false;
+        return false;
+    }
+
+    tail_ = tail + count;
+    dataBytes_ += bytes;
+    stats_.blocksWritten += count;
+    return true;
+}
+
+bool AudioRecordMix::writeHeader(uint32_t dataBytes) {
+    uint8_t header[HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+
+    const uint16_t channels = 2;
+    const uint16_t bitsPerSample = 16;
+    const uint16_t blockAlign = channels * bitsPerSample / 8;
+    const uint32_t byteRate = RECORD_SAMPLE_RATE * blockAlign;
+    const uint32_t riffSize = HEADER_SIZE - 8 + dataBytes;
+    const uint32_t fmtSize = 16;
+    const uint16_t pcmFormat = 1;
+    const uint32_t junkSize = HEADER_SIZE - 12 - (8 + fmtSize) - 8 - 8;
+
+    // Cortex-M7 is little-endian, same as RIFF
+    uint8_t* p = header;
+    memcpy(p, "RIFF", 4); memcpy(p + 4, &riffSize, 4); memcpy(p + 8, "WAVE", 4);
+    p += 12;
+    memcpy(p, "fmt ", 4); memcpy(p + 4, &fmtSize, 4);
+    memcpy(p + 8, &pcmFormat, 2); memcpy(p + 10, &channels, 2);
+    memcpy(p + 12, &RECORD_SAMPLE_RATE, 4); memcpy(p + 16, &byteRate, 4);
+    memcpy(p + 20, &blockAlign, 2); memcpy(p + 22, &bitsPerSample, 2);
+    p += 8 + fmtSize;
+    memcpy(p, "JUNK", 4); memcpy(p + 4, &junkSize, 4);  // Pads samples to a sector boundary
+    p += 8 + junkSize;
+    memcpy(p, "data", 4); memcpy(p + 4, &dataBytes, 4);
+
+    if (!file_.seekSet(0) || file_.write(header, HEADER_SIZE) != HEADER_SIZE) {
+        Serial.println("[AudioRecordMix] ERROR: Failed to write WAV header");
+        return false;
+    }
+    return file_.seekSet(HEADER_SIZE + dataBytes_);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file audio_record_mix.h
+ * @brief Records the final mix (software engines + line-in hardware chips) to WAV on SD
+ *
+ * The OPL3 and Genesis boards only exist as analog audio coming back through
+ * the codec line-in, so the only place the device's real output exists as
+ * samples is outputMixer. This stream taps those two outputs.
+ *
+ * Data path:
+ *   audio ISR  -> copies each 64-frame stereo block into a PSRAM block queue
+ *                 (single producer / single consumer, no locks - head/tail only)
+ *   main loop  -> service() writes WRITE_BLOCKS at a time (16KB, sector aligned)
+ *                 into a file preallocated at start()
+ *
+ * The WAV header is padded with a JUNK chunk to 512 bytes so every sample
+ * write starts on a sector boundary. The first couple of minutes are
+ * preallocated contiguously; past that the file grows a cluster at a time
+ * as it is written (one cluster per 16KB write at most, picked from just
+ * after the last one). The unused preallocation is truncated away in stop().
+ *
+ * The queue holds ~1.5s of audio to ride out SD write stalls while a VGZ/FM9
+ * streams from the same card. Blocks are only dropped if the queue actually
+ * fills; stop() logs the drop count, queue high-water mark and slowest write.
+ */
+
+#ifndef AUDIO_RECORD_MIX_H
+#define AUDIO_RECORD_MIX_H
+
+#include <Audio.h>
+#include <SD.h>
+#include <stdint.h>
+
+/**
+ * @class AudioRecordMix
+ * @brief Stereo-in, no-output AudioStream with a background WAV writer
+ *
+ * Thread Safety:
+ * - update() (ISR) fills the slot at head_, then publishes head_ + 1
+ * - service() (main loop) writes slots from tail_, then publishes the new tail_
+ * - start()/stop() run in the main loop; recording_ gates the ISR
+ */
+class AudioRecordMix : public AudioStream {
+public:
+    static const uint16_t QUEUE_BLOCKS = 1024;           // 1.49s in PSRAM (256KB)
+    static const uint16_t QUEUE_BLOCKS_FALLBACK = 128;   // 186ms on the heap (32KB)
+    static const uint16_t WRITE_BLOCKS = 64;             // 16KB per SD write
+    static const uint32_t PREALLOC_SECONDS = 2 * 60;     // ~21MB reserved at start()
+    static const uint32_t HEADER_SIZE = 512;             // RIFF + fmt + JUNK + data header
+
+    struct Stats {
+        uint32_t blocksRecorded;     // Blocks queued by the ISR
+        uint32_t blocksWritten;      // Blocks written to SD
+        uint32_t droppedBlocks;      // Blocks lost to a full queue
+        uint16_t queueBlocks;        // Queue capacity
+        uint16_t maxQueueDepth;      // High-water mark
+        uint32_t writes;
+        uint32_t maxWriteUs;         // Slowest single SD write
+        uint32_t avgWriteUs;
+        uint32_t writeErrors;
+        bool contiguous;             // The preallocated stretch is contiguous
+    };
+
+    AudioRecordMix();
+    virtual ~AudioRecordMix();
+
+    virtual void update() override;
+
+    /**
+     * Start recording to a new WAV file
+     *
+     * preAllocate() finds all its contiguous clusters in one blocking call and
+     * SdFat can't extend the allocation later, so only preallocSeconds are
+     * reserved - a few hundred clusters, not the tens of thousands a whole
+     * album would need. Now Playing starts recording mid-track, so this call
+     * runs during playback; the time it takes is logged.
+     *
+     * @param path Output path, or nullptr for the next free /RECORD/RECnnnn.WAV
+     * @param preallocSeconds Length to reserve up front (recording runs past it)
+     * @return true if recording started
+     */
+    bool start(const char* path = nullptr, uint32_t preallocSeconds = PREALLOC_SECONDS);
+
+    /**
+     * Drain the queue, finalize the header and close the file
+     */
+    bool stop();
+
+    /**
+     * Write queued blocks to SD (call from main loop)
+     */
+    void service();
+
+    bool isRecording() const { return recording_; }
+    uint32_t getRecordedMs() const;
+    const char* getPath() const { return path_; }
+    const Stats& getStats() const { return stats_; }
+
+private:
+    static const uint16_t FRAMES_PER_BLOCK = AUDIO_BLOCK_SAMPLES;
+    static const uint16_t BLOCK_BYTES = FRAMES_PER_BLOCK * 2 * sizeof(int16_t);
+
+    bool allocateQueue();
+    bool writeBlocks(uint32_t count);
+    bool writeHeader(uint32_t dataBytes);
+    bool nextFreePath();
+
+    audio_block_t* inputQueueArray_[2];
+
+    // Block queue (interleaved L/R, BLOCK_BYTES per slot)
+    int16_t* queue_;
+    bool queueInPSRAM_;
+    uint16_t queueBlocks_;                   // Power of 2
+    volatile uint32_t head_;                 // Written by ISR
+    volatile uint32_t tail_;                 // Written by main loop
+    volatile bool recording_;
+
+    FsFile file_;
+    bool fileOpen_;
+    uint32_t dataBytes_;
+    uint64_t totalWriteUs_;
+    char path_[64];
+
+    Stats stats_;
+};
+
+#endif // AUDIO_RECORD_MIX_H
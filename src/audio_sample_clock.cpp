@@ -0,0 +1,56 @@
+/**
+ * @file audio_sample_clock.cpp
+ * @brief Implementation of AudioSampleClock
+ */
+
+#include "audio_sample_clock.h"
+#include "debug_config.h"
+
+AudioSampleClock::AudioSampleClock()
+    : AudioStream(0, nullptr)
+    , blockStart_(0)
+    , blockMicros_(0)
+    , stressBurnUs_(0) {
+    // Nothing connects to the clock, so enable updates directly
+    active = true;
+}
+
+// ============================================
+// AUDIO ISR
+// ============================================
+
+void AudioSampleClock::update() {
+    // Publish the time first - now() pairs it with blockStart_ via the re-read
+    blockMicros_ = micros();
+    blockStart_ = blockStart_ + AUDIO_BLOCK_SAMPLES;
+
+#if DEBUG_LOAD_SHEDDER_STRESS
+    uint32_t burnUs = stressBurnUs_;
+    if (burnUs) {
+        uint32_t start = micros();
+        while (micros() - start < burnUs) {}
+    }
+#endif
+}
+
+// ============================================
+// MAIN LOOP
+// ============================================
+
+uint32_t AudioSampleClock::now() const {
+    uint32_t start;
+    uint32_t startMicros;
+    do {
+        start = blockStart_;
+        startMicros = blockMicros_;
+    } while (start != blockStart_);
+
+    // Interpolate inside the block, but never past its end: if the ISR is
+    // late, time waits for it instead of running ahead of the software streams
+    uint32_t elapsedUs = micros() - startMicros;
+    uint32_t offset = (uint32_t)(elapsedUs * (AUDIO_SAMPLE_RATE_EXACT / 1000000.0f));
+    if (offset >= AUDIO_BLOCK_SAMPLES) {
+        offset = AUDIO_BLOCK_SAMPLES - 1;
+    }
+    return start + offset;
+}
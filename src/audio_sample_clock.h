@@ -0,0 +1,72 @@
+/**
+ * @file audio_sample_clock.h
+ * @brief Master sample clock driven by the audio ISR
+ *
+ * The codec runs at AUDIO_SAMPLE_RATE_EXACT (~44117.6Hz on Teensy 4), not
+ * 44100Hz. The software sources (NES/GB APU, SPC, DAC pre-render, FM9 audio)
+ * emit one sample per output sample, so they run at the I2S rate. The VGM
+ * timeline used to run against micros() at 44100Hz. The hardware chips then
+ * fell behind the software parts by ~1.4s per hour, and the DAC/FM9 streams
+ * had to keep skipping or stretching samples to follow.
+ *
+ * AudioSampleClock counts output samples in the audio ISR. Anything that
+ * schedules chip writes against now() therefore advances exactly as fast as
+ * the software streams consume samples. micros() is only used to interpolate
+ * inside the current block, so now() is smooth but never runs ahead of the
+ * next block.
+ *
+ * Construct it before the other AudioStream objects. It then updates first in
+ * each audio interrupt, and the blocks rendered in that interrupt start at
+ * blockStart().
+ */
+
+#ifndef AUDIO_SAMPLE_CLOCK_H
+#define AUDIO_SAMPLE_CLOCK_H
+
+#include <Audio.h>
+#include <stdint.h>
+
+/**
+ * @class AudioSampleClock
+ * @brief No-input, no-output AudioStream that counts I2S samples
+ *
+ * Thread Safety:
+ * - update() (ISR) writes blockStart_ and blockMicros_
+ * - now() (main loop) re-reads blockStart_ until both values belong to the
+ *   same block
+ */
+class AudioSampleClock : public AudioStream {
+public:
+    AudioSampleClock();
+
+    virtual void update() override;
+
+    /**
+     * Current output sample position (wraps after ~27 hours - compare with
+     * (int32_t)(a - b))
+     */
+    uint32_t now() const;
+
+    /**
+     * First sample of the block being rendered in this audio interrupt
+     */
+    uint32_t blockStart() const { return blockStart_; }
+
+    /**
+     * Output sample rate the clock counts at
+     */
+    static float sampleRate() { return AUDIO_SAMPLE_RATE_EXACT; }
+
+    /**
+     * Busy-wait this long in every update() - synthetic ISR load for
+     * LoadShedder::startStressTest() (only with DEBUG_LOAD_SHEDDER_STRESS)
+     */
+    void setStressBurnUs(uint32_t us) { stressBurnUs_ = us; }
+
+private:
+    volatile uint32_t blockStart_;
+    volatile uint32_t blockMicros_;    // micros() when blockStart_ was published
+    volatile uint32_t stressBurnUs_;
+};
+
+#endif // AUDIO_SAMPLE_CLOCK_H
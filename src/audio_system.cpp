@@ -1,4 +1,6 @@
 #include "audio_system.h"
+#include "audio_effect_reverb_psram.h"
+#include "debug_config.h"
 #include "drum_sampler_v2.h"
 #include "opl3_synth.h"
 
@@ -21,16 +23,16 @@ static constexpr float GENESIS_LINE_IN_GAIN = 0.9f;    // Mixer software gain fo
 bool AudioSystem::initialize(
     const Config& config,
     AudioControlSGTL5000& audioShield,
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight,
-    AudioMixer4& finalMixerLeft,
-    AudioMixer4& finalMixerRight,
-    AudioMixer4& fadeMixerLeft,
-    AudioMixer4& fadeMixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight,
+    AudioMixerStage& finalMixerLeft,
+    AudioMixerStage& finalMixerRight,
+    AudioMixerStage& fadeMixerLeft,
+    AudioMixerStage& fadeMixerRight,
+    AudioEffectReverbPSRAM& reverb
 ) {
     // Note: AudioMemory() must be called by the caller before this function
     // (it requires a compile-time constant, not a runtime variable)
-    // Note: Reverb removed to save ~50KB RAM (AudioEffectFreeverb uses 25KB each)
 
     // Initialize SGTL5000 audio codec
     audioShield.enable();
@@ -44,11 +46,9 @@ bool AudioSystem::initialize(
     // Configure mixer gains
     configureMixers(config, mixerLeft, mixerRight);
 
-    // Reverb removed - configure final mixer for direct passthrough
-    finalMixerLeft.gain(0, 1.0f);   // Direct signal at 100%
-    finalMixerLeft.gain(1, 0.0f);   // No reverb
-    finalMixerRight.gain(0, 1.0f);  // Direct signal at 100%
-    finalMixerRight.gain(1, 0.0f);  // No reverb
+    // Configure reverb (final mixer ch0 = dry, ch1 = wet)
+    configureReverb(reverb);
+    enableReverb(finalMixerLeft, finalMixerRight, reverb, config.enableReverb);
 
     // Configure crossfeed
     enableCrossfeed(mixerLeft, mixerRight, config.enableCrossfeed);
@@ -68,8 +68,8 @@ bool AudioSystem::initialize(
 }
 
 void AudioSystem::setPCMGain(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight,
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight,
     float gain
 ) {
     mixerLeft.gain(1, gain);   // PCM left channel
@@ -77,8 +77,8 @@ void AudioSystem::setPCMGain(
 }
 
 void AudioSystem::enableCrossfeed(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight,
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight,
     bool enable
 ) {
     if (enable) {
@@ -96,37 +96,45 @@ void AudioSystem::enableCrossfeed(
     }
 }
 
-// Reverb removed to save ~50KB RAM (AudioEffectFreeverb uses 25KB each)
-// void AudioSystem::enableReverb(
-//     AudioMixer4& finalMixerLeft,
-//     AudioMixer4& finalMixerRight,
-//     AudioEffectFreeverb& reverbLeft,
-//     AudioEffectFreeverb& reverbRight,
-//     bool enable
-// ) {
-//     if (enable) {
-//         // Medium reverb - noticeable but not overpowering
-//         // Dry signal: 82%
-//         finalMixerLeft.gain(0, 0.82f);
-//         finalMixerRight.gain(0, 0.82f);
-//
-//         // Wet signal: 25% for pleasant ambience
-//         finalMixerLeft.gain(1, 0.25f);
-//         finalMixerRight.gain(1, 0.25f);
-//     } else {
-//         // 100% dry signal, no reverb
-//         finalMixerLeft.gain(0, 1.0f);
-//         finalMixerRight.gain(0, 1.0f);
-//
-//         // Mute wet signal
-//         finalMixerLeft.gain(1, 0.0f);
-//         finalMixerRight.gain(1, 0.0f);
-//     }
-// }
+void AudioSystem::enableReverb(
+    AudioMixerStage& finalMixerLeft,
+    AudioMixerStage& finalMixerRight,
+    AudioEffectReverbPSRAM& reverb,
+    bool enable
+) {
+    // No PSRAM - stay fully dry
+    if (enable && reverb.isAvailable()) {
+        reverb.setEnabled(true);
+
+        // Medium reverb - noticeable but not overpowering
+        // Dry signal: 82%
+        finalMixerLeft.gain(0, 0.82f);
+        finalMixerRight.gain(0, 0.82f);
+
+        // Wet signal: 25% for pleasant ambience
+        finalMixerLeft.gain(1, 0.25f);
+        finalMixerRight.gain(1, 0.25f);
+    } else {
+        // 100% dry signal, no reverb
+        finalMixerLeft.gain(0, 1.0f);
+        finalMixerRight.gain(0, 1.0f);
+
+        // Mute wet signal
+        finalMixerLeft.gain(1, 0.0f);
+        finalMixerRight.gain(1, 0.0f);
+
+        // Fades out its last block, then costs nothing in the ISR
+        reverb.setEnabled(false);
+
+#if DEBUG_SERIAL_ENABLED && DEBUG_AUDIO_SYSTEM
+        reverb.printStats();  // ISR load over the song that just ended
+#endif
+    }
+}
 
 void AudioSystem::setDrumGain(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight,
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight,
     float gain
 ) {
     mixerLeft.gain(2, gain);   // Drum sampler left
@@ -137,8 +145,8 @@ void AudioSystem::setDrumSamplerEnabled(
     bool enabled,
     DrumSamplerV2* drumSampler,
     OPL3Synth* opl3Synth,
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight
 ) {
     if (drumSampler) {
         drumSampler->setEnabled(enabled);
@@ -176,8 +184,8 @@ float AudioSystem::getMasterVolume() {
 }
 
 void AudioSystem::setFadeGain(
-    AudioMixer4& fadeMixerLeft,
-    AudioMixer4& fadeMixerRight,
+    AudioMixerStage& fadeMixerLeft,
+    AudioMixerStage& fadeMixerRight,
     float gain
 ) {
     // // Serial.printf("AudioSystem::setFadeGain called with gain=%f\n", gain);
@@ -194,8 +202,8 @@ void AudioSystem::setFadeGain(
 
 void AudioSystem::configureMixers(
     const Config& config,
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight
 ) {
     // Channel 0: OPL3 input
     mixerLeft.gain(0, config.opl3Gain);
@@ -214,33 +222,33 @@ void AudioSystem::configureMixers(
     mixerRight.gain(3, 0.0f);
 }
 
-// Reverb removed to save ~50KB RAM
-// void AudioSystem::configureReverb(
-//     AudioEffectFreeverb& reverbLeft,
-//     AudioEffectFreeverb& reverbRight
-// ) {
-//     // Configure reverb for medium hall - noticeable but pleasant
-//     reverbLeft.roomsize(0.6f);   // Medium hall
-//     reverbLeft.damping(0.55f);   // Moderate damping for natural decay
-//     reverbRight.roomsize(0.6f);
-//     reverbRight.damping(0.55f);
-// }
+void AudioSystem::configureReverb(
+    AudioEffectReverbPSRAM& reverb
+) {
+    // Configure reverb for medium hall - noticeable but pleasant
+    reverb.roomsize(0.6f);   // Medium hall
+    reverb.damping(0.55f);   // Moderate damping for natural decay
+
+    // Send: OPL3 line-in in full, drums at their mixer balance against it
+    reverb.setSendLevel(AudioEffectReverbPSRAM::SEND_LINE_IN, 1.0f);
+    reverb.setSendLevel(AudioEffectReverbPSRAM::SEND_DRUMS, 0.5f);
+}
 
 // ========================================
 // Line-In Control (Hardware Synthesizers)
 // ========================================
 
 void AudioSystem::muteLineIn(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight
 ) {
     mixerLeft.gain(0, 0.0f);   // Mute line-in (main mixer channel 0)
     mixerRight.gain(0, 0.0f);
 }
 
 void AudioSystem::unmuteLineInForOPL3(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight
 ) {
     // Unmute mixer channel 0 with OPL3-specific gain
     mixerLeft.gain(0, OPL3_LINE_IN_GAIN);
@@ -250,8 +258,8 @@ void AudioSystem::unmuteLineInForOPL3(
 }
 
 void AudioSystem::unmuteLineInForGenesis(
-    AudioMixer4& mixerLeft,
-    AudioMixer4& mixerRight
+    AudioMixerStage& mixerLeft,
+    AudioMixerStage& mixerRight
 ) {
     // Unmute mixer channel 0 with Genesis-specific gain
     mixerLeft.gain(0, GENESIS_LINE_IN_GAIN);
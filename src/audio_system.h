@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 #include <Audio.h>
+#include "audio_mixer_fused.h"
+
+class AudioEffectReverbPSRAM;
 
 /**
  * AudioSystem - Centralized audio configuration and control
@@ -10,7 +13,7 @@
  * Manages the Teensy audio system including:
  * - SGTL5000 audio board initialization
  * - Stereo crossfeed (softer panning for MIDI)
- * - Reverb effect (ambience for MIDI)
+ * - Reverb effect (ambience for MIDI, delay lines in PSRAM)
  * - Mixer gain control
  *
  * Note: Audio objects and connections MUST remain global due to Teensy Audio
@@ -30,54 +33,54 @@ public:
 
     /**
      * Initialize the audio board and configure all audio paths
-     * Note: Reverb removed to save ~50KB RAM
      *
      * @param config Audio system configuration
      * @param audioShield Reference to SGTL5000 control object
      * @param mixerLeft Reference to left mixer
      * @param mixerRight Reference to right mixer
-     * @param finalMixerLeft Reference to left final mixer (now passthrough, reverb removed)
-     * @param finalMixerRight Reference to right final mixer (now passthrough, reverb removed)
+     * @param finalMixerLeft Reference to left final mixer (ch0 dry, ch1 reverb wet)
+     * @param finalMixerRight Reference to right final mixer (ch0 dry, ch1 reverb wet)
+     * @param reverb MIDI reverb (begin() already called)
      * @return true if initialization successful
      */
     static bool initialize(
         const Config& config,
         AudioControlSGTL5000& audioShield,
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight,
-        AudioMixer4& finalMixerLeft,
-        AudioMixer4& finalMixerRight,
-        AudioMixer4& fadeMixerLeft,
-        AudioMixer4& fadeMixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight,
+        AudioMixerStage& finalMixerLeft,
+        AudioMixerStage& finalMixerRight,
+        AudioMixerStage& fadeMixerLeft,
+        AudioMixerStage& fadeMixerRight,
+        AudioEffectReverbPSRAM& reverb
     );
 
     // PCM mixer control (for FM90S player)
     static void setPCMGain(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight,
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight,
         float gain
     );
 
     // Stereo crossfeed control (for softer MIDI panning)
     static void enableCrossfeed(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight,
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight,
         bool enable
     );
 
-    // Reverb removed to save ~50KB RAM (AudioEffectFreeverb uses 25KB each)
-    // static void enableReverb(
-    //     AudioMixer4& finalMixerLeft,
-    //     AudioMixer4& finalMixerRight,
-    //     AudioEffectFreeverb& reverbLeft,
-    //     AudioEffectFreeverb& reverbRight,
-    //     bool enable
-    // );
+    // Reverb control (MIDI ambience - no-op without PSRAM)
+    static void enableReverb(
+        AudioMixerStage& finalMixerLeft,
+        AudioMixerStage& finalMixerRight,
+        AudioEffectReverbPSRAM& reverb,
+        bool enable
+    );
 
     // Drum sampler gain control
     static void setDrumGain(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight,
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight,
         float gain
     );
 
@@ -86,8 +89,8 @@ public:
         bool enabled,
         class DrumSamplerV2* drumSampler,
         class OPL3Synth* opl3Synth,
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight
     );
 
     // Master volume control
@@ -101,8 +104,8 @@ public:
 
     // Fade control (for VGM loop fadeout - affects both Bluetooth and line-out)
     static void setFadeGain(
-        AudioMixer4& fadeMixerLeft,
-        AudioMixer4& fadeMixerRight,
+        AudioMixerStage& fadeMixerLeft,
+        AudioMixerStage& fadeMixerRight,
         float gain  // 0.0 = silent, 1.0 = full volume
     );
 
@@ -113,8 +116,8 @@ public:
      * Use when switching to software emulators (NES APU, SPC, MOD, etc.)
      */
     static void muteLineIn(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight
     );
 
     /**
@@ -122,8 +125,8 @@ public:
      * Uses standard OPL3 gain level (0.8f)
      */
     static void unmuteLineInForOPL3(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight
     );
 
     /**
@@ -131,8 +134,8 @@ public:
      * May use different gain level if Genesis outputs different analog level
      */
     static void unmuteLineInForGenesis(
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight
     );
 
     /**
@@ -150,15 +153,13 @@ private:
     // Helper to configure mixer channels
     static void configureMixers(
         const Config& config,
-        AudioMixer4& mixerLeft,
-        AudioMixer4& mixerRight
+        AudioMixerStage& mixerLeft,
+        AudioMixerStage& mixerRight
     );
 
-    // Reverb removed to save ~50KB RAM
-    // static void configureReverb(
-    //     AudioEffectFreeverb& reverbLeft,
-    //     AudioEffectFreeverb& reverbRight
-    // );
+    static void configureReverb(
+        AudioEffectReverbPSRAM& reverb
+    );
 };
 
 #endif // AUDIO_SYSTEM_H
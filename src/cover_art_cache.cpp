@@ -0,0 +1,650 @@
+#include "cover_art_cache.h"
+#include <stddef.h>
+
+CoverArtCache* g_coverArtCache = nullptr;
+
+static const char* THUMB_DIR_ROOT = "/FM90S";
+static const char* THUMB_DIR = "/FM90S/THUMBS";
+static const size_t COMPRESSED_SIZE = 4096;
+static const size_t DICT_SIZE = 32768;            // Standard gzip dictionary
+
+// uzlib's read callback has no user pointer - set around each inflate step
+static File* s_inflateFile = nullptr;
+static uint8_t* s_inflateBuffer = nullptr;
+
+CoverArtCache::CoverArtCache()
+    : pixels_(nullptr)
+    , pixelsInPSRAM_(false)
+    , slotCount_(0)
+    , useCounter_(0)
+    , fs_(nullptr)
+    , dirHash_(0)
+    , records_(nullptr)
+    , recordsInPSRAM_(false)
+    , recordCount_(0)
+    , wantedCount_(0)
+    , failedCount_(0)
+    , compressed_(nullptr)
+    , inflated_(nullptr)
+    , dictionary_(nullptr)
+    , generation_(0) {
+    dirPath_[0] = '\0';
+    sidecarPath_[0] = '\0';
+    memset(slots_, 0, sizeof(slots_));
+    memset(&stats_, 0, sizeof(stats_));
+    job_.active = false;
+    job_.slot = -1;
+}
+
+CoverArtCache::~CoverArtCache() {
+    abortJob(false);
+    if (pixels_) {
+        if (pixelsInPSRAM_) extmem_free(pixels_); else free(pixels_);
+    }
+    if (records_) {
+        if (recordsInPSRAM_) extmem_free(records_); else free(records_);
+    }
+    free(compressed_);
+    free(inflated_);
+    if (dictionary_) {
+        if (pixelsInPSRAM_) extmem_free(dictionary_); else free(dictionary_);
+    }
+}
+
+bool CoverArtCache::begin() {
+    size_t pixelBytes = (size_t)CACHE_SLOTS * THUMB_PIXELS * sizeof(uint16_t);
+    size_t recordBytes = (size_t)MAX_DIR_RECORDS * sizeof(DirRecord);
+
+    pixels_ = (uint16_t*)extmem_malloc(pixelBytes);
+    if (pixels_) {
+        pixelsInPSRAM_ = true;
+        slotCount_ = CACHE_SLOTS;
+        records_ = (DirRecord*)extmem_malloc(recordBytes);
+        recordsInPSRAM_ = (records_ != nullptr);
+        dictionary_ = (uint8_t*)extmem_malloc(DICT_SIZE);
+    } else {
+        pixels_ = (uint16_t*)malloc((size_t)CACHE_SLOTS_FALLBACK * THUMB_PIXELS * sizeof(uint16_t));
+        slotCount_ = CACHE_SLOTS_FALLBACK;
+        dictionary_ = (uint8_t*)malloc(DICT_SIZE);
+        Serial.println("[CoverArt] WARNING: No PSRAM, thumbnail cache limited");
+    }
+    if (!records_) {
+        records_ = (DirRecord*)malloc(recordBytes);
+        recordsInPSRAM_ = false;
+    }
+    compressed_ = (uint8_t*)malloc(COMPRESSED_SIZE);
+    inflated_ = (uint8_t*)malloc(INFLATE_SLICE);
+
+    if (!pixels_ || !records_ || !compressed_ || !inflated_ || !dictionary_) {
+        Serial.println("[CoverArt] ERROR: Failed to allocate thumbnail cache");
+        return false;
+    }
+
+    if (!SD.exists(THUMB_DIR_ROOT)) {
+        SD.mkdir(THUMB_DIR_ROOT);
+    }
+    if (!SD.exists(THUMB_DIR)) {
+        SD.mkdir(THUMB_DIR);
+    }
+
+    Serial.printf("[CoverArt] %u thumbnail slots (%s)\n", slotCount_, pixelsInPSRAM_ ? "PSRAM" : "heap");
+    return true;
+}
+
+// ============================================
+// DIRECTORY / LOOKUP
+// ============================================
+
+uint32_t CoverArtCache::hashName(uint32_t hash, const char* text) {
+    // FNV-1a over the lower-cased text (FAT names are case-insensitive)
+    for (const char* p = text; *p; p++) {
+        uint8_t c = (uint8_t)*p;
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        hash ^= c;
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+void CoverArtCache::setDirectory(FS* fs, const char* sourceTag, const char* dirPath) {
+    if (!pixels_) return;
+
+    uint32_t hash = 0;
+    if (fs && dirPath) {
+        hash = hashName(hashName(0x811C9DC5, sourceTag ? sourceTag : ""), dirPath);
+        if (hash == 0) hash = 1;
+    }
+    if (fs == fs_ && hash == dirHash_) {
+        return;   // Same directory - keep the index and any extraction in progress
+    }
+
+    abortJob(false);
+    wantedCount_ = 0;
+    failedCount_ = 0;
+    recordCount_ = 0;
+    fs_ = fs;
+    dirHash_ = hash;
+    if (!fs_) {
+        dirPath_[0] = '\0';
+        return;
+    }
+
+    strncpy(dirPath_, dirPath, sizeof(dirPath_) - 1);
+    dirPath_[sizeof(dirPath_) - 1] = '\0';
+    snprintf(sidecarPath_, sizeof(sidecarPath_), "%s/%08lX.THM", THUMB_DIR, (unsigned long)dirHash_);
+    loadSidecar();
+}
+
+void CoverArtCache::loadSidecar() {
+    File f = SD.open(sidecarPath_, FILE_READ);
+    if (!f) {
+        return;
+    }
+
+    SidecarHeader header;
+    if (f.read((uint8_t*)&header, sizeof(header)) != (int)sizeof(header) ||
+        header.magic != SIDECAR_MAGIC || header.version != SIDECAR_VERSION ||
+        header.thumbSize != THUMB_SIZE) {
+        f.close();
+        SD.remove(sidecarPath_);   // Another build's format - rebuilt as files are visited
+        return;
+    }
+
+    uint32_t slots = (f.size() - SIDECAR_HEADER_SIZE) / RECORD_SIZE;
+    for (uint32_t i = 0; i < slots && i < 0xFFFF; i++) {
+        RecordHeader rec;
+        if (!f.seek(SIDECAR_HEADER_SIZE + i * RECORD_SIZE) ||
+            f.read((uint8_t*)&rec, sizeof(rec)) != (int)sizeof(rec)) {
+            break;
+        }
+        if (rec.nameHash == 0) continue;
+
+        // No-image records have zero pixels, so their CRC is checked here;
+        // thumbnails are checked when they're read
+        if (!rec.hasImage) {
+            uint32_t crc = crc32Update(0xFFFFFFFF, (const uint8_t*)&rec, offsetof(RecordHeader, crc));
+            static const uint8_t zeros[64] = {0};
+            for (uint32_t n = 0; n < THUMB_PIXELS * 2; n += sizeof(zeros)) {
+                crc = crc32Update(crc, zeros, sizeof(zeros));
+            }
+            if (~crc != rec.crc) continue;
+        }
+
+        // A file re-extracted after a bad record appears twice - the later one wins
+        int index = findRecord(rec.nameHash, rec.fileSize);
+        if (index < 0) {
+            if (recordCount_ >= MAX_DIR_RECORDS) continue;
+            index = recordCount_++;
+        }
+        records_[index].nameHash = rec.nameHash;
+        records_[index].fileSize = rec.fileSize;
+        records_[index].slot = (uint16_t)i;
+        records_[index].hasImage = rec.hasImage;
+    }
+    f.close();
+}
+
+int CoverArtCache::findRecord(uint32_t nameHash, uint32_t fileSize) const {
+    for (uint16_t i = 0; i < recordCount_; i++) {
+        if (records_[i].nameHash == nameHash && records_[i].fileSize == fileSize) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int CoverArtCache::findSlot(uint32_t nameHash, uint32_t fileSize) const {
+    for (uint8_t i = 0; i < slotCount_; i++) {
+        const CacheSlot& s = slots_[i];
+        if (s.lastUse && s.dirHash == dirHash_ && s.nameHash == nameHash && s.fileSize == fileSize) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int CoverArtCache::claimSlot() {
+    int oldest = -1;
+    for (uint8_t i = 0; i < slotCount_; i++) {
+        if ((int)i == job_.slot) continue;
+        if (slots_[i].lastUse == 0) {
+            oldest = i;
+            break;
+        }
+        if (oldest < 0 || slots_[i].lastUse < slots_[oldest].lastUse) {
+            oldest = i;
+        }
+    }
+    if (oldest >= 0 && slots_[oldest].lastUse != 0) {
+        stats_.evictions++;
+    }
+    if (oldest >= 0) {
+        memset(&slots_[oldest], 0, sizeof(CacheSlot));
+    }
+    return oldest;
+}
+
+bool CoverArtCache::isFailed(uint32_t nameHash, uint32_t fileSize) const {
+    for (uint8_t i = 0; i < failedCount_; i++) {
+        if (failed_[i][0] == nameHash && failed_[i][1] == fileSize) return true;
+    }
+    return false;
+}
+
+void CoverArtCache::markFailed(uint32_t nameHash, uint32_t fileSize) {
+    uint8_t index = failedCount_ < MAX_FAILED ? failedCount_++ : (stats_.failures % MAX_FAILED);
+    failed_[index][0] = nameHash;
+    failed_[index][1] = fileSize;
+    stats_.failures++;
+}
+
+void CoverArtCache::clearWanted() {
+    wantedCount_ = 0;
+}
+
+void CoverArtCache::want(const char* name, uint32_t fileSize) {
+    if (!fs_ || !name || wantedCount_ >= MAX_WANTED) return;
+
+    Wanted& w = wanted_[wantedCount_++];
+    strncpy(w.name, name, sizeof(w.name) - 1);
+    w.name[sizeof(w.name) - 1] = '\0';
+    w.nameHash = hashName(0x811C9DC5, name);
+    if (w.nameHash == 0) w.nameHash = 1;
+    w.fileSize = fileSize;
+}
+
+CoverArtCache::Status CoverArtCache::get(const char* name, uint32_t fileSize, const uint16_t** pixels) {
+    if (!fs_ || !pixels_) return STATUS_NO_IMAGE;
+
+    uint32_t nameHash = hashName(0x811C9DC5, name);
+    if (nameHash == 0) nameHash = 1;
+
+    int rec = findRecord(nameHash, fileSize);
+    if (rec < 0) {
+        return isFailed(nameHash, fileSize) ? STATUS_NO_IMAGE : STATUS_PENDING;
+    }
+    if (!records_[rec].hasImage) {
+        return STATUS_NO_IMAGE;
+    }
+
+    int slot = findSlot(nameHash, fileSize);
+    if (slot < 0) {
+        return STATUS_PENDING;
+    }
+    slots_[slot].lastUse = ++useCounter_;
+    stats_.cacheHits++;
+    if (pixels) *pixels = slotPixels(slot);
+    return STATUS_READY;
+}
+
+// ============================================
+// BACKGROUND WORK
+// ============================================
+
+void CoverArtCache::service(uint32_t budgetUs) {
+    if (!fs_ || !pixels_) return;
+
+    uint32_t start = micros();
+    do {
+        if (job_.active) {
+            stepJob();
+        } else if (!startNextWork()) {
+            break;
+        }
+    } while (micros() - start < budgetUs);
+
+    uint32_t elapsed = micros() - start;
+    if (elapsed > stats_.maxServiceUs) stats_.maxServiceUs = elapsed;
+}
+
+bool CoverArtCache::startNextWork() {
+    while (wantedCount_ > 0) {
+        Wanted w = wanted_[0];
+        wantedCount_--;
+        memmove(&wanted_[0], &wanted_[1], wantedCount_ * sizeof(Wanted));
+
+        int rec = findRecord(w.nameHash, w.fileSize);
+        if (rec >= 0) {
+            if (!records_[rec].hasImage || findSlot(w.nameHash, w.fileSize) >= 0) {
+                continue;   // Nothing to do
+            }
+            if (!loadFromSidecar(records_[rec])) {
+                // Bad record - forget it, the file is extracted again next time it's wanted
+                records_[rec] = records_[--recordCount_];
+            }
+            return true;
+        }
+
+        if (isFailed(w.nameHash, w.fileSize)) {
+            continue;
+        }
+        startJob(w);
+        return true;
+    }
+    return false;
+}
+
+bool CoverArtCache::loadFromSidecar(const DirRecord& record) {
+    File f = SD.open(sidecarPath_, FILE_READ);
+    if (!f) return false;
+
+    RecordHeader rec;
+    int slot = claimSlot();
+    bool ok = slot >= 0 &&
+              f.seek(SIDECAR_HEADER_SIZE + (uint32_t)record.slot * RECORD_SIZE) &&
+              f.read((uint8_t*)&rec, sizeof(rec)) == (int)sizeof(rec) &&
+              f.read((uint8_t*)slotPixels(slot), THUMB_PIXELS * 2) == (int)(THUMB_PIXELS * 2);
+    f.close();
+
+    if (ok) {
+        uint32_t crc = crc32Update(0xFFFFFFFF, (const uint8_t*)&rec, offsetof(RecordHeader, crc));
+        crc = crc32Update(crc, (const uint8_t*)slotPixels(slot), THUMB_PIXELS * 2);
+        ok = (~crc == rec.crc) && rec.nameHash == record.nameHash && rec.fileSize == record.fileSize;
+    }
+    if (!ok) {
+        return false;
+    }
+
+    CacheSlot& s = slots_[slot];
+    s.dirHash = dirHash_;
+    s.nameHash = record.nameHash;
+    s.fileSize = record.fileSize;
+    s.lastUse = ++useCounter_;
+    stats_.sidecarLoads++;
+    generation_++;
+    return true;
+}
+
+int CoverArtCache::inflateReadCallback(struct uzlib_uncomp* uncomp) {
+    // Same refill pattern as FM9File/VGMFile: buffered bytes first, then the next chunk
+    if (uncomp->source < uncomp->source_limit) {
+        return *uncomp->source++;
+    }
+    if (!s_inflateFile || !s_inflateBuffer || !s_inflateFile->available()) {
+        return -1;
+    }
+    int bytesRead = s_inflateFile->read(s_inflateBuffer, COMPRESSED_SIZE);
+    if (bytesRead <= 0) {
+        return -1;
+    }
+    uncomp->source = s_inflateBuffer;
+    uncomp->source_limit = s_inflateBuffer + bytesRead;
+    return *uncomp->source++;
+}
+
+bool CoverArtCache::startJob(const Wanted& wanted) {
+    char path[sizeof(dirPath_) + NAME_LEN + 2];
+    bool root = strcmp(dirPath_, "/") == 0;
+    snprintf(path, sizeof(path), "%s/%s", root ? "" : dirPath_, wanted.name);
+
+    job_.nameHash = wanted.nameHash;
+    job_.fileSize = wanted.fileSize;
+    job_.startMs = millis();
+    job_.slot = -1;
+    job_.file = fs_->open(path, FILE_READ);
+    if (!job_.file) {
+        markFailed(wanted.nameHash, wanted.fileSize);
+        return false;
+    }
+    job_.active = true;
+
+    int bytesRead = job_.file.read(compressed_, COMPRESSED_SIZE);
+    if (bytesRead < 18) {   // Minimum gzip size
+        abortJob(true);
+        return false;
+    }
+
+    memset(&job_.inflater, 0, sizeof(job_.inflater));
+    uzlib_uncompress_init(&job_.inflater, dictionary_, DICT_SIZE);
+    job_.inflater.source = compressed_;
+    job_.inflater.source_limit = compressed_ + bytesRead;
+    job_.inflater.source_read_cb = inflateReadCallback;
+
+    if (uzlib_gzip_parse_header(&job_.inflater) != TINF_OK) {
+        finishJob(false);   // Not gzip, so no FM9 header and no image
+        return true;
+    }
+
+    job_.stage = STAGE_INFLATE;
+    memset(job_.window, 0, sizeof(job_.window));
+    job_.foundMagic = false;
+    job_.headerPos = 0;
+    job_.imageOffset = 0;
+    job_.row = 0;
+    return true;
+}
+
+void CoverArtCache::stepJob() {
+    if (job_.stage == STAGE_INFLATE) {
+        stepInflate();
+    } else {
+        stepImage();
+    }
+}
+
+void CoverArtCache::stepInflate() {
+    struct uzlib_uncomp& d = job_.inflater;
+    d.dest_start = inflated_;
+    d.dest = inflated_;
+    d.dest_limit = inflated_ + INFLATE_SLICE;
+
+    s_inflateFile = &job_.file;
+    s_inflateBuffer = compressed_;
+    int res = uzlib_uncompress(&d);
+    s_inflateFile = nullptr;
+    s_inflateBuffer = nullptr;
+
+    // Scan for the FM9 header exactly as FM9File does
+    size_t count = d.dest - inflated_;
+    for (size_t i = 0; i < count && job_.headerPos < sizeof(FM9Header); i++) {
+        uint8_t byte = inflated_[i];
+        if (!job_.foundMagic) {
+            job_.window[0] = job_.window[1];
+            job_.window[1] = job_.window[2];
+            job_.window[2] = job_.window[3];
+            job_.window[3] = byte;
+            if (job_.window[0] == 'F' && job_.window[1] == 'M' &&
+                job_.window[2] == '9' && job_.window[3] == '0') {
+                job_.foundMagic = true;
+                memcpy(job_.headerBytes, job_.window, 4);
+                job_.headerPos = 4;
+            }
+        } else {
+            job_.headerBytes[job_.headerPos++] = byte;
+        }
+    }
+
+    const FM9Header* header = (const FM9Header*)job_.headerBytes;
+    bool haveHeader = job_.headerPos == sizeof(FM9Header);
+    if (haveHeader && !(header->flags & FM9_FLAG_HAS_IMAGE)) {
+        finishJob(false);   // No need to inflate the rest
+        return;
+    }
+
+    if (res == TINF_OK) {
+        return;   // More to inflate
+    }
+    if (res != TINF_DONE) {
+        abortJob(true);
+        return;
+    }
+    if (!haveHeader) {
+        finishJob(false);   // Plain VGZ data
+        return;
+    }
+
+    // uzlib stops before the 8-byte gzip trailer; audio, then the image, follow it
+    uint32_t gzipEnd = job_.file.position() - (d.source_limit - d.source) + 8;
+    job_.imageOffset = gzipEnd + header->audio_size;
+    if (job_.imageOffset + FM9_IMAGE_SIZE > job_.file.size() || !job_.file.seek(job_.imageOffset)) {
+        finishJob(false);
+        return;
+    }
+
+    job_.slot = (int8_t)claimSlot();
+    if (job_.slot < 0) {
+        abortJob(true);
+        return;
+    }
+    job_.stage = STAGE_IMAGE;
+    job_.row = 0;
+}
+
+void CoverArtCache::stepImage() {
+    // Two source rows make one thumbnail row
+    const size_t rowBytes = FM9_IMAGE_WIDTH * 2;
+    if (job_.file.read(inflated_, rowBytes * 2) != (int)(rowBytes * 2)) {
+        abortJob(true);
+        return;
+    }
+
+    const uint16_t* top = (const uint16_t*)inflated_;
+    const uint16_t* bottom = top + FM9_IMAGE_WIDTH;
+    uint16_t* out = slotPixels(job_.slot) + (size_t)job_.row * THUMB_SIZE;
+
+    for (uint8_t x = 0; x < THUMB_SIZE; x++) {
+        uint16_t p[4] = { top[2 * x], top[2 * x + 1], bottom[2 * x], bottom[2 * x + 1] };
+        uint16_t r = 0, g = 0, b = 0;
+        for (uint8_t i = 0; i < 4; i++) {
+            r += p[i] >> 11;
+            g += (p[i] >> 5) & 0x3F;
+            b += p[i] & 0x1F;
+        }
+        out[x] = (uint16_t)((((r + 2) >> 2) << 11) | (((g + 2) >> 2) << 5) | ((b + 2) >> 2));
+    }
+
+    if (++job_.row >= THUMB_SIZE) {
+        finishJob(true);
+    }
+}
+
+void CoverArtCache::finishJob(bool hasImage) {
+    RecordHeader rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.nameHash = job_.nameHash;
+    rec.fileSize = job_.fileSize;
+    rec.imageOffset = hasImage ? job_.imageOffset : 0;
+    rec.hasImage = hasImage ? 1 : 0;
+
+    job_.file.close();
+    int sidecarSlot = appendRecord(rec, hasImage ? slotPixels(job_.slot) : nullptr);
+
+    // Keep the result for this session even if the sidecar couldn't be written
+    int index = findRecord(rec.nameHash, rec.fileSize);
+    if (index < 0 && recordCount_ < MAX_DIR_RECORDS) {
+        index = recordCount_++;
+    }
+    if (index >= 0) {
+        records_[index].nameHash = rec.nameHash;
+        records_[index].fileSize = rec.fileSize;
+        records_[index].slot = sidecarSlot >= 0 ? (uint16_t)sidecarSlot : 0xFFFF;
+        records_[index].hasImage = rec.hasImage;
+    }
+
+    if (hasImage) {
+        CacheSlot& s = slots_[job_.slot];
+        s.dirHash = dirHash_;
+        s.nameHash = rec.nameHash;
+        s.fileSize = rec.fileSize;
+        s.lastUse = ++useCounter_;
+    }
+
+    job_.active = false;
+    job_.slot = -1;
+    stats_.extracted++;
+    stats_.lastExtractMs = millis() - job_.startMs;
+    generation_++;
+}
+
+void CoverArtCache::abortJob(bool failed) {
+    if (!job_.active) return;
+
+    job_.file.close();
+    if (job_.slot >= 0) {
+        memset(&slots_[job_.slot], 0, sizeof(CacheSlot));   // Partly written
+    }
+    if (failed) {
+        markFailed(job_.nameHash, job_.fileSize);
+        generation_++;
+    }
+    job_.active = false;
+    job_.slot = -1;
+}
+
+// ============================================
+// SIDECAR
+// ============================================
+
+int CoverArtCache::appendRecord(RecordHeader& rec, const uint16_t* pixels) {
+    File f = SD.open(sidecarPath_, FILE_WRITE);
+    if (!f) return -1;
+
+    if (f.size() < SIDECAR_HEADER_SIZE) {
+        SidecarHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic = SIDECAR_MAGIC;
+        header.version = SIDECAR_VERSION;
+        header.thumbSize = THUMB_SIZE;
+        if (!f.seek(0) || f.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+            f.close();
+            return -1;
+        }
+    }
+
+    // Whole records only - a torn append is overwritten
+    uint32_t slot = (f.size() - SIDECAR_HEADER_SIZE) / RECORD_SIZE;
+    if (slot >= 0xFFFF) {
+        f.close();
+        return -1;
+    }
+
+    static const uint8_t zeros[64] = {0};
+    uint32_t crc = crc32Update(0xFFFFFFFF, (const uint8_t*)&rec, offsetof(RecordHeader, crc));
+    if (pixels) {
+        crc = crc32Update(crc, (const uint8_t*)pixels, THUMB_PIXELS * 2);
+    } else {
+        for (uint32_t n = 0; n < THUMB_PIXELS * 2; n += sizeof(zeros)) {
+            crc = crc32Update(crc, zeros, sizeof(zeros));
+        }
+    }
+    rec.crc = ~crc;
+
+    bool ok = f.seek(SIDECAR_HEADER_SIZE + slot * RECORD_SIZE) &&
+              f.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+    if (pixels) {
+        ok = ok && f.write((const uint8_t*)pixels, THUMB_PIXELS * 2) == THUMB_PIXELS * 2;
+    } else {
+        for (uint32_t n = 0; ok && n < THUMB_PIXELS * 2; n += sizeof(zeros)) {
+            ok = f.write(zeros, sizeof(zeros)) == sizeof(zeros);
+        }
+    }
+    f.close();
+
+    return ok ? (int)slot : -1;
+}
+
+uint32_t CoverArtCache::crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+    // Bitwise CRC-32 (IEEE), same as LoudnessIndex; the caller inverts at the end
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return crc;
+}
+
+void CoverArtCache::printStats() const {
+    Serial.println("=== Cover Art Stats ===");
+    uint8_t used = 0;
+    for (uint8_t i = 0; i < slotCount_; i++) {
+        if (slots_[i].lastUse) used++;
+    }
+    Serial.printf("Thumbnails: %u / %u (%s), directory records: %u\n",
+                  used, slotCount_, pixelsInPSRAM_ ? "PSRAM" : "heap", recordCount_);
+    Serial.printf("Extracted: %lu (last %lu ms), from sidecar: %lu, hits: %lu\n",
+                  stats_.extracted, stats_.lastExtractMs, stats_.sidecarLoads, stats_.cacheHits);
+    Serial.printf("Evictions: %lu, failures: %lu, longest service: %lu us\n",
+                  stats_.evictions, stats_.failures, stats_.maxServiceUs);
+    Serial.println("=======================");
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+#include "fm9_file.h"
+#include "../lib/uzlib/uzlib.h"
+
+/**
+ * CoverArtCache - FM9 cover-art thumbnails for the file browser
+ *
+ * An FM9 cover image sits after the uncompressed audio chunk, and its offset
+ * is only known once the whole gzip section has been inflated to reach the
+ * FM9 header (FM9File does this at load time). The browser can't afford that
+ * per highlighted file, so this class does it in the background:
+ *
+ *   - The browser calls want() for the FM9 entries around the cursor,
+ *     highlighted entry first, then service() from its update().
+ *   - service() works through them within a time budget. Inflating runs in
+ *     2KB output slices and the image is read a row pair at a time, so one
+ *     call stays about as long as the budget and scrolling, the audio ISRs
+ *     and the players' buffer refills are never held up for long.
+ *   - The 100x100 image is box-filtered to THUMB_SIZE x THUMB_SIZE and kept
+ *     in a PSRAM LRU of CACHE_SLOTS thumbnails shared by all directories.
+ *
+ * Results are also appended to a sidecar on the SD card, one per directory
+ * (/FM90S/THUMBS/<hash of source + path>.THM), so the inflate is paid once
+ * per file: the next visit reads a 5KB record instead. Files without an
+ * image get a record too, so they're never inflated again. USB directories
+ * keep their sidecars on the SD card as well.
+ *
+ * Files are identified by name and size; a changed file gets a new record
+ * and the stale one is simply never matched again.
+ */
+class CoverArtCache {
+public:
+    static const uint8_t THUMB_SIZE = FM9_IMAGE_WIDTH / 2;            // 2x2 box filter
+    static const uint16_t THUMB_PIXELS = THUMB_SIZE * THUMB_SIZE;
+    static const uint8_t CACHE_SLOTS = 64;                           // 320KB in PSRAM
+    static const uint8_t CACHE_SLOTS_FALLBACK = 4;                   // 20KB on the heap
+    static const uint16_t MAX_DIR_RECORDS = 512;                     // Sidecar records per directory
+    static const uint8_t MAX_WANTED = 9;                             // Cursor +/- 4
+    static const uint8_t NAME_LEN = 128;
+    static const uint16_t INFLATE_SLICE = 2048;                      // Inflated bytes per step
+
+    enum Status : uint8_t {
+        STATUS_PENDING,           // Not extracted yet (or waiting for a cache slot)
+        STATUS_READY,             // Thumbnail available
+        STATUS_NO_IMAGE           // Not an FM9 with a cover (or unreadable)
+    };
+
+    struct Stats {
+        uint32_t extracted;       // Files inflated
+        uint32_t sidecarLoads;    // Thumbnails read back from a sidecar
+        uint32_t cacheHits;
+        uint32_t evictions;
+        uint32_t failures;
+        uint32_t maxServiceUs;    // Longest service() call
+        uint32_t lastExtractMs;   // Wall time of the last extraction
+    };
+
+    CoverArtCache();
+    ~CoverArtCache();
+
+    /**
+     * Allocate the thumbnail cache (call once after SD.begin())
+     */
+    bool begin();
+
+    /**
+     * Switch to a directory
+     * @param fs Filesystem the directory is on (nullptr disables thumbnails)
+     * @param sourceTag Distinguishes sources with the same paths ("SD", "USB")
+     * @param dirPath Directory path
+     */
+    void setDirectory(FS* fs, const char* sourceTag, const char* dirPath);
+
+    /**
+     * Replace the prefetch list - call clearWanted(), then want() in priority order
+     */
+    void clearWanted();
+    void want(const char* name, uint32_t fileSize);
+
+    /**
+     * Thumbnail for a file in the current directory
+     * @param pixels Set to THUMB_PIXELS RGB565 pixels when STATUS_READY
+     *               (valid until the next service() call)
+     */
+    Status get(const char* name, uint32_t fileSize, const uint16_t** pixels);
+
+    /**
+     * Do background work for up to about budgetUs (call from the browser's update())
+     */
+    void service(uint32_t budgetUs);
+
+    /**
+     * Changes whenever a thumbnail or a no-image result becomes available
+     */
+    uint32_t getGeneration() const { return generation_; }
+
+    bool isBusy() const { return job_.active || wantedCount_ > 0; }
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+private:
+    static const uint32_t SIDECAR_MAGIC = 0x48544D46;   // "FMTH"
+    static const uint16_t SIDECAR_VERSION = 1;
+    static const uint16_t SIDECAR_HEADER_SIZE = 16;
+    static const uint8_t MAX_FAILED = 8;
+
+    struct SidecarHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t thumbSize;
+        uint8_t reserved[8];
+    };
+    static_assert(sizeof(SidecarHeader) == SIDECAR_HEADER_SIZE, "Sidecar header layout");
+
+    /**
+     * One file (followed in the sidecar by THUMB_PIXELS pixels, zero if no image)
+     */
+    struct RecordHeader {
+        uint32_t nameHash;        // FNV-1a of the lower-cased name, never 0
+        uint32_t fileSize;
+        uint32_t imageOffset;     // Offset of the 100x100 image in the FM9
+        uint8_t hasImage;
+        uint8_t reserved[3];
+        uint32_t crc;             // CRC32 of the fields above and the pixels
+    };
+    static const uint32_t RECORD_SIZE = sizeof(RecordHeader) + THUMB_PIXELS * 2;
+
+    struct DirRecord {
+        uint32_t nameHash;
+        uint32_t fileSize;
+        uint16_t slot;            // Record index in the sidecar
+        uint8_t hasImage;
+        uint8_t reserved;
+    };
+
+    struct CacheSlot {
+        uint32_t dirHash;
+        uint32_t nameHash;
+        uint32_t fileSize;
+        uint32_t lastUse;         // 0 = empty
+    };
+
+    struct Wanted {
+        char name[NAME_LEN];
+        uint32_t nameHash;
+        uint32_t fileSize;
+    };
+
+    enum JobStage : uint8_t {
+        STAGE_INFLATE,            // Looking for the FM9 header and the gzip end
+        STAGE_IMAGE               // Reading and downscaling the image
+    };
+
+    /**
+     * Background extraction of one file
+     */
+    struct Job {
+        bool active;
+        JobStage stage;
+        uint32_t nameHash;
+        uint32_t fileSize;
+        File file;
+        struct uzlib_uncomp inflater;
+        uint8_t window[4];        // Last inflated bytes, for the "FM90" magic
+        bool foundMagic;
+        uint8_t headerPos;
+        uint8_t headerBytes[sizeof(FM9Header)];
+        uint32_t imageOffset;
+        uint8_t row;              // Thumbnail rows done
+        int8_t slot;              // Cache slot being filled (STAGE_IMAGE), else -1
+        uint32_t startMs;
+    };
+
+    static int inflateReadCallback(struct uzlib_uncomp* uncomp);
+    static uint32_t hashName(uint32_t hash, const char* text);
+    static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length);
+
+    void loadSidecar();
+    int findRecord(uint32_t nameHash, uint32_t fileSize) const;
+    int findSlot(uint32_t nameHash, uint32_t fileSize) const;
+    int claimSlot();
+    uint16_t* slotPixels(int slot) const { return pixels_ + (size_t)slot * THUMB_PIXELS; }
+    bool isFailed(uint32_t nameHash, uint32_t fileSize) const;
+    void markFailed(uint32_t nameHash, uint32_t fileSize);
+
+    bool startNextWork();
+    bool loadFromSidecar(const DirRecord& record);
+    bool startJob(const Wanted& wanted);
+    void stepJob();
+    void stepInflate();
+    void stepImage();
+    void finishJob(bool hasImage);
+    void abortJob(bool failed);
+    int appendRecord(RecordHeader& header, const uint16_t* pixels);
+
+    // Thumbnail LRU
+    uint16_t* pixels_;
+    bool pixelsInPSRAM_;
+    CacheSlot slots_[CACHE_SLOTS];
+    uint8_t slotCount_;
+    uint32_t useCounter_;
+
+    // Current directory and its sidecar index
+    FS* fs_;
+    char dirPath_[192];
+    uint32_t dirHash_;
+    char sidecarPath_[40];
+    DirRecord* records_;
+    bool recordsInPSRAM_;
+    uint16_t recordCount_;
+
+    // Prefetch list
+    Wanted wanted_[MAX_WANTED];
+    uint8_t wantedCount_;
+
+    uint32_t failed_[MAX_FAILED][2];     // nameHash, fileSize of files that couldn't be read
+    uint8_t failedCount_;
+
+    // Extraction buffers (allocated with the cache)
+    Job job_;
+    uint8_t* compressed_;
+    uint8_t* inflated_;
+    uint8_t* dictionary_;
+
+    uint32_t generation_;
+    Stats stats_;
+};
+
+extern CoverArtCache* g_coverArtCache;
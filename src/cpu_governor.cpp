@@ -0,0 +1,263 @@
+#include "cpu_governor.h"
+#include <Audio.h>
+#include "audio_globals.h"
+#include "trace_log.h"
+
+// Teensy core (clockspeed.c, EventResponder.cpp, tempmon.c)
+extern "C" uint32_t set_arm_clock(uint32_t frequency);
+extern "C" volatile uint32_t systick_cycle_count;
+extern "C" float tempmonGetTemp(void);
+
+CpuGovernor* g_cpuGovernor = nullptr;
+
+// Speeds the core is specified and tested at; set_arm_clock() picks the
+// matching core voltage for each
+const uint32_t CpuGovernor::OPERATING_POINTS[CpuGovernor::POINT_COUNT] = {600, 450, 300, 150};
+
+static const uint32_t ALIGN_TIMEOUT_MS = 5;
+
+CpuGovernor::CpuGovernor()
+    : enabled_(false)
+    , point_(0)
+    , downRun_(0)
+    , pointSinceMs_(0)
+    , stressActive_(false)
+    , stressStartMs_(0)
+    , stressDurationMs_(0)
+    , stressNextHopMs_(0)
+    , stressStartUs_(0)
+    , stressStartSample_(0)
+    , stressLastUs_(0)
+    , stressPairs_(0)
+    , hopUs_(0)
+    , hopSample_(0) {
+    memset(&stress_, 0, sizeof(stress_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+void CpuGovernor::begin() {
+    pointSinceMs_ = millis();
+    if (F_CPU_ACTUAL != OPERATING_POINTS[0] * 1000000) {
+        setPoint(0);
+    }
+}
+
+void CpuGovernor::setEnabled(bool enabled) {
+    enabled_ = enabled;
+    downRun_ = 0;
+    if (!enabled_ && point_ != 0 && !stressActive_) {
+        setPoint(0);
+    }
+}
+
+// ============================================
+// Load-based stepping
+// ============================================
+
+bool CpuGovernor::onWindow(const LoadShedder::Window& window, uint8_t shedLevel) {
+    if (!enabled_ || stressActive_) return false;
+
+    bool heavy = window.isrPercent >= UP_ISR_PERCENT || window.lateBlocks > 0 ||
+                 window.maxLoopGapUs >= UP_LOOP_GAP_US;
+    if (heavy) {
+        downRun_ = 0;
+        if (point_ == 0) return false;   // Nothing left to raise - let the shedder act
+
+        Serial.printf("[CpuGovernor] Boost %lu -> %lu MHz: ISR %.0f%%, loop gap %lums, %lu late blocks\n",
+                      OPERATING_POINTS[point_], OPERATING_POINTS[0],
+                      window.isrPercent, window.maxLoopGapUs / 1000, window.lateBlocks);
+        stats_.boosts++;
+        setPoint(0);
+        return true;
+    }
+
+    if (shedLevel > 0 || point_ + 1 >= POINT_COUNT) {
+        downRun_ = 0;
+        return false;
+    }
+
+    // Would the next point down still have headroom? (CPU-bound work scales
+    // with the clock; loop gaps spent waiting on SPI/SD don't, so this errs high)
+    float scale = (float)OPERATING_POINTS[point_] / OPERATING_POINTS[point_ + 1];
+    bool light = window.isrPercent * scale < DOWN_ISR_PERCENT &&
+                 window.maxLoopGapUs * scale < DOWN_LOOP_GAP_US;
+    if (!light) {
+        downRun_ = 0;
+        return false;
+    }
+    if (++downRun_ < DOWN_WINDOWS) return false;
+
+    downRun_ = 0;
+    Serial.printf("[CpuGovernor] Step down %lu -> %lu MHz: ISR %.0f%%, loop gap %lums\n",
+                  OPERATING_POINTS[point_], OPERATING_POINTS[point_ + 1],
+                  window.isrPercent, window.maxLoopGapUs / 1000);
+    setPoint(point_ + 1);
+    return true;
+}
+
+// ============================================
+// Clock change
+// ============================================
+
+void CpuGovernor::setPoint(uint8_t point) {
+    uint32_t nowMs = millis();
+    stats_.msAtPoint[point_] += nowMs - pointSinceMs_;
+
+    // Change right after an audio interrupt, so the next one is a whole block away
+    // (no further wait - micros() is re-based below wherever the SysTick phase is)
+    uint32_t block = audioClock.blockStart();
+    while (audioClock.blockStart() == block && millis() - nowMs < ALIGN_TIMEOUT_MS) {
+    }
+
+    uint32_t beforeUs = micros();
+    __disable_irq();
+    uint32_t oldMHz = F_CPU_ACTUAL / 1000000;
+    uint32_t sinceTickUs = (ARM_DWT_CYCCNT - systick_cycle_count) / oldMHz;
+
+    set_arm_clock(OPERATING_POINTS[point] * 1000000);
+
+    // micros() = last SysTick + (cycles since it) / MHz - express the time
+    // since the tick in new-clock cycles so micros() carries on where it was
+    uint32_t newMHz = F_CPU_ACTUAL / 1000000;
+    systick_cycle_count = ARM_DWT_CYCCNT - sinceTickUs * newMHz;
+    __enable_irq();
+
+    // Stress test: the re-base must carry micros() straight across the change
+    if (stressActive_) {
+        int32_t stepUs = (int32_t)(micros() - beforeUs);
+        StressPoint& sp = stress_.points[point];
+        sp.hopsIn++;
+        if (stepUs < 0) {
+            sp.rebaseBackward++;
+        } else if ((uint32_t)stepUs > sp.maxRebaseUs) {
+            sp.maxRebaseUs = stepUs;
+        }
+        stressPairs_ |= 1 << (point_ * POINT_COUNT + point);
+    }
+
+    // Usage figures are cycle counts against the current clock
+    AudioProcessorUsageMaxReset();
+    TraceLog::setCpuHz(F_CPU_ACTUAL);
+
+    point_ = point;
+    pointSinceMs_ = millis();
+    stats_.transitions++;
+}
+
+// ============================================
+// Stress test
+// ============================================
+
+void CpuGovernor::startStressTest(uint32_t durationMs) {
+    memset(&stress_, 0, sizeof(stress_));
+    stressPairs_ = 0;
+    AudioMemoryUsageMaxReset();
+
+    stressActive_ = true;
+    stressStartMs_ = millis();
+    stressDurationMs_ = durationMs;
+    stressNextHopMs_ = stressStartMs_;
+    stressStartUs_ = micros();
+    stressStartSample_ = audioClock.blockStart();
+    stressLastUs_ = stressStartUs_;
+    hopUs_ = stressStartUs_;
+    hopSample_ = stressStartSample_;
+
+    Serial.printf("[CpuGovernor] Stress test: hopping every %lu ms for %lu s\n",
+                  STRESS_HOP_MS, durationMs / 1000);
+}
+
+void CpuGovernor::update() {
+    if (!stressActive_) return;
+
+    uint32_t nowUs = micros();
+    if ((int32_t)(nowUs - stressLastUs_) < 0) {
+        stress_.microsBackward++;
+        stress_.points[point_].microsBackward++;
+    }
+    stressLastUs_ = nowUs;
+
+    uint32_t nowMs = millis();
+    if ((int32_t)(nowMs - stressNextHopMs_) < 0) return;
+
+    // Blocks the ISR should have run since the last hop vs blocks it counted
+    // (one block of difference is phase)
+    uint32_t sample = audioClock.blockStart();
+    uint32_t expected = (uint32_t)((float)(nowUs - hopUs_) * (AUDIO_SAMPLE_RATE_EXACT / 1000000.0f)) / AUDIO_BLOCK_SAMPLES;
+    uint32_t counted = (sample - hopSample_) / AUDIO_BLOCK_SAMPLES;
+    if (expected > counted + 1) {
+        stress_.lateBlocks += expected - counted - 1;
+        stress_.points[point_].lateBlocks += expected - counted - 1;
+    }
+
+    // The next check covers this hop's transition as well
+    hopUs_ = nowUs;
+    hopSample_ = sample;
+
+    if (nowMs - stressStartMs_ >= stressDurationMs_) {
+        finishStressTest();
+        return;
+    }
+
+    // Any other point, so every hop is a real transition
+    uint8_t next = (point_ + 1 + random(POINT_COUNT - 1)) % POINT_COUNT;
+    setPoint(next);
+    stress_.hops++;
+    stressNextHopMs_ = millis() + STRESS_HOP_MS;
+}
+
+void CpuGovernor::finishStressTest() {
+    stressActive_ = false;
+    setPoint(0);
+
+    uint32_t elapsedUs = micros() - stressStartUs_;
+    uint32_t elapsedSamples = audioClock.blockStart() - stressStartSample_;
+    int32_t expectedSamples = (int32_t)((double)elapsedUs * AUDIO_SAMPLE_RATE_EXACT / 1000000.0);
+
+    stress_.ran = true;
+    stress_.durationMs = millis() - stressStartMs_;
+    stress_.driftSamples = (int32_t)elapsedSamples - expectedSamples;
+    stress_.audioBlocksMax = AudioMemoryUsageMax();
+    stress_.pairsCovered = __builtin_popcount(stressPairs_);
+
+    // Both clocks come from the 24MHz crystal: anything beyond block
+    // granularity is a timing fault. Every point has to have been entered.
+    bool passed = stress_.lateBlocks == 0 && stress_.microsBackward == 0 &&
+                  abs(stress_.driftSamples) <= 2 * AUDIO_BLOCK_SAMPLES;
+    for (uint8_t i = 0; i < POINT_COUNT; i++) {
+        const StressPoint& sp = stress_.points[i];
+        if (sp.hopsIn == 0 || sp.rebaseBackward > 0) {
+            passed = false;
+        }
+    }
+
+    Serial.printf("[CpuGovernor] Stress test %s: %lu hops in %lu ms, %lu late blocks, "
+                  "%lu micros() steps back, drift %ld samples, %u audio blocks max\n",
+                  passed ? "PASSED" : "FAILED", stress_.hops, stress_.durationMs,
+                  stress_.lateBlocks, stress_.microsBackward, stress_.driftSamples,
+                  stress_.audioBlocksMax);
+    Serial.printf("[CpuGovernor]   %u of %u transitions covered\n",
+                  stress_.pairsCovered, (unsigned)(POINT_COUNT * (POINT_COUNT - 1)));
+    for (uint8_t i = 0; i < POINT_COUNT; i++) {
+        const StressPoint& sp = stress_.points[i];
+        Serial.printf("[CpuGovernor]   %3lu MHz: %lu hops in, %lu late blocks, %lu micros() steps back, "
+                      "re-base %lu back / max step %lu us\n",
+                      OPERATING_POINTS[i], sp.hopsIn, sp.lateBlocks, sp.microsBackward,
+                      sp.rebaseBackward, sp.maxRebaseUs);
+    }
+}
+
+void CpuGovernor::printStats() const {
+    Serial.println("=== CPU Governor Stats ===");
+    Serial.printf("State: %s, %lu MHz, die %.1f C\n", enabled_ ? "enabled" : "disabled",
+                  getMHz(), tempmonGetTemp());
+    Serial.printf("Transitions: %lu (%lu boosts)\n", stats_.transitions, stats_.boosts);
+    for (uint8_t i = 0; i < POINT_COUNT; i++) {
+        uint32_t ms = stats_.msAtPoint[i] + (i == point_ ? millis() - pointSinceMs_ : 0);
+        Serial.printf("  %3lu MHz: %lu s\n", OPERATING_POINTS[i], ms / 1000);
+    }
+    if (stress_.ran) {
+        Serial.printf("Last stress test: %lu hops, %lu late blocks, %lu micros() steps back, drift %ld samples\n",
+                      stress_.hops, stress_.lateBlocks, stress_.microsBackward, stress_.driftSamples);
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Arduino.h>
+#include "load_shedder.h"
+
+/**
+ * CpuGovernor - Scale the ARM clock to the playback workload
+ *
+ * The core runs at 600MHz whether it is browsing, streaming OPL3 register
+ * writes to the hardware chips, or decoding SPC/MP3. The governor steps the
+ * clock through OPERATING_POINTS using the load shedder's measurements
+ * (per-block audio ISR time, main-loop slack, late blocks):
+ *
+ *   - Up: any window over the UP marks jumps straight back to 600MHz. The
+ *     load shedder only sheds once the clock is already at the top.
+ *   - Down: one point at a time, after DOWN_WINDOWS windows in a row in which
+ *     the load scaled to the next point would still be under the DOWN marks,
+ *     and only with nothing shed.
+ *
+ * What a clock change touches:
+ *   - VGM/SPC/NES/GB scheduling runs on the audio sample clock (PLL4) and
+ *     IntervalTimer on the PIT (24MHz oscillator) - neither changes.
+ *   - delayMicroseconds()/delayNanoseconds() read F_CPU_ACTUAL every call, so
+ *     the bit-banged bus delays stay in time; the bit-bang loops themselves
+ *     only get slower, which the chips' minimum timings allow.
+ *   - micros() interpolates the cycle counter from the last SysTick. The
+ *     interpolation base is re-based to the new clock with interrupts off,
+ *     so micros() stays continuous and monotonic wherever the change lands.
+ *   - Cycle-counter timings are converted when taken (OPL bus time) or
+ *     re-based by TraceLog::setCpuHz().
+ *   - The change is made just after an audio interrupt, so the next block is
+ *     one AUDIO_BLOCK_SAMPLES period (64 samples, ~1.45ms) away and
+ *     set_arm_clock() (core voltage step + PLL relock) runs inside that gap.
+ *
+ * startStressTest() hops between random points while audio runs and checks
+ * for late blocks, micros() going backwards, and drift between micros() and
+ * the audio sample clock. Results are broken down per operating point,
+ * including the micros() step across each clock change (the SysTick re-base),
+ * so every point is shown to stay monotonic. Enable DEBUG_CPU_GOVERNOR_STRESS
+ * to run it at boot.
+ *
+ * Off by default (g_cpuGovernorEnabled, Settings > System > CPU Power Saving,
+ * kept in the resume journal) - it is meant for battery-powered or closed
+ * enclosures.
+ */
+class CpuGovernor {
+public:
+    static const uint8_t POINT_COUNT = 4;
+    static const uint32_t OPERATING_POINTS[POINT_COUNT];     // MHz, fastest first
+
+    static constexpr float UP_ISR_PERCENT = 60.0f;
+    static const uint32_t UP_LOOP_GAP_US = 20000;
+    static constexpr float DOWN_ISR_PERCENT = 35.0f;         // Predicted at the lower point
+    static const uint32_t DOWN_LOOP_GAP_US = 8000;
+    static const uint8_t DOWN_WINDOWS = 8;                   // 2s of headroom per step
+
+    static const uint32_t STRESS_HOP_MS = 50;
+
+    struct Stats {
+        uint32_t transitions;
+        uint32_t boosts;                  // Jumps back to the top
+        uint32_t msAtPoint[POINT_COUNT];
+    };
+
+    struct StressPoint {
+        uint32_t hopsIn;                  // Clock changes into this point
+        uint32_t lateBlocks;              // Missed in the change into it and the time spent there
+        uint32_t microsBackward;          // micros() readings lower than the last one while here
+        uint32_t rebaseBackward;          // micros() went backwards across the change into it
+        uint32_t maxRebaseUs;             // Longest micros() step across the change into it
+    };
+
+    struct StressResult {
+        bool ran;
+        uint32_t hops;
+        uint32_t durationMs;
+        uint32_t lateBlocks;              // Audio blocks missed around the hops
+        uint32_t microsBackward;          // micros() readings lower than the last one
+        int32_t driftSamples;             // Sample clock minus micros() over the test
+        uint16_t audioBlocksMax;          // AudioMemoryUsageMax() during the test
+        uint8_t pairsCovered;             // Distinct from -> to changes made (of POINT_COUNT * (POINT_COUNT - 1))
+        StressPoint points[POINT_COUNT];
+    };
+
+    CpuGovernor();
+
+    /**
+     * Start at the top operating point
+     */
+    void begin();
+
+    /**
+     * When disabled the clock goes back to the top and stays there
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * Stress test bookkeeping (call every main-loop iteration)
+     */
+    void update();
+
+    /**
+     * A load shedder window has ended
+     * @param shedLevel Steps currently shed (the clock only comes down at 0)
+     * @return true if the clock was changed (the window's measurements are stale)
+     */
+    bool onWindow(const LoadShedder::Window& window, uint8_t shedLevel);
+
+    /**
+     * Hop between random operating points every STRESS_HOP_MS for durationMs,
+     * then print the result (load-based stepping pauses meanwhile)
+     */
+    void startStressTest(uint32_t durationMs);
+    bool isStressTesting() const { return stressActive_; }
+    const StressResult& getStressResult() const { return stress_; }
+
+    uint32_t getMHz() const { return OPERATING_POINTS[point_]; }
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+private:
+    void setPoint(uint8_t point);
+    void finishStressTest();
+
+    bool enabled_;
+    uint8_t point_;
+    uint8_t downRun_;
+    uint32_t pointSinceMs_;
+
+    // Stress test
+    bool stressActive_;
+    uint32_t stressStartMs_;
+    uint32_t stressDurationMs_;
+    uint32_t stressNextHopMs_;
+    uint32_t stressStartUs_;
+    uint32_t stressStartSample_;
+    uint32_t stressLastUs_;
+    uint16_t stressPairs_;                // Bit from * POINT_COUNT + to per change made
+    uint32_t hopUs_;                      // micros() / sample clock at the last hop
+    uint32_t hopSample_;
+    StressResult stress_;
+
+    Stats stats_;
+};
+
+extern CpuGovernor* g_cpuGovernor;
@@ -10,7 +10,7 @@
  *     - Magic "DAC1" (4 bytes)
  *     - Total samples (4 bytes, uint32_t)
  *     - Loop point sample (4 bytes, uint32_t, 0xFFFFFFFF if no loop)
- *     - Flags (4 bytes, reserved)
+ *     - Flags (4 bytes, reserved; DACPrerenderCache keeps its LRU stamp here)
  *
  *   Data (totalSamples * 2 bytes):
  *     For each sample:
@@ -95,6 +95,7 @@ public:
     static const uint32_t MAGIC = 0x31434144;  // "DAC1" in little-endian
     static const size_t HEADER_SIZE = 16;
     static const uint32_t NO_LOOP = 0xFFFFFFFF;
+    static const uint8_t RENDER_VERSION = 1;   // Bump when rendered output changes (invalidates the cache)
 
     // Flag byte bit definitions
     static const uint8_t FLAG_PAN_MASK = 0xC0;      // Bits 7-6
@@ -0,0 +1,365 @@
+/**
+ * @file dac_prerender_cache.cpp
+ * @brief Implementation of the pre-rendered DAC cache
+ */
+
+#include "dac_prerender_cache.h"
+#include "dac_prerender.h"
+#include "file_source.h"
+
+static const char* CACHE_ROOT = "/FM90S";
+static const char* CACHE_DIR = "/FM90S/DACCACHE";
+static const char* RENDER_PATH = "/FM90S/DACCACHE/~RENDER.TMP";
+
+// ============================================================================
+// Constructor / Setup
+// ============================================================================
+
+DACPrerenderCache::DACPrerenderCache()
+    : entryCount_(0)
+    , totalBytes_(0)
+    , maxBytes_(DEFAULT_MAX_BYTES)
+    , nextStamp_(1)
+    , ready_(false) {
+    memset(entries_, 0, sizeof(entries_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool DACPrerenderCache::begin() {
+    if (!SD.exists(CACHE_ROOT)) {
+        SD.mkdir(CACHE_ROOT);
+    }
+    if (!SD.exists(CACHE_DIR) && !SD.mkdir(CACHE_DIR)) {
+        Serial.println("[DACCache] ERROR: Failed to create cache directory");
+        return false;
+    }
+
+    // A render interrupted by a reset or power cut
+    if (SD.exists(RENDER_PATH)) {
+        SD.remove(RENDER_PATH);
+    }
+
+    File dir = SD.open(CACHE_DIR);
+    if (!dir) {
+        Serial.println("[DACCache] ERROR: Failed to open cache directory");
+        return false;
+    }
+
+    // Files can't be removed while the directory is being walked
+    uint64_t stale[MAX_ENTRIES];
+    uint8_t staleCount = 0;
+
+    while (true) {
+        File f = dir.openNextFile();
+        if (!f) break;
+
+        uint64_t key;
+        if (f.isDirectory() || !parseName(f.name(), key)) {
+            f.close();
+            continue;
+        }
+
+        uint8_t header[DACPrerenderer::HEADER_SIZE];
+        bool valid = f.read(header, sizeof(header)) == (int)sizeof(header) &&
+                     header[0] == 'D' && header[1] == 'A' && header[2] == 'C' && header[3] == '1';
+        uint32_t bytes = (uint32_t)f.size();
+        f.close();
+
+        if (!valid || entryCount_ >= MAX_ENTRIES) {
+            if (staleCount < MAX_ENTRIES) {
+                stale[staleCount++] = key;
+            }
+            continue;
+        }
+
+        Entry& entry = entries_[entryCount_++];
+        entry.key = key;
+        entry.bytes = bytes;
+        entry.lastUse = (uint32_t)header[FLAGS_OFFSET] |
+                        ((uint32_t)header[FLAGS_OFFSET + 1] << 8) |
+                        ((uint32_t)header[FLAGS_OFFSET + 2] << 16) |
+                        ((uint32_t)header[FLAGS_OFFSET + 3] << 24);
+        totalBytes_ += bytes;
+        if (entry.lastUse >= nextStamp_) {
+            nextStamp_ = entry.lastUse + 1;
+        }
+    }
+    dir.close();
+
+    char path[PATH_SIZE];
+    for (uint8_t i = 0; i < staleCount; i++) {
+        formatPath(stale[i], path, sizeof(path));
+        SD.remove(path);
+    }
+
+    ready_ = true;
+    evict(0, 0, 0);
+
+    Serial.printf("[DACCache] %u cached renders, %.1f MB (cap %.0f MB)\n",
+                  entryCount_, totalBytes_ / (1024.0f * 1024.0f), maxBytes_ / (1024.0f * 1024.0f));
+    return true;
+}
+
+void DACPrerenderCache::setMaxBytes(uint32_t maxBytes) {
+    maxBytes_ = maxBytes;
+    if (ready_) {
+        evict(0, 0, 0);
+    }
+}
+
+// ============================================================================
+// Keys
+// ============================================================================
+
+uint64_t DACPrerenderCache::hashBytes(uint64_t hash, const uint8_t* data, size_t length) {
+    // FNV-1a, 64-bit
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool DACPrerenderCache::makeKey(const char* path, FileSource* fileSource, uint64_t& key) {
+    if (!ready_ || !path || !fileSource) {
+        return false;
+    }
+
+    uint32_t startMs = millis();
+    File f = fileSource->open(path, FILE_READ);
+    if (!f) {
+        return false;
+    }
+
+    uint32_t size = (uint32_t)f.size();
+    DateTimeFields modified;
+    if (!f.getModifyTime(modified)) {
+        memset(&modified, 0, sizeof(modified));
+    }
+
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    uint8_t version = DACPrerenderer::RENDER_VERSION;
+    hash = hashBytes(hash, &version, sizeof(version));
+    hash = hashBytes(hash, (const uint8_t*)&size, sizeof(size));
+    uint8_t stamp[7] = { modified.sec, modified.min, modified.hour, modified.mday, modified.mon,
+                         (uint8_t)(modified.year & 0xFF), (uint8_t)(modified.year >> 8) };
+    hash = hashBytes(hash, stamp, sizeof(stamp));
+
+    // Content digest: whole file if small, else evenly spaced chunks
+    uint8_t buffer[512];
+    uint8_t chunks = (size <= FULL_DIGEST_BYTES) ? 1 : DIGEST_SAMPLES;
+    uint32_t chunkBytes = (size <= FULL_DIGEST_BYTES) ? size : DIGEST_CHUNK;
+    bool ok = true;
+
+    for (uint8_t c = 0; c < chunks && ok; c++) {
+        uint32_t offset = (chunks == 1) ? 0 :
+                          (uint32_t)((uint64_t)(size - DIGEST_CHUNK) * c / (DIGEST_SAMPLES - 1));
+        if (!f.seek(offset)) {
+            ok = false;
+            break;
+        }
+        uint32_t remaining = chunkBytes;
+        while (remaining > 0) {
+            uint32_t n = remaining < sizeof(buffer) ? remaining : sizeof(buffer);
+            if (f.read(buffer, n) != (int)n) {
+                ok = false;
+                break;
+            }
+            hash = hashBytes(hash, buffer, n);
+            remaining -= n;
+        }
+    }
+    f.close();
+
+    stats_.lastKeyMs = millis() - startMs;
+    if (!ok) {
+        return false;
+    }
+
+    key = hash ? hash : 1;   // 0 is "no key" to evict()
+    return true;
+}
+
+void DACPrerenderCache::formatPath(uint64_t key, char* path, size_t pathSize) const {
+    snprintf(path, pathSize, "%s/%08lX%08lX.DAC", CACHE_DIR,
+             (unsigned long)(key >> 32), (unsigned long)(key & 0xFFFFFFFF));
+}
+
+bool DACPrerenderCache::parseName(const char* name, uint64_t& key) {
+    // <16 hex digits>.DAC
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < 16; i++) {
+        char c = name[i];
+        uint8_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else return false;
+        value = (value << 4) | digit;
+    }
+    if (strcasecmp(name + 16, ".DAC") != 0 || value == 0) {
+        return false;
+    }
+    key = value;
+    return true;
+}
+
+// ============================================================================
+// Lookup / Store
+// ============================================================================
+
+int DACPrerenderCache::findEntry(uint64_t key) const {
+    for (uint8_t i = 0; i < entryCount_; i++) {
+        if (entries_[i].key == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool DACPrerenderCache::lookup(uint64_t key, char* path, size_t pathSize) {
+    int index = findEntry(key);
+    if (index < 0) {
+        stats_.misses++;
+        return false;
+    }
+
+    // Stamping also proves the file is still there
+    uint32_t stamp = nextStamp_++;
+    if (!writeStamp(key, stamp)) {
+        Serial.println("[DACCache] Cached render missing - dropping entry");
+        removeEntry(index);
+        stats_.misses++;
+        return false;
+    }
+
+    entries_[index].lastUse = stamp;
+    formatPath(key, path, pathSize);
+    stats_.hits++;
+    return true;
+}
+
+const char* DACPrerenderCache::getRenderPath() const {
+    return RENDER_PATH;
+}
+
+void DACPrerenderCache::reserve(uint32_t expectedBytes) {
+    if (ready_) {
+        evict(expectedBytes, 1, 0);
+    }
+}
+
+bool DACPrerenderCache::store(uint64_t key, char* path, size_t pathSize) {
+    if (!ready_) {
+        return false;
+    }
+
+    formatPath(key, path, pathSize);
+    int index = findEntry(key);
+    if (index >= 0) {
+        removeEntry(index);
+    }
+    if (SD.exists(path)) {
+        SD.remove(path);
+    }
+
+    if (!SD.rename(RENDER_PATH, path)) {
+        Serial.println("[DACCache] ERROR: Failed to move render into the cache");
+        return false;
+    }
+
+    File f = SD.open(path, FILE_READ);
+    uint32_t bytes = f ? (uint32_t)f.size() : 0;
+    if (f) {
+        f.close();
+    }
+
+    uint32_t stamp = nextStamp_++;
+    writeStamp(key, stamp);
+
+    evict(0, 1, 0);
+    Entry& entry = entries_[entryCount_++];
+    entry.key = key;
+    entry.bytes = bytes;
+    entry.lastUse = stamp;
+    totalBytes_ += bytes;
+    stats_.stores++;
+
+    evict(0, 0, key);
+    return true;
+}
+
+void DACPrerenderCache::remove(uint64_t key) {
+    int index = findEntry(key);
+    if (index < 0) {
+        return;
+    }
+    char path[PATH_SIZE];
+    formatPath(key, path, sizeof(path));
+    SD.remove(path);
+    removeEntry(index);
+}
+
+// ============================================================================
+// Eviction
+// ============================================================================
+
+void DACPrerenderCache::removeEntry(int index) {
+    totalBytes_ -= entries_[index].bytes;
+    entries_[index] = entries_[--entryCount_];
+}
+
+void DACPrerenderCache::evict(uint32_t incomingBytes, uint8_t incomingEntries, uint64_t keepKey) {
+    while (entryCount_ > 0 &&
+           (entryCount_ + incomingEntries > MAX_ENTRIES || totalBytes_ + incomingBytes > maxBytes_)) {
+        int oldest = -1;
+        for (uint8_t i = 0; i < entryCount_; i++) {
+            if (entries_[i].key == keepKey) continue;
+            if (oldest < 0 || entries_[i].lastUse < entries_[oldest].lastUse) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            break;   // Only the entry being kept is left
+        }
+
+        char path[PATH_SIZE];
+        formatPath(entries_[oldest].key, path, sizeof(path));
+        SD.remove(path);
+        removeEntry(oldest);
+        stats_.evictions++;
+    }
+}
+
+bool DACPrerenderCache::writeStamp(uint64_t key, uint32_t stamp) {
+    char path[PATH_SIZE];
+    formatPath(key, path, sizeof(path));
+    if (!SD.exists(path)) {
+        return false;
+    }
+
+    File f = SD.open(path, FILE_WRITE);
+    if (!f) {
+        return false;
+    }
+    uint8_t bytes[4] = { (uint8_t)(stamp & 0xFF), (uint8_t)((stamp >> 8) & 0xFF),
+                         (uint8_t)((stamp >> 16) & 0xFF), (uint8_t)(stamp >> 24) };
+    bool ok = f.size() >= DACPrerenderer::HEADER_SIZE && f.seek(FLAGS_OFFSET) &&
+              f.write(bytes, sizeof(bytes)) == sizeof(bytes);
+    f.close();
+    return ok;
+}
+
+// ============================================================================
+// Stats
+// ============================================================================
+
+void DACPrerenderCache::printStats() const {
+    Serial.println("=== DAC Cache Stats ===");
+    Serial.printf("Entries: %u / %u, %.1f / %.0f MB\n", entryCount_, MAX_ENTRIES,
+                  totalBytes_ / (1024.0f * 1024.0f), maxBytes_ / (1024.0f * 1024.0f));
+    Serial.printf("Hits: %lu, misses: %lu, stored: %lu, evicted: %lu\n",
+                  stats_.hits, stats_.misses, stats_.stores, stats_.evictions);
+    Serial.printf("Last key: %lu ms\n", stats_.lastKeyMs);
+    Serial.println("=======================");
+}
@@ -0,0 +1,148 @@
+/**
+ * @file dac_prerender_cache.h
+ * @brief Persistent cache of pre-rendered DAC1 files, keyed by source content
+ *
+ * DACPrerenderer::preRender() parses the whole VGM and expands every DAC
+ * command before playback can start, which takes seconds on long Genesis
+ * tracks. The output depends only on the VGM's contents and the renderer, so
+ * VGMPlayer renders each track once into this cache and plays later repeats
+ * (queue, repeat, after a reboot) straight from the cached file.
+ *
+ * Key (64-bit FNV-1a, used as the file name):
+ *   - DACPrerenderer::RENDER_VERSION (bump it when the output format changes)
+ *   - source file size and modify time
+ *   - a digest of the stored command stream: the whole file up to
+ *     FULL_DIGEST_BYTES, else DIGEST_SAMPLES evenly spaced 4KB chunks
+ *     including the first and last. Cost is bounded (~70KB read) whatever
+ *     the track length.
+ * The key doesn't include the path, so the same track in two folders or on
+ * the USB drive shares one entry.
+ *
+ * Storage: /FM90S/DACCACHE/<key>.DAC, plain DAC1 files that
+ * AudioStreamDACPrerender loads directly. The LRU stamp lives in the DAC1
+ * header's reserved flags word, so there is no separate index to corrupt:
+ * begin() rebuilds the table from the directory. A render is written to a
+ * temp file and renamed only once complete, so a power cut never leaves a
+ * truncated entry behind.
+ *
+ * Eviction: least recently used entries go first once the cache holds more
+ * than maxBytes or MAX_ENTRIES files.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+// Forward declarations
+class FileSource;
+
+/**
+ * @class DACPrerenderCache
+ * @brief LRU directory of pre-rendered DAC streams on the SD card
+ *
+ * Usage (VGMPlayer::loadFile):
+ * 1. makeKey() for the source VGM
+ * 2. lookup() - on a hit, load the returned path and skip pre-rendering
+ * 3. on a miss, preRender() into getRenderPath(), then store()
+ */
+class DACPrerenderCache {
+public:
+    static const uint8_t MAX_ENTRIES = 64;
+    static const uint32_t DEFAULT_MAX_BYTES = 512UL * 1024 * 1024;   // ~95 minutes of DAC stream
+    static const uint32_t FULL_DIGEST_BYTES = 65536;                 // Smaller sources are hashed whole
+    static const uint8_t DIGEST_SAMPLES = 16;
+    static const uint16_t DIGEST_CHUNK = 4096;
+    static const size_t PATH_SIZE = 48;
+
+    struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t stores;
+        uint32_t evictions;
+        uint32_t lastKeyMs;       // Time makeKey() took for the last track
+    };
+
+    DACPrerenderCache();
+
+    /**
+     * Scan the cache directory, drop leftovers and load the LRU table
+     * Call after SD.begin().
+     */
+    bool begin();
+
+    /**
+     * Cache size cap (evicts immediately if already over)
+     */
+    void setMaxBytes(uint32_t maxBytes);
+    uint32_t getMaxBytes() const { return maxBytes_; }
+
+    /**
+     * Compute the cache key of a source file
+     * @param path Path within fileSource
+     * @param fileSource Where the VGM is played from
+     * @param key Output key
+     * @return false if the file can't be read (don't cache it)
+     */
+    bool makeKey(const char* path, FileSource* fileSource, uint64_t& key);
+
+    /**
+     * Find a cached render and mark it most recently used
+     * @param key Key from makeKey()
+     * @param path Output path of the DAC1 file (PATH_SIZE bytes)
+     * @return true on a hit
+     */
+    bool lookup(uint64_t key, char* path, size_t pathSize);
+
+    /**
+     * Temp file preRender() should write a new entry to
+     */
+    const char* getRenderPath() const;
+
+    /**
+     * Make room for a render about to be written
+     * @param expectedBytes Estimated DAC1 file size (HEADER_SIZE + 2 * samples)
+     */
+    void reserve(uint32_t expectedBytes);
+
+    /**
+     * Move a finished render from getRenderPath() into the cache
+     * @param path Output path of the stored DAC1 file (PATH_SIZE bytes)
+     * @return false if it couldn't be stored (the render is left in place)
+     */
+    bool store(uint64_t key, char* path, size_t pathSize);
+
+    /**
+     * Drop an entry (e.g. its file no longer loads)
+     */
+    void remove(uint64_t key);
+
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t bytes;
+        uint32_t lastUse;         // LRU stamp, also in the file's DAC1 flags word
+    };
+
+    static const uint32_t FLAGS_OFFSET = 12;  // DAC1 header reserved word
+
+    void formatPath(uint64_t key, char* path, size_t pathSize) const;
+    static bool parseName(const char* name, uint64_t& key);
+    int findEntry(uint64_t key) const;
+    void removeEntry(int index);
+    void evict(uint32_t incomingBytes, uint8_t incomingEntries, uint64_t keepKey);
+    bool writeStamp(uint64_t key, uint32_t stamp);
+    static uint64_t hashBytes(uint64_t hash, const uint8_t* data, size_t length);
+
+    Entry entries_[MAX_ENTRIES];
+    uint8_t entryCount_;
+    uint32_t totalBytes_;
+    uint32_t maxBytes_;
+    uint32_t nextStamp_;
+    bool ready_;
+
+    Stats stats_;
+};
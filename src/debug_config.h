@@ -20,6 +20,27 @@
 #define DEBUG_AUDIO_SYSTEM false              // Audio routing, mixers, effects
 #define DEBUG_PLAYBACK false                  // Playback start/stop/state changes
 
+// Binary trace log (trace_log.h) - TRACE() is a few stores into a RAM ring,
+// safe in ISRs and timing-critical paths. Formatting is deferred to idle time.
+#define DEBUG_TRACE_ENABLED true              // Record TRACE() calls (cheap - leave on)
+#define DEBUG_TRACE_ECHO true                 // Print drained records on Serial from the main loop
+
+// CPU governor stress test (cpu_governor.h) - hops the ARM clock every 50ms for
+// 60s after boot and reports late audio blocks / micros() faults per operating
+// point (600/450/300/150MHz), across the SysTick re-base included. Start a
+// track first (the resume journal picks it up again at boot).
+#define DEBUG_CPU_GOVERNOR_STRESS false
+
+// Load shedder stress test (load_shedder.h) - adds busy time to the audio
+// interrupt, then to the main loop, idling after each until every step is
+// back, and reports the level reached and the recovery time. Takes 1-3 minutes.
+#define DEBUG_LOAD_SHEDDER_STRESS false
+
+// RA8875 transport bench (display_manager.h) - draws the same register-heavy
+// scene blocking and through the DMA command list at boot and prints the CPU
+// time of each.
+#define DEBUG_RA8875_TRANSPORT_BENCH false
+
 // Convenience: Enable all debug flags at once (for development)
 // Uncomment this to override all flags above
 // #define DEBUG_ALL
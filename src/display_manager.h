@@ -7,6 +7,7 @@
 #include "RA8875_SPI1.h"
 #include <Adafruit_RGBLCDShield.h>
 #include "retro_ui.h"
+#include "debug_config.h"
 
 // Display pins - No conflicts with OPL3 or Audio Board
 #define RA8875_CS     28
@@ -60,6 +61,20 @@ public:
         tft->PWM1config(true, RA8875_PWM_CLK_DIV1024);
         tft->PWM1out(255);  // Full brightness
 
+#if DEBUG_RA8875_TRANSPORT_BENCH
+        uint32_t benchStart = ARM_DWT_CYCCNT;
+        drawTransportBench();
+        uint32_t blockingCycles = ARM_DWT_CYCCNT - benchStart;
+#endif
+
+        // From here on drawing only builds a command list; SPI1 DMA sends it
+        // in the background (stays blocking if the buffers can't be allocated)
+        tft->beginAsync();
+
+#if DEBUG_RA8875_TRANSPORT_BENCH
+        reportTransportBench(blockingCycles);
+#endif
+
         // Initialize LCD Shield (I2C on pins 18/19)
         lcd = new Adafruit_RGBLCDShield();
         lcd->begin(16, 2);
@@ -88,6 +103,45 @@ public:
         return true;
     }
 
+#if DEBUG_RA8875_TRANSPORT_BENCH
+    // Register-heavy scene: 100 filled rects (13 register writes + a busy poll
+    // each) and 20 lines of text
+    void drawTransportBench() {
+        for (int i = 0; i < 100; i++) {
+            tft->fillRect((i * 37) % 760, (i * 23) % 440, 40, 40, i * 0x0841);
+        }
+        tft->textMode();
+        tft->textColor(RA8875_WHITE, RA8875_BLACK);
+        for (int i = 0; i < 20; i++) {
+            tft->textSetCursor(8, i * 16);
+            tft->textWrite("Transport bench 0123456789");
+        }
+        tft->graphicsMode();
+    }
+
+    // Same scene through the command list. CPU = writer time + completion
+    // handler time; the SPI library's DMA interrupt entry is not counted.
+    void reportTransportBench(uint32_t blockingCycles) {
+        uint32_t cyclesPerUs = F_CPU_ACTUAL / 1000000;
+        Serial.printf("[DisplayManager] Transport bench, blocking: %lu us CPU\n",
+                      blockingCycles / cyclesPerUs);
+        if (!tft->isAsync()) return;
+
+        tft->resetStats();
+        uint32_t start = ARM_DWT_CYCCNT;
+        drawTransportBench();
+        uint32_t writerCycles = ARM_DWT_CYCCNT - start;
+        tft->waitIdle();
+
+        const RA8875_SPI1::TransportStats& st = tft->getStats();
+        Serial.printf("[DisplayManager] Transport bench, async: %lu us writer + %lu us interrupt "
+                      "(%lu entries, %lu transfers, %lu stalls)\n",
+                      writerCycles / cyclesPerUs, (uint32_t)(st.isrCycles / cyclesPerUs),
+                      st.ops, st.transfers, st.stalls);
+        tft->resetStats();
+    }
+#endif
+
     // Accessor methods
     RA8875_SPI1* getTFT() { return tft; }
     Adafruit_RGBLCDShield* getLCD() { return lcd; }
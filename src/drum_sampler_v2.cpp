@@ -1,4 +1,5 @@
 #include "drum_sampler_v2.h"
+#include "load_shedder.h"
 
 // Include all drum sample headers (PROGMEM data)
 #include "drums/acoustic_bass_drum_35.h"
@@ -405,8 +406,14 @@ bool DrumSamplerV2::begin() {
 }
 
 int DrumSamplerV2::allocateVoice() {
+  // Under load only the first SHED_DRUM_VOICES take new notes; the rest ring out
+  int voiceLimit = DRUM_VOICES;
+  if (g_loadShedder && g_loadShedder->isShed(LoadShedder::STEP_DRUM_VOICES)) {
+    voiceLimit = LoadShedder::SHED_DRUM_VOICES;
+  }
+
   // First, try to find a free voice
-  for (int i = 0; i < DRUM_VOICES; i++) {
+  for (int i = 0; i < voiceLimit; i++) {
     if (!voices_[i].active || !voices_[i].player->isPlaying()) {
       voices_[i].active = false;  // Mark as available
       return i;
@@ -417,7 +424,7 @@ int DrumSamplerV2::allocateVoice() {
   int oldestIdx = 0;
   uint32_t oldestTime = voices_[0].startTime;
 
-  for (int i = 1; i < DRUM_VOICES; i++) {
+  for (int i = 1; i < voiceLimit; i++) {
     if (voices_[i].startTime < oldestTime) {
       oldestTime = voices_[i].startTime;
       oldestIdx = i;
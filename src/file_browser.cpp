@@ -84,6 +84,8 @@ bool FileBrowser::isMidiFile(const char* filename) {
          name.endsWith(".midi") ||
          name.endsWith(".smf") ||
          name.endsWith(".kar") ||   // Karaoke MIDI files
+         name.endsWith(".rmi") ||   // RIFF MIDI files
+         name.endsWith(".xmi") ||   // Miles XMIDI files (DOS games)
          name.endsWith(".vgm") ||   // VGM files
          name.endsWith(".vgz") ||   // Compressed VGM files
          name.endsWith(".fm9") ||   // FM9 extended VGM files (VGM + audio + FX)
@@ -1,8 +1,13 @@
 #include "file_source.h"
+#include "zip_archive.h"
 
 FileSource::FileSource()
   : source_(SD_CARD)
-  , usbFilesystem_(nullptr) {
+  , usbFilesystem_(nullptr)
+  , viewFs_(nullptr)
+  , memoryLimit_(DEFAULT_MEMORY_LIMIT) {
+  viewPath_[0] = '\0';
+  memset(&memoryStats_, 0, sizeof(memoryStats_));
 }
 
 void FileSource::setSource(Source source, void* context) {
@@ -24,6 +29,98 @@ File FileSource::open(const char* filename, uint8_t mode) {
     return File();
   }
 
+  // Writing to the loaded file makes it stale
+  if (mode != FILE_READ && view_ && strcasecmp(viewPath_, filename) == 0) {
+    view_.reset();
+  }
+  return openStreamed(filename, mode);
+}
+
+FileView FileSource::openView(const char* filename) {
+  if (!filename || memoryLimit_ == 0) {
+    return FileView();
+  }
+
+  File file = openStreamed(filename, FILE_READ);
+  if (!file) {
+    return FileView();
+  }
+  FileView view = viewOf(filename, file);
+  file.close();
+  return view;
+}
+
+void FileSource::setMemoryLimit(uint32_t bytes) {
+  memoryLimit_ = bytes;
+  if (view_ && view_.size() > bytes) {
+    view_.reset();
+  }
+}
+
+FileView FileSource::viewOf(const char* filename, File& file) {
+  if (file.isDirectory()) {
+    return FileView();
+  }
+
+  uint32_t size = (uint32_t)file.size();
+  if (size > memoryLimit_) {
+    memoryStats_.streamed++;
+    return FileView();
+  }
+
+  // Same file as last time, unchanged on the card?
+  if (view_ && viewFs_ == getFilesystem() && view_.size() == size &&
+      strcasecmp(viewPath_, filename) == 0) {
+    DateTimeFields loaded, current;
+    bool hadTime = view_.getModifyTime(loaded);
+    bool hasTime = file.getModifyTime(current);
+    if (hadTime == hasTime && (!hasTime || memcmp(&loaded, &current, sizeof(loaded)) == 0)) {
+      memoryStats_.hits++;
+      return view_;
+    }
+  }
+
+  // Release the previous file first so both don't have to fit at once
+  view_.reset();
+
+  uint32_t startMs = millis();
+  FileView view = FileView::load(file);
+  if (!view) {
+    memoryStats_.streamed++;
+    return FileView();
+  }
+
+  memoryStats_.loads++;
+  memoryStats_.bytesLoaded += size;
+  memoryStats_.lastLoadMs = millis() - startMs;
+  memoryStats_.loadMs += memoryStats_.lastLoadMs;
+  Serial.printf("[FileSource] Loaded %s into PSRAM: %lu KB in %lu ms\n",
+                filename, size / 1024, memoryStats_.lastLoadMs);
+
+  view_ = view;
+  viewFs_ = getFilesystem();
+  snprintf(viewPath_, sizeof(viewPath_), "%s", filename);
+  return view;
+}
+
+void FileSource::printMemoryStats() const {
+  Serial.println("=== FileSource Memory Stats ===");
+  Serial.printf("Limit: %lu KB, loaded: %s (%lu KB)\n", memoryLimit_ / 1024,
+                view_ ? viewPath_ : "-", view_.size() / 1024);
+  Serial.printf("Loads: %lu (%lu KB, %lu ms), hits: %lu, streamed: %lu\n",
+                memoryStats_.loads, memoryStats_.bytesLoaded / 1024, memoryStats_.loadMs,
+                memoryStats_.hits, memoryStats_.streamed);
+  if (memoryStats_.loadMs > 0) {
+    Serial.printf("Load rate: %lu KB/s\n", memoryStats_.bytesLoaded / memoryStats_.loadMs);
+  }
+}
+
+File FileSource::openStreamed(const char* filename, uint8_t mode) {
+  // Paths through a .zip are read from the archive (read-only)
+  if (ZipArchive::isArchivePath(filename)) {
+    return (mode == FILE_READ) ? ZipArchive::open(getFilesystem(), filename) : File();
+  }
+
   switch (source_) {
     case SD_CARD:
       return SD.open(filename, mode);
@@ -52,6 +149,10 @@ bool FileSource::exists(const char* filename) {
     return false;
   }
 
+  if (ZipArchive::isArchivePath(filename)) {
+    return ZipArchive::exists(getFilesystem(), filename);
+  }
+
   switch (source_) {
     case SD_CARD:
       return SD.exists(filename);
@@ -69,3 +170,8 @@ bool FileSource::exists(const char* filename) {
       return false;
   }
 }
+
+FS* FileSource::getFilesystem() const {
+  // FLOPPY_TEMP files are on the SD card
+  return (source_ == USB_DRIVE) ? usbFilesystem_ : &SD;
+}
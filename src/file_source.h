@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include <SD.h>
 #include <FS.h>
+#include "file_view.h"
 
 // Abstraction for opening files from different sources (SD card, USB drive, etc.)
 // This allows players to be agnostic about where files come from
@@ -13,6 +14,17 @@ public:
     FLOPPY_TEMP   // Temporary files from floppy (stored on SD)
   };
 
+  static const uint32_t DEFAULT_MEMORY_LIMIT = 1024UL * 1024;  // Covers SPC, MIDI and most VGM/VGZ
+
+  struct MemoryStats {
+    uint32_t loads;        // Files read into PSRAM
+    uint32_t hits;         // openView() calls served from the loaded file
+    uint32_t streamed;     // openView() calls over the limit (or PSRAM short)
+    uint32_t bytesLoaded;
+    uint32_t loadMs;       // Total time spent loading
+    uint32_t lastLoadMs;
+  };
+
   FileSource();
 
   // Set the current file source
@@ -25,12 +37,42 @@ public:
 
   // Open a file from the current source
   // Returns a File object that can be used with standard SD library operations
+  // Paths through a .zip ("/VGM/PACK.ZIP/01.VGM") are read from inside the archive
+  // Always streams - callers that want the file in PSRAM use openView()
   File open(const char* filename, uint8_t mode = FILE_READ);
 
+  // Whole-file view for parsing in place (view.open() gives a File over it)
+  // For format loaders that read the whole file or seek around it during
+  // playback; a sampled read or one sequential pass should use open().
+  // Invalid if the file is over the memory limit, can't be opened or PSRAM is
+  // short - stream it with open() instead
+  FileView openView(const char* filename);
+
+  // Files up to this size are read into PSRAM in one pass by openView(), and
+  // kept until a different file is loaded (0 streams every file)
+  void setMemoryLimit(uint32_t bytes);
+  uint32_t getMemoryLimit() const { return memoryLimit_; }
+
+  const MemoryStats& getMemoryStats() const { return memoryStats_; }
+  void printMemoryStats() const;
+
   // Check if a file exists in the current source
   bool exists(const char* filename);
 
+  // Filesystem of the current source (nullptr if the USB drive isn't set)
+  FS* getFilesystem() const;
+
 private:
+  File openStreamed(const char* filename, uint8_t mode);
+  FileView viewOf(const char* filename, File& file);
+
   Source source_;
   FS* usbFilesystem_;  // Pointer to USB filesystem (only valid when source_ == USB_DRIVE)
+
+  // Most recently loaded file
+  FileView view_;
+  FS* viewFs_;
+  char viewPath_[256];
+  uint32_t memoryLimit_;
+  MemoryStats memoryStats_;
 };
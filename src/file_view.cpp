@@ -0,0 +1,166 @@
+#include "file_view.h"
+
+// ============================================
+// FileViewImpl - File interface over a view
+// ============================================
+
+class FileViewImpl : public FileImpl {
+public:
+    explicit FileViewImpl(const FileView& view)
+        : view_(view)
+        , position_(0)
+        , open_(true) {
+    }
+
+    size_t read(void* buf, size_t nbyte) override {
+        if (!open_) return 0;
+        uint32_t remaining = view_.size() - position_;
+        if (nbyte > remaining) nbyte = remaining;
+        memcpy(buf, view_.data() + position_, nbyte);
+        position_ += nbyte;
+        return nbyte;
+    }
+
+    size_t write(const void* buf, size_t size) override { return 0; }
+
+    int available() override {
+        return open_ ? (int)(view_.size() - position_) : 0;
+    }
+
+    int peek() override {
+        return (open_ && position_ < view_.size()) ? view_.data()[position_] : -1;
+    }
+
+    void flush() override {}
+    bool truncate(uint64_t size) override { return false; }
+
+    bool seek(uint64_t pos, int mode) override {
+        if (!open_) return false;
+
+        int64_t target = (int64_t)pos;
+        if (mode == SeekCur) {
+            target += position_;
+        } else if (mode == SeekEnd) {
+            target += view_.size();
+        }
+        if (target < 0 || (uint64_t)target > view_.size()) return false;
+
+        position_ = (uint32_t)target;
+        return true;
+    }
+
+    uint64_t position() override { return position_; }
+    uint64_t size() override { return view_.size(); }
+
+    void close() override {
+        open_ = false;
+        view_.reset();
+    }
+
+    bool isOpen() override { return open_; }
+    const char* name() override { return view_.buffer_ ? view_.buffer_->name : ""; }
+    boolean isDirectory() override { return false; }
+    File openNextFile(uint8_t mode) override { return File(); }
+    void rewindDirectory() override {}
+    bool getModifyTime(DateTimeFields& tm) override { return view_.getModifyTime(tm); }
+
+private:
+    FileView view_;
+    uint32_t position_;
+    bool open_;
+};
+
+// ============================================
+// FileView
+// ============================================
+
+FileView::FileView()
+    : buffer_(nullptr) {
+}
+
+FileView::FileView(Buffer* buffer)
+    : buffer_(buffer) {
+    if (buffer_) {
+        buffer_->refs++;
+    }
+}
+
+FileView::FileView(const FileView& other)
+    : FileView(other.buffer_) {
+}
+
+FileView& FileView::operator=(const FileView& other) {
+    if (buffer_ != other.buffer_) {
+        reset();
+        buffer_ = other.buffer_;
+        if (buffer_) {
+            buffer_->refs++;
+        }
+    }
+    return *this;
+}
+
+FileView::~FileView() {
+    reset();
+}
+
+void FileView::reset() {
+    if (!buffer_) return;
+
+    if (--buffer_->refs == 0) {
+        extmem_free(buffer_->data);
+        delete buffer_;
+    }
+    buffer_ = nullptr;
+}
+
+FileView FileView::load(File& file) {
+    if (!file || file.isDirectory()) {
+        return FileView();
+    }
+
+    uint32_t size = (uint32_t)file.size();
+
+    // PSRAM only - a fallback on the heap would take RAM the players need
+    uint8_t* data = (uint8_t*)extmem_malloc(size > 0 ? size : 1);
+    if (!data) {
+        return FileView();
+    }
+
+    // One sequential read; large requests go to the card as multi-sector reads
+    file.seek(0);
+    if (file.read(data, size) != size) {
+        extmem_free(data);
+        return FileView();
+    }
+    file.seek(0);
+
+    Buffer* buffer = new Buffer();
+    buffer->data = data;
+    buffer->size = size;
+    buffer->refs = 0;
+    buffer->hasModified = file.getModifyTime(buffer->modified);
+    snprintf(buffer->name, sizeof(buffer->name), "%s", file.name());
+    return FileView(buffer);
+}
+
+const uint8_t* FileView::data() const {
+    return buffer_ ? buffer_->data : nullptr;
+}
+
+uint32_t FileView::size() const {
+    return buffer_ ? buffer_->size : 0;
+}
+
+bool FileView::getModifyTime(DateTimeFields& tm) const {
+    if (!buffer_ || !buffer_->hasModified) return false;
+    tm = buffer_->modified;
+    return true;
+}
+
+File FileView::open() const {
+    if (!buffer_) {
+        return File();
+    }
+    return File(new FileViewImpl(*this));
+}
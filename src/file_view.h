@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+/**
+ * FileView - A whole file held read-only in PSRAM
+ *
+ * Small tracks (SPC 66KB, most VGM/VGZ, MIDI) are read in one sequential
+ * read, after which a player can parse them in place through data()/size()
+ * with no per-byte I/O, or keep streaming through open(), which returns a
+ * File served from the same memory. Seeks, rewinds and loop jumps cost
+ * nothing either way.
+ *
+ * Views are reference counted: copies and Files opened from a view share one
+ * buffer, freed when the last of them goes away. Counting isn't atomic -
+ * copy and release views from the main loop only.
+ *
+ * FileSource decides which files are loaded (see FileSource::setMemoryLimit());
+ * use FileSource::openView() rather than load() directly.
+ */
+class FileView {
+public:
+    FileView();
+    FileView(const FileView& other);
+    FileView& operator=(const FileView& other);
+    ~FileView();
+
+    /**
+     * Read an open file from the start into PSRAM
+     * @return Invalid view if PSRAM is short or the read fails (keep streaming)
+     */
+    static FileView load(File& file);
+
+    const uint8_t* data() const;
+    uint32_t size() const;
+    explicit operator bool() const { return buffer_ != nullptr; }
+
+    /**
+     * Modify time of the file the view was loaded from (false if it had none)
+     */
+    bool getModifyTime(DateTimeFields& tm) const;
+
+    /**
+     * Open a read-only File over the view (keeps the buffer alive until closed)
+     */
+    File open() const;
+
+    /**
+     * Drop this reference
+     */
+    void reset();
+
+private:
+    struct Buffer {
+        uint8_t* data;
+        uint32_t size;
+        uint32_t refs;
+        bool hasModified;
+        DateTimeFields modified;
+        char name[64];
+    };
+
+    explicit FileView(Buffer* buffer);
+
+    Buffer* buffer_;
+
+    friend class FileViewImpl;
+};
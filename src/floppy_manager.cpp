@@ -254,6 +254,8 @@ bool FloppyManager::isMusicFile(const char* filename) const {
          name.endsWith(".midi") ||
          name.endsWith(".smf") ||
          name.endsWith(".kar") ||
+         name.endsWith(".rmi") ||
+         name.endsWith(".xmi") ||
          name.endsWith(".vgm") ||
          name.endsWith(".vgz") ||
          name.endsWith(".dro") ||
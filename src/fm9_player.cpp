@@ -125,6 +125,7 @@ bool FM9Player::loadFile(const char* filename) {
                 Serial.print(" samples, ");
                 Serial.print(g_fm9WavStream->getDurationMs());
                 Serial.println(" ms");
+                vgmPlayer_->setRateLocked(true);  // WAV is not resampled - chips stay at 1x
             } else {
                 Serial.println("[FM9Player] WARNING: Failed to load WAV from offset");
             }
@@ -138,6 +139,7 @@ bool FM9Player::loadFile(const char* filename) {
                 Serial.print(" samples, ");
                 Serial.print(g_fm9Mp3Stream->getDurationMs());
                 Serial.println(" ms");
+                vgmPlayer_->setRateLocked(true);  // MP3 is not resampled - chips stay at 1x
             } else {
                 Serial.println("[FM9Player] WARNING: Failed to load MP3 from offset");
             }
@@ -343,6 +345,13 @@ uint32_t FM9Player::getPositionMs() const {
     return vgmPlayer_->getPositionMs();
 }
 
+bool FM9Player::seekToMs(uint32_t positionMs) {
+    if (!vgmPlayer_) return false;
+    // Embedded WAV/MP3 follow on their own: update() hands them the new VGM sample
+    // and the drift check forces a stream seek
+    return vgmPlayer_->seekToMs(positionMs);
+}
+
 float FM9Player::getProgress() const {
     if (!vgmPlayer_) return 0.0f;
     return vgmPlayer_->getProgress();
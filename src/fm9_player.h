@@ -56,6 +56,7 @@ public:
 
     uint32_t getDurationMs() const override;
     uint32_t getPositionMs() const override;
+    bool seekToMs(uint32_t positionMs) override;
     float getProgress() const override;
     const char* getFileName() const override { return currentFileName_; }
     FileFormat getFormat() const override { return FileFormat::FM9; }
@@ -104,10 +105,10 @@ private:
     // Audio routing - two-level mixer architecture:
     // 1. fm9AudioMixer: combines WAV (ch0) and MP3 (ch1) - mutually exclusive
     // 2. dacNesMixer: fm9AudioMixer output goes to channel 3
-    AudioMixer4* fm9AudioMixerLeft_;   // FM9 WAV/MP3 pre-mixer
-    AudioMixer4* fm9AudioMixerRight_;
-    AudioMixer4* dacNesMixerLeft_;     // Parent mixer (FM9 output on ch3)
-    AudioMixer4* dacNesMixerRight_;
+    AudioMixerStage* fm9AudioMixerLeft_;   // FM9 WAV/MP3 pre-mixer
+    AudioMixerStage* fm9AudioMixerRight_;
+    AudioMixerStage* dacNesMixerLeft_;     // Parent mixer (FM9 output on ch3)
+    AudioMixerStage* dacNesMixerRight_;
 
     // FM9 audio mixer channels
     static const int FM9_WAV_CHANNEL = 0;   // WAV on fm9AudioMixer channel 0
@@ -30,8 +30,11 @@ GameBoyAPU::GameBoyAPU()
     , panningRight_(0)
     , volumeLeft_(7)  // Default max volume
     , volumeRight_(7)
+    , offlineRender_(false)
     , frameStep_(0)
     , clockAccumulator_(0)
+    , timerClocksPerSample_(TIMER_CLOCKS_PER_SAMPLE)
+    , frameTimerPeriodUs_(1953.0f)
     , hpf90_a_(0)
     , hpf90_x1_left_(0), hpf90_y1_left_(0)
     , hpf90_x1_right_(0), hpf90_y1_right_(0)
@@ -99,7 +102,21 @@ void GameBoyAPU::startFrameTimer() {
     instance_ = this;
     frameStep_ = 0;
     stopping_ = false;
-    frameTimer_.begin(frameSequencerISR, 1953);  // 1953 microseconds = 512.0 Hz
+    frameTimer_.begin(frameSequencerISR, frameTimerPeriodUs_);  // 1953 microseconds = 512.0 Hz at normal rate
+}
+
+void GameBoyAPU::setPitchScale(float scale) {
+    // Read once per sample by update() - a single float store is atomic on Cortex-M7
+    timerClocksPerSample_ = TIMER_CLOCKS_PER_SAMPLE * scale;
+}
+
+void GameBoyAPU::setFrameRateScale(float scale) {
+    frameTimerPeriodUs_ = 1953.0f / scale;
+
+    // update() applies the new period from the next tick on, so no step is lost or doubled
+    if (instance_ == this && !stopping_) {
+        frameTimer_.update(frameTimerPeriodUs_);
+    }
 }
 
 void GameBoyAPU::stopFrameTimer() {
@@ -111,6 +128,17 @@ void GameBoyAPU::stopFrameTimer() {
     }
 }
 
+void GameBoyAPU::beginOfflineRender() {
+    stopFrameTimer();
+    offlineRender_ = true;
+    reset();
+}
+
+void GameBoyAPU::endOfflineRender() {
+    reset();  // Same idle state VGMPlayer::stop() leaves behind
+    offlineRender_ = false;
+}
+
 void GameBoyAPU::frameSequencerISR() {
     if (instance_ && !instance_->stopping_) {
         instance_->frameSequencerTick();
@@ -733,7 +761,7 @@ float GameBoyAPU::applyOutputFiltersRight(float x) {
 // ========================================
 
 void GameBoyAPU::update() {
-    if (stopping_) return;
+    if (stopping_ || offlineRender_) return;
 
     audio_block_t* blockLeft = allocate();
     audio_block_t* blockRight = allocate();
@@ -745,40 +773,9 @@ void GameBoyAPU::update() {
 
     updateCallCount_++;
 
+    uint8_t channelOut[STEM_COUNT];
     for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
-        // Clock timers for sub-sample accuracy
-        float clocksThisSample = TIMER_CLOCKS_PER_SAMPLE + clockAccumulator_;
-        int clocksToRun = (int)clocksThisSample;
-        clockAccumulator_ = clocksThisSample - clocksToRun;
-
-        for (int c = 0; c < clocksToRun; c++) {
-            pulse1_.clockTimer();
-            pulse2_.clockTimer();
-            wave_.clockTimer();
-
-            // Noise clocks at half rate (1.048576 MHz vs 2.097152 MHz)
-            if (c & 1) {
-                noise_.clockTimer();
-            }
-        }
-
-        // Get channel outputs (0-15)
-        uint8_t p1 = pulse1_.getOutput();
-        uint8_t p2 = pulse2_.getOutput();
-        uint8_t wav = wave_.getOutput();
-        uint8_t noi = noise_.getOutput();
-
-        // Mix with panning
-        float left, right;
-        mixChannelsStereo(p1, p2, wav, noi, left, right);
-
-        // Apply output filter (HPF only - DMG has no hardware LPF)
-        left = applyOutputFiltersLeft(left);
-        right = applyOutputFiltersRight(right);
-
-        // Convert to int16
-        blockLeft->data[i] = (int16_t)(left * 32767.0f);
-        blockRight->data[i] = (int16_t)(right * 32767.0f);
+        generateSample(channelOut, blockLeft->data[i], blockRight->data[i]);
 
         // Track non-zero samples for debug
         if (blockLeft->data[i] != 0 || blockRight->data[i] != 0) {
@@ -791,3 +788,62 @@ void GameBoyAPU::update() {
     release(blockLeft);
     release(blockRight);
 }
+
+// Clock all channels by one output sample and mix them
+// Shared by the audio ISR (update) and offline rendering (renderSample)
+void GameBoyAPU::generateSample(uint8_t* channelOut, int16_t& sampleLeft, int16_t& sampleRight) {
+    // Clock timers for sub-sample accuracy
+    float clocksThisSample = timerClocksPerSample_ + clockAccumulator_;
+    int clocksToRun = (int)clocksThisSample;
+    clockAccumulator_ = clocksThisSample - clocksToRun;
+
+    for (int c = 0; c < clocksToRun; c++) {
+        pulse1_.clockTimer();
+        pulse2_.clockTimer();
+        wave_.clockTimer();
+
+        // Noise clocks at half rate (1.048576 MHz vs 2.097152 MHz)
+        if (c & 1) {
+            noise_.clockTimer();
+        }
+    }
+
+    // Get channel outputs (0-15)
+    channelOut[STEM_PULSE1] = pulse1_.getOutput();
+    channelOut[STEM_PULSE2] = pulse2_.getOutput();
+    channelOut[STEM_WAVE] = wave_.getOutput();
+    channelOut[STEM_NOISE] = noise_.getOutput();
+
+    // Mix with panning
+    float left, right;
+    mixChannelsStereo(channelOut[STEM_PULSE1], channelOut[STEM_PULSE2],
+                      channelOut[STEM_WAVE], channelOut[STEM_NOISE], left, right);
+
+    // Apply output filter (HPF only - DMG has no hardware LPF)
+    left = applyOutputFiltersLeft(left);
+    right = applyOutputFiltersRight(right);
+
+    // Convert to int16
+    sampleLeft = (int16_t)(left * 32767.0f);
+    sampleRight = (int16_t)(right * 32767.0f);
+}
+
+// ========================================
+// Offline Rendering (stem export)
+// ========================================
+
+void GameBoyAPU::renderSample(int16_t* stems, int16_t& mixLeft, int16_t& mixRight) {
+    uint8_t channelOut[STEM_COUNT];
+    generateSample(channelOut, mixLeft, mixRight);
+
+    // Each channel alone through NR50/NR51 (panning folded to mono), unfiltered
+    for (int ch = 0; ch < STEM_COUNT; ch++) {
+        uint8_t solo[STEM_COUNT] = {0, 0, 0, 0};
+        solo[ch] = channelOut[ch];
+
+        float left, right;
+        mixChannelsStereo(solo[STEM_PULSE1], solo[STEM_PULSE2], solo[STEM_WAVE], solo[STEM_NOISE],
+                          left, right);
+        stems[ch] = (int16_t)((left + right) * 0.5f * 32767.0f);
+    }
+}
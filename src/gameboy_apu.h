@@ -32,6 +32,35 @@ public:
     // Start the frame sequencer timer (call when playback begins)
     void startFrameTimer();
 
+    // ========== Playback Rate / Pitch ==========
+    // Scale channel timer clocks (1.0 = normal, 2.0 = one octave up). Envelopes,
+    // sweep and length counters are frame-sequencer driven and are not affected.
+    void setPitchScale(float scale);
+
+    // Scale the 512Hz frame sequencer to follow a faster/slower song clock.
+    // Takes effect immediately if the frame timer is running.
+    void setFrameRateScale(float scale);
+
+    // ========== Offline Rendering (stem export) ==========
+    // Stem order for renderSample()
+    enum Stem { STEM_PULSE1, STEM_PULSE2, STEM_WAVE, STEM_NOISE, STEM_COUNT };
+
+    // Frame sequencer rate - offline callers clock it themselves (no IntervalTimer)
+    static constexpr uint32_t FRAME_SEQUENCER_HZ = 512;
+
+    // Synthesize one 44.1kHz sample without the Audio Library: fills stems[STEM_COUNT]
+    // with each channel mixed alone, plus the full stereo mix as update() would output
+    void renderSample(int16_t* stems, int16_t& mixLeft, int16_t& mixRight);
+
+    // Advance the frame sequencer by one step (512Hz) - offline counterpart of the ISR
+    void clockFrameSequencer() { frameSequencerTick(); }
+
+    // Take the (static, always-linked) instance off the audio graph for offline use:
+    // stops the frame timer, resets, and makes update() return without output.
+    // Only valid while no VGM is playing. endOfflineRender() resets to idle again.
+    void beginOfflineRender();
+    void endOfflineRender();
+
 private:
     // Master clock and sample rate (Game Boy DMG: 4.194304 MHz)
     static constexpr float MASTER_CLOCK_HZ = 4194304.0f;
@@ -274,10 +303,13 @@ private:
     // Frame sequencer (512 Hz, drives all timing)
     IntervalTimer frameTimer_;
     static GameBoyAPU* instance_;  // For ISR access
+    volatile bool offlineRender_;  // update() yields to renderSample()
     volatile uint8_t frameStep_;   // 0-7 (8-step sequence)
 
     // Clock accumulator for sub-sample accuracy
     float clockAccumulator_;
+    float timerClocksPerSample_;   // TIMER_CLOCKS_PER_SAMPLE x pitch scale
+    float frameTimerPeriodUs_;     // Frame sequencer period (1953us at normal rate)
 
     // Frame sequencer ISR and tick logic
     static void frameSequencerISR();  // ISR callback (must be static)
@@ -289,6 +321,9 @@ private:
     // Noise divisor lookup table
     static const uint8_t divisorTable_[8];
 
+    // Clock every channel by one output sample and mix (update() and renderSample())
+    void generateSample(uint8_t* channelOut, int16_t& sampleLeft, int16_t& sampleRight);
+
     // Stereo mixing with panning (GB hardware panning)
     void mixChannelsStereo(
         uint8_t pulse1Out, uint8_t pulse2Out,
@@ -220,8 +220,8 @@ HardwareInitializer::InitResult HardwareInitializer::initializeDisplay(const Con
 }
 
 bool HardwareInitializer::initializeAudioBoard(const Config& config,
-                                               AudioMixer4& mixerLeft,
-                                               AudioMixer4& mixerRight,
+                                               AudioMixerStage& mixerLeft,
+                                               AudioMixerStage& mixerRight,
                                                AudioControlSGTL5000& audioShield) {
     // Allocate audio memory
     AudioMemory(20);
@@ -281,8 +281,8 @@ void HardwareInitializer::configureOPL3Pins(OPL3Pins& pins) {
     pins.spiSCK  = 13;  // SCK (unchanged)
 }
 
-void HardwareInitializer::configureAudioMixers(AudioMixer4& mixerLeft,
-                                              AudioMixer4& mixerRight,
+void HardwareInitializer::configureAudioMixers(AudioMixerStage& mixerLeft,
+                                              AudioMixerStage& mixerRight,
                                               const Config& config) {
     // Configure left mixer
     mixerLeft.gain(0, config.opl3MixLevel);   // OPL3 left
@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include <Audio.h>
+#include "audio_mixer_fused.h"
 #include "opl3_synth.h"
 
 // Forward declarations
@@ -94,8 +95,8 @@ public:
     static bool initializeSerial(const Config& config);
     static InitResult initializeDisplay(const Config& config);
     static bool initializeAudioBoard(const Config& config,
-                                     AudioMixer4& mixerLeft,
-                                     AudioMixer4& mixerRight,
+                                     AudioMixerStage& mixerLeft,
+                                     AudioMixerStage& mixerRight,
                                      AudioControlSGTL5000& audioShield);
     static OPL3Synth* initializeOPL3(const Config& config);
     static bool initializeSDCard();
@@ -109,8 +110,8 @@ public:
 private:
     // Helper functions
     static void configureOPL3Pins(OPL3Pins& pins);
-    static void configureAudioMixers(AudioMixer4& mixerLeft,
-                                     AudioMixer4& mixerRight,
+    static void configureAudioMixers(AudioMixerStage& mixerLeft,
+                                     AudioMixerStage& mixerRight,
                                      const Config& config);
     static void printSystemBanner();
     static void printInitStatus(const InitResult& result);
@@ -0,0 +1,278 @@
+#include "load_shedder.h"
+#include <Audio.h>
+#include "audio_globals.h"
+#include "cpu_governor.h"
+#include "debug_config.h"
+
+LoadShedder* g_loadShedder = nullptr;
+
+LoadShedder::LoadShedder()
+    : level_(0)
+    , heavyRun_(0)
+    , lightRun_(0)
+    , restoreWindows_(RESTORE_WINDOWS)
+    , lastRestoreMs_(0)
+    , windowStartUs_(0)
+    , windowStartSample_(0)
+    , lastLoopUs_(0)
+    , maxGapUs_(0)
+    , stressPhase_(STRESS_OFF)
+    , stressStartMs_(0)
+    , stressPhaseMs_(0) {
+    memset(&stats_, 0, sizeof(stats_));
+    memset(&stressBase_, 0, sizeof(stressBase_));
+    memset(&stress_, 0, sizeof(stress_));
+}
+
+void LoadShedder::begin() {
+    uint32_t nowUs = micros();
+    windowStartUs_ = nowUs;
+    windowStartSample_ = audioClock.blockStart();
+    lastLoopUs_ = nowUs;
+    maxGapUs_ = 0;
+    AudioProcessorUsageMaxReset();
+}
+
+const char* LoadShedder::stepName(Step step) {
+    switch (step) {
+        case STEP_VISUALIZER:   return "visualizer";
+        case STEP_DISPLAY_RATE: return "display refresh";
+        case STEP_BACKGROUND:   return "background work";
+        case STEP_SPC_FILTER:   return "SPC filter";
+        case STEP_DRUM_VOICES:  return "drum voices";
+        default:                return "?";
+    }
+}
+
+// ============================================
+// Measurement
+// ============================================
+
+void LoadShedder::update() {
+    uint32_t nowUs = micros();
+
+    uint32_t gap = nowUs - lastLoopUs_;
+    if (gap > maxGapUs_) {
+        maxGapUs_ = gap;
+    }
+    lastLoopUs_ = nowUs;
+
+    if (nowUs - windowStartUs_ >= WINDOW_MS * 1000) {
+        endWindow(nowUs);
+    }
+
+    if (stressPhase_ != STRESS_OFF) {
+        updateStress();
+    }
+}
+
+void LoadShedder::endWindow(uint32_t nowUs) {
+    // Peak per-block ISR time over the window
+    float isrPercent = AudioProcessorUsageMax();
+    AudioProcessorUsageMaxReset();
+
+    // Blocks the ISR should have run by now vs blocks it counted. The window
+    // starts mid-block, so one block of difference is just phase.
+    uint32_t sample = audioClock.blockStart();
+    uint32_t elapsedUs = nowUs - windowStartUs_;
+    uint32_t expected = (uint32_t)((float)elapsedUs * (AUDIO_SAMPLE_RATE_EXACT / 1000000.0f)) / AUDIO_BLOCK_SAMPLES;
+    uint32_t counted = (sample - windowStartSample_) / AUDIO_BLOCK_SAMPLES;
+    uint32_t lateBlocks = expected > counted + 1 ? expected - counted - 1 : 0;
+
+    uint32_t maxGapUs = maxGapUs_;
+
+    windowStartUs_ = nowUs;
+    windowStartSample_ = sample;
+    maxGapUs_ = 0;
+
+    stats_.windows++;
+    stats_.lateBlocks += lateBlocks;
+    if (isrPercent > stats_.maxIsrPercent) {
+        stats_.maxIsrPercent = isrPercent;
+    }
+    if (maxGapUs > stats_.maxLoopGapUs) {
+        stats_.maxLoopGapUs = maxGapUs;
+    }
+
+    if (stressPhase_ != STRESS_OFF) {
+        if (isrPercent > stress_.maxIsrPercent) {
+            stress_.maxIsrPercent = isrPercent;
+        }
+        if (maxGapUs > stress_.maxLoopGapUs) {
+            stress_.maxLoopGapUs = maxGapUs;
+        }
+    }
+
+    Window window = {isrPercent, maxGapUs, lateBlocks};
+
+    // A clock change answers this window (and makes it stale) - start over
+    if (g_cpuGovernor && g_cpuGovernor->onWindow(window, level_)) {
+        heavyRun_ = 0;
+        lightRun_ = 0;
+        return;
+    }
+
+    bool heavy = isrPercent >= ISR_HIGH_PERCENT || lateBlocks > 0 || maxGapUs >= LOOP_GAP_HIGH_US;
+    bool light = isrPercent < ISR_LOW_PERCENT && maxGapUs < LOOP_GAP_LOW_US;
+
+    if (heavy) {
+        stats_.heavyWindows++;
+        lightRun_ = 0;
+        if (++heavyRun_ >= SHED_WINDOWS && level_ < STEP_COUNT) {
+            shed(window);
+            heavyRun_ = 0;
+        }
+    } else if (light) {
+        heavyRun_ = 0;
+        if (++lightRun_ >= restoreWindows_ && level_ > 0) {
+            restore();
+            lightRun_ = 0;
+        }
+    } else {
+        // In the hysteresis band: hold the current level
+        heavyRun_ = 0;
+        lightRun_ = 0;
+    }
+}
+
+// ============================================
+// Level changes
+// ============================================
+
+void LoadShedder::shed(const Window& window) {
+    // Shedding right after a restore means the step is needed at this load -
+    // wait longer before trying it again
+    if (lastRestoreMs_ != 0 && millis() - lastRestoreMs_ < RELAPSE_MS) {
+        uint16_t hold = (uint16_t)restoreWindows_ * 2;
+        restoreWindows_ = hold > MAX_RESTORE_WINDOWS ? MAX_RESTORE_WINDOWS : (uint8_t)hold;
+    } else {
+        restoreWindows_ = RESTORE_WINDOWS;
+    }
+
+    Step step = (Step)level_;
+    level_++;
+    stats_.sheds++;
+    if (stressPhase_ == STRESS_ISR_LOAD && level_ > stress_.isrLevel) {
+        stress_.isrLevel = level_;
+    } else if (stressPhase_ == STRESS_LOOP_LOAD && level_ > stress_.loopLevel) {
+        stress_.loopLevel = level_;
+    }
+    Serial.printf("[LoadShedder] Shed %s (level %u/%u): ISR %.0f%%, loop gap %lums, %lu late blocks\n",
+                  stepName(step), level_, (unsigned)STEP_COUNT,
+                  window.isrPercent, window.maxLoopGapUs / 1000, window.lateBlocks);
+}
+
+void LoadShedder::restore() {
+    level_--;
+    Step step = (Step)level_;
+    stats_.restores++;
+    lastRestoreMs_ = millis();
+    Serial.printf("[LoadShedder] Restored %s (level %u/%u)\n",
+                  stepName(step), level_, (unsigned)STEP_COUNT);
+}
+
+// ============================================
+// Stress test
+// ============================================
+
+void LoadShedder::startStressTest() {
+    memset(&stress_, 0, sizeof(stress_));
+    stressBase_ = stats_;
+    stressStartMs_ = millis();
+    Serial.printf("[LoadShedder] Stress test: %lu s ISR load (+%u%% of a block), idle, "
+                  "%lu s loop load (+%lu ms per iteration), idle\n",
+                  STRESS_LOAD_MS / 1000, STRESS_ISR_PERCENT,
+                  STRESS_LOAD_MS / 1000, STRESS_LOOP_BURN_US / 1000);
+    enterStressPhase(STRESS_ISR_LOAD);
+}
+
+void LoadShedder::enterStressPhase(StressPhase phase) {
+    stressPhase_ = phase;
+    stressPhaseMs_ = millis();
+
+#if DEBUG_LOAD_SHEDDER_STRESS
+    uint32_t blockUs = (uint32_t)(AUDIO_BLOCK_SAMPLES * 1000000.0f / AUDIO_SAMPLE_RATE_EXACT);
+    audioClock.setStressBurnUs(phase == STRESS_ISR_LOAD ? blockUs * STRESS_ISR_PERCENT / 100 : 0);
+#endif
+}
+
+void LoadShedder::updateStress() {
+    uint32_t nowMs = millis();
+    uint32_t phaseMs = nowMs - stressPhaseMs_;
+
+    // Idle phases run until every step is back and the relapse window has
+    // passed, so the next load phase starts from the normal restore hold
+    bool recovered = level_ == 0 && (lastRestoreMs_ == 0 || nowMs - lastRestoreMs_ >= RELAPSE_MS);
+    bool idleDone = recovered || phaseMs >= STRESS_IDLE_MAX_MS;
+
+    switch (stressPhase_) {
+        case STRESS_ISR_LOAD:
+            if (phaseMs >= STRESS_LOAD_MS) enterStressPhase(STRESS_ISR_IDLE);
+            break;
+        case STRESS_ISR_IDLE:
+            if (level_ == 0 && stress_.isrRecoverMs == 0) stress_.isrRecoverMs = phaseMs;
+            if (idleDone) {
+                stress_.isrEndLevel = level_;
+                enterStressPhase(STRESS_LOOP_LOAD);
+            }
+            break;
+        case STRESS_LOOP_LOAD:
+            // Counted in the next update()'s loop gap
+            delayMicroseconds(STRESS_LOOP_BURN_US);
+            if (phaseMs >= STRESS_LOAD_MS) enterStressPhase(STRESS_LOOP_IDLE);
+            break;
+        case STRESS_LOOP_IDLE:
+            if (level_ == 0 && stress_.loopRecoverMs == 0) stress_.loopRecoverMs = phaseMs;
+            if (idleDone) {
+                stress_.loopEndLevel = level_;
+                finishStressTest();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void LoadShedder::finishStressTest() {
+    enterStressPhase(STRESS_OFF);
+
+    stress_.ran = true;
+    stress_.durationMs = millis() - stressStartMs_;
+    stress_.sheds = stats_.sheds - stressBase_.sheds;
+    stress_.restores = stats_.restores - stressBase_.restores;
+    stress_.lateBlocks = stats_.lateBlocks - stressBase_.lateBlocks;
+
+    // Each load phase has to shed something and each idle phase has to give
+    // it all back. The CPU governor may absorb part of the load by raising
+    // the clock first, so the depth is reported, not checked.
+    bool passed = stress_.isrLevel > 0 && stress_.loopLevel > 0 &&
+                  stress_.isrEndLevel == 0 && stress_.loopEndLevel == 0;
+
+    Serial.printf("[LoadShedder] Stress test %s in %lu ms: ISR load shed %u/%u (%u left, back in %lu ms), "
+                  "loop load shed %u/%u (%u left, back in %lu ms), %lu sheds, %lu restores, %lu late blocks, "
+                  "peak ISR %.0f%%, longest loop gap %lu ms\n",
+                  passed ? "PASSED" : "FAILED", stress_.durationMs,
+                  stress_.isrLevel, (unsigned)STEP_COUNT, stress_.isrEndLevel, stress_.isrRecoverMs,
+                  stress_.loopLevel, (unsigned)STEP_COUNT, stress_.loopEndLevel, stress_.loopRecoverMs,
+                  stress_.sheds, stress_.restores, stress_.lateBlocks,
+                  stress_.maxIsrPercent, stress_.maxLoopGapUs / 1000);
+}
+
+void LoadShedder::printStats() const {
+    Serial.println("=== Load Shedder Stats ===");
+    Serial.printf("Level: %u/%u", level_, (unsigned)STEP_COUNT);
+    if (level_ > 0) {
+        Serial.printf(" (last shed: %s)", stepName((Step)(level_ - 1)));
+    }
+    Serial.println();
+    Serial.printf("Windows: %lu (%lu heavy)\n", stats_.windows, stats_.heavyWindows);
+    Serial.printf("Sheds: %lu, restores: %lu\n", stats_.sheds, stats_.restores);
+    Serial.printf("Peak ISR: %.1f%% of a block, late blocks: %lu\n",
+                  stats_.maxIsrPercent, stats_.lateBlocks);
+    Serial.printf("Longest loop gap: %lu us\n", stats_.maxLoopGapUs);
+    if (stress_.ran) {
+        Serial.printf("Last stress test: ISR load shed %u (%u left), loop load shed %u (%u left), %lu late blocks\n",
+                      stress_.isrLevel, stress_.isrEndLevel, stress_.loopLevel, stress_.loopEndLevel,
+                      stress_.lateBlocks);
+    }
+}
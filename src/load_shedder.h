@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * LoadShedder - Trade optional work for audio headroom under load
+ *
+ * Some combinations run the audio update and the main loop close to their
+ * limits: SPC with the post-filter on, FM9 MP3 decode, a dense drum part,
+ * the register stream and the visualizer all at once. When either side runs
+ * out of time the result is a click or a stalled refill, not a slower UI.
+ *
+ * update() (every main-loop iteration) measures over WINDOW_MS windows:
+ *   - audio ISR load: the peak per-block update time (AudioProcessorUsageMax(),
+ *     as a share of one AUDIO_BLOCK_SAMPLES block)
+ *   - late blocks: blocks the sample clock should have counted by micros()
+ *     but didn't, i.e. audio interrupts that were merged or skipped
+ *   - main-loop slack: the longest gap between two update() calls
+ *
+ * A window is heavy if any of these crosses its high mark and light if all are
+ * under their low marks. SHED_WINDOWS heavy windows in a row shed the next
+ * step; restoreWindows light windows in a row restore the last one. A step
+ * that has to be shed again soon after being restored doubles the restore
+ * hold (up to MAX_RESTORE_WINDOWS), so a borderline load settles instead of
+ * toggling. Every change is logged.
+ *
+ * Each window goes to the CPU governor first: while the ARM clock can still
+ * be raised, that is done instead of shedding.
+ *
+ * Steps are ranked cheapest-to-lose first. Each consumer asks isShed() for its
+ * own step, so nothing here reaches into the players or the UI, and the user's
+ * settings (e.g. g_spcFilterEnabled) are never changed.
+ *
+ * startStressTest() adds synthetic load - busy time in the audio interrupt,
+ * then long main-loop iterations - with an idle phase after each, and
+ * reports how far the level went and how long it took to come back to 0. Enable
+ * DEBUG_LOAD_SHEDDER_STRESS to run it at boot.
+ */
+class LoadShedder {
+public:
+    enum Step : uint8_t {
+        STEP_VISUALIZER,      // Visualizer frozen, analyzer ISR tap off
+        STEP_DISPLAY_RATE,    // Register stream and progress redraws at a lower rate
+        STEP_BACKGROUND,      // Cover-art extraction deferred
+        STEP_SPC_FILTER,      // SPC post-filter (spc_filter_run) skipped
+        STEP_DRUM_VOICES,     // Drum sampler limited to SHED_DRUM_VOICES
+        STEP_COUNT
+    };
+
+    static const uint32_t WINDOW_MS = 250;
+    static const uint8_t SHED_WINDOWS = 2;               // 0.5s of sustained load
+    static const uint8_t RESTORE_WINDOWS = 20;           // 5s of headroom
+    static const uint8_t MAX_RESTORE_WINDOWS = 240;      // 60s
+    static const uint32_t RELAPSE_MS = 10000;            // Re-shed within this doubles the hold
+
+    static constexpr float ISR_HIGH_PERCENT = 70.0f;     // Of one block period
+    static constexpr float ISR_LOW_PERCENT = 45.0f;
+    static const uint32_t LOOP_GAP_HIGH_US = 30000;
+    static const uint32_t LOOP_GAP_LOW_US = 10000;
+
+    static const uint8_t SHED_DRUM_VOICES = 4;
+    static const uint8_t SHED_DISPLAY_DIVIDER = 4;       // 10Hz register stream -> 2.5Hz
+
+    static const uint32_t STRESS_LOAD_MS = 5000;         // Each synthetic-load phase
+    static const uint32_t STRESS_IDLE_MAX_MS = 90000;    // Recovery phases give up after this
+    static const uint8_t STRESS_ISR_PERCENT = 75;        // Added ISR busy time, % of a block
+    static const uint32_t STRESS_LOOP_BURN_US = 40000;   // Added to every main-loop iteration
+
+    /**
+     * Measurements of one window (also handed to the CPU governor)
+     */
+    struct Window {
+        float isrPercent;         // Peak per-block audio update time, % of a block
+        uint32_t maxLoopGapUs;
+        uint32_t lateBlocks;
+    };
+
+    struct Stats {
+        uint32_t windows;
+        uint32_t heavyWindows;
+        uint32_t sheds;
+        uint32_t restores;
+        uint32_t lateBlocks;
+        float maxIsrPercent;
+        uint32_t maxLoopGapUs;
+    };
+
+    struct StressResult {
+        bool ran;
+        uint32_t durationMs;
+        uint8_t isrLevel;             // Highest level during the ISR-load phase
+        uint8_t isrEndLevel;          // Level left after its idle phase
+        uint32_t isrRecoverMs;        // Load off to level 0
+        uint8_t loopLevel;            // Highest level during the main-loop phase
+        uint8_t loopEndLevel;         // Level left after its idle phase
+        uint32_t loopRecoverMs;
+        uint32_t sheds;
+        uint32_t restores;
+        uint32_t lateBlocks;
+        float maxIsrPercent;
+        uint32_t maxLoopGapUs;
+    };
+
+    LoadShedder();
+
+    /**
+     * Start measuring (call once after the audio objects are running)
+     */
+    void begin();
+
+    /**
+     * Measure and step the level (call every main-loop iteration)
+     */
+    void update();
+
+    /**
+     * True if the step is currently shed
+     */
+    bool isShed(Step step) const { return step < level_; }
+
+    /**
+     * Number of steps shed (0 = everything running)
+     */
+    uint8_t getLevel() const { return level_; }
+
+    static const char* stepName(Step step);
+
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+    /**
+     * Run the synthetic-load phases (driven from update())
+     */
+    void startStressTest();
+    bool isStressTesting() const { return stressPhase_ != STRESS_OFF; }
+    const StressResult& getStressResult() const { return stress_; }
+
+private:
+    enum StressPhase : uint8_t {
+        STRESS_OFF,
+        STRESS_ISR_LOAD,
+        STRESS_ISR_IDLE,
+        STRESS_LOOP_LOAD,
+        STRESS_LOOP_IDLE
+    };
+
+    void endWindow(uint32_t nowUs);
+    void updateStress();
+    void enterStressPhase(StressPhase phase);
+    void finishStressTest();
+    void shed(const Window& window);
+    void restore();
+
+    uint8_t level_;
+    uint8_t heavyRun_;
+    uint8_t lightRun_;
+    uint8_t restoreWindows_;
+    uint32_t lastRestoreMs_;
+
+    // Current window
+    uint32_t windowStartUs_;
+    uint32_t windowStartSample_;
+    uint32_t lastLoopUs_;
+    uint32_t maxGapUs_;
+
+    Stats stats_;
+
+    // Stress test
+    StressPhase stressPhase_;
+    uint32_t stressStartMs_;
+    uint32_t stressPhaseMs_;
+    Stats stressBase_;                // stats_ when the test started
+    StressResult stress_;
+};
+
+extern LoadShedder* g_loadShedder;
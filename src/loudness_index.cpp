@@ -0,0 +1,373 @@
+#include "loudness_index.h"
+#include <stddef.h>
+#include <math.h>
+#include "player_manager.h"
+#include "playback_state.h"
+#include "audio_mixer_fused.h"
+#include "audio_analyze_loudness.h"
+
+LoudnessIndex* g_loudnessIndex = nullptr;
+
+static const char* INDEX_DIR = "/FM90S";
+static const char* INDEX_PATH = "/FM90S/LOUDNESS.IDX";
+static const uint32_t STATE_POLL_MS = 20;         // Track changes are picked up within ~one fade step
+static const uint16_t LOAD_CHUNK = 32;            // Records per SD read at boot
+
+LoudnessIndex::LoudnessIndex()
+    : fileOpen_(false)
+    , records_(nullptr)
+    , recordsInPSRAM_(false)
+    , capacity_(0)
+    , slotCount_(0)
+    , playerManager_(nullptr)
+    , mixer_(nullptr)
+    , fadeStage_(nullptr)
+    , meter_(nullptr)
+    , enabled_(true)
+    , measuring_(false)
+    , lastPollMs_(0) {
+    currentPath_[0] = '\0';
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+LoudnessIndex::~LoudnessIndex() {
+    if (fileOpen_) {
+        file_.close();
+    }
+    if (records_) {
+        if (recordsInPSRAM_) {
+            extmem_free(records_);
+        } else {
+            free(records_);
+        }
+        records_ = nullptr;
+    }
+}
+
+bool LoudnessIndex::begin() {
+    if (!allocateTable() || !openFile()) {
+        return false;
+    }
+
+    loadRecords();
+    Serial.printf("[Loudness] %u tracks indexed (capacity %u)\n", stats_.records, capacity_);
+    return true;
+}
+
+void LoudnessIndex::attach(PlayerManager* playerManager, AudioMixerFused* mixer,
+                           AudioMixerStage* fadeStage, AudioAnalyzeLoudness* meter) {
+    playerManager_ = playerManager;
+    mixer_ = mixer;
+    fadeStage_ = fadeStage;
+    meter_ = meter;
+}
+
+void LoudnessIndex::setEnabled(bool enabled) {
+    enabled_ = enabled;
+
+    // Re-apply for the track already playing
+    const Record* rec = currentPath_[0] ? find(currentPath_) : nullptr;
+    applyGain((enabled_ && rec) ? gainForRecord(*rec) : 0.0f);
+}
+
+// ============================================
+// LOOKUP
+// ============================================
+
+uint32_t LoudnessIndex::hashPath(const char* path) {
+    // FNV-1a over the lower-cased path (FAT names are case-insensitive)
+    uint32_t hash = 0x811C9DC5;
+    for (const char* p = path; *p; p++) {
+        char c = *p;
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        hash ^= (uint8_t)c;
+        hash *= 0x01000193;
+    }
+    return hash ? hash : 1;   // 0 marks an empty slot
+}
+
+const LoudnessIndex::Record* LoudnessIndex::find(const char* path) const {
+    if (!records_ || !path || !path[0]) return nullptr;
+
+    // Linear scan: 8192 compares at track start is well under a millisecond
+    uint32_t hash = hashPath(path);
+    for (uint16_t i = 0; i < slotCount_; i++) {
+        if (records_[i].source != SOURCE_EMPTY && records_[i].pathHash == hash) {
+            return &records_[i];
+        }
+    }
+    return nullptr;
+}
+
+float LoudnessIndex::gainForRecord(const Record& rec) {
+    float gain = TARGET_LUFS - rec.loudness / 100.0f;
+
+    // Boosting must not push the true peak into the output's clip point
+    float headroom = TRUE_PEAK_CEILING_DBTP - rec.truePeak / 100.0f;
+    if (gain > headroom) gain = headroom;
+
+    if (gain > MAX_GAIN_DB) gain = MAX_GAIN_DB;
+    if (gain < MIN_GAIN_DB) gain = MIN_GAIN_DB;
+    return gain;
+}
+
+void LoudnessIndex::applyGain(float gainDb) {
+    stats_.appliedGainDb = gainDb;
+    if (mixer_) {
+        mixer_->setOutputGain(powf(10.0f, gainDb / 20.0f));
+    }
+}
+
+// ============================================
+// TRACK TRACKING (main loop)
+// ============================================
+
+void LoudnessIndex::update() {
+    if (!fileOpen_ || !playerManager_) return;
+
+    if (measuring_) {
+        meter_->service();
+    }
+
+    uint32_t now = millis();
+    if (now - lastPollMs_ < STATE_POLL_MS) return;
+    lastPollMs_ = now;
+
+    bool active = playerManager_->isPlaying() || playerManager_->isPaused();
+    String path = active ? PlaybackState::getInstance()->getCurrentPath() : String();
+
+    if (strcmp(path.c_str(), currentPath_) != 0) {
+        if (currentPath_[0]) {
+            onTrackEnded();
+        }
+        strncpy(currentPath_, path.c_str(), sizeof(currentPath_) - 1);
+        currentPath_[sizeof(currentPath_) - 1] = '\0';
+        if (currentPath_[0]) {
+            onTrackStarted(currentPath_);
+        }
+    }
+
+    if (measuring_) {
+        // Silence while paused is gated out anyway, but a loop fade-out or the
+        // stop fade would pull the measurement down
+        bool fading = fadeStage_ && fadeStage_->getGain(0) < 0.999f;
+        meter_->setPaused(playerManager_->isPaused() || fading);
+    }
+}
+
+void LoudnessIndex::onTrackStarted(const char* path) {
+    stats_.lookups++;
+
+    const Record* rec = find(path);
+    if (rec) {
+        stats_.hits++;
+        measuring_ = false;
+        applyGain(enabled_ ? gainForRecord(*rec) : 0.0f);
+        Serial.printf("[Loudness] %.1f LUFS, %.1f dBTP -> %+.1f dB\n",
+                      rec->loudness / 100.0f, rec->truePeak / 100.0f, stats_.appliedGainDb);
+        return;
+    }
+
+    // Unknown track: unity, so the meter sees the track's own level
+    applyGain(0.0f);
+    if (meter_) {
+        meter_->start();
+        measuring_ = meter_->isRunning();
+    }
+}
+
+void LoudnessIndex::onTrackEnded() {
+    if (!measuring_) return;
+
+    measuring_ = false;
+    meter_->stop();
+    store(currentPath_, meter_);
+}
+
+// ============================================
+// STORAGE
+// ============================================
+
+bool LoudnessIndex::store(const char* path, const AudioAnalyzeLoudness* meter) {
+    AudioAnalyzeLoudness::Result result = meter->getResult();
+    if (!result.valid || result.measuredSeconds < MIN_MEASURE_SECONDS) {
+        return false;
+    }
+
+    uint32_t hash = hashPath(path);
+    int32_t slot = -1;
+    int32_t freeSlot = -1;
+    for (uint16_t i = 0; i < slotCount_; i++) {
+        if (records_[i].source == SOURCE_EMPTY) {
+            if (freeSlot < 0) freeSlot = i;
+        } else if (records_[i].pathHash == hash) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot >= 0 && records_[slot].source == SOURCE_HOST) {
+        return false;   // Host analysis covers the whole track - keep it
+    }
+    if (slot < 0) {
+        slot = (freeSlot >= 0) ? freeSlot : slotCount_;
+    }
+    if (slot >= capacity_) {
+        Serial.println("[Loudness] WARNING: Index full - measurement not stored");
+        return false;
+    }
+
+    Record& rec = records_[slot];
+    bool added = rec.source == SOURCE_EMPTY;
+    memset(&rec, 0, sizeof(rec));
+    rec.pathHash = hash;
+    rec.loudness = (int16_t)lroundf(result.integratedLufs * 100.0f);
+    rec.truePeak = (int16_t)lroundf(result.truePeakDbtp * 100.0f);
+    rec.seconds = result.measuredSeconds > 65535.0f ? 65535 : (uint16_t)result.measuredSeconds;
+    rec.source = SOURCE_DEVICE;
+
+    if (!writeRecord(slot)) {
+        return false;
+    }
+
+    if (added) stats_.records++;
+    stats_.measured++;
+    Serial.printf("[Loudness] Measured %.1f LUFS, %.1f dBTP over %u s\n",
+                  result.integratedLufs, result.truePeakDbtp, rec.seconds);
+    return true;
+}
+
+bool LoudnessIndex::writeRecord(uint16_t slot) {
+    Record& rec = records_[slot];
+    rec.crc = crc32((const uint8_t*)&rec, offsetof(Record, crc));
+
+    bool ok = file_.seek(HEADER_SIZE + (uint32_t)slot * sizeof(Record)) &&
+              file_.write((const uint8_t*)&rec, sizeof(Record)) == sizeof(Record);
+    file_.flush();
+
+    if (!ok) {
+        stats_.writeErrors++;
+        Serial.println("[Loudness] ERROR: Index write failed");
+        return false;
+    }
+
+    if (slot >= slotCount_) {
+        slotCount_ = slot + 1;
+    }
+    return true;
+}
+
+bool LoudnessIndex::allocateTable() {
+    if (records_) return true;
+
+    records_ = (Record*)extmem_malloc((size_t)MAX_RECORDS * sizeof(Record));
+    if (records_) {
+        recordsInPSRAM_ = true;
+        capacity_ = MAX_RECORDS;
+    } else {
+        records_ = (Record*)malloc((size_t)MAX_RECORDS_FALLBACK * sizeof(Record));
+        if (!records_) {
+            Serial.println("[Loudness] ERROR: Failed to allocate index table");
+            return false;
+        }
+        recordsInPSRAM_ = false;
+        capacity_ = MAX_RECORDS_FALLBACK;
+        Serial.println("[Loudness] WARNING: No PSRAM, index limited to the first records");
+    }
+
+    memset(records_, 0, (size_t)capacity_ * sizeof(Record));
+    stats_.capacity = capacity_;
+    return true;
+}
+
+bool LoudnessIndex::openFile() {
+    if (!SD.exists(INDEX_DIR)) {
+        SD.mkdir(INDEX_DIR);
+    }
+
+    file_ = SD.open(INDEX_PATH, FILE_WRITE);
+    if (!file_) {
+        Serial.println("[Loudness] ERROR: Failed to open index file");
+        return false;
+    }
+
+    Header header;
+    bool valid = file_.size() >= HEADER_SIZE && file_.seek(0) &&
+                 file_.read((uint8_t*)&header, sizeof(header)) == (int)sizeof(header) &&
+                 header.magic == MAGIC && header.version == VERSION &&
+                 header.recordSize == sizeof(Record);
+
+    if (!valid) {
+        // New card, or an index from an incompatible build - start over
+        if (file_.size() > 0) {
+            Serial.println("[Loudness] Index format changed - rebuilding");
+            file_.truncate(0);
+        }
+        memset(&header, 0, sizeof(header));
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.recordSize = sizeof(Record);
+        if (!file_.seek(0) || file_.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+            Serial.println("[Loudness] ERROR: Failed to write index header");
+            file_.close();
+            return false;
+        }
+        file_.flush();
+    }
+
+    fileOpen_ = true;
+    return true;
+}
+
+void LoudnessIndex::loadRecords() {
+    uint32_t slots = (file_.size() - HEADER_SIZE) / sizeof(Record);
+    if (slots > capacity_) {
+        Serial.printf("[Loudness] WARNING: Index has %lu records, loading %u\n", slots, capacity_);
+        slots = capacity_;
+    }
+
+    file_.seek(HEADER_SIZE);
+    uint16_t loaded = 0;
+    while (loaded < slots) {
+        uint16_t count = (slots - loaded) < LOAD_CHUNK ? (slots - loaded) : LOAD_CHUNK;
+        int bytes = file_.read((uint8_t*)&records_[loaded], count * sizeof(Record));
+        if (bytes != (int)(count * sizeof(Record))) break;
+        loaded += count;
+    }
+    slotCount_ = loaded;
+
+    // A record torn by power loss fails its CRC - its slot is reused
+    for (uint16_t i = 0; i < slotCount_; i++) {
+        Record& rec = records_[i];
+        if (rec.source == SOURCE_EMPTY) continue;
+        if (rec.pathHash == 0 || rec.crc != crc32((const uint8_t*)&rec, offsetof(Record, crc))) {
+            memset(&rec, 0, sizeof(rec));
+            continue;
+        }
+        stats_.records++;
+    }
+}
+
+uint32_t LoudnessIndex::crc32(const uint8_t* data, size_t length) {
+    // Bitwise CRC-32 (IEEE), same as ResumeJournal - records are 12 bytes
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void LoudnessIndex::printStats() const {
+    Serial.println("=== Loudness Index Stats ===");
+    Serial.printf("Normalization: %s, target %.1f LUFS, ceiling %.1f dBTP\n",
+                  enabled_ ? "on" : "off", TARGET_LUFS, TRUE_PEAK_CEILING_DBTP);
+    Serial.printf("Records: %u / %u (%s)\n", stats_.records, stats_.capacity,
+                  recordsInPSRAM_ ? "PSRAM" : "heap");
+    Serial.printf("Tracks started: %lu, indexed: %lu, measured: %lu, write errors: %lu\n",
+                  stats_.lookups, stats_.hits, stats_.measured, stats_.writeErrors);
+    Serial.printf("Current gain: %+.1f dB%s\n", stats_.appliedGainDb, measuring_ ? " (measuring)" : "");
+    Serial.println("============================");
+}
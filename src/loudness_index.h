@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+class PlayerManager;
+class AudioMixerFused;
+class AudioMixerStage;
+class AudioAnalyzeLoudness;
+
+/**
+ * LoudnessIndex - Per-track loudness table and playback gain normalization
+ *
+ * Keeps one record per track (integrated loudness, true peak) in an index
+ * file on the SD card. When a track starts, update() looks it up and sets
+ * outputMixer's output gain so the track plays at TARGET_LUFS. A track with
+ * no record plays at unity while AudioAnalyzeLoudness measures it in the
+ * background, and the result is stored when the track ends, so the next
+ * play is normalized with no analysis running at all.
+ *
+ * Records come from two places:
+ *   - the device (SOURCE_DEVICE): measured at the mixer output, so it covers
+ *     the line-in OPL3/Genesis boards, which only exist as analog audio
+ *   - tools/analyze_loudness.py (SOURCE_HOST): offline analysis of renders or
+ *     /RECORD captures. A host record is never replaced by a device one.
+ *
+ * Gain: TARGET_LUFS - loudness, lowered if needed so the true peak stays under
+ * TRUE_PEAK_CEILING_DBTP, and limited to MIN_GAIN_DB..MAX_GAIN_DB (the mixer's
+ * Q15 gains top out just under +6dB). Tracks that hit a limit can't reach the
+ * target - there is no limiter on the output.
+ *
+ * Storage: a header followed by fixed 16-byte records, each with its own CRC.
+ * The table is loaded into PSRAM at boot; storing a record rewrites only its
+ * own 16 bytes, so a torn write loses at most that one record.
+ */
+class LoudnessIndex {
+public:
+    static constexpr float TARGET_LUFS = -18.0f;
+    static constexpr float TRUE_PEAK_CEILING_DBTP = -1.0f;
+    static constexpr float MAX_GAIN_DB = 5.9f;
+    static constexpr float MIN_GAIN_DB = -12.0f;
+    static const uint16_t MAX_RECORDS = 8192;            // 128KB in PSRAM
+    static const uint16_t MAX_RECORDS_FALLBACK = 512;    // 8KB on the heap
+    static const uint16_t MIN_MEASURE_SECONDS = 10;      // Shorter measurements aren't stored
+
+    enum RecordSource : uint8_t {
+        SOURCE_EMPTY = 0,
+        SOURCE_DEVICE = 1,
+        SOURCE_HOST = 2
+    };
+
+    /**
+     * One track (layout shared with tools/analyze_loudness.py)
+     */
+    struct Record {
+        uint32_t pathHash;        // FNV-1a of the lower-cased path, never 0
+        int16_t loudness;         // Integrated loudness, LUFS x 100
+        int16_t truePeak;         // dBTP x 100
+        uint16_t seconds;         // Audio measured
+        uint8_t source;           // RecordSource
+        uint8_t reserved;
+        uint32_t crc;             // CRC32 of everything above
+    };
+    static_assert(sizeof(Record) == 16, "Loudness record layout is shared with the host tool");
+
+    struct Stats {
+        uint16_t records;         // Valid records loaded or stored
+        uint16_t capacity;
+        uint32_t lookups;         // Tracks started
+        uint32_t hits;            // ...that had a record
+        uint32_t measured;        // Device measurements stored
+        uint32_t writeErrors;
+        float appliedGainDb;      // Gain of the current track
+    };
+
+    LoudnessIndex();
+    ~LoudnessIndex();
+
+    /**
+     * Open (or create) the index and load every valid record
+     * Call after SD.begin().
+     */
+    bool begin();
+
+    /**
+     * Wire up the playback objects
+     * @param fadeStage Any fade stage channel 0 - measurement pauses while it is below unity
+     */
+    void attach(PlayerManager* playerManager, AudioMixerFused* mixer,
+                AudioMixerStage* fadeStage, AudioAnalyzeLoudness* meter);
+
+    /**
+     * Normalization on/off (measuring and storing continue either way)
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+
+    /**
+     * Call from main loop - track changes, background measurement
+     */
+    void update();
+
+    /**
+     * Look up a track
+     * @return nullptr if the track has no record
+     */
+    const Record* find(const char* path) const;
+
+    /**
+     * Gain normalization would apply for a record (dB)
+     */
+    static float gainForRecord(const Record& rec);
+
+    static uint32_t hashPath(const char* path);
+
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+private:
+    static const uint32_t MAGIC = 0x494C4D46;        // "FMLI"
+    static const uint16_t VERSION = 1;
+    static const uint16_t HEADER_SIZE = 16;
+
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+        uint8_t reserved[8];
+    };
+    static_assert(sizeof(Header) == HEADER_SIZE, "Loudness index header layout is shared with the host tool");
+
+    bool openFile();
+    bool allocateTable();
+    void loadRecords();
+    bool store(const char* path, const AudioAnalyzeLoudness* meter);
+    bool writeRecord(uint16_t slot);
+    void onTrackStarted(const char* path);
+    void onTrackEnded();
+    void applyGain(float gainDb);
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+    File file_;
+    bool fileOpen_;
+    Record* records_;             // File slot i = records_[i]
+    bool recordsInPSRAM_;
+    uint16_t capacity_;
+    uint16_t slotCount_;          // Slots present in the file (valid or not)
+
+    PlayerManager* playerManager_;
+    AudioMixerFused* mixer_;
+    AudioMixerStage* fadeStage_;
+    AudioAnalyzeLoudness* meter_;
+
+    bool enabled_;
+    bool measuring_;              // meter_ is running for currentPath_
+    char currentPath_[128];
+    uint32_t lastPollMs_;
+
+    Stats stats_;
+};
+
+extern LoudnessIndex* g_loudnessIndex;
@@ -6,6 +6,12 @@
 #include <SPI.h>
 #include "hardware_initializer.h"  // Centralized hardware initialization
 #include "audio_system.h"          // Centralized audio configuration
+#include "audio_mixer_fused.h"     // Single-node output mixer (replaces the AudioMixer4 chain)
+#include "audio_analyze_visualizer.h"  // Spectrum/scope tap for the Now Playing screen
+#include "audio_record_mix.h"      // Final-mix WAV recorder
+#include "audio_effect_reverb_psram.h"  // MIDI reverb (delay lines in PSRAM)
+#include "audio_sample_clock.h"     // Master sample clock (counted in the audio ISR)
+#include "audio_analyze_loudness.h"  // BS.1770 loudness meter on the final mix
 #include "player_manager.h"        // Unified player management (replaces PlayerFactory + PlaybackController)
 #include "playback_coordinator.h"  // Event-driven playback lifecycle coordinator
 #include "opl3_synth.h"
@@ -19,6 +25,7 @@
 #include "ui/framework/screen_context.h"  // Framework dependency injection
 #include "ui/framework/system_event_handlers.h"  // System event handlers
 #include "ui/lcd_manager.h"  // Smart LCD update manager
+#include "ui/button_input.h"  // Interrupt-driven button events
 #include "ui/framework/playback_navigation_handler.h"  // Playback navigation decisions
 #include "playback_state.h"  // Global playback state tracking
 #include "drum_sampler_v2.h"  // PCM drum sampler (AudioPlayMemory + PROGMEM samples)
@@ -28,18 +35,27 @@
 #include "audio_stream_spc.h"  // AudioStreamSPC (AudioStream for SNES files) - SEPARATE FILE TO AVOID ODR
 #include "spc_player.h"  // SPC player (uses AudioStreamSPC)
 #include "dac_prerender.h"     // DAC pre-renderer for Genesis VGM (solves dense PCM timing)
+#include "dac_prerender_cache.h"  // Persistent cache of pre-rendered DAC files
 #include "audio_stream_dac_prerender.h"  // AudioStream for pre-rendered DAC playback
 #include "bluetooth_manager.h"  // ESP32 Bluetooth control
 #include "ui/framework/event_manager.h"  // GUI Framework Phase 1: Event system
 #include "queue_manager.h"  // Queue system for sequential playback
 #include "ui/framework/status_bar_manager.h"  // Global status bar with "Now playing:" and "Up Next:"
+#include "resume_journal.h"  // Persisted settings + resume-from-last-track
+#include "loudness_index.h"  // Per-track loudness index + gain normalization
+#include "cover_art_cache.h"  // FM9 cover thumbnails for the file browser
+#include "load_shedder.h"  // Sheds optional work when the audio ISR or main loop runs long
+#include "cpu_governor.h"  // ARM clock scaling by workload
+#include "trace_log.h"  // Binary deferred-format diagnostics (TRACE)
 
 // --------- Config ----------
 static const bool kForce2OpMode = false;          // Set true to disable 4-op voices (2-op only)
 static const uint8_t kMax4OpVoices = 12;         // Max concurrent 4-op voices (1-12, each uses 2 channels)
 bool g_drumSamplerEnabled = true;                 // Runtime toggle for PCM drum sampler (MIDI channel 10) - non-static for menu access
 bool g_crossfeedEnabled = true;                   // Runtime toggle for stereo crossfeed (softer panning for MIDI) - non-static for menu access
-bool g_reverbEnabled = true;                      // Runtime toggle for reverb effect (MIDI only) - non-static for menu access
+bool g_reverbEnabled = false;                     // Runtime toggle for reverb effect (MIDI only) - OFF until its ISR cost is measured on target
+bool g_cpuGovernorEnabled = false;                // Scale the ARM clock with load (OFF = fixed 600MHz, Settings > System)
+bool g_loudnessNormalizeEnabled = true;           // Per-track loudness gain from the loudness index (Settings > System)
 
 // VGM-specific settings
 uint8_t g_maxLoopsBeforeFade = 2;                 // 0 = loop forever, 1+ = fade after N loops (non-static for menu access)
@@ -47,6 +63,10 @@ float g_fadeDurationSeconds = 7.0f;               // Fade duration in seconds (n
 bool g_nesFiltersEnabled = false;                 // NES APU output filters (default OFF for raw sound)
 bool g_nesStereoEnabled = true;                   // NES APU stereo panning (default ON)
 bool g_spcFilterEnabled = false;                  // SPC gaussian filter (default OFF for raw sound)
+bool g_dualOPL2StereoSplit = false;               // Dual OPL2 VGMs: chip 0 left, chip 1 right (default OFF = centered)
+uint8_t g_vgmPlaybackRatePercent = 100;           // VGM/FM9 playback rate 50-200% (applied live)
+bool g_vgmPitchFollowsRate = false;               // Scale APU/OPL pitch with rate (default OFF = pitch fixed)
+bool g_vgmRateLocked = false;                     // Current file has a sample-locked stream - plays at 100%
 
 // Genesis-specific settings
 bool g_genesisDACEmulation = false;               // DAC emulation (OFF - using hardware DAC)
@@ -62,6 +82,7 @@ bool g_genesisDACEmulation = false;               // DAC emulation (OFF - using
 DisplayManager* displayManager = nullptr;
 Adafruit_RGBLCDShield* lcd = nullptr;
 LCDManager* g_lcdManager = nullptr;  // Smart LCD update manager
+ButtonInput* g_buttonInput = nullptr;  // Button event queue (MCP23017 INTA)
 FileBrowser* browser = nullptr;
 FloppyManager* floppy = nullptr;  // Local pointer (legacy, kept for compatibility)
 
@@ -72,6 +93,8 @@ FloppyManager* g_floppy = nullptr;  // For floppy file browser
 FileSource* g_fileSource = nullptr;  // File source abstraction
 ScreenManager* g_screenManager = nullptr;  // For navigation tracking
 DrumSamplerV2* g_drumSampler = nullptr;  // PCM drum sampler for MIDI channel 10
+// Master sample clock - first AudioStream constructed, so it updates first in every audio interrupt
+AudioSampleClock audioClock;
 // CRITICAL FIX: Create NES APU, GB APU, and AudioStreamSPC as static stack objects, not heap-allocated
 // The Audio Library's update graph doesn't reliably register heap objects created with new
 static NESAPUEmulator g_nesAPU_obj;      // Stack object - constructor runs at startup, registers on update list
@@ -87,6 +110,7 @@ AudioStreamSPC* g_spcAudioStream = &g_spc_obj;  // Pointer to stack object for A
 static AudioStreamDACPrerender g_dacPrerenderStream_obj;  // Stack object - constructor runs at startup
 AudioStreamDACPrerender* g_dacPrerenderStream = &g_dacPrerenderStream_obj;  // Pointer for API compatibility
 DACPrerenderer* g_dacPrerenderer = nullptr;  // Pre-renderer (heap allocated in setup)
+DACPrerenderCache* g_dacPrerenderCache = nullptr;  // Cache of renders on SD (heap allocated in setup)
 
 // FM9 WAV player (embedded audio from FM9 extended VGM files)
 // Uses custom AudioStream with sync support and PSRAM buffering
@@ -118,116 +142,169 @@ USBFilesystem g_myFS(g_myusb);
 AudioInputI2S            i2sIn;
 AudioAnalyzePeak         peakLeft;    // Monitor left input level
 AudioAnalyzePeak         peakRight;   // Monitor right input level
-AudioMixer4              mixerLeft;
-AudioMixer4              mixerRight;
-AudioMixer4              mixerChannel1Left;   // Submixer for channel 1 (NES APU + SPC + GB APU)
-AudioMixer4              mixerChannel1Right;  // Submixer for channel 1 (NES APU + SPC + GB APU)
-AudioMixer4              dacNesMixerLeft;     // Pre-mixer for DAC Prerender + NES APU (fixes channel conflict)
-AudioMixer4              dacNesMixerRight;    // Pre-mixer for DAC Prerender + NES APU (fixes channel conflict)
-// Reverb removed to save ~50KB RAM (AudioEffectFreeverb uses 25KB each)
-// AudioEffectFreeverb      reverbLeft;
-// AudioEffectFreeverb      reverbRight;
-AudioMixer4              finalMixerLeft;   // Now just passes through (reverb removed)
-AudioMixer4              finalMixerRight;  // Now just passes through (reverb removed)
-AudioMixer4              fadeMixerLeft;    // Final fade stage (affects both Bluetooth and line-out)
-AudioMixer4              fadeMixerRight;   // Final fade stage (affects both Bluetooth and line-out)
+// Output mixing stages - gain-only, all summed in one AudioMixerFused (see audio_mixer_fused.h)
+// Channel numbers are unchanged from the old AudioMixer4 chain so players keep their gain() calls
+AudioMixerStage          mixerLeft;
+AudioMixerStage          mixerRight;
+AudioMixerStage          mixerChannel1Left;   // Submixer for channel 1 (NES APU + SPC + GB APU)
+AudioMixerStage          mixerChannel1Right;  // Submixer for channel 1 (NES APU + SPC + GB APU)
+AudioMixerStage          dacNesMixerLeft;     // Pre-mixer for DAC Prerender + NES APU (fixes channel conflict)
+AudioMixerStage          dacNesMixerRight;    // Pre-mixer for DAC Prerender + NES APU (fixes channel conflict)
+AudioEffectReverbPSRAM   midiReverb;       // MIDI reverb, delay lines in PSRAM (before outputMixer so its wet block is current)
+AudioMixerStage          finalMixerLeft;   // Dry (ch0) / reverb wet (ch1) blend
+AudioMixerStage          finalMixerRight;  // Dry (ch0) / reverb wet (ch1) blend
+AudioMixerStage          fadeMixerLeft;    // Final fade stage (affects both Bluetooth and line-out)
+AudioMixerStage          fadeMixerRight;   // Final fade stage (affects both Bluetooth and line-out)
+AudioMixerStage          fm9AudioMixerLeft;   // FM9 audio pre-mixer (WAV ch0, MP3 ch1)
+AudioMixerStage          fm9AudioMixerRight;  // FM9 audio pre-mixer (WAV ch0, MP3 ch1)
+AudioMixerFused          outputMixer;      // Constructed after every source so all inputs are current
 AudioOutputI2S           i2sOut;
+AudioAnalyzeVisualizer   mixVisualizer;    // Spectrum/scope tap on the final mix (Now Playing screen)
+AudioRecordMix           mixRecorder;      // Records the final mix (incl. line-in OPL3/Genesis) to WAV
+AudioAnalyzeLoudness     loudnessMeter;    // Measures tracks missing from the loudness index
 AudioControlSGTL5000     audioShield;
 
+// ========== Output Mixer Architecture ==========
+// Every source connects straight to outputMixer; the stages above only hold gains.
+// outputMixer multiplies each input once by the product of the stage gains along
+// its old path (set up in setupOutputMixerRoutes()).
+//
+// Stage paths (left shown, right mirrors with the *Right stages):
+//   OPL3 line-in ───────────────────────────────────────→ mixer ch0 ─→ final ch0 ─→ fade ch0
+//   OPL3 opposite side (crossfeed) ─────────────────────→ mixer ch3 ─→ final ch0 ─→ fade ch0
+//   Drum sampler ───────────────────────────────────────→ mixer ch2 ─→ final ch0 ─→ fade ch0
+//   DAC Prerender ──────────────→ dacNes ch0 ─→ ch1 ch0 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   NES APU ────────────────────→ dacNes ch1 ─→ ch1 ch0 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   FM9 WAV ───→ fm9 ch0 ───────→ dacNes ch3 ─→ ch1 ch0 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   FM9 MP3 ───→ fm9 ch1 ───────→ dacNes ch3 ─→ ch1 ch0 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   SPC ────────────────────────────────────→ ch1 ch1 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   GB APU ─────────────────────────────────→ ch1 ch2 ─→ mixer ch1 ─→ final ch0 ─→ fade ch0
+//   Reverb wet (send: OPL3 line-in + drums) ────────────────────────→ final ch1 ─→ fade ch0
+//
+// Gain control: Players mute/unmute their stage channels exactly as before
+
+// outputMixer input ports (left = even, right = odd)
+enum OutputMixerPort : uint8_t {
+  PORT_OPL3_LEFT = 0,  PORT_OPL3_RIGHT = 1,
+  PORT_DRUMS_LEFT = 2, PORT_DRUMS_RIGHT = 3,
+  PORT_DAC_LEFT = 4,   PORT_DAC_RIGHT = 5,
+  PORT_NES_LEFT = 6,   PORT_NES_RIGHT = 7,
+  PORT_FM9_WAV_LEFT = 8, PORT_FM9_WAV_RIGHT = 9,
+  PORT_FM9_MP3_LEFT = 10, PORT_FM9_MP3_RIGHT = 11,
+  PORT_SPC_LEFT = 12,  PORT_SPC_RIGHT = 13,
+  PORT_GB_LEFT = 14,   PORT_GB_RIGHT = 15,
+  PORT_REVERB_LEFT = 16, PORT_REVERB_RIGHT = 17
+};
+
 // Audio connections - These MUST remain global for the audio library
-AudioConnection          patchCord1(i2sIn, 0, mixerLeft, 0);   // OPL3 left → mixerLeft ch0 (main)
-AudioConnection          patchCord2(i2sIn, 1, mixerRight, 0);  // OPL3 right → mixerRight ch0 (main)
+AudioConnection          patchCord1(i2sIn, 0, outputMixer, PORT_OPL3_LEFT);
+AudioConnection          patchCord2(i2sIn, 1, outputMixer, PORT_OPL3_RIGHT);
 AudioConnection          patchCordPeakL(i2sIn, 0, peakLeft, 0);   // Monitor left input
 AudioConnection          patchCordPeakR(i2sIn, 1, peakRight, 0);  // Monitor right input
+AudioConnection          patchCordReverbInL(i2sIn, 0, midiReverb, 0);  // Reverb send (line-in)
+AudioConnection          patchCordReverbInR(i2sIn, 1, midiReverb, 1);
+AudioConnection          patchCordReverbL(midiReverb, 0, outputMixer, PORT_REVERB_LEFT);
+AudioConnection          patchCordReverbR(midiReverb, 1, outputMixer, PORT_REVERB_RIGHT);
 // Connections to drum sampler will be created after initialization
 AudioConnection*         patchCordDrumLeft = nullptr;
 AudioConnection*         patchCordDrumRight = nullptr;
+AudioConnection*         patchCordDrumReverbLeft = nullptr;   // Reverb send (drums)
+AudioConnection*         patchCordDrumReverbRight = nullptr;
 
-// ========== DAC/NES Pre-mixer Architecture ==========
-// DAC Prerender and NES APU were previously both connected to submixer channel 0.
-// In Teensy Audio Library, multiple sources to same mixer input = ONLY last one works!
-// Fix: Route through a dedicated pre-mixer (dacNesMixer), then to submixer channel 0.
-//
-// Signal flow:
-//   DAC Prerender ──→ dacNesMixer ch0 ──┐
-//   NES APU ────────→ dacNesMixer ch1 ──┼──→ mixerChannel1 ch0 ──→ main mixer
-//   (ch2 unused)      dacNesMixer ch2 ──┤
-//   FM9 Audio ──────→ dacNesMixer ch3 ──┘
-//
-// Gain control: Players mute/unmute their respective dacNesMixer channels
-
-// DAC Pre-render Stream (Genesis VGM PCM) → dacNesMixer channel 0
-static AudioConnection   patchCordDACPrerenderLeft_obj(g_dacPrerenderStream_obj, 0, dacNesMixerLeft, 0);
-static AudioConnection   patchCordDACPrerenderRight_obj(g_dacPrerenderStream_obj, 1, dacNesMixerRight, 0);
+// DAC Pre-render Stream (Genesis VGM PCM)
+static AudioConnection   patchCordDACPrerenderLeft_obj(g_dacPrerenderStream_obj, 0, outputMixer, PORT_DAC_LEFT);
+static AudioConnection   patchCordDACPrerenderRight_obj(g_dacPrerenderStream_obj, 1, outputMixer, PORT_DAC_RIGHT);
 AudioConnection*         patchCordDACPrerenderLeft = &patchCordDACPrerenderLeft_obj;
 AudioConnection*         patchCordDACPrerenderRight = &patchCordDACPrerenderRight_obj;
 
-// NES APU → dacNesMixer channel 1
-static AudioConnection   patchCordNESAPULeft_obj(g_nesAPU_obj, 0, dacNesMixerLeft, 1);
-static AudioConnection   patchCordNESAPURight_obj(g_nesAPU_obj, 1, dacNesMixerRight, 1);
+// NES APU
+static AudioConnection   patchCordNESAPULeft_obj(g_nesAPU_obj, 0, outputMixer, PORT_NES_LEFT);
+static AudioConnection   patchCordNESAPURight_obj(g_nesAPU_obj, 1, outputMixer, PORT_NES_RIGHT);
 AudioConnection*         patchCordNESAPULeft = &patchCordNESAPULeft_obj;
 AudioConnection*         patchCordNESAPURight = &patchCordNESAPURight_obj;
 
-// ========== FM9 Audio Pre-mixer ==========
-// FM9 files can have WAV or MP3 embedded audio (mutually exclusive)
-// We need a small pre-mixer to combine these before feeding into dacNesMixer channel 3
-// This avoids the "multiple connections to same channel" issue in Teensy Audio Library
-AudioMixer4              fm9AudioMixerLeft;   // FM9 audio pre-mixer (WAV ch0, MP3 ch1)
-AudioMixer4              fm9AudioMixerRight;  // FM9 audio pre-mixer (WAV ch0, MP3 ch1)
-
-// FM9 WAV → fm9AudioMixer channel 0
-static AudioConnection   patchCordFM9WavLeft_obj(g_fm9WavStream_obj, 0, fm9AudioMixerLeft, 0);
-static AudioConnection   patchCordFM9WavRight_obj(g_fm9WavStream_obj, 1, fm9AudioMixerRight, 0);
+// FM9 WAV / MP3 embedded audio (mutually exclusive, gated by fm9AudioMixer ch0/ch1)
+static AudioConnection   patchCordFM9WavLeft_obj(g_fm9WavStream_obj, 0, outputMixer, PORT_FM9_WAV_LEFT);
+static AudioConnection   patchCordFM9WavRight_obj(g_fm9WavStream_obj, 1, outputMixer, PORT_FM9_WAV_RIGHT);
 AudioConnection*         patchCordFM9WavLeft = &patchCordFM9WavLeft_obj;
 AudioConnection*         patchCordFM9WavRight = &patchCordFM9WavRight_obj;
 
-// FM9 MP3 → fm9AudioMixer channel 1
-static AudioConnection   patchCordFM9Mp3Left_obj(g_fm9Mp3Stream_obj, 0, fm9AudioMixerLeft, 1);
-static AudioConnection   patchCordFM9Mp3Right_obj(g_fm9Mp3Stream_obj, 1, fm9AudioMixerRight, 1);
+static AudioConnection   patchCordFM9Mp3Left_obj(g_fm9Mp3Stream_obj, 0, outputMixer, PORT_FM9_MP3_LEFT);
+static AudioConnection   patchCordFM9Mp3Right_obj(g_fm9Mp3Stream_obj, 1, outputMixer, PORT_FM9_MP3_RIGHT);
 AudioConnection*         patchCordFM9Mp3Left = &patchCordFM9Mp3Left_obj;
 AudioConnection*         patchCordFM9Mp3Right = &patchCordFM9Mp3Right_obj;
 
-// FM9 pre-mixer output → dacNesMixer channel 3
-static AudioConnection   patchCordFM9MixLeft_obj(fm9AudioMixerLeft, 0, dacNesMixerLeft, 3);
-static AudioConnection   patchCordFM9MixRight_obj(fm9AudioMixerRight, 0, dacNesMixerRight, 3);
-
-// DAC/NES Pre-mixer output → submixer channel 0
-static AudioConnection   patchCordDacNesMixLeft_obj(dacNesMixerLeft, 0, mixerChannel1Left, 0);
-static AudioConnection   patchCordDacNesMixRight_obj(dacNesMixerRight, 0, mixerChannel1Right, 0);
-
-// SPC → submixer channel 1
-static AudioConnection   patchCordSPCLeft_obj(g_spc_obj, 0, mixerChannel1Left, 1);
-static AudioConnection   patchCordSPCRight_obj(g_spc_obj, 1, mixerChannel1Right, 1);
+// SPC
+static AudioConnection   patchCordSPCLeft_obj(g_spc_obj, 0, outputMixer, PORT_SPC_LEFT);
+static AudioConnection   patchCordSPCRight_obj(g_spc_obj, 1, outputMixer, PORT_SPC_RIGHT);
 AudioConnection*         patchCordSPCLeft = &patchCordSPCLeft_obj;
 AudioConnection*         patchCordSPCRight = &patchCordSPCRight_obj;
 
-// GB APU → submixer channel 2
-static AudioConnection   patchCordGBAPULeft_obj(g_gbAPU_obj, 0, mixerChannel1Left, 2);
-static AudioConnection   patchCordGBAPURight_obj(g_gbAPU_obj, 1, mixerChannel1Right, 2);
+// GB APU
+static AudioConnection   patchCordGBAPULeft_obj(g_gbAPU_obj, 0, outputMixer, PORT_GB_LEFT);
+static AudioConnection   patchCordGBAPURight_obj(g_gbAPU_obj, 1, outputMixer, PORT_GB_RIGHT);
 AudioConnection*         patchCordGBAPULeft = &patchCordGBAPULeft_obj;
 AudioConnection*         patchCordGBAPURight = &patchCordGBAPURight_obj;
 
-// Submixer output → main mixer channel 1
-AudioConnection          patchCordSubmixL(mixerChannel1Left, 0, mixerLeft, 1);
-AudioConnection          patchCordSubmixR(mixerChannel1Right, 0, mixerRight, 1);
-
-// Crossfeed connections for softer stereo panning (MIDI only) - back on channel 3
-AudioConnection          patchCordCrossfeedL(i2sIn, 1, mixerLeft, 3);   // OPL3 right → mixerLeft ch3 (crossfeed)
-AudioConnection          patchCordCrossfeedR(i2sIn, 0, mixerRight, 3);  // OPL3 left → mixerRight ch3 (crossfeed)
-// Dry signal path (direct) - goes straight to final mixer (reverb removed)
-AudioConnection          patchCord5(mixerLeft, 0, finalMixerLeft, 0);
-AudioConnection          patchCord6(mixerRight, 0, finalMixerRight, 0);
-// Reverb removed to save ~50KB RAM (AudioEffectFreeverb uses 25KB each)
-// AudioConnection          patchCord7(mixerLeft, 0, reverbLeft, 0);
-// AudioConnection          patchCord8(mixerRight, 0, reverbRight, 0);
-// AudioConnection          patchCord9(reverbLeft, 0, finalMixerLeft, 1);
-// AudioConnection          patchCord10(reverbRight, 0, finalMixerRight, 1);
-// Fade stage (for VGM loop fadeout - affects both Bluetooth and line-out)
-AudioConnection          patchCord11(finalMixerLeft, 0, fadeMixerLeft, 0);
-AudioConnection          patchCord12(finalMixerRight, 0, fadeMixerRight, 0);
-// Final output
-AudioConnection          patchCord13(fadeMixerLeft, 0, i2sOut, 0);
-AudioConnection          patchCord14(fadeMixerRight, 0, i2sOut, 1);
+// Final output (fade stage is the last hop of every route - affects both Bluetooth and line-out)
+AudioConnection          patchCord13(outputMixer, 0, i2sOut, 0);
+AudioConnection          patchCord14(outputMixer, 1, i2sOut, 1);
+AudioConnection          patchCordVizL(outputMixer, 0, mixVisualizer, 0);
+AudioConnection          patchCordVizR(outputMixer, 1, mixVisualizer, 1);
+AudioConnection          patchCordRecL(outputMixer, 0, mixRecorder, 0);
+AudioConnection          patchCordRecR(outputMixer, 1, mixRecorder, 1);
+AudioConnection          patchCordLoudL(outputMixer, 0, loudnessMeter, 0);
+AudioConnection          patchCordLoudR(outputMixer, 1, loudnessMeter, 1);
+
+/**
+ * @brief Declare the stage chain each outputMixer input passes through
+ *
+ * Mirrors the AudioMixer4 cascade this replaced, so every gain() call a player
+ * makes has the same effect it always had.
+ */
+static void setupOutputMixerRoutes() {
+  typedef AudioMixerFused::Hop Hop;
+
+  // OPL3 line-in, direct and crossfeed (crossfeed gain lives on mixer ch3)
+  outputMixer.route(PORT_OPL3_LEFT, 0, {Hop{&mixerLeft, 0}, Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_OPL3_RIGHT, 1, {Hop{&mixerRight, 0}, Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_OPL3_RIGHT, 0, {Hop{&mixerLeft, 3}, Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_OPL3_LEFT, 1, {Hop{&mixerRight, 3}, Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+
+  // Drum sampler (connected later, only if it initializes)
+  outputMixer.route(PORT_DRUMS_LEFT, 0, {Hop{&mixerLeft, 2}, Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_DRUMS_RIGHT, 1, {Hop{&mixerRight, 2}, Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+
+  // Channel 1 submixer sources
+  outputMixer.route(PORT_DAC_LEFT, 0, {Hop{&dacNesMixerLeft, 0}, Hop{&mixerChannel1Left, 0}, Hop{&mixerLeft, 1},
+                                       Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_DAC_RIGHT, 1, {Hop{&dacNesMixerRight, 0}, Hop{&mixerChannel1Right, 0}, Hop{&mixerRight, 1},
+                                        Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_NES_LEFT, 0, {Hop{&dacNesMixerLeft, 1}, Hop{&mixerChannel1Left, 0}, Hop{&mixerLeft, 1},
+                                       Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_NES_RIGHT, 1, {Hop{&dacNesMixerRight, 1}, Hop{&mixerChannel1Right, 0}, Hop{&mixerRight, 1},
+                                        Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_FM9_WAV_LEFT, 0, {Hop{&fm9AudioMixerLeft, 0}, Hop{&dacNesMixerLeft, 3}, Hop{&mixerChannel1Left, 0},
+                                           Hop{&mixerLeft, 1}, Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_FM9_WAV_RIGHT, 1, {Hop{&fm9AudioMixerRight, 0}, Hop{&dacNesMixerRight, 3}, Hop{&mixerChannel1Right, 0},
+                                            Hop{&mixerRight, 1}, Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_FM9_MP3_LEFT, 0, {Hop{&fm9AudioMixerLeft, 1}, Hop{&dacNesMixerLeft, 3}, Hop{&mixerChannel1Left, 0},
+                                           Hop{&mixerLeft, 1}, Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_FM9_MP3_RIGHT, 1, {Hop{&fm9AudioMixerRight, 1}, Hop{&dacNesMixerRight, 3}, Hop{&mixerChannel1Right, 0},
+                                            Hop{&mixerRight, 1}, Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_SPC_LEFT, 0, {Hop{&mixerChannel1Left, 1}, Hop{&mixerLeft, 1},
+                                       Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_SPC_RIGHT, 1, {Hop{&mixerChannel1Right, 1}, Hop{&mixerRight, 1},
+                                        Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+  outputMixer.route(PORT_GB_LEFT, 0, {Hop{&mixerChannel1Left, 2}, Hop{&mixerLeft, 1},
+                                      Hop{&finalMixerLeft, 0}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_GB_RIGHT, 1, {Hop{&mixerChannel1Right, 2}, Hop{&mixerRight, 1},
+                                       Hop{&finalMixerRight, 0}, Hop{&fadeMixerRight, 0}});
+
+  // Reverb wet return (final ch1, where the Freeverb return used to be)
+  outputMixer.route(PORT_REVERB_LEFT, 0, {Hop{&finalMixerLeft, 1}, Hop{&fadeMixerLeft, 0}});
+  outputMixer.route(PORT_REVERB_RIGHT, 1, {Hop{&finalMixerRight, 1}, Hop{&fadeMixerRight, 0}});
+}
 
 /**
  * @brief Test function for direct Genesis hardware validation
@@ -251,8 +328,8 @@ void testGenesisTone() {
   // Genesis board outputs analog audio that must be mixed with OPL3
   // The Teensy Audio Board (SGTL5000) needs line input enabled to hear it
   extern AudioControlSGTL5000 audioShield;
-  extern AudioMixer4 fadeMixerLeft;
-  extern AudioMixer4 fadeMixerRight;
+  extern AudioMixerStage fadeMixerLeft;
+  extern AudioMixerStage fadeMixerRight;
 
   audioShield.inputSelect(AUDIO_INPUT_LINEIN);  // Switch from MIC to LINE IN FIRST
   audioShield.lineInLevel(0);  // 0-15 (0=minimum gain/quietest, 15=maximum gain/loudest), set AFTER selecting input
@@ -380,6 +457,9 @@ void testGenesisTone() {
 }
 
 void setup() {
+  // Adopt (or clear) the trace ring before anything can TRACE()
+  TraceLog::begin();
+
   // ========================================
   // Initialize all hardware using HardwareInitializer
   // ========================================
@@ -424,6 +504,28 @@ void setup() {
     }
   }
 
+  // Last boot ended in a fault: save the trace ring from before it while it's intact
+  if (CrashReport && TraceLog::hasPreviousSession()) {
+    TraceLog::dumpToSD("/FM90S/CRASH.TRC");
+  }
+
+  // ========================================
+  // Restore persisted settings (SD is up, nothing has read the g_ settings yet)
+  // ========================================
+  g_resumeJournal = new ResumeJournal();
+  if (g_resumeJournal->begin()) {
+    g_resumeJournal->applySettings();
+  }
+
+  // Per-track loudness records (gain is applied once PlayerManager exists)
+  g_loudnessIndex = new LoudnessIndex();
+  g_loudnessIndex->begin();
+  g_loudnessIndex->setEnabled(g_loudnessNormalizeEnabled);
+
+  // FM9 cover thumbnails (extracted in the background by the file browser)
+  g_coverArtCache = new CoverArtCache();
+  g_coverArtCache->begin();
+
   // Note: ScreenManager initialization deferred until after all dependencies created
 
   // ========================================
@@ -474,9 +576,15 @@ void setup() {
   // Initialize audio system
   // ========================================
   // Allocate audio memory (starts the Audio Library update system)
-  // 8 drum voices × ~4 buffers + overhead = 60 blocks
+  // 8 drum voices × ~4 buffers + overhead. The fused output mixer holds fewer
+  // blocks than the old AudioMixer4 cascade, but reverb, recorder, loudness
+  // meter and visualizer taps hold their own - keep 60 until AudioMemoryUsageMax()
+  // has been measured with all of them on (AudioMixerFused::printStats())
   AudioMemory(60);
 
+  // Declare the stage chain behind each outputMixer input (stage gains set before this are kept)
+  setupOutputMixerRoutes();
+
   AudioSystem::Config audioConfig;
   audioConfig.masterVolume = 0.7f;
   audioConfig.opl3Gain = 0.8f;
@@ -487,13 +595,19 @@ void setup() {
   audioConfig.enableCrossfeed = false;  // Hardware starts OFF
   audioConfig.enableReverb = false;     // Hardware starts OFF
 
-  // Reverb removed to save ~50KB RAM - simplified AudioSystem::initialize call
+  // Reverb delay lines live in PSRAM - without it the reverb just stays off
+  midiReverb.begin();
+
+  // Loudness meter block queue (PSRAM, heap fallback) - idle until a track needs measuring
+  loudnessMeter.begin();
+
   AudioSystem::initialize(
     audioConfig,
     audioShield,
     mixerLeft, mixerRight,
     finalMixerLeft, finalMixerRight,
-    fadeMixerLeft, fadeMixerRight
+    fadeMixerLeft, fadeMixerRight,
+    midiReverb
   );
 
   // ========================================
@@ -508,10 +622,12 @@ void setup() {
     g_drumSampler->setEnabled(true);
 
     if (g_drumSampler->begin()) {
-      // Create audio connections: drum sampler (stereo) -> mixerLeft and mixerRight
-      // Drum sampler outputs go to mixer channel 2 (0=OPL3, 1=FM90S, 2=Drums)
-      patchCordDrumLeft = new AudioConnection(g_drumSampler->getOutputLeft(), 0, mixerLeft, 2);
-      patchCordDrumRight = new AudioConnection(g_drumSampler->getOutputRight(), 0, mixerRight, 2);
+      // Create audio connections: drum sampler (stereo) -> outputMixer drum ports
+      // Drum gain is mixer stage channel 2 (0=OPL3, 1=FM90S, 2=Drums)
+      patchCordDrumLeft = new AudioConnection(g_drumSampler->getOutputLeft(), 0, outputMixer, PORT_DRUMS_LEFT);
+      patchCordDrumRight = new AudioConnection(g_drumSampler->getOutputRight(), 0, outputMixer, PORT_DRUMS_RIGHT);
+      patchCordDrumReverbLeft = new AudioConnection(g_drumSampler->getOutputLeft(), 0, midiReverb, 2);
+      patchCordDrumReverbRight = new AudioConnection(g_drumSampler->getOutputRight(), 0, midiReverb, 3);
 
       // Set drum mixer gain (adjust to balance with OPL3)
       mixerLeft.gain(2, 0.40f);   // Drums at 40%
@@ -607,6 +723,10 @@ void setup() {
   // real-time emulation cannot handle (e.g., streaming PCM at 44.1 kHz rate).
   g_dacPrerenderer = new DACPrerenderer();
 
+  // Renders are kept on SD keyed by VGM content, so a repeat play skips pre-rendering
+  g_dacPrerenderCache = new DACPrerenderCache();
+  g_dacPrerenderCache->begin();
+
   // DAC prerender stream connections already created as static objects
   // Connected to submixer channel 0 (shares with NES APU - only one plays at a time)
   // Start muted, VGMPlayer will unmute when Genesis VGM with DAC plays
@@ -675,6 +795,7 @@ void setup() {
   playerConfig.gbAPU = g_gbAPU;    // Global Game Boy APU emulator (stays alive)
   playerConfig.genesisBoard = g_genesisBoard;  // Genesis synthesizer board (YM2612 + SN76489)
   playerConfig.dacPrerenderer = g_dacPrerenderer;  // DAC pre-renderer for Genesis VGM PCM playback
+  playerConfig.dacPrerenderCache = g_dacPrerenderCache;  // Cached renders from earlier plays
   playerConfig.dacPrerenderStream = g_dacPrerenderStream;  // Pre-rendered DAC playback stream
   playerConfig.spcAudioStream = g_spcAudioStream;  // Global SPC audio stream (stays alive)
   playerConfig.mixerLeft = &mixerLeft;
@@ -689,11 +810,9 @@ void setup() {
   playerConfig.finalMixerRight = &finalMixerRight;
   playerConfig.fadeMixerLeft = &fadeMixerLeft;
   playerConfig.fadeMixerRight = &fadeMixerRight;
-  // Reverb removed to save ~50KB RAM
-  playerConfig.reverbLeft = nullptr;
-  playerConfig.reverbRight = nullptr;
+  playerConfig.reverb = midiReverb.isAvailable() ? &midiReverb : nullptr;
   playerConfig.crossfeedEnabled = g_crossfeedEnabled;
-  playerConfig.reverbEnabled = false;  // Reverb removed
+  playerConfig.reverbEnabled = g_reverbEnabled;
 
   g_playerManager = new PlayerManager(playerConfig);
 
@@ -768,11 +887,16 @@ void setup() {
   screenContext->floppy = g_floppy;
 
   // ========================================
-  // Initialize LCDManager (Time-sliced LCD updates - ZERO blocking!)
+  // Initialize LCDManager (background I2C queue - ZERO blocking!)
   // ========================================
   g_lcdManager = new LCDManager(lcd);
   screenContext->lcdManager = g_lcdManager;
-  Serial.println("[LCDManager] Initialized with time-sliced updates (1 char per iteration, 3ms spacing)");
+  Serial.println("[LCDManager] Initialized with shadow diffing + interrupt-driven I2C queue");
+
+  // Buttons: MCP23017 INTA jumpered to pin 33 (falls back to polling if absent)
+  g_buttonInput = new ButtonInput(g_lcdManager);
+  g_buttonInput->begin(33);
+  screenContext->buttonInput = g_buttonInput;
 
   // Create ScreenManager and assign it to context (circular reference)
   g_screenManager = ScreenManager::getInstance();
@@ -810,6 +934,28 @@ void setup() {
 
   // // Serial.println("[Main] PlayerManager natural completion callback wired to PlaybackCoordinator");
 
+  // ========================================
+  // Resume the track that was playing at power-off
+  // ========================================
+  g_loudnessIndex->attach(g_playerManager, &outputMixer, &fadeMixerLeft, &loudnessMeter);
+  g_resumeJournal->attach(g_playerManager, g_coordinator, g_queueManager, g_eventManager, g_fileSource);
+  g_resumeJournal->resumePlayback();
+
+  // Watch audio ISR load and main-loop slack from here on
+  g_loadShedder = new LoadShedder();
+  g_loadShedder->begin();
+
+  // Clock scaling, driven by the load shedder's windows
+  g_cpuGovernor = new CpuGovernor();
+  g_cpuGovernor->begin();
+  g_cpuGovernor->setEnabled(g_cpuGovernorEnabled);
+#if DEBUG_CPU_GOVERNOR_STRESS
+  g_cpuGovernor->startStressTest(60000);
+#endif
+#if DEBUG_LOAD_SHEDDER_STRESS
+  g_loadShedder->startStressTest();
+#endif
+
   // Create menu system (legacy serial interface)
   // TODO Phase 6: MenuSystem still references individual players - will be updated or removed
   // menu = new MenuSystem(g_midiPlayer, g_vgmPlayer, g_droPlayer, g_imfPlayer, g_radPlayer, g_spcPlayer,
@@ -827,10 +973,8 @@ void loop() {
     lastSPCCheck = now;
     spcCheckCount++;
     if (g_spcAudioStream) {
-      Serial.printf("[Main] SPC AudioStream diagnostics after %d seconds:\n", spcCheckCount);
-      Serial.printf("  - updateCount: %lu\n", g_spcAudioStream->getUpdateCount());
-      Serial.printf("  - ticks (volatile): %lu\n", g_spcAudioStream->getTicks());
-      Serial.printf("  - Expected ~344 ticks/sec if update() is being called\n");
+      TRACE("[Main] SPC AudioStream after %d s: updateCount=%lu ticks=%lu (expect ~344 ticks/sec)",
+            spcCheckCount, g_spcAudioStream->getUpdateCount(), g_spcAudioStream->getTicks());
     }
   }
 
@@ -856,6 +1000,15 @@ void loop() {
     }
   }
 
+#if DEBUG_SERIAL_ENABLED && DEBUG_AUDIO_SYSTEM
+  // Output mixer / audio graph ISR load (AudioProcessorUsageMax before/after figures)
+  static unsigned long lastMixerStats = 0;
+  if (now - lastMixerStats > 10000) {
+    lastMixerStats = now;
+    outputMixer.printStats();
+  }
+#endif
+
   // Update playback (player updates, progress tracking, completion detection)
   // PlayerManager handles:
   // - Calling player->update()
@@ -879,6 +1032,27 @@ void loop() {
     g_dacPrerenderStream->refillBuffer();
   }
 
+  // Drain the final-mix recorder's block queue to SD (no-op unless recording)
+  mixRecorder.service();
+
+  // Checkpoint settings/track/position to the SD journal (throttled internally)
+  if (g_resumeJournal) {
+    g_resumeJournal->update();
+  }
+
+  // Apply indexed track gain; measure unindexed tracks in the background
+  if (g_loudnessIndex) {
+    g_loudnessIndex->update();
+  }
+
+  // Measure ISR load / loop slack; shed or restore optional work
+  if (g_loadShedder) {
+    g_loadShedder->update();
+  }
+  if (g_cpuGovernor) {
+    g_cpuGovernor->update();
+  }
+
   // Update USB drive manager (hot-plug detection)
   // Calls myusb.Task() and fires callbacks when drive connects/disconnects
   if (g_usbDrive) {
@@ -895,12 +1069,21 @@ void loop() {
     g_screenManager->update();
   }
 
+  // Continue the TFT command list where the DMA interrupt left it for the
+  // main loop (busy-flag polls, completion callbacks, non-DMA fallback)
+  if (displayManager && displayManager->isInitialized()) {
+    displayManager->getTFT()->service();
+  }
+
   // Update LCD manager (smart LCD updates with throttling and dirty checking)
   // Call this AFTER screen manager update() so screens can set LCD content
   if (g_lcdManager) {
     g_lcdManager->update();
   }
 
+  // Format pending TRACE() records now that this iteration's work is done
+  TraceLog::drain();
+
   // Serial menu system removed - GUI only now
 
   // Yield to background tasks (non-blocking, allows USB enumeration, etc.)
@@ -7,15 +7,29 @@ enum class MidiEventType : uint8_t {
   ChannelPressure, PitchBend, MetaTempo, EndOfTrack, Unknown
 };
 
-// A decoded MIDI event with absolute tick time
+// A decoded MIDI event with absolute tick time, packed into 8 bytes so the
+// track buffers stay small and events copy as a single register pair.
+// The type says what the two data bytes hold:
+//   NoteOn, NoteOff                   key, velocity
+//   ControlChange                     value1 = CC number, value2 = CC value
+//   ProgramChange, ChannelPressure    value1
+//   PitchBend                         the 14-bit LSB/MSB pair - use pitchBend()
+//   MetaTempo                         24 bits across channel and both data bytes - use tempoUSQ()
 struct MidiEvent {
   uint32_t tick = 0;
   MidiEventType type = MidiEventType::Unknown;
   uint8_t  channel = 0;
-  uint8_t  key = 0;         // note number for note events
-  uint8_t  velocity = 0;    // velocity for note on/off
-  uint8_t  value1 = 0;      // CC number, Program #, Channel Pressure
-  uint8_t  value2 = 0;      // CC value
-  int16_t  pitchBend = 0;   // -8192..8191
-  uint32_t tempoUSQ = 500000; // for MetaTempo
-};
\ No newline at end of file
+  union { uint8_t key = 0;      uint8_t value1; };
+  union { uint8_t velocity = 0; uint8_t value2; };
+
+  int16_t pitchBend() const { return (int16_t)(((value2 & 0x7F) << 7) | (value1 & 0x7F)) - 8192; }  // -8192..8191
+
+  uint32_t tempoUSQ() const { return ((uint32_t)channel << 16) | ((uint32_t)value1 << 8) | value2; }
+  void setTempoUSQ(uint32_t usq) {
+    channel = (uint8_t)(usq >> 16);
+    value1 = (uint8_t)(usq >> 8);
+    value2 = (uint8_t)usq;
+  }
+};
+
+static_assert(sizeof(MidiEvent) == 8, "MidiEvent must stay packed");
@@ -17,8 +17,7 @@ MidiPlayer::MidiPlayer(const PlayerConfig& config)
   , fadeMixerRight_(config.fadeMixerRight)
   , finalMixerLeft_(config.finalMixerLeft)
   , finalMixerRight_(config.finalMixerRight)
-  , reverbLeft_(config.reverbLeft)
-  , reverbRight_(config.reverbRight)
+  , reverb_(config.reverb)
   , crossfeedEnabled_(config.crossfeedEnabled)
   , reverbEnabled_(config.reverbEnabled)
   , state_(PlayerState::IDLE)
@@ -323,7 +322,7 @@ void MidiPlayer::dispatchEvent(const MidiEvent& ev) {
       break;
     case MidiEventType::PitchBend:
       if (!useDrumSampler) {
-        synth_->pitchBend(ev.channel, ev.pitchBend);
+        synth_->pitchBend(ev.channel, ev.pitchBend());
       }
       break;
     case MidiEventType::ControlChange:
@@ -333,7 +332,7 @@ void MidiPlayer::dispatchEvent(const MidiEvent& ev) {
       break;
     case MidiEventType::MetaTempo:
       // Update µs/tick and reconfigure timer
-      midi_.applyTempoChange(ev.tempoUSQ);
+      midi_.applyTempoChange(ev.tempoUSQ());
       updateTickTimer(midi_.usPerTick());
       break;
     case MidiEventType::EndOfTrack:
@@ -494,6 +493,60 @@ uint32_t MidiPlayer::getDurationMs() const {
   return (uint32_t)(getDuration() * 1000.0f);
 }
 
+bool MidiPlayer::seekToMs(uint32_t positionMs) {
+  if (state_ != PlayerState::PLAYING && state_ != PlayerState::PAUSED) {
+    return false;
+  }
+
+  bool wasPlaying = (state_ == PlayerState::PLAYING);
+  if (wasPlaying) {
+    stopTickTimer();
+  }
+  synth_->allNotesOff();
+
+  uint32_t seekStart = micros();
+  uint32_t chased = 0;
+
+  // Chase: apply every event except notes so programs, controllers, pitch bends
+  // and tempo are what they would be at the target. Position uses the same
+  // ticks x current tempo estimate as getPositionMs().
+  MidiEvent ev;
+  while (midi_.peekEvent(ev)) {
+    uint32_t eventMs = (uint32_t)(((uint64_t)ev.tick * midi_.usPerTick()) / 1000ULL);
+    if (eventMs >= positionMs) {
+      break;
+    }
+    midi_.popEvent(ev);
+    eventCount_++;
+    chased++;
+
+    if (ev.tick > estimatedTotalTicks_) {
+      estimatedTotalTicks_ = ev.tick;
+    }
+    if (ev.type != MidiEventType::NoteOn && ev.type != MidiEventType::NoteOff) {
+      dispatchEvent(ev);
+    }
+    lastDispatchedTick_ = ev.tick;
+  }
+
+  uint32_t targetTick = (uint32_t)(((uint64_t)positionMs * 1000ULL) / midi_.usPerTick());
+  if (targetTick < lastDispatchedTick_) {
+    targetTick = lastDispatchedTick_;
+  }
+  noInterrupts();
+  tickCount_ = targetTick;
+  interrupts();
+  lastDispatchedTick_ = targetTick;
+
+  if (wasPlaying) {
+    startTickTimer(midi_.usPerTick());
+  }
+
+  Serial.printf("[MidiPlayer] Seek to %lu ms: chased %lu events in %lu us\n",
+                positionMs, chased, micros() - seekStart);
+  return true;
+}
+
 uint32_t MidiPlayer::getPositionMs() const {
   // Calculate position from current tick and tempo
   float durationSec = getDuration();
@@ -37,6 +37,7 @@ public:
 
   uint32_t getDurationMs() const override;
   uint32_t getPositionMs() const override;
+  bool seekToMs(uint32_t positionMs) override;
   float getProgress() const override;
 
   const char* getFileName() const override { return currentFileName_; }
@@ -85,14 +86,13 @@ private:
   OPL3Synth* synth_;
   FileSource* fileSource_;
   DrumSamplerV2* drumSampler_;
-  AudioMixer4* mixerLeft_;
-  AudioMixer4* mixerRight_;
-  AudioMixer4* fadeMixerLeft_;
-  AudioMixer4* fadeMixerRight_;
-  AudioMixer4* finalMixerLeft_;
-  AudioMixer4* finalMixerRight_;
-  AudioEffectFreeverb* reverbLeft_;
-  AudioEffectFreeverb* reverbRight_;
+  AudioMixerStage* mixerLeft_;
+  AudioMixerStage* mixerRight_;
+  AudioMixerStage* fadeMixerLeft_;
+  AudioMixerStage* fadeMixerRight_;
+  AudioMixerStage* finalMixerLeft_;
+  AudioMixerStage* finalMixerRight_;
+  AudioEffectReverbPSRAM* reverb_;
   bool crossfeedEnabled_;
   bool reverbEnabled_;
 
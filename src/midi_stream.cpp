@@ -5,12 +5,21 @@
 // ============================================================================
 
 TrackStream::TrackStream()
-  : trackStartPos_(0)
+  : data_(nullptr)
+  , trackStartPos_(0)
   , trackEndPos_(0)
   , currentFilePos_(0)
   , eof_(false)
+  , encoding_(ENCODING_SMF)
   , absoluteTick_(0)
   , runningStatus_(0)
+  , lastTick_(0)
+  , noteOffs_(nullptr)
+  , noteOffCount_(0)
+  , hasStaged_(false)
+  , stagedOffTick_(0)
+  , stagedHasOff_(false)
+  , loopDepth_(0)
   , bufferHead_(0)
   , bufferTail_(0)
   , bufferSize_(0)
@@ -21,9 +30,10 @@ TrackStream::~TrackStream() {
   if (file_) {
     file_.close();
   }
+  delete[] noteOffs_;
 }
 
-bool TrackStream::begin(File& file, uint32_t startPos, uint32_t length) {
+bool TrackStream::begin(File& file, uint32_t startPos, uint32_t length, Encoding encoding) {
   if (!file) {
     // // Serial.println("TrackStream::begin - invalid file");
     return false;
@@ -31,31 +41,57 @@ bool TrackStream::begin(File& file, uint32_t startPos, uint32_t length) {
 
   // Store file handle (each track gets its own handle)
   file_ = file;
+  encoding_ = encoding;
+  resetState(startPos, length);
+
+  // Seek to track start
+  if (!file_.seek(trackStartPos_)) {
+    // // Serial.println("TrackStream::begin - seek failed");
+    return false;
+  }
+
+  // Fill initial buffer
+  return refillBuffer();
+}
+
+bool TrackStream::begin(const FileView& view, uint32_t startPos, uint32_t length, Encoding encoding) {
+  if (!view || startPos + length > view.size()) {
+    return false;
+  }
+
+  view_ = view;
+  data_ = view_.data();
+  encoding_ = encoding;
+  resetState(startPos, length);
+
+  // Fill initial buffer
+  return refillBuffer();
+}
+
+void TrackStream::resetState(uint32_t startPos, uint32_t length) {
   trackStartPos_ = startPos;
   trackEndPos_ = startPos + length;
   currentFilePos_ = startPos;
   eof_ = false;
   absoluteTick_ = 0;
   runningStatus_ = 0;
+  lastTick_ = 0;
+  delete[] noteOffs_;
+  noteOffs_ = nullptr;
+  noteOffCount_ = 0;
+  hasStaged_ = false;
+  stagedHasOff_ = false;
+  loopDepth_ = 0;
   bufferHead_ = 0;
   bufferTail_ = 0;
   bufferSize_ = 0;
   nextEventTick_ = 0;
-
-  // Seek to track start
-  if (!file_.seek(trackStartPos_)) {
-    // // Serial.println("TrackStream::begin - seek failed");
-    return false;
-  }
-
-  // Fill initial buffer
-  return refillBuffer();
 }
 
-bool TrackStream::peek(MidiEvent& out) {
+bool TrackStream::peekTick(uint32_t& tick) {
   // If buffer empty, try to refill
   if (bufferSize_ == 0) {
-    if (eof_) {
+    if (drained()) {
       return false;  // Track exhausted
     }
     if (!refillBuffer()) {
@@ -63,13 +99,18 @@ bool TrackStream::peek(MidiEvent& out) {
     }
   }
 
+  tick = buffer_[bufferTail_].tick;
+  return true;
+}
+
+bool TrackStream::peek(MidiEvent& out) {
   // Return event at tail without consuming
-  if (bufferSize_ > 0) {
-    out = buffer_[bufferTail_];
-    return true;
+  uint32_t tick;
+  if (!peekTick(tick)) {
+    return false;
   }
-
-  return false;
+  out = buffer_[bufferTail_];
+  return true;
 }
 
 bool TrackStream::pop(MidiEvent& out) {
@@ -92,7 +133,7 @@ bool TrackStream::pop(MidiEvent& out) {
 
 bool TrackStream::refillBuffer() {
   // Try to fill buffer to capacity
-  while (bufferSize_ < BUFFER_SIZE && !eof_) {
+  while (bufferSize_ < BUFFER_SIZE && !drained()) {
     if (!parseNextEvent()) {
       // Either EOF or parse error
       break;
@@ -108,6 +149,11 @@ bool TrackStream::readByte(uint8_t& out) {
     return false;
   }
 
+  if (data_) {
+    out = data_[currentFilePos_++];
+    return true;
+  }
+
   int result = file_.read();
   if (result < 0) {
     // // Serial.println("TrackStream: file read error");
@@ -145,117 +191,202 @@ uint16_t TrackStream::readBE16(const uint8_t* p) {
 }
 
 bool TrackStream::parseNextEvent() {
-  if (currentFilePos_ >= trackEndPos_) {
-    eof_ = true;
-    return false;
+  MidiEvent e;
+
+  if (encoding_ == ENCODING_SMF) {
+    if (!parseEvent(e)) {
+      return false;
+    }
+    pushEvent(e);
+    return true;
   }
 
-  // Read delta time
-  uint32_t delta = 0;
-  if (!readVarLen(delta)) {
-    eof_ = true;
-    return false;
+  // XMI: merge the note-offs implied by note durations into the event order
+  if (!hasStaged_ && !eof_) {
+    if (noteOffCount_ == XMI_MAX_NOTES) {
+      // Every slot in use - end the earliest note now rather than lose it
+      popNoteOff(e);
+      e.tick = absoluteTick_;
+      pushEvent(e);
+      return true;
+    }
+    hasStaged_ = parseEvent(staged_);
   }
-  absoluteTick_ += delta;
 
-  // Read status byte
-  uint8_t status;
-  if (!readByte(status)) {
+  if (noteOffCount_ > 0 &&
+      (!hasStaged_ || staged_.type == MidiEventType::EndOfTrack || noteOffs_[0].tick <= staged_.tick)) {
+    popNoteOff(e);
+    pushEvent(e);
+    return true;
+  }
+
+  if (hasStaged_) {
+    // End of track comes after the last note-off
+    if (staged_.tick < lastTick_) {
+      staged_.tick = lastTick_;
+    }
+    pushEvent(staged_);
+    hasStaged_ = false;
+
+    // Only now - a zero-length note's off shares the note-on's tick and must follow it
+    if (stagedHasOff_) {
+      scheduleNoteOff(staged_.channel, staged_.key, stagedOffTick_);
+      stagedHasOff_ = false;
+    }
+    return true;
+  }
+
+  // Track finished - hand the note-off slots back
+  delete[] noteOffs_;
+  noteOffs_ = nullptr;
+  return false;
+}
+
+void TrackStream::pushEvent(const MidiEvent& e) {
+  buffer_[bufferHead_] = e;
+  bufferHead_ = (bufferHead_ + 1) % BUFFER_SIZE;
+  bufferSize_++;
+  if (bufferSize_ == 1) {
+    nextEventTick_ = e.tick;
+  }
+  lastTick_ = e.tick;
+}
+
+bool TrackStream::parseEvent(MidiEvent& e) {
+  if (currentFilePos_ >= trackEndPos_) {
     eof_ = true;
     return false;
   }
 
-  // Handle running status
-  if (status < 0x80) {
-    // Running status - rewind one byte
-    if (!runningStatus_) {
-      // // Serial.println("TrackStream: No running status for data byte");
+  e = MidiEvent();
+
+  uint32_t delta = 0;
+  uint8_t status;
+  if (encoding_ == ENCODING_XMI) {
+    // Delay and status byte (XMI has no running status)
+    if (!readXmiDelay(delta, status)) {
       eof_ = true;
       return false;
     }
-    currentFilePos_--;  // Put byte back
-    file_.seek(currentFilePos_);
-    status = runningStatus_;
-  } else if ((status & 0xF0) != 0xF0) {
-    // Update running status (only for channel voice messages)
-    runningStatus_ = status;
-  }
-
-  // Parse event based on status
-  if ((status & 0xF0) == 0xF0) {
-    // System / Meta event
-  if (status == 0xFF) {
-    // Meta event
-    uint8_t type;
-    if (!readByte(type)) {
+    absoluteTick_ += delta;
+  } else {
+    // Read delta time
+    if (!readVarLen(delta)) {
       eof_ = true;
       return false;
     }
+    absoluteTick_ += delta;
 
-    uint32_t len = 0;
-    if (!readVarLen(len)) {
+    // Read status byte
+    if (!readByte(status)) {
       eof_ = true;
       return false;
     }
 
-    // Bounds check
-    if (currentFilePos_ + len > trackEndPos_) {
-      // // Serial.println("TrackStream: Meta event exceeds track bounds");
-      eof_ = true;
-      return false;
+    // Handle running status
+    if (status < 0x80) {
+      // Running status - rewind one byte
+      if (!runningStatus_) {
+        // // Serial.println("TrackStream: No running status for data byte");
+        eof_ = true;
+        return false;
+      }
+      currentFilePos_--;  // Put byte back
+      if (!data_) {
+        file_.seek(currentFilePos_);
+      }
+      status = runningStatus_;
+    } else if ((status & 0xF0) != 0xF0) {
+      // Update running status (only for channel voice messages)
+      runningStatus_ = status;
     }
+  }
 
-    // Handle specific meta events
-    if (type == 0x2F) {
-      // End of track
-      MidiEvent e;
-      e.tick = absoluteTick_;
-      e.type = MidiEventType::EndOfTrack;
-      e.channel = 0;
-      buffer_[bufferHead_] = e;
-      bufferHead_ = (bufferHead_ + 1) % BUFFER_SIZE;
-      bufferSize_++;
-      if (bufferSize_ == 1) {
-        nextEventTick_ = e.tick;
+  // Parse event based on status
+  if ((status & 0xF0) == 0xF0) {
+    // System / Meta event
+    if (status == 0xFF) {
+      // Meta event
+      uint8_t type;
+      if (!readByte(type)) {
+        eof_ = true;
+        return false;
       }
 
-      // Skip length bytes (should be 0)
-      for (uint32_t i = 0; i < len; i++) {
-        uint8_t dummy;
-        readByte(dummy);
+      uint32_t len = 0;
+      if (!readVarLen(len)) {
+        eof_ = true;
+        return false;
       }
 
-      eof_ = true;  // Mark end of track
-      return true;
+      // Bounds check
+      if (currentFilePos_ + len > trackEndPos_) {
+        // // Serial.println("TrackStream: Meta event exceeds track bounds");
+        eof_ = true;
+        return false;
+      }
 
-    } else if (type == 0x51 && len == 3) {
-      // Tempo change
-      uint8_t data[3];
-      for (int i = 0; i < 3; i++) {
-        if (!readByte(data[i])) {
-          eof_ = true;
-          return false;
+      // Handle specific meta events
+      if (type == 0x2F) {
+        // End of track
+        e.tick = absoluteTick_;
+        e.type = MidiEventType::EndOfTrack;
+        e.channel = 0;
+
+        // Skip length bytes (should be 0)
+        for (uint32_t i = 0; i < len; i++) {
+          uint8_t dummy;
+          readByte(dummy);
         }
-      }
 
-      uint32_t usq = ((uint32_t)data[0]<<16) | ((uint32_t)data[1]<<8) | data[2];
+        eof_ = true;  // Mark end of track
+        return true;
+
+      } else if (type == 0x51 && len == 3 && encoding_ == ENCODING_SMF) {
+        // Tempo change (XMI plays at a fixed rate; the Miles driver ignores these)
+        uint8_t data[3];
+        for (int i = 0; i < 3; i++) {
+          if (!readByte(data[i])) {
+            eof_ = true;
+            return false;
+          }
+        }
 
-      MidiEvent e;
-      e.tick = absoluteTick_;
-      e.type = MidiEventType::MetaTempo;
-      e.channel = 0;
-      e.tempoUSQ = usq;
-      buffer_[bufferHead_] = e;
-      bufferHead_ = (bufferHead_ + 1) % BUFFER_SIZE;
-      bufferSize_++;
-      if (bufferSize_ == 1) {
-        nextEventTick_ = e.tick;
+        uint32_t usq = ((uint32_t)data[0]<<16) | ((uint32_t)data[1]<<8) | data[2];
+
+        e.tick = absoluteTick_;
+        e.type = MidiEventType::MetaTempo;
+        e.setTempoUSQ(usq);
+        return true;
+
+      } else {
+        // Skip unknown meta event
+        for (uint32_t i = 0; i < len; i++) {
+          uint8_t dummy;
+          if (!readByte(dummy)) {
+            eof_ = true;
+            return false;
+          }
+        }
+        return parseEvent(e);  // Recursively parse next event
       }
 
-      return true;
-
     } else {
-      // Skip unknown meta event
+      // SysEx (0xF0 or 0xF7)
+      uint32_t len = 0;
+      if (!readVarLen(len)) {
+        eof_ = true;
+        return false;
+      }
+
+      // Bounds check
+      if (currentFilePos_ + len > trackEndPos_) {
+        // // Serial.println("TrackStream: SysEx exceeds track bounds");
+        eof_ = true;
+        return false;
+      }
+
+      // Skip SysEx data
       for (uint32_t i = 0; i < len; i++) {
         uint8_t dummy;
         if (!readByte(dummy)) {
@@ -263,142 +394,230 @@ bool TrackStream::parseNextEvent() {
           return false;
         }
       }
-      return parseNextEvent();  // Recursively parse next event
-    }
 
-  } else {
-    // SysEx (0xF0 or 0xF7)
-    uint32_t len = 0;
-    if (!readVarLen(len)) {
-      eof_ = true;
-      return false;
+      return parseEvent(e);  // Recursively parse next event
     }
+  } else {
+    // Channel voice message
+    uint8_t hi = status & 0xF0;
+    uint8_t ch = status & 0x0F;
 
-    // Bounds check
-    if (currentFilePos_ + len > trackEndPos_) {
-      // // Serial.println("TrackStream: SysEx exceeds track bounds");
-      eof_ = true;
-      return false;
-    }
+    e.tick = absoluteTick_;
+    e.channel = ch;
 
-    // Skip SysEx data
-    for (uint32_t i = 0; i < len; i++) {
-      uint8_t dummy;
-      if (!readByte(dummy)) {
-        eof_ = true;
-        return false;
+    switch (hi) {
+      case 0x80: {  // Note Off
+        uint8_t key, vel;
+        if (!readByte(key) || !readByte(vel)) {
+          eof_ = true;
+          return false;
+        }
+        e.type = MidiEventType::NoteOff;
+        e.key = key;
+        e.velocity = vel;
+        break;
       }
-    }
 
-    return parseNextEvent();  // Recursively parse next event
-  }
-  } else {
-    // Channel voice message
-  uint8_t hi = status & 0xF0;
-  uint8_t ch = status & 0x0F;
+      case 0x90: {  // Note On
+        uint8_t key, vel;
+        if (!readByte(key) || !readByte(vel)) {
+          eof_ = true;
+          return false;
+        }
+        e.type = (vel == 0) ? MidiEventType::NoteOff : MidiEventType::NoteOn;
+        e.key = key;
+        e.velocity = vel;
+
+        if (encoding_ == ENCODING_XMI) {
+          // XMI notes carry their duration instead of a note-off event
+          uint32_t duration;
+          if (!readVarLen(duration)) {
+            eof_ = true;
+            return false;
+          }
+          if (vel > 0) {
+            // Scheduled by parseNextEvent() when this note-on is emitted
+            stagedOffTick_ = absoluteTick_ + duration;
+            stagedHasOff_ = true;
+          }
+        }
+        break;
+      }
 
-  MidiEvent e;
-  e.tick = absoluteTick_;
-  e.channel = ch;
+      case 0xA0: {  // Poly Pressure (ignore)
+        uint8_t dummy1, dummy2;
+        if (!readByte(dummy1) || !readByte(dummy2)) {
+          eof_ = true;
+          return false;
+        }
+        return parseEvent(e);  // Skip this event, parse next
+      }
 
-  switch (hi) {
-    case 0x80: {  // Note Off
-      uint8_t key, vel;
-      if (!readByte(key) || !readByte(vel)) {
-        eof_ = true;
-        return false;
+      case 0xB0: {  // Control Change
+        uint8_t cc, val;
+        if (!readByte(cc) || !readByte(val)) {
+          eof_ = true;
+          return false;
+        }
+        if (encoding_ == ENCODING_XMI && cc >= 110 && cc <= 120) {
+          // XMIDI driver controllers - not for the synth
+          handleXmiController(cc, val);
+          return parseEvent(e);
+        }
+        e.type = MidiEventType::ControlChange;
+        e.value1 = cc;
+        e.value2 = val;
+        break;
       }
-      e.type = MidiEventType::NoteOff;
-      e.key = key;
-      e.velocity = vel;
-      break;
-    }
 
-    case 0x90: {  // Note On
-      uint8_t key, vel;
-      if (!readByte(key) || !readByte(vel)) {
-        eof_ = true;
-        return false;
+      case 0xC0: {  // Program Change
+        uint8_t prog;
+        if (!readByte(prog)) {
+          eof_ = true;
+          return false;
+        }
+        e.type = MidiEventType::ProgramChange;
+        e.value1 = prog;
+        break;
       }
-      e.type = (vel == 0) ? MidiEventType::NoteOff : MidiEventType::NoteOn;
-      e.key = key;
-      e.velocity = vel;
-      break;
-    }
 
-    case 0xA0: {  // Poly Pressure (ignore)
-      uint8_t dummy1, dummy2;
-      if (!readByte(dummy1) || !readByte(dummy2)) {
-        eof_ = true;
-        return false;
+      case 0xD0: {  // Channel Pressure
+        uint8_t pres;
+        if (!readByte(pres)) {
+          eof_ = true;
+          return false;
+        }
+        e.type = MidiEventType::ChannelPressure;
+        e.value1 = pres;
+        break;
       }
-      return parseNextEvent();  // Skip this event, parse next
-    }
 
-    case 0xB0: {  // Control Change
-      uint8_t cc, val;
-      if (!readByte(cc) || !readByte(val)) {
-        eof_ = true;
-        return false;
+      case 0xE0: {  // Pitch Bend
+        uint8_t lsb, msb;
+        if (!readByte(lsb) || !readByte(msb)) {
+          eof_ = true;
+          return false;
+        }
+        // Kept as the raw pair - MidiEvent::pitchBend() centres it
+        e.type = MidiEventType::PitchBend;
+        e.value1 = lsb & 0x7F;
+        e.value2 = msb & 0x7F;
+        break;
       }
-      e.type = MidiEventType::ControlChange;
-      e.value1 = cc;
-      e.value2 = val;
-      break;
-    }
 
-    case 0xC0: {  // Program Change
-      uint8_t prog;
-      if (!readByte(prog)) {
+      default:
+        // // Serial.print("TrackStream: Unknown status 0x");
+        // // Serial.println(status, HEX);
         eof_ = true;
         return false;
-      }
-      e.type = MidiEventType::ProgramChange;
-      e.value1 = prog;
-      break;
     }
 
-    case 0xD0: {  // Channel Pressure
-      uint8_t pres;
-      if (!readByte(pres)) {
-        eof_ = true;
-        return false;
-      }
-      e.type = MidiEventType::ChannelPressure;
-      e.value1 = pres;
-      break;
+    return true;
+  }
+}
+
+// ============================================================================
+// TrackStream XMI support
+// ============================================================================
+
+bool TrackStream::readXmiDelay(uint32_t& delay, uint8_t& status) {
+  // Delays are runs of bytes below 0x80, summed; the first byte with the
+  // top bit set is the event's status
+  delay = 0;
+  for (;;) {
+    if (!readByte(status)) {
+      return false;
+    }
+    if (status & 0x80) {
+      return true;
     }
+    delay += status;
+  }
+}
 
-    case 0xE0: {  // Pitch Bend
-      uint8_t lsb, msb;
-      if (!readByte(lsb) || !readByte(msb)) {
-        eof_ = true;
-        return false;
-      }
-      int16_t pb = ((int16_t)(msb & 0x7F) << 7) | (int16_t)(lsb & 0x7F);
-      pb -= 8192;
-      e.type = MidiEventType::PitchBend;
-      e.pitchBend = pb;
-      break;
+void TrackStream::scheduleNoteOff(uint8_t channel, uint8_t key, uint32_t tick) {
+  if (!noteOffs_) {
+    noteOffs_ = new NoteOff[XMI_MAX_NOTES];
+    if (!noteOffs_) {
+      return;
     }
+  }
 
-    default:
-      // // Serial.print("TrackStream: Unknown status 0x");
-      // // Serial.println(status, HEX);
-      eof_ = true;
-      return false;
+  // parseNextEvent() keeps a slot free before each event it parses
+  if (noteOffCount_ >= XMI_MAX_NOTES) {
+    return;
   }
 
-  // Add event to buffer
-  buffer_[bufferHead_] = e;
-  bufferHead_ = (bufferHead_ + 1) % BUFFER_SIZE;
-  bufferSize_++;
-  if (bufferSize_ == 1) {
-    nextEventTick_ = e.tick;
+  // Sift up
+  uint8_t i = noteOffCount_++;
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (noteOffs_[parent].tick <= tick) {
+      break;
+    }
+    noteOffs_[i] = noteOffs_[parent];
+    i = parent;
   }
+  noteOffs_[i].tick = tick;
+  noteOffs_[i].channel = channel;
+  noteOffs_[i].key = key;
+}
 
-  return true;
+void TrackStream::popNoteOff(MidiEvent& out) {
+  const NoteOff top = noteOffs_[0];
+  out = MidiEvent();
+  out.tick = top.tick;
+  out.type = MidiEventType::NoteOff;
+  out.channel = top.channel;
+  out.key = top.key;
+  out.velocity = 0;
+
+  // Sift the last entry down from the root
+  const NoteOff last = noteOffs_[--noteOffCount_];
+  uint8_t i = 0;
+  for (;;) {
+    uint8_t child = i * 2 + 1;
+    if (child >= noteOffCount_) {
+      break;
+    }
+    if (child + 1 < noteOffCount_ && noteOffs_[child + 1].tick < noteOffs_[child].tick) {
+      child++;
+    }
+    if (last.tick <= noteOffs_[child].tick) {
+      break;
+    }
+    noteOffs_[i] = noteOffs_[child];
+    i = child;
   }
+  noteOffs_[i] = last;
+}
+
+void TrackStream::handleXmiController(uint8_t cc, uint8_t value) {
+  if (cc == 116) {
+    // FOR loop: value = passes, 0 = forever. Forever is ignored (one pass)
+    // but still pushed, so its NEXT doesn't close an outer loop.
+    if (loopDepth_ < XMI_LOOP_DEPTH) {
+      loops_[loopDepth_].pos = currentFilePos_;
+      loops_[loopDepth_].remaining = value > 0 ? value : 1;
+      loopDepth_++;
+    }
+  } else if (cc == 117) {
+    // NEXT (value >= 64) or BREAK (value < 64)
+    if (loopDepth_ == 0) {
+      return;
+    }
+    XmiLoop& loop = loops_[loopDepth_ - 1];
+    if (value < 64 || --loop.remaining == 0) {
+      loopDepth_--;
+    } else {
+      currentFilePos_ = loop.pos;
+      if (!data_) {
+        file_.seek(currentFilePos_);
+      }
+    }
+  }
+  // Channel lock, timbre protect, bank select, callback and branch index
+  // controllers only mean something to a game driving the Miles driver
 }
 
 // ============================================================================
@@ -413,6 +632,11 @@ StreamingMidiSong::StreamingMidiSong()
   , initialTempoUSQ_(500000)
   , currentUSPerTick_(500000 / 480)
   , format_(0)
+  , sequential_(false)
+  , currentTrack_(0)
+  , tickBase_(0)
+  , earliestTrack_(-1)
+  , earliestKnown_(false)
   , fileSource_(nullptr) {
   memset(filename_, 0, sizeof(filename_));
 }
@@ -435,8 +659,11 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
   filename_[sizeof(filename_) - 1] = '\0';
   fileSource_ = fileSource;
 
+  // Small files are parsed in place from PSRAM; larger ones stream per track
+  FileView view = fileSource_->openView(filename_);
+
   // Open the file
-  File file = fileSource_->open(filename_, FILE_READ);
+  File file = view ? view.open() : fileSource_->open(filename_, FILE_READ);
   if (!file) {
     // // Serial.print("StreamingMidiSong: Failed to open file: ");
     // // Serial.println(filename_);
@@ -453,12 +680,74 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
     return false;
   }
 
+  // Read the container signature
+  uint8_t headerBuf[12];
+  file.seek(0);
+  if (file.read(headerBuf, 12) != 12) {
+    // // Serial.println("StreamingMidiSong: Failed to read header");
+    file.close();
+    return false;
+  }
+
+  bool ok = false;
+  if (memcmp(headerBuf, "RIFF", 4) == 0 && memcmp(headerBuf + 8, "RMID", 4) == 0) {
+    // RIFF MIDI: find the SMF in the 'data' chunk (chunk lengths are little-endian)
+    uint32_t pos = 12;
+    while (pos + 8 <= fileSize) {
+      uint8_t chunk[8];
+      file.seek(pos);
+      if (file.read(chunk, 8) != 8) {
+        break;
+      }
+      uint32_t len = ((uint32_t)chunk[7]<<24) | ((uint32_t)chunk[6]<<16) |
+                     ((uint32_t)chunk[5]<<8) | chunk[4];
+      if (len > fileSize - pos - 8) {
+        break;
+      }
+      if (memcmp(chunk, "data", 4) == 0) {
+        ok = loadSmf(file, view, pos + 8, len);
+        break;
+      }
+      pos += 8 + len + (len & 1);
+    }
+  } else if (memcmp(headerBuf, "FORM", 4) == 0) {
+    ok = loadXmi(file, view, fileSize);
+  } else {
+    ok = loadSmf(file, view, 0, fileSize);
+  }
+
+  // Close the main file handle - each track has its own handle now (a
+  // streamed XMI track took this one over and left it empty)
+  file.close();
+
+  if (!ok) {
+    clear();
+    return false;
+  }
+
+  // Find initial tempo from first tempo event across all tracks
+  initialTempoUSQ_ = 500000;  // Default 120 BPM
+  MidiEvent ev;
+  if (peekEvent(ev) && ev.type == MidiEventType::MetaTempo) {
+    initialTempoUSQ_ = ev.tempoUSQ();
+  }
+
+  currentUSPerTick_ = (uint32_t)((double)initialTempoUSQ_ / (double)ppqn_);
+
+  return true;
+}
+
+bool StreamingMidiSong::loadSmf(File& file, const FileView& view, uint32_t start, uint32_t size) {
+  if (size < 14) {
+    return false;
+  }
+  uint32_t end = start + size;
+
   // Read and parse header
   uint8_t headerBuf[14];
-  file.seek(0);
+  file.seek(start);
   if (file.read(headerBuf, 14) != 14) {
     // // Serial.println("StreamingMidiSong: Failed to read header");
-    file.close();
     return false;
   }
 
@@ -491,8 +780,11 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
   }
   ppqn_ = (uint16_t)div;
 
+  // Type 2: independent patterns, played in order
+  sequential_ = (format_ == 2);
+
   // Skip rest of header if needed
-  uint32_t headerEndPos = 8 + headerLen;
+  uint32_t headerEndPos = start + 8 + headerLen;
   file.seek(headerEndPos);
 
   // Allocate track array
@@ -513,14 +805,12 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
     file.seek(filePos);
     if (file.read(trackHeader, 8) != 8) {
       // // Serial.println(" - Failed to read track header");
-      clear();
       return false;
     }
 
     // Check MTrk signature
     if (memcmp(trackHeader, "MTrk", 4) != 0) {
       // // Serial.println(" - Invalid track signature");
-      clear();
       return false;
     }
 
@@ -530,27 +820,12 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
     // Serial.print(" len="); // Serial.println(trackLen);
 
     // Bounds check
-    if (filePos + 8 + trackLen > fileSize) {
+    if (filePos + 8 + trackLen > end) {
       // // Serial.println(" - Track exceeds file size");
-      clear();
-      return false;
-    }
-
-    // Open a new file handle for this track using FileSource
-    File trackFile = fileSource_->open(filename_, FILE_READ);
-    if (!trackFile) {
-      // // Serial.println(" - Failed to open file for track");
-      clear();
-      file.close();
       return false;
     }
 
-    // Initialize track stream
-    uint32_t trackDataStart = filePos + 8;
-    if (!tracks_[t].begin(trackFile, trackDataStart, trackLen)) {
-      // // Serial.println(" - Failed to initialize track stream");
-      trackFile.close();
-      clear();
+    if (!beginTrack(t, view, filePos + 8, trackLen, TrackStream::ENCODING_SMF)) {
       return false;
     }
 
@@ -559,53 +834,193 @@ bool StreamingMidiSong::loadFromFile(const char* filename, FileSource* fileSourc
   }
 
   // // Serial.println("StreamingMidiSong: All tracks initialized successfully");
+  return true;
+}
 
-  // Close the main file handle - each track has its own handle now
-  file.close();
+// Read an IFF chunk header (big-endian length) at pos, bounded by end
+static bool readIffChunk(File& file, uint32_t pos, uint32_t end, char id[4], uint32_t& len) {
+  uint8_t chunk[8];
+  if (pos + 8 > end || !file.seek(pos) || file.read(chunk, 8) != 8) {
+    return false;
+  }
+  len = ((uint32_t)chunk[4]<<24) | ((uint32_t)chunk[5]<<16) | ((uint32_t)chunk[6]<<8) | chunk[7];
+  if (len > end - pos - 8) {
+    return false;
+  }
+  memcpy(id, chunk, 4);
+  return true;
+}
 
-  // Find initial tempo from first tempo event across all tracks
-  initialTempoUSQ_ = 500000;  // Default 120 BPM
-  MidiEvent ev;
-  if (peekEvent(ev) && ev.type == MidiEventType::MetaTempo) {
-    initialTempoUSQ_ = ev.tempoUSQ;
+// Find the EVNT chunk of the next FORM XMID at or after pos, and move pos past it
+static bool nextXmiSequence(File& file, uint32_t& pos, uint32_t end,
+                            uint32_t& eventStart, uint32_t& eventLen) {
+  char id[4];
+  uint32_t len;
+  while (readIffChunk(file, pos, end, id, len)) {
+    uint32_t formPos = pos;
+    pos += 8 + len + (len & 1);
+
+    char type[4];
+    if (memcmp(id, "FORM", 4) != 0 || len < 4 || file.read(type, 4) != 4 ||
+        memcmp(type, "XMID", 4) != 0) {
+      continue;
+    }
+
+    // TIMB (timbre list) and RBRN (branch points) are for the Miles driver
+    uint32_t formEnd = formPos + 8 + len;
+    uint32_t chunkPos = formPos + 12;
+    while (readIffChunk(file, chunkPos, formEnd, id, len)) {
+      if (memcmp(id, "EVNT", 4) == 0) {
+        eventStart = chunkPos + 8;
+        eventLen = len;
+        return true;
+      }
+      chunkPos += 8 + len + (len & 1);
+    }
   }
+  return false;
+}
 
-  currentUSPerTick_ = (uint32_t)((double)initialTempoUSQ_ / (double)ppqn_);
+bool StreamingMidiSong::loadXmi(File& file, const FileView& view, uint32_t size) {
+  // Either a FORM XDIR (sequence count) followed by a CAT XMID holding one
+  // FORM XMID per sequence, or a bare FORM XMID
+  char id[4];
+  char type[4];
+  uint32_t len;
+  if (!readIffChunk(file, 0, size, id, len) || file.read(type, 4) != 4) {
+    return false;
+  }
+
+  uint32_t seqStart = 0;
+  uint32_t seqEnd = size;
+  if (memcmp(type, "XDIR", 4) == 0) {
+    uint32_t catPos = 8 + len + (len & 1);
+    if (!readIffChunk(file, catPos, size, id, len) || memcmp(id, "CAT ", 4) != 0 ||
+        len < 4 || file.read(type, 4) != 4 || memcmp(type, "XMID", 4) != 0) {
+      return false;
+    }
+    seqStart = catPos + 12;
+    seqEnd = catPos + 8 + len;
+  } else if (memcmp(type, "XMID", 4) != 0) {
+    return false;
+  }
+
+  // Only the first sequence plays (see the class comment)
+  uint32_t pos = seqStart;
+  uint32_t eventStart, eventLen;
+  if (!nextXmiSequence(file, pos, seqEnd, eventStart, eventLen)) {
+    return false;
+  }
 
+  numTracks_ = 1;
+  maxTracks_ = 1;
+  tracks_ = new TrackStream[maxTracks_];
+  if (!tracks_) {
+    return false;
+  }
+
+  if (view) {
+    if (!tracks_[0].begin(view, eventStart, eventLen, TrackStream::ENCODING_XMI)) {
+      return false;
+    }
+  } else {
+    // Streamed: the one track takes over the header handle instead of opening another
+    if (!tracks_[0].begin(file, eventStart, eventLen, TrackStream::ENCODING_XMI)) {
+      return false;
+    }
+    file = File();
+  }
+
+  // The Miles driver plays XMI at a fixed 120 ticks per second
+  format_ = 0;
+  ppqn_ = 60;
   return true;
 }
 
-int StreamingMidiSong::findEarliestTrack(MidiEvent& out) {
-  uint32_t earliestTick = UINT32_MAX;
-  int earliestTrack = -1;
+bool StreamingMidiSong::beginTrack(uint8_t t, const FileView& view, uint32_t start, uint32_t length,
+                                   TrackStream::Encoding encoding) {
+  if (view) {
+    // Whole file in PSRAM: parse the track in place
+    return tracks_[t].begin(view, start, length, encoding);
+  }
 
-  // Scan all tracks for earliest event
-  for (int i = 0; i < numTracks_; i++) {
-    MidiEvent ev;
-    if (tracks_[i].peek(ev)) {
-      if (ev.tick < earliestTick) {
-        earliestTick = ev.tick;
+  // Open a new file handle for this track using FileSource
+  File trackFile = fileSource_->open(filename_, FILE_READ);
+  if (!trackFile) {
+    // // Serial.println(" - Failed to open file for track");
+    return false;
+  }
+
+  // Initialize track stream
+  if (!tracks_[t].begin(trackFile, start, length, encoding)) {
+    // // Serial.println(" - Failed to initialize track stream");
+    trackFile.close();
+    return false;
+  }
+  return true;
+}
+
+int StreamingMidiSong::findEarliestTrack() {
+  // Nothing has been popped since the last search
+  if (earliestKnown_) {
+    return earliestTrack_;
+  }
+
+  int earliestTrack = -1;
+  uint32_t tick;
+
+  if (sequential_) {
+    // One track at a time, each starting where the previous one ended
+    while (currentTrack_ < numTracks_) {
+      if (tracks_[currentTrack_].peekTick(tick)) {
+        earliestTrack = currentTrack_;
+        break;
+      }
+      tickBase_ += tracks_[currentTrack_].getLastTick();
+      currentTrack_++;
+    }
+  } else {
+    // Scan all tracks for earliest event (ticks only - events stay in their buffers)
+    uint32_t earliestTick = UINT32_MAX;
+    for (int i = 0; i < numTracks_; i++) {
+      if (tracks_[i].peekTick(tick) && tick < earliestTick) {
+        earliestTick = tick;
         earliestTrack = i;
-        out = ev;
       }
     }
   }
 
+  earliestTrack_ = earliestTrack;
+  earliestKnown_ = true;
   return earliestTrack;
 }
 
 bool StreamingMidiSong::peekEvent(MidiEvent& out) {
-  return findEarliestTrack(out) >= 0;
+  int track = findEarliestTrack();
+  if (track < 0 || !tracks_[track].peek(out)) {
+    return false;
+  }
+  if (sequential_) {
+    out.tick += tickBase_;
+  }
+  return true;
 }
 
 bool StreamingMidiSong::popEvent(MidiEvent& out) {
-  int track = findEarliestTrack(out);
+  int track = findEarliestTrack();
   if (track < 0) {
     return false;
   }
 
-  // Pop from that track
-  return tracks_[track].pop(out);
+  // Pop from that track (the next search starts over)
+  earliestKnown_ = false;
+  if (!tracks_[track].pop(out)) {
+    return false;
+  }
+  if (sequential_) {
+    out.tick += tickBase_;
+  }
+  return true;
 }
 
 bool StreamingMidiSong::playbackDone(uint32_t lastTickDispatched) const {
@@ -634,6 +1049,11 @@ void StreamingMidiSong::clear() {
   initialTempoUSQ_ = 500000;
   currentUSPerTick_ = 500000 / 480;
   format_ = 0;
+  sequential_ = false;
+  currentTrack_ = 0;
+  tickBase_ = 0;
+  earliestTrack_ = -1;
+  earliestKnown_ = false;
   fileSource_ = nullptr;
   memset(filename_, 0, sizeof(filename_));
 }
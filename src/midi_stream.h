@@ -14,9 +14,23 @@ class StreamingMidiSong;
  *
  * Maintains a small lookahead buffer of events read from storage.
  * File position is tracked per-track, allowing independent streaming.
+ * When the whole file is in PSRAM (FileView) the track is parsed in place.
+ *
+ * XMI (Miles XMIDI) event data is decoded directly rather than converted to
+ * SMF first: delays are runs of bytes below 0x80, there is no running status,
+ * and each note-on carries its duration. The implied note-offs wait in a
+ * small heap (allocated on the first note) and are merged into the event
+ * order as the track is parsed. FOR/NEXT loop controllers are followed. An
+ * infinite loop (FOR 0) is ignored - its body plays once - as the player has
+ * no loop-forever mode for MIDI and a song has to end.
  */
 class TrackStream {
 public:
+  enum Encoding : uint8_t {
+    ENCODING_SMF,   // Standard MIDI file track (MTrk)
+    ENCODING_XMI    // XMIDI sequence (EVNT)
+  };
+
   TrackStream();
   ~TrackStream();
 
@@ -24,12 +38,19 @@ public:
   // file: File handle (each track gets its own handle to the same file)
   // startPos: Byte offset where track data begins (after MTrk + length)
   // length: Track data length in bytes
-  bool begin(File& file, uint32_t startPos, uint32_t length);
+  bool begin(File& file, uint32_t startPos, uint32_t length, Encoding encoding = ENCODING_SMF);
+
+  // Initialize stream over a whole-file view (no file handle, no per-byte I/O)
+  bool begin(const FileView& view, uint32_t startPos, uint32_t length, Encoding encoding = ENCODING_SMF);
 
   // Event access (same as MidiSong interface)
   bool peek(MidiEvent& out);  // View next event without consuming
   bool pop(MidiEvent& out);   // Consume next event
-  bool isDone() const { return eof_ && bufferSize_ == 0; }
+  bool peekTick(uint32_t& tick);  // Tick of the next event, without copying it
+  bool isDone() const { return drained() && bufferSize_ == 0; }
+
+  // Tick of the last event buffered (the track's length once it is done)
+  uint32_t getLastTick() const { return lastTick_; }
 
   // For debugging
   uint32_t getCurrentTick() const { return nextEventTick_; }
@@ -43,22 +64,68 @@ private:
   // Parse next event from file into buffer
   bool parseNextEvent();
 
+  // Decode one event from the track (false at end of track or on error)
+  bool parseEvent(MidiEvent& e);
+
+  // Append an event to the ring buffer
+  void pushEvent(const MidiEvent& e);
+
+  // Track data, staged event and pending note-offs all used up
+  bool drained() const { return eof_ && !hasStaged_ && noteOffCount_ == 0; }
+
   // MIDI parser helpers (shared with midi_file.cpp logic)
   static uint32_t readBE32(const uint8_t* p);
   static uint16_t readBE16(const uint8_t* p);
   bool readVarLen(uint32_t& out);  // Reads from file, not buffer
   bool readByte(uint8_t& out);     // Read single byte from file
 
+  // Reset parser and buffer state for a new track
+  void resetState(uint32_t startPos, uint32_t length);
+
+  // XMI helpers
+  bool readXmiDelay(uint32_t& delay, uint8_t& status);  // Delay bytes up to the status byte
+  void scheduleNoteOff(uint8_t channel, uint8_t key, uint32_t tick);
+  void popNoteOff(MidiEvent& out);                       // Earliest pending note-off
+  void handleXmiController(uint8_t cc, uint8_t value);
+
   // File state
-  File file_;                  // File handle for this track
+  File file_;                  // File handle for this track (streaming)
+  FileView view_;              // Whole file (in place), else invalid
+  const uint8_t* data_;        // view_.data() while parsing in place
   uint32_t trackStartPos_;     // Byte offset where track data starts
   uint32_t trackEndPos_;       // Byte offset where track ends
   uint32_t currentFilePos_;    // Current read position in file
   bool eof_;                   // Track data exhausted
 
   // Parser state
+  Encoding encoding_;          // Track data format
   uint32_t absoluteTick_;      // Current absolute tick (accumulated deltas)
   uint8_t runningStatus_;      // MIDI running status byte
+  uint32_t lastTick_;          // Tick of the last event buffered
+
+  // XMI state
+  static const uint8_t XMI_MAX_NOTES = 64;            // Notes sounding at once
+  static const uint8_t XMI_LOOP_DEPTH = 4;            // Nested FOR loops
+
+  struct NoteOff {
+    uint32_t tick;
+    uint8_t channel;
+    uint8_t key;
+  };
+
+  struct XmiLoop {
+    uint32_t pos;              // Byte offset just after the FOR controller
+    uint8_t remaining;         // Passes left, including the current one
+  };
+
+  NoteOff* noteOffs_;          // Min-heap on tick (XMI only, nullptr until needed)
+  uint8_t noteOffCount_;
+  MidiEvent staged_;           // Next parsed event, held back for earlier note-offs
+  bool hasStaged_;
+  uint32_t stagedOffTick_;     // Note-off for a staged XMI note-on, scheduled once it is emitted
+  bool stagedHasOff_;
+  XmiLoop loops_[XMI_LOOP_DEPTH];
+  uint8_t loopDepth_;
 
   // Event buffer (ring buffer)
   static const uint8_t BUFFER_SIZE = 32;
@@ -77,6 +144,15 @@ private:
  * Merges events from multiple track streams in real-time.
  * Memory usage is O(num_tracks × buffer_size) instead of O(total_events).
  *
+ * Also reads the containers DOS game music ships in:
+ *   - RIFF RMID: the SMF in the 'data' chunk is played where it lies
+ *   - XMI: the first FORM XMID sequence (bare, or in a FORM XDIR + CAT XMID
+ *     collection) becomes an XMI track stream over its EVNT chunk, timed at
+ *     the fixed 120Hz the Miles driver plays at. The other sequences of a
+ *     collection are separate pieces the game picks by index, not a medley.
+ * SMF type 2 files play their tracks one after another, each starting where
+ * the previous one ended, instead of merged.
+ *
  * Interface is identical to MidiSong for drop-in replacement.
  */
 class StreamingMidiSong {
@@ -105,8 +181,16 @@ public:
   void resetPlayback(); // NOT SUPPORTED for streaming (would require file reopen)
 
 private:
-  // Find track with earliest event
-  int findEarliestTrack(MidiEvent& out);
+  // Find track with earliest event (-1 when all are done); kept until the next pop
+  int findEarliestTrack();
+
+  // Container parsers (file is the header handle, view is valid if in PSRAM)
+  bool loadSmf(File& file, const FileView& view, uint32_t start, uint32_t size);
+  bool loadXmi(File& file, const FileView& view, uint32_t size);
+
+  // Start track t over [start, start + length) of the file
+  bool beginTrack(uint8_t t, const FileView& view, uint32_t start, uint32_t length,
+                  TrackStream::Encoding encoding);
 
   // Track streams
   TrackStream* tracks_;     // Array of track streams
@@ -119,7 +203,14 @@ private:
   uint32_t currentUSPerTick_;
 
   // Format info
-  uint16_t format_;         // SMF format (0 or 1)
+  uint16_t format_;         // SMF format (0, 1 or 2)
+  bool sequential_;         // Tracks play one after another (type 2)
+  uint8_t currentTrack_;    // Track playing when sequential
+  uint32_t tickBase_;       // Start tick of the current track when sequential
+
+  // Merge state (a peekEvent() and the popEvent() after it search once)
+  int16_t earliestTrack_;   // Result of the last findEarliestTrack()
+  bool earliestKnown_;      // False once an event has been popped
 
   // File source
   FileSource* fileSource_;  // File source abstraction
@@ -76,12 +76,15 @@ NESAPUEmulator::NESAPUEmulator()
     : AudioStream(0, nullptr)  // 0 inputs, stereo output created in update()
     , registerWriteCount_(0)
     , clockAccumulator_(0)
+    , cpuClocksPerSample_(CPU_CLOCKS_PER_SAMPLE)
+    , frameTimerPeriodUs_(4167.0f)
     , cpuCycleEven_(false)
     , updateCallCount_(0)
     , nonZeroSampleCount_(0)
     , frameStep_(0)
     , frameMode_(false)  // Start in 4-step mode
     , frameIRQDisable_(true)  // IRQ disabled by default
+    , offlineRender_(false)
     , stopping_(false)  // Not stopping
     , lowpassFilterState_(0.0f) {
 
@@ -178,9 +181,34 @@ void NESAPUEmulator::startFrameTimer() {
     // Ensure instance pointer is set (for ISR)
     instance_ = this;
 
-    // Start the frame counter timer at 240Hz (4166.67 microseconds)
+    // Start the frame counter timer at 240Hz (4166.67 microseconds, scaled by playback rate)
     // Note: IntervalTimer.begin() replaces any existing timer
-    frameTimer_.begin(frameCounterISR, 4167);
+    frameTimer_.begin(frameCounterISR, frameTimerPeriodUs_);
+}
+
+void NESAPUEmulator::beginOfflineRender() {
+    stopFrameTimer();
+    offlineRender_ = true;
+    reset();  // Clears stopping_ so frameCounterTick() runs when clocked by hand
+}
+
+void NESAPUEmulator::endOfflineRender() {
+    reset();  // Same idle state VGMPlayer::stop() leaves behind
+    offlineRender_ = false;
+}
+
+void NESAPUEmulator::setPitchScale(float scale) {
+    // Read once per sample by update() - a single float store is atomic on Cortex-M7
+    cpuClocksPerSample_ = CPU_CLOCKS_PER_SAMPLE * scale;
+}
+
+void NESAPUEmulator::setFrameRateScale(float scale) {
+    frameTimerPeriodUs_ = 4167.0f / scale;
+
+    // update() applies the new period from the next tick on, so no step is lost or doubled
+    if (instance_ == this && !stopping_) {
+        frameTimer_.update(frameTimerPeriodUs_);
+    }
 }
 
 void NESAPUEmulator::reset() {
@@ -1290,7 +1318,7 @@ inline float NESAPUEmulator::applyOutputFiltersRight(float x) {
 // AudioStream update method - called at 44.1kHz by Teensy Audio Library ISR
 void NESAPUEmulator::update() {
     // Check stopping flag IMMEDIATELY
-    if (stopping_) {
+    if (stopping_ || offlineRender_) {
         // CRITICAL: NO // Serial.print in Audio ISR!
         return;
     }
@@ -1350,79 +1378,10 @@ void NESAPUEmulator::update() {
     */
 
     // Generate AUDIO_BLOCK_SAMPLES (128) samples (blocks already allocated above)
+    uint8_t channelOut[STEM_COUNT];
     for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
-        // SIMPLIFIED CORRECT IMPLEMENTATION
-        // The nonlinear mixer expects the direct channel outputs (0-15)
-        // NOT band-limited averaged values!
-
-        // Clock APU at 1.789773 MHz (accumulated per sample)
-        // We need to clock ~40.58 CPU cycles per sample
-        clockAccumulator_ += CPU_CLOCKS_PER_SAMPLE;
-
-        // CRITICAL: Different channels clock at different rates!
-        while (clockAccumulator_ >= 1.0f) {
-            // Triangle clocks EVERY CPU cycle (CPU rate)
-            triangle_.clockTimer();
-
-            // DMC also clocks EVERY CPU cycle (but uses its own divider)
-            dmc_.clockTimer();
-
-            // Pulse and noise channels clock on EVERY OTHER CPU cycle (APU rate)
-            if (cpuCycleEven_) {
-                pulse1_.clockTimer();
-                pulse2_.clockTimer();
-                noise_.clockTimer();
-            }
-            cpuCycleEven_ = !cpuCycleEven_;
-            clockAccumulator_ -= 1.0f;
-        }
-
-        // Get the CURRENT output of each channel (this is what the hardware does)
-        // The nonlinear mixer works on the instantaneous channel outputs
-        uint8_t pulse1Out = pulse1_.getOutput();  // Returns 0-15 (volume-scaled)
-        uint8_t pulse2Out = pulse2_.getOutput();  // Returns 0-15 (volume-scaled)
-        uint8_t triangleOut = triangle_.getOutput();  // Returns 0-15 (no volume control)
-        uint8_t noiseOut = noise_.getOutput();  // Returns 0-15 (volume-scaled)
-        uint8_t dmcOut = dmc_.getOutput();  // Returns 0-127 (7-bit DAC)
-
-        // Access global settings
-        extern bool g_nesFiltersEnabled;
-        extern bool g_nesStereoEnabled;
-
-        float outputLeft, outputRight;
-
-        if (g_nesStereoEnabled) {
-            // STEREO MODE: Use stereo mixer with panning
-            mixChannelsStereo(pulse1Out, pulse2Out, triangleOut, noiseOut, dmcOut,
-                            noise_.periodIndex, outputLeft, outputRight);
-
-            // Apply filters separately to each channel if enabled
-            if (g_nesFiltersEnabled) {
-                outputLeft = applyOutputFiltersLeft(outputLeft);
-                outputRight = applyOutputFiltersRight(outputRight);
-            }
-        } else {
-            // MONO MODE: Use original mono mixer (unchanged behavior)
-            float mixed = mixChannels(pulse1Out, pulse2Out, triangleOut, noiseOut, dmcOut);
-
-            // Apply filters if enabled
-            if (g_nesFiltersEnabled) {
-                mixed = applyOutputFilters(mixed);
-            }
-
-            // Same output for both channels
-            outputLeft = outputRight = mixed;
-        }
-
-        // Hard clamp to [-1, 1] before 16-bit conversion to prevent overflow
-        if (outputLeft > 1.0f) outputLeft = 1.0f;
-        else if (outputLeft < -1.0f) outputLeft = -1.0f;
-        if (outputRight > 1.0f) outputRight = 1.0f;
-        else if (outputRight < -1.0f) outputRight = -1.0f;
-
-        // Convert to 16-bit audio (-32768 to +32767)
-        int16_t sampleLeft = (int16_t)(outputLeft * 32767.0f);
-        int16_t sampleRight = (int16_t)(outputRight * 32767.0f);
+        int16_t sampleLeft, sampleRight;
+        generateSample(channelOut, sampleLeft, sampleRight);
 
         // Count non-zero samples for debugging
         if (sampleLeft != 0 || sampleRight != 0) {
@@ -1443,6 +1402,102 @@ void NESAPUEmulator::update() {
     release(blockRight);
 }
 
+// Clock all channels by one output sample and mix them
+// Shared by the audio ISR (update) and offline rendering (renderSample)
+void NESAPUEmulator::generateSample(uint8_t* channelOut, int16_t& sampleLeft, int16_t& sampleRight) {
+    // SIMPLIFIED CORRECT IMPLEMENTATION
+    // The nonlinear mixer expects the direct channel outputs (0-15)
+    // NOT band-limited averaged values!
+
+    // Clock APU at 1.789773 MHz (accumulated per sample)
+    // We need to clock ~40.58 CPU cycles per sample (scaled by setPitchScale)
+    clockAccumulator_ += cpuClocksPerSample_;
+
+    // CRITICAL: Different channels clock at different rates!
+    while (clockAccumulator_ >= 1.0f) {
+        // Triangle clocks EVERY CPU cycle (CPU rate)
+        triangle_.clockTimer();
+
+        // DMC also clocks EVERY CPU cycle (but uses its own divider)
+        dmc_.clockTimer();
+
+        // Pulse and noise channels clock on EVERY OTHER CPU cycle (APU rate)
+        if (cpuCycleEven_) {
+            pulse1_.clockTimer();
+            pulse2_.clockTimer();
+            noise_.clockTimer();
+        }
+        cpuCycleEven_ = !cpuCycleEven_;
+        clockAccumulator_ -= 1.0f;
+    }
+
+    // Get the CURRENT output of each channel (this is what the hardware does)
+    // The nonlinear mixer works on the instantaneous channel outputs
+    uint8_t pulse1Out = pulse1_.getOutput();  // Returns 0-15 (volume-scaled)
+    uint8_t pulse2Out = pulse2_.getOutput();  // Returns 0-15 (volume-scaled)
+    uint8_t triangleOut = triangle_.getOutput();  // Returns 0-15 (no volume control)
+    uint8_t noiseOut = noise_.getOutput();  // Returns 0-15 (volume-scaled)
+    uint8_t dmcOut = dmc_.getOutput();  // Returns 0-127 (7-bit DAC)
+
+    channelOut[STEM_PULSE1] = pulse1Out;
+    channelOut[STEM_PULSE2] = pulse2Out;
+    channelOut[STEM_TRIANGLE] = triangleOut;
+    channelOut[STEM_NOISE] = noiseOut;
+    channelOut[STEM_DMC] = dmcOut;
+
+    // Access global settings
+    extern bool g_nesFiltersEnabled;
+    extern bool g_nesStereoEnabled;
+
+    float outputLeft, outputRight;
+
+    if (g_nesStereoEnabled) {
+        // STEREO MODE: Use stereo mixer with panning
+        mixChannelsStereo(pulse1Out, pulse2Out, triangleOut, noiseOut, dmcOut,
+                        noise_.periodIndex, outputLeft, outputRight);
+
+        // Apply filters separately to each channel if enabled
+        if (g_nesFiltersEnabled) {
+            outputLeft = applyOutputFiltersLeft(outputLeft);
+            outputRight = applyOutputFiltersRight(outputRight);
+        }
+    } else {
+        // MONO MODE: Use original mono mixer (unchanged behavior)
+        float mixed = mixChannels(pulse1Out, pulse2Out, triangleOut, noiseOut, dmcOut);
+
+        // Apply filters if enabled
+        if (g_nesFiltersEnabled) {
+            mixed = applyOutputFilters(mixed);
+        }
+
+        // Same output for both channels
+        outputLeft = outputRight = mixed;
+    }
+
+    // Hard clamp to [-1, 1] before 16-bit conversion to prevent overflow
+    if (outputLeft > 1.0f) outputLeft = 1.0f;
+    else if (outputLeft < -1.0f) outputLeft = -1.0f;
+    if (outputRight > 1.0f) outputRight = 1.0f;
+    else if (outputRight < -1.0f) outputRight = -1.0f;
+
+    // Convert to 16-bit audio (-32768 to +32767)
+    sampleLeft = (int16_t)(outputLeft * 32767.0f);
+    sampleRight = (int16_t)(outputRight * 32767.0f);
+}
+
+// Offline render of one sample: the mix exactly as update() produces it, plus
+// each channel run alone through the nonlinear mixer (no filters/panning)
+void NESAPUEmulator::renderSample(int16_t* stems, int16_t& mixLeft, int16_t& mixRight) {
+    uint8_t channelOut[STEM_COUNT];
+    generateSample(channelOut, mixLeft, mixRight);
+
+    stems[STEM_PULSE1] = (int16_t)(mixChannels(channelOut[STEM_PULSE1], 0, 0, 0, 0) * 32767.0f);
+    stems[STEM_PULSE2] = (int16_t)(mixChannels(0, channelOut[STEM_PULSE2], 0, 0, 0) * 32767.0f);
+    stems[STEM_TRIANGLE] = (int16_t)(mixChannels(0, 0, channelOut[STEM_TRIANGLE], 0, 0) * 32767.0f);
+    stems[STEM_NOISE] = (int16_t)(mixChannels(0, 0, 0, channelOut[STEM_NOISE], 0) * 32767.0f);
+    stems[STEM_DMC] = (int16_t)(mixChannels(0, 0, 0, 0, channelOut[STEM_DMC]) * 32767.0f);
+}
+
 // Frame counter ISR - called at 240Hz
 void NESAPUEmulator::frameCounterISR() {
     // CRITICAL: Get local copy of instance pointer first
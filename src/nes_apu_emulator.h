@@ -45,6 +45,35 @@ public:
     // Start the frame counter timer (call when playback begins)
     void startFrameTimer();
 
+    // ========== Playback Rate / Pitch ==========
+    // Scale channel timer clocks (1.0 = normal, 2.0 = one octave up). Envelopes,
+    // sweeps and length counters are frame-counter driven and are not affected.
+    void setPitchScale(float scale);
+
+    // Scale the 240Hz frame counter to follow a faster/slower song clock.
+    // Takes effect immediately if the frame timer is running.
+    void setFrameRateScale(float scale);
+
+    // ========== Offline Rendering (stem export) ==========
+    // Stem order for renderSample()
+    enum Stem { STEM_PULSE1, STEM_PULSE2, STEM_TRIANGLE, STEM_NOISE, STEM_DMC, STEM_COUNT };
+
+    // Frame counter rate - offline callers clock it themselves (no IntervalTimer)
+    static constexpr uint32_t FRAME_COUNTER_HZ = 240;
+
+    // Synthesize one 44.1kHz sample without the Audio Library: fills stems[STEM_COUNT]
+    // with each channel mixed alone, plus the full stereo mix as update() would output
+    void renderSample(int16_t* stems, int16_t& mixLeft, int16_t& mixRight);
+
+    // Advance the frame counter by one step (240Hz) - offline counterpart of the ISR
+    void clockFrameCounter() { frameCounterTick(); }
+
+    // Take the (static, always-linked) instance off the audio graph for offline use:
+    // stops the frame timer, resets, and makes update() return without output.
+    // Only valid while no VGM is playing. endOfflineRender() resets to idle again.
+    void beginOfflineRender();
+    void endOfflineRender();
+
 private:
     // APU clock rate (NTSC)
     static constexpr float CPU_CLOCK_HZ = 1789773.0f;
@@ -345,9 +374,12 @@ private:
     volatile uint8_t frameStep_;       // Current frame step (0-3 or 0-4)
     volatile bool frameMode_;          // false = 4-step, true = 5-step
     volatile bool frameIRQDisable_;    // IRQ inhibit flag
+    volatile bool offlineRender_;      // update() yields to renderSample()
 
     // Clock accumulator for sub-sample accuracy
     float clockAccumulator_;
+    float cpuClocksPerSample_;     // CPU_CLOCKS_PER_SAMPLE x pitch scale
+    float frameTimerPeriodUs_;     // Frame counter period (4167us at normal rate)
 
     // APU cycle tracking (pulse channels clock every 2 CPU cycles)
     bool cpuCycleEven_;
@@ -374,6 +406,9 @@ private:
     static void frameCounterISR();  // ISR callback (must be static)
     void frameCounterTick();        // Frame counter logic (240Hz)
 
+    // Clock every channel by one output sample and mix (update() and renderSample())
+    void generateSample(uint8_t* channelOut, int16_t& sampleLeft, int16_t& sampleRight);
+
     // Nonlinear mixing (from NESdev wiki - CRITICAL for authentic sound!)
     float mixChannels(uint8_t pulse1Out, uint8_t pulse2Out, uint8_t triangleOut, uint8_t noiseOut, uint8_t dmcOut);
 
@@ -0,0 +1,251 @@
+#include "opl_remap.h"
+#include <OPL3Duo.h>
+
+OPLRemapper::OPLRemapper()
+  : opl_(nullptr),
+    splitStereo_(false),
+    pitchQ12_(PITCH_UNITY),
+    batchCount_(0) {
+  waveSelectEnabled_[0] = waveSelectEnabled_[1] = false;
+  memset(rawWaveform_, 0, sizeof(rawWaveform_));
+  memset(freq_, 0, sizeof(freq_));
+  memset(shadow_, 0, sizeof(shadow_));
+  memset(shadowValid_, 0, sizeof(shadowValid_));
+  resetStats();
+}
+
+void OPLRemapper::begin(OPL3Duo* opl, ChipType chipType, DualOPL2Stereo stereo) {
+  opl_ = opl;
+  reset();
+  resetStats();
+  if (!opl_) return;
+
+  splitStereo_ = (chipType == ChipType::DUAL_OPL2 && stereo == DualOPL2Stereo::SPLIT);
+
+  if (chipType == ChipType::YMF262_OPL3 || chipType == ChipType::DUAL_OPL3) {
+    // Enable OPL3 mode on both chips
+    opl_->setOPL3Enabled(0, true);
+    if (chipType == ChipType::DUAL_OPL3) {
+      opl_->setOPL3Enabled(1, true);
+    }
+  } else if (splitStereo_) {
+    // OPL3 mode is needed for the L/R output bits in C0-C8
+    opl_->setOPL3Enabled(0, true);
+    opl_->setOPL3Enabled(1, true);
+    delay(5);  // Mode change settling time before the seed writes below
+
+    // With NEW=1 a channel with no output bits is silent, and OPL2 files are not
+    // required to write C0-C8 at all - seed each channel with its chip's side
+    for (uint8_t ch = 0; ch < 9; ch++) {
+      write(0x5A, 0xC0 + ch, 0x00);
+      write(0xAA, 0xC0 + ch, 0x00);
+    }
+    flush();
+    resetStats();
+  } else {
+    // OPL2 mode - disable OPL3 features
+    opl_->setOPL3Enabled(0, false);
+    if (chipType == ChipType::DUAL_OPL2) {
+      opl_->setOPL3Enabled(1, false);
+    }
+  }
+}
+
+void OPLRemapper::reset() {
+  batchCount_ = 0;
+  waveSelectEnabled_[0] = waveSelectEnabled_[1] = false;
+  memset(rawWaveform_, 0, sizeof(rawWaveform_));
+  memset(freq_, 0, sizeof(freq_));
+  memset(shadowValid_, 0, sizeof(shadowValid_));
+}
+
+void OPLRemapper::write(uint8_t vgmCmd, uint8_t reg, uint8_t val) {
+  stats_.writesIn++;
+
+  switch (vgmCmd) {
+    case 0x5A:  // YM3812 chip 0
+      emit(0, reg, splitStereo_ ? remapSplitStereo(0, reg, val) : val);
+      break;
+    case 0xAA:  // YM3812 chip 1
+      emit(1, reg, splitStereo_ ? remapSplitStereo(1, reg, val) : val);
+      break;
+    case 0x5E:  // YMF262 chip 0 port 0
+      emit(0, reg, val);
+      break;
+    case 0x5F:  // YMF262 chip 0 port 1
+      emit(0, 0x100 | reg, val);
+      break;
+    case 0xAE:  // YMF262 chip 1 port 0
+      emit(1, reg, val);
+      break;
+    case 0xAF:  // YMF262 chip 1 port 1
+      emit(1, 0x100 | reg, val);
+      break;
+  }
+}
+
+void OPLRemapper::setPitchScale(float scale) {
+  uint16_t pitch = (uint16_t)(scale * PITCH_UNITY + 0.5f);
+  if (pitch == pitchQ12_) return;
+  pitchQ12_ = pitch;
+
+  // Re-pitch every channel the file has touched (Bx is re-sent with its current
+  // key-on bit, so sounding notes change pitch without a retrigger)
+  for (uint8_t unit = 0; unit < 2; unit++) {
+    for (uint8_t port = 0; port < 2; port++) {
+      for (uint8_t ch = 0; ch < 9; ch++) {
+        if (freq_[unit][port][ch].valid) {
+          queueFrequency(unit, port, ch, false);
+        }
+      }
+    }
+  }
+}
+
+void OPLRemapper::emit(uint8_t unit, uint16_t reg, uint8_t val) {
+  uint8_t low = reg & 0xFF;
+  bool isFnum = (low >= 0xA0 && low <= 0xA8);
+  bool isKeyBlock = (low >= 0xB0 && low <= 0xB8);
+
+  if (!isFnum && !isKeyBlock) {
+    queue(unit, reg, val);
+    return;
+  }
+
+  // Latch raw values even at unity pitch so a later pitch change can re-emit them
+  FrequencyLatch& f = freq_[unit][reg >> 8][low & 0x0F];
+  if (isFnum) {
+    f.fnumLow = val;
+    f.valid |= 0x01;
+  } else {
+    f.keyBlock = val;
+    f.valid |= 0x02;
+  }
+
+  if (pitchQ12_ == PITCH_UNITY) {
+    queue(unit, reg, val);
+  } else {
+    queueFrequency(unit, reg >> 8, low & 0x0F, isKeyBlock);
+  }
+}
+
+void OPLRemapper::queueFrequency(uint8_t unit, uint8_t port, uint8_t ch, bool keyWrite) {
+  const FrequencyLatch& f = freq_[unit][port][ch];
+  uint16_t base = (uint16_t)port << 8;
+
+  uint32_t fnum = f.fnumLow | ((f.keyBlock & 0x03) << 8);
+  uint8_t block = (f.keyBlock >> 2) & 0x07;
+
+  // Scale in Q12, then keep the F-number in 512-1023 (best resolution) by moving the block
+  uint32_t scaled = fnum * pitchQ12_;
+  while (scaled > (1023UL << 12) && block < 7) {
+    scaled >>= 1;
+    block++;
+  }
+  while (scaled < (512UL << 12) && block > 0) {
+    scaled <<= 1;
+    block--;
+  }
+  uint32_t out = (scaled + (1UL << 11)) >> 12;
+  if (out > 1023) out = 1023;
+
+  // Ax before Bx, so a key-on never sounds at the old frequency. Bx also goes
+  // out after a lone Ax write, because renormalizing may have moved the block.
+  queue(unit, base | (0xA0 + ch), out & 0xFF);
+  if (keyWrite || (f.valid & 0x02)) {
+    queue(unit, base | (0xB0 + ch), (f.keyBlock & 0xE0) | (block << 2) | (out >> 8));
+  }
+}
+
+uint8_t OPLRemapper::remapSplitStereo(uint8_t unit, uint8_t reg, uint8_t val) {
+  if (reg == 0x01) {
+    // Test/WSE register - OPL3 ignores WSE in NEW mode, so we apply it ourselves.
+    // The OPL2 keeps its waveform latches while WSE is off, so re-emit them on change.
+    bool wse = (val & 0x20) != 0;
+    if (wse != waveSelectEnabled_[unit]) {
+      waveSelectEnabled_[unit] = wse;
+      for (uint8_t op = 0; op < 0x16; op++) {
+        queue(unit, 0xE0 + op, wse ? (rawWaveform_[unit][op] & 0x03) : 0x00);
+      }
+    }
+  } else if (reg >= 0xC0 && reg <= 0xC8) {
+    // Feedback/connection + output bits: chip 0 = left (A), chip 1 = right (B)
+    val = (val & 0x0F) | (unit == 0 ? 0x10 : 0x20);
+  } else if (reg >= 0xE0 && reg <= 0xF5) {
+    // OPL2 only has waveforms 0-3, and only while WSE is set
+    rawWaveform_[unit][reg - 0xE0] = val;
+    val = waveSelectEnabled_[unit] ? (val & 0x03) : 0x00;
+  }
+  return val;
+}
+
+bool OPLRemapper::isOrderedRegister(uint16_t reg) {
+  // Key-on (B0-B8), rhythm (BD) and mode registers trigger envelopes or change
+  // how other registers are interpreted - nothing may be reordered across them
+  uint8_t low = reg & 0xFF;
+  if (low >= 0xB0 && low <= 0xB8) return true;
+  if (reg == 0x0BD || reg == 0x104 || reg == 0x105) return true;
+  return false;
+}
+
+bool OPLRemapper::isPassThroughRegister(uint16_t reg) {
+  // Timer values and timer control/IRQ reset act on every write
+  return reg >= 0x02 && reg <= 0x04;
+}
+
+void OPLRemapper::queue(uint8_t unit, uint16_t reg, uint8_t val) {
+  // Collapse into an earlier write to the same register in this time slice,
+  // as long as no ordered write for this unit lies between them
+  if (!isOrderedRegister(reg) && !isPassThroughRegister(reg)) {
+    for (int i = batchCount_ - 1; i >= 0; i--) {
+      PendingWrite& w = batch_[i];
+      if (w.unit != unit) continue;
+      if (w.reg == reg) {
+        w.value = val;
+        stats_.writesMerged++;
+        return;
+      }
+      if (isOrderedRegister(w.reg)) break;
+    }
+  }
+
+  if (batchCount_ >= MAX_BATCH) {
+    flush();
+  }
+
+  PendingWrite& w = batch_[batchCount_++];
+  w.unit = unit;
+  w.reg = reg;
+  w.value = val;
+}
+
+void OPLRemapper::flush() {
+  if (batchCount_ == 0 || !opl_) {
+    batchCount_ = 0;
+    return;
+  }
+
+  uint32_t startCycles = ARM_DWT_CYCCNT;
+
+  for (uint8_t i = 0; i < batchCount_; i++) {
+    const PendingWrite& w = batch_[i];
+    uint32_t bit = 1UL << (w.reg & 31);
+    uint32_t& valid = shadowValid_[w.unit][w.reg >> 5];
+
+    if (!isPassThroughRegister(w.reg) && (valid & bit) && shadow_[w.unit][w.reg] == w.value) {
+      stats_.writesDropped++;
+      continue;
+    }
+
+    // setChipRegister keeps the library's own register shadow in sync
+    opl_->setChipRegister(w.unit, w.reg, w.value);
+    shadow_[w.unit][w.reg] = w.value;
+    valid |= bit;
+    stats_.writesIssued++;
+  }
+
+  // Converted now: the ARM clock may change before the stats are printed
+  stats_.busNanos += (uint64_t)(ARM_DWT_CYCCNT - startCycles) * 1000 / (F_CPU_ACTUAL / 1000000);
+  stats_.batches++;
+  batchCount_ = 0;
+}
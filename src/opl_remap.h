@@ -0,0 +1,140 @@
+#pragma once
+#include <Arduino.h>
+#include "vgm_file.h"  // For ChipType
+
+class OPL3Duo;
+
+/**
+ * OPLRemapper - Translates VGM OPL writes into OPL3 Duo register space
+ *
+ * VGM files address OPL chips by command byte (0x5A/0xAA = YM3812 chip 0/1,
+ * 0x5E/0x5F/0xAE/0xAF = YMF262 chip 0/1 port 0/1). The OPL3 Duo board has two
+ * YMF262s, so every VGM OPL flavour is mapped onto (synth unit, 9-bit register)
+ * once per command here instead of inside the command dispatcher.
+ *
+ * Writes are queued and issued at each VGM wait boundary (flush()):
+ * - A write whose value matches the last value sent to that register is dropped
+ * - Repeated writes to the same register in one time slice collapse to the last
+ *   value, unless a key-on/rhythm/mode write sits between them (order matters)
+ * - Timer registers (0x02-0x04) always pass through untouched
+ * The writes that remain still go out one setChipRegister() each, with the
+ * library's full address/data waits - the saving is only in writes that never
+ * reach the bus, not in a faster bus cycle.
+ *
+ * Grouped bus transactions (one transaction per batch with shorter waits) are
+ * deliberately not done. The bus cycle is OPL3Duo's write routine in
+ * ArduinoOPL2, which lib_deps fetches at build time and is not in this tree.
+ * Replacing it means re-deriving its pin sequence and the YMF262 wait times
+ * with nothing to check them against here, and a short wait corrupts
+ * registers silently instead of failing. tools/host/opl_remap checks the
+ * issued stream against the raw one and reports the batch sizes such a path
+ * would get.
+ *
+ * Dual OPL2 stereo:
+ *   A real dual-OPL2 card (SB Pro 1) wires chip 0 left and chip 1 right. In
+ *   SPLIT mode both YMF262s run with NEW=1 and every C0-C8 write is rewritten
+ *   to carry the chip's L/R output bits. Waveform registers are masked back to
+ *   the four OPL2 waveforms (or forced to sine while WSE is off) since OPL3
+ *   mode would otherwise expose waveforms 4-7 and ignore the OPL2 WSE gate.
+ *   CENTERED keeps both chips in OPL2 mode, mixed to both speakers.
+ *
+ * Pitch scaling:
+ *   setPitchScale() rewrites every A0-A8/B0-B8 pair so the F-number is scaled
+ *   and renormalized into the 512-1023 range by moving the block (octave). The
+ *   file's raw F-number/block/key-on values are latched per channel, so a pitch
+ *   change mid-song re-emits all channels without retriggering notes.
+ */
+class OPLRemapper {
+public:
+  enum class DualOPL2Stereo : uint8_t {
+    CENTERED,  // Both chips in both speakers (OPL2 mode)
+    SPLIT      // Chip 0 hard left, chip 1 hard right (OPL3 mode + panning)
+  };
+
+  struct Stats {
+    uint32_t writesIn;       // Register writes requested by the VGM stream
+    uint32_t writesIssued;   // Writes that reached the bus
+    uint32_t writesDropped;  // Redundant writes (same value as shadow)
+    uint32_t writesMerged;   // Writes collapsed into a later one in the same batch
+    uint32_t batches;        // Non-empty flushes
+    uint64_t busNanos;       // Wall time of the issued writes in flush() (valid across clock changes)
+  };
+
+  OPLRemapper();
+
+  /**
+   * Configure chip modes for a new file and clear shadow/batch state
+   * @param opl - OPL3 Duo instance (from OPL3Synth::getOPL())
+   * @param chipType - Chip type reported by the VGM header
+   * @param stereo - Stereo placement for DUAL_OPL2 files (ignored otherwise)
+   */
+  void begin(OPL3Duo* opl, ChipType chipType, DualOPL2Stereo stereo);
+
+  /**
+   * Forget shadow and pending writes (call after a hardware reset)
+   */
+  void reset();
+
+  /**
+   * Queue a VGM OPL write
+   * @param vgmCmd - VGM command byte (0x5A, 0xAA, 0x5E, 0x5F, 0xAE, 0xAF)
+   */
+  void write(uint8_t vgmCmd, uint8_t reg, uint8_t val);
+
+  /**
+   * Issue all queued writes to the chips (call at each wait boundary)
+   */
+  void flush();
+
+  /**
+   * Scale all channel frequencies (1.0 = unchanged, 0.5-2.0 useful range)
+   * Sounding notes are re-pitched at the next flush()
+   */
+  void setPitchScale(float scale);
+
+  bool isSplitStereo() const { return splitStereo_; }
+  const Stats& getStats() const { return stats_; }
+  void resetStats() { memset(&stats_, 0, sizeof(stats_)); }
+
+private:
+  static const uint8_t MAX_BATCH = 128;
+
+  struct PendingWrite {
+    uint16_t reg;    // 9-bit register (bit 8 = port 1)
+    uint8_t unit;    // Synth unit (chip 0/1)
+    uint8_t value;
+  };
+
+  // Frequency registers as written by the file, per unit/port/channel
+  struct FrequencyLatch {
+    uint8_t fnumLow;   // Ax value
+    uint8_t keyBlock;  // Bx value (key-on, block, F-number bits 8-9)
+    uint8_t valid;     // Bit 0 = Ax seen, bit 1 = Bx seen
+  };
+
+  static const uint16_t PITCH_UNITY = 4096;  // Q12 pitch scale
+
+  void emit(uint8_t unit, uint16_t reg, uint8_t val);
+  void queueFrequency(uint8_t unit, uint8_t port, uint8_t ch, bool keyWrite);
+  void queue(uint8_t unit, uint16_t reg, uint8_t val);
+  uint8_t remapSplitStereo(uint8_t unit, uint8_t reg, uint8_t val);
+  static bool isOrderedRegister(uint16_t reg);
+  static bool isPassThroughRegister(uint16_t reg);
+
+  OPL3Duo* opl_;
+  bool splitStereo_;
+  bool waveSelectEnabled_[2];    // OPL2 WSE bit (reg 0x01 bit 5) per chip
+  uint8_t rawWaveform_[2][0x16]; // Unmasked E0-F5 values as written by the file
+
+  uint16_t pitchQ12_;
+  FrequencyLatch freq_[2][2][9];
+
+  PendingWrite batch_[MAX_BATCH];
+  uint8_t batchCount_;
+
+  // Last value sent per unit/port/register, with valid bits (unknown after reset)
+  uint8_t shadow_[2][512];
+  uint32_t shadowValid_[2][512 / 32];
+
+  Stats stats_;
+};
@@ -2,6 +2,7 @@
 #define PLAYER_CONFIG_H
 
 #include <Audio.h>
+#include "audio_mixer_fused.h"
 
 // Forward declarations
 class OPL3Synth;
@@ -11,8 +12,10 @@ class NESAPUEmulator;
 class GameBoyAPU;
 class GenesisBoard;
 class DACPrerenderer;
+class DACPrerenderCache;
 class AudioStreamSPC;
 class AudioStreamDACPrerender;
+class AudioEffectReverbPSRAM;
 
 /**
  * PlayerConfig - Dependency Injection Container
@@ -59,15 +62,15 @@ struct PlayerConfig {
     /**
      * Main audio mixers (channel 0 = OPL3, channel 1 = PCM/APU, channel 2 = Drums)
      */
-    AudioMixer4* mixerLeft = nullptr;
-    AudioMixer4* mixerRight = nullptr;
+    AudioMixerStage* mixerLeft = nullptr;
+    AudioMixerStage* mixerRight = nullptr;
 
     /**
      * Submixer for channel 1 (DAC/NES premixer on ch0, SPC on ch1, GB on ch2)
      * VGM and SPC players use this instead of main mixer
      */
-    AudioMixer4* mixerChannel1Left = nullptr;
-    AudioMixer4* mixerChannel1Right = nullptr;
+    AudioMixerStage* mixerChannel1Left = nullptr;
+    AudioMixerStage* mixerChannel1Right = nullptr;
 
     /**
      * DAC/NES Pre-mixer (combines DAC Prerender, NES APU, FM9 audio)
@@ -78,8 +81,8 @@ struct PlayerConfig {
      * Output feeds into mixerChannel1 channel 0
      * VGMPlayer controls muting here for DAC/NES, not on submixer
      */
-    AudioMixer4* dacNesMixerLeft = nullptr;
-    AudioMixer4* dacNesMixerRight = nullptr;
+    AudioMixerStage* dacNesMixerLeft = nullptr;
+    AudioMixerStage* dacNesMixerRight = nullptr;
 
     /**
      * FM9 Audio Pre-mixer (combines WAV and MP3 streams)
@@ -88,28 +91,28 @@ struct PlayerConfig {
      * Output feeds into dacNesMixer channel 3
      * FM9Player controls muting here for WAV/MP3 individually
      */
-    AudioMixer4* fm9AudioMixerLeft = nullptr;
-    AudioMixer4* fm9AudioMixerRight = nullptr;
+    AudioMixerStage* fm9AudioMixerLeft = nullptr;
+    AudioMixerStage* fm9AudioMixerRight = nullptr;
 
     /**
      * Fade mixers (for VGM loop fadeout and muting)
      * Channel 0 = main signal
      */
-    AudioMixer4* fadeMixerLeft = nullptr;
-    AudioMixer4* fadeMixerRight = nullptr;
+    AudioMixerStage* fadeMixerLeft = nullptr;
+    AudioMixerStage* fadeMixerRight = nullptr;
 
     /**
      * Final mixers (dry + wet reverb blend)
      * Used by: MIDI player for reverb effect
      */
-    AudioMixer4* finalMixerLeft = nullptr;
-    AudioMixer4* finalMixerRight = nullptr;
+    AudioMixerStage* finalMixerLeft = nullptr;
+    AudioMixerStage* finalMixerRight = nullptr;
 
     /**
-     * Reverb effects (MIDI only)
+     * Reverb effect (MIDI only, wet return on finalMixer ch1)
+     * nullptr if PSRAM is missing - MIDI then plays dry
      */
-    AudioEffectFreeverb* reverbLeft = nullptr;
-    AudioEffectFreeverb* reverbRight = nullptr;
+    AudioEffectReverbPSRAM* reverb = nullptr;
 
     // ============================================
     // OPTIONAL DEPENDENCIES (can be nullptr)
@@ -150,6 +153,13 @@ struct PlayerConfig {
      */
     DACPrerenderer* dacPrerenderer = nullptr;
 
+    /**
+     * Persistent cache of pre-rendered DAC files (keyed by VGM content)
+     * Repeat plays of a Genesis track load the cached render instead of re-rendering
+     * If nullptr, every load pre-renders into /TEMP/~dac.tmp
+     */
+    DACPrerenderCache* dacPrerenderCache = nullptr;
+
     /**
      * DAC prerender audio stream (for pre-rendered Genesis DAC playback)
      * Plays back pre-rendered DAC file with perfect timing synchronization
@@ -177,9 +187,9 @@ struct PlayerConfig {
 
     /**
      * Enable reverb effect for MIDI playback
-     * (adds ambience and depth)
+     * (adds ambience and depth - off by default, see audio_effect_reverb_psram.h)
      */
-    bool reverbEnabled = true;
+    bool reverbEnabled = false;
 
     /**
      * VGM loop configuration
@@ -221,7 +231,7 @@ struct PlayerConfig {
      * - fileSource != nullptr
      * - All core mixer pointers != nullptr
      *
-     * Note: Reverb was removed to save RAM. fm9AudioMixer is optional.
+     * Note: reverb and fm9AudioMixer are optional.
      */
     bool isValid() const {
         bool valid = fileSource != nullptr &&
@@ -235,7 +245,7 @@ struct PlayerConfig {
                      fadeMixerRight != nullptr &&
                      finalMixerLeft != nullptr &&
                      finalMixerRight != nullptr;
-        // Note: reverbLeft/Right removed (reverb disabled to save RAM)
+        // Note: reverb is optional (needs PSRAM)
         // Note: fm9AudioMixerLeft/Right are optional (FM9 audio is optional)
 
         return valid;
@@ -1,5 +1,6 @@
 #include "player_manager.h"
 #include "audio_system.h"
+#include "audio_globals.h"
 #include "midi_player.h"
 #include "vgm_player.h"
 #include "fm9_player.h"
@@ -29,8 +30,7 @@ PlayerManager::PlayerManager(const PlayerConfig& config)
     , finalMixerRight_(config.finalMixerRight)
     , fadeMixerLeft_(config.fadeMixerLeft)
     , fadeMixerRight_(config.fadeMixerRight)
-    , reverbLeft_(config.reverbLeft)
-    , reverbRight_(config.reverbRight)
+    , reverb_(config.reverb)
     , crossfeedEnabled_(config.crossfeedEnabled)
     , reverbEnabled_(config.reverbEnabled)
     , playbackState_(PlaybackState::getInstance())
@@ -40,6 +40,8 @@ PlayerManager::PlayerManager(const PlayerConfig& config)
     , stopCompleteCallback_(nullptr)
     , naturalCompletionCallback_(nullptr)
     , pendingFormat_(FileFormat::UNKNOWN)
+    , seekMuted_(false)
+    , seekDoneSample_(0)
 {
     // // Serial.println("[PlayerManager] Created");
 }
@@ -197,6 +199,12 @@ void PlayerManager::setNaturalCompletionCallback(NaturalCompletionCallback callb
 void PlayerManager::update() {
     if (!currentPlayer_) return;
 
+    // Seek mute held long enough - ramp back in (over one block)
+    if (seekMuted_ && audioClock.blockStart() - seekDoneSample_ >= SEEK_MUTE_BLOCKS * AUDIO_BLOCK_SAMPLES) {
+        seekMuted_ = false;
+        AudioSystem::setFadeGain(*fadeMixerLeft_, *fadeMixerRight_, 1.0f);
+    }
+
     // Update the player
     currentPlayer_->update();
 
@@ -221,6 +229,22 @@ void PlayerManager::resume() {
     currentPlayer_->resume();
 }
 
+bool PlayerManager::seekToMs(uint32_t positionMs) {
+    if (!currentPlayer_) return false;
+    if (!currentPlayer_->isPlaying() && !currentPlayer_->isPaused()) return false;
+
+    // Silence the jump itself. Gain changes take effect at the next audio
+    // interrupt, so unmuting right after the seek could skip the mute
+    // entirely - update() lifts it once the ISR has rendered silence.
+    AudioSystem::setFadeGain(*fadeMixerLeft_, *fadeMixerRight_, 0.0f);
+    bool ok = currentPlayer_->seekToMs(positionMs);
+    seekMuted_ = true;
+    seekDoneSample_ = audioClock.blockStart();
+
+    Serial.printf("[PlayerManager] Seek to %lu ms %s\n", positionMs, ok ? "OK" : "not supported");
+    return ok;
+}
+
 // ========================================
 // State Queries
 // ========================================
@@ -313,7 +337,8 @@ FileFormat PlayerManager::detectFormat(const char* path) const {
 
     // Case-insensitive comparison
     if (strcasecmp(ext, "mid") == 0 || strcasecmp(ext, "midi") == 0 ||
-        strcasecmp(ext, "smf") == 0 || strcasecmp(ext, "kar") == 0) {
+        strcasecmp(ext, "smf") == 0 || strcasecmp(ext, "kar") == 0 ||
+        strcasecmp(ext, "rmi") == 0 || strcasecmp(ext, "xmi") == 0) {
         return FileFormat::MIDI;
     }
 
@@ -362,6 +387,7 @@ void PlayerManager::centralizedPlay() {
     // NOTE: Currently players also call setFadeGain(1.0) - this is DUPLICATION
     // TODO Phase 4.1: Remove setFadeGain from all player play() methods
     // TODO Phase 4.1: Remove enableCrossfeed/enableReverb from MidiPlayer play()
+    seekMuted_ = false;
     AudioSystem::setFadeGain(*fadeMixerLeft_, *fadeMixerRight_, 1.0f);
 
     // STEP 3: Call player's play() method (player handles its own logic)
@@ -374,7 +400,8 @@ void PlayerManager::centralizedStop() {
     // STEP 1: Call player's stop() method
     currentPlayer_->stop();
 
-    // STEP 2: MUTE audio (centralized)
+    // STEP 2: MUTE audio (centralized) - and drop a pending seek unmute
+    seekMuted_ = false;
     AudioSystem::setFadeGain(*fadeMixerLeft_, *fadeMixerRight_, 0.0f);
 
     // STEP 3: Mute line-in (hardware synthesizers)
@@ -420,29 +447,38 @@ void PlayerManager::centralizedStop() {
 }
 
 void PlayerManager::applyFormatSpecificEffects(FileFormat format, bool enable) {
-    // Only MIDI gets crossfeed (reverb removed to save ~50KB RAM)
+    // Only MIDI gets crossfeed and reverb
     if (format == FileFormat::MIDI) {
         // Apply crossfeed if user preference allows
         if (crossfeedEnabled_) {
             AudioSystem::enableCrossfeed(*mixerLeft_, *mixerRight_, enable);
         }
 
-        // Reverb removed to save ~50KB RAM
-        // if (reverbEnabled_) {
-        //     AudioSystem::enableReverb(*finalMixerLeft_, *finalMixerRight_,
-        //                              *reverbLeft_, *reverbRight_, enable);
-        // }
+        // Apply reverb if user preference allows (and PSRAM is present)
+        if (reverb_ && (reverbEnabled_ || !enable)) {
+            AudioSystem::enableReverb(*finalMixerLeft_, *finalMixerRight_, *reverb_, enable);
+        }
     } else {
         // All other formats: ensure effects are disabled
         if (!enable) {
             AudioSystem::enableCrossfeed(*mixerLeft_, *mixerRight_, false);
-            // Reverb removed to save ~50KB RAM
-            // AudioSystem::enableReverb(*finalMixerLeft_, *finalMixerRight_,
-            //                          *reverbLeft_, *reverbRight_, false);
+            if (reverb_) {
+                AudioSystem::enableReverb(*finalMixerLeft_, *finalMixerRight_, *reverb_, false);
+            }
         }
     }
 }
 
+void PlayerManager::setReverbEnabled(bool enabled) {
+    if (reverbEnabled_ == enabled) return;
+    reverbEnabled_ = enabled;
+
+    // Takes effect immediately if MIDI is playing
+    if (reverb_ && currentFormat_ == FileFormat::MIDI && (isPlaying() || isPaused())) {
+        AudioSystem::enableReverb(*finalMixerLeft_, *finalMixerRight_, *reverb_, enabled);
+    }
+}
+
 // ========================================
 // Optional Components (for GUI integration)
 // ========================================
@@ -9,8 +9,8 @@
 class OPL3Synth;
 class FileSource;
 class DrumSamplerV2;
-class AudioMixer4;
-class AudioEffectFreeverb;
+class AudioMixerStage;
+class AudioEffectReverbPSRAM;
 class EventManager;
 class ScreenManager;
 
@@ -133,6 +133,14 @@ public:
     void pause();
     void resume();
 
+    /**
+     * Seek the current player (fade stage muted around the jump)
+     * The mute holds for SEEK_MUTE_BLOCKS audio blocks after the seek returns,
+     * then update() ramps the fade stage back up over one block.
+     * @return false if nothing is playing or the player can't seek
+     */
+    bool seekToMs(uint32_t positionMs);
+
     // ========================================
     // State Queries
     // ========================================
@@ -149,6 +157,12 @@ public:
     float getProgress() const;
     const char* getFileName() const;
 
+    /**
+     * Update the reverb preference (settings screen)
+     * Applied immediately when MIDI is playing, otherwise on the next MIDI play()
+     */
+    void setReverbEnabled(bool enabled);
+
     // ========================================
     // Optional Components (for GUI integration)
     // ========================================
@@ -218,18 +232,17 @@ private:
     OPL3Synth* opl3_;
     FileSource* fileSource_;
     DrumSamplerV2* drumSampler_;
-    AudioMixer4* mixerLeft_;           // Main mixer (line-in on ch0, submixer on ch1)
-    AudioMixer4* mixerRight_;          // Main mixer
-    AudioMixer4* submixerLeft_;        // Submixer (ch0=dacNesMixer, ch1=SPC, ch2=GB, ch3=MOD)
-    AudioMixer4* submixerRight_;       // Submixer
-    AudioMixer4* dacNesMixerLeft_;     // DAC/NES pre-mixer (ch0=DAC, ch1=NES APU)
-    AudioMixer4* dacNesMixerRight_;    // DAC/NES pre-mixer
-    AudioMixer4* finalMixerLeft_;
-    AudioMixer4* finalMixerRight_;
-    AudioMixer4* fadeMixerLeft_;
-    AudioMixer4* fadeMixerRight_;
-    AudioEffectFreeverb* reverbLeft_;
-    AudioEffectFreeverb* reverbRight_;
+    AudioMixerStage* mixerLeft_;           // Main mixer (line-in on ch0, submixer on ch1)
+    AudioMixerStage* mixerRight_;          // Main mixer
+    AudioMixerStage* submixerLeft_;        // Submixer (ch0=dacNesMixer, ch1=SPC, ch2=GB, ch3=MOD)
+    AudioMixerStage* submixerRight_;       // Submixer
+    AudioMixerStage* dacNesMixerLeft_;     // DAC/NES pre-mixer (ch0=DAC, ch1=NES APU)
+    AudioMixerStage* dacNesMixerRight_;    // DAC/NES pre-mixer
+    AudioMixerStage* finalMixerLeft_;
+    AudioMixerStage* finalMixerRight_;
+    AudioMixerStage* fadeMixerLeft_;
+    AudioMixerStage* fadeMixerRight_;
+    AudioEffectReverbPSRAM* reverb_;
 
     // User preferences (from config)
     bool crossfeedEnabled_;
@@ -248,4 +261,9 @@ private:
     // Pending operation state
     String pendingFilePath_;          // File path being prepared
     FileFormat pendingFormat_;        // Format being prepared
+
+    // Seek mute: one block to ramp down, then at least one full silent block
+    static const uint32_t SEEK_MUTE_BLOCKS = 2;
+    bool seekMuted_;                  // Fade stage held at 0 since a seek
+    uint32_t seekDoneSample_;         // audioClock.blockStart() when the seek returned
 };
@@ -0,0 +1,405 @@
+#include "resume_journal.h"
+#include <stddef.h>
+#include "player_manager.h"
+#include "playback_coordinator.h"
+#include "playback_state.h"
+#include "queue_manager.h"
+#include "file_source.h"
+#include "ui/framework/event_manager.h"
+
+ResumeJournal* g_resumeJournal = nullptr;
+
+static const char* JOURNAL_DIR = "/FM90S";
+static const char* JOURNAL_PATH = "/FM90S/RESUME.JNL";
+static const uint32_t STATE_POLL_MS = 250;        // How often update() looks for changes
+static const uint32_t RESUME_TIMEOUT_MS = 15000;  // Give up waiting for the resumed track to start
+
+ResumeJournal::ResumeJournal()
+    : fileOpen_(false)
+    , loaded_(false)
+    , playerManager_(nullptr)
+    , coordinator_(nullptr)
+    , queueManager_(nullptr)
+    , eventManager_(nullptr)
+    , fileSource_(nullptr)
+    , pendingSeekMs_(0)
+    , lastCheckpointMs_(0)
+    , resumePending_(false)
+    , resumeStartMs_(0)
+    , lastPollMs_(0) {
+    memset(&record_, 0, sizeof(record_));
+    memset(pendingPath_, 0, sizeof(pendingPath_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+ResumeJournal::~ResumeJournal() {
+    if (eventManager_) {
+        eventManager_->offAll(this);
+    }
+    if (fileOpen_) {
+        file_.close();
+    }
+}
+
+bool ResumeJournal::begin() {
+    if (!openFile()) {
+        return false;
+    }
+
+    loaded_ = loadNewest();
+    if (loaded_) {
+        stats_.sequence = record_.sequence;
+        Serial.printf("[ResumeJournal] Loaded record #%lu (%s%s)\n",
+                      record_.sequence,
+                      record_.playing ? "resume: " : "no track playing",
+                      record_.playing ? record_.trackPath : "");
+    } else {
+        Serial.println("[ResumeJournal] No valid record - using defaults");
+    }
+    return loaded_;
+}
+
+void ResumeJournal::attach(PlayerManager* playerManager, PlaybackCoordinator* coordinator,
+                           QueueManager* queueManager, EventManager* eventManager, FileSource* fileSource) {
+    playerManager_ = playerManager;
+    coordinator_ = coordinator;
+    queueManager_ = queueManager;
+    eventManager_ = eventManager;
+    fileSource_ = fileSource;
+}
+
+// ============================================
+// SETTINGS
+// ============================================
+
+void ResumeJournal::captureSettings(Settings& out) const {
+    extern bool g_drumSamplerEnabled;
+    extern bool g_crossfeedEnabled;
+    extern bool g_reverbEnabled;
+    extern uint8_t g_maxLoopsBeforeFade;
+    extern float g_fadeDurationSeconds;
+    extern bool g_nesFiltersEnabled;
+    extern bool g_nesStereoEnabled;
+    extern bool g_spcFilterEnabled;
+    extern bool g_dualOPL2StereoSplit;
+    extern uint8_t g_vgmPlaybackRatePercent;
+    extern bool g_vgmPitchFollowsRate;
+    extern bool g_cpuGovernorEnabled;
+    extern bool g_loudnessNormalizeEnabled;
+
+    memset(&out, 0, sizeof(out));
+    out.drumSamplerEnabled = g_drumSamplerEnabled;
+    out.crossfeedEnabled = g_crossfeedEnabled;
+    out.reverbEnabled = g_reverbEnabled;
+    out.maxLoopsBeforeFade = g_maxLoopsBeforeFade;
+    out.fadeDurationSeconds = g_fadeDurationSeconds;
+    out.nesFiltersEnabled = g_nesFiltersEnabled;
+    out.nesStereoEnabled = g_nesStereoEnabled;
+    out.spcFilterEnabled = g_spcFilterEnabled;
+    out.dualOPL2StereoSplit = g_dualOPL2StereoSplit;
+    out.playbackRatePercent = g_vgmPlaybackRatePercent;
+    out.pitchFollowsRate = g_vgmPitchFollowsRate;
+    out.cpuGovernorEnabled = g_cpuGovernorEnabled;
+    out.loudnessNormalizeOff = !g_loudnessNormalizeEnabled;
+}
+
+void ResumeJournal::applySettings() {
+    if (!loaded_) return;
+
+    extern bool g_drumSamplerEnabled;
+    extern bool g_crossfeedEnabled;
+    extern bool g_reverbEnabled;
+    extern uint8_t g_maxLoopsBeforeFade;
+    extern float g_fadeDurationSeconds;
+    extern bool g_nesFiltersEnabled;
+    extern bool g_nesStereoEnabled;
+    extern bool g_spcFilterEnabled;
+    extern bool g_dualOPL2StereoSplit;
+    extern uint8_t g_vgmPlaybackRatePercent;
+    extern bool g_vgmPitchFollowsRate;
+    extern bool g_cpuGovernorEnabled;
+    extern bool g_loudnessNormalizeEnabled;
+
+    const Settings& s = record_.settings;
+    g_drumSamplerEnabled = s.drumSamplerEnabled;
+    g_crossfeedEnabled = s.crossfeedEnabled;
+    g_reverbEnabled = s.reverbEnabled;
+    g_maxLoopsBeforeFade = s.maxLoopsBeforeFade;
+    g_fadeDurationSeconds = s.fadeDurationSeconds;
+    g_nesFiltersEnabled = s.nesFiltersEnabled;
+    g_nesStereoEnabled = s.nesStereoEnabled;
+    g_spcFilterEnabled = s.spcFilterEnabled;
+    g_dualOPL2StereoSplit = s.dualOPL2StereoSplit;
+    g_vgmPlaybackRatePercent = s.playbackRatePercent;
+    g_vgmPitchFollowsRate = s.pitchFollowsRate;
+    g_cpuGovernorEnabled = s.cpuGovernorEnabled;  // Older journals: reserved byte, 0 = off
+    g_loudnessNormalizeEnabled = !s.loudnessNormalizeOff;
+
+    Serial.println("[ResumeJournal] Settings restored");
+}
+
+// ============================================
+// RESUME
+// ============================================
+
+bool ResumeJournal::resumePlayback() {
+    if (!hasResumePoint() || !coordinator_ || !fileSource_) {
+        return false;
+    }
+
+    if (record_.source == FileSource::USB_DRIVE) {
+        // The drive isn't enumerated this early in boot
+        Serial.println("[ResumeJournal] Last track was on USB - not resuming");
+        return false;
+    }
+    if (!SD.exists(record_.trackPath)) {
+        Serial.printf("[ResumeJournal] %s is gone - not resuming\n", record_.trackPath);
+        return false;
+    }
+
+    Record saved = record_;
+
+    // Disarm first: if this track takes the player down, the next boot won't replay it
+    record_.playing = 0;
+    writeRecord();
+
+    fileSource_->setSource((FileSource::Source)saved.source);
+    if (queueManager_) {
+        for (uint8_t i = 0; i < saved.queueCount && i < MAX_QUEUE; i++) {
+            queueManager_->addToQueue(saved.queue[i]);
+        }
+    }
+
+    pendingSeekMs_ = saved.positionMs;
+    strncpy(pendingPath_, saved.trackPath, PATH_LEN - 1);
+    pendingPath_[PATH_LEN - 1] = '\0';
+    resumePending_ = true;
+    resumeStartMs_ = millis();
+
+    if (eventManager_) {
+        eventManager_->on(EventManager::EVENT_PLAYBACK_STARTED, onPlaybackStarted, this);
+    }
+
+    Serial.printf("[ResumeJournal] Resuming %s at %lu ms (boot +%lu ms)\n",
+                  pendingPath_, pendingSeekMs_, millis());
+    coordinator_->requestPlay(pendingPath_);
+    return true;
+}
+
+void ResumeJournal::onPlaybackStarted(void* context) {
+    ResumeJournal* self = static_cast<ResumeJournal*>(context);
+    if (!self || !self->resumePending_) return;
+
+    self->eventManager_->off(EventManager::EVENT_PLAYBACK_STARTED, self);
+    self->resumePending_ = false;
+
+    // The user may have picked something else before the resumed track came up
+    String current = PlaybackState::getInstance()->getCurrentPath();
+    bool seeked = false;
+    if (strcmp(current.c_str(), self->pendingPath_) == 0 && self->pendingSeekMs_ > 0 && self->playerManager_) {
+        seeked = self->playerManager_->seekToMs(self->pendingSeekMs_);
+    }
+
+    Serial.printf("[ResumeJournal] Audio at boot +%lu ms (%s %lu ms)\n",
+                  millis(), seeked ? "seeked to" : "no seek to", self->pendingSeekMs_);
+
+    self->pendingSeekMs_ = 0;
+    self->lastCheckpointMs_ = millis();
+}
+
+// ============================================
+// CHECKPOINTS
+// ============================================
+
+void ResumeJournal::captureState(Record& rec) const {
+    memset(&rec, 0, sizeof(rec));
+    captureSettings(rec.settings);
+
+    if (playerManager_ && (playerManager_->isPlaying() || playerManager_->isPaused())) {
+        String path = PlaybackState::getInstance()->getCurrentPath();
+        if (path.length() > 0 && path.length() < PATH_LEN) {
+            rec.playing = 1;
+            strncpy(rec.trackPath, path.c_str(), PATH_LEN - 1);
+            rec.positionMs = playerManager_->getPositionMs();
+        }
+    }
+
+    rec.source = fileSource_ ? (uint8_t)fileSource_->getSource() : 0;
+
+    if (queueManager_) {
+        int count = queueManager_->getQueueSize();
+        for (int i = 0; i < count && rec.queueCount < MAX_QUEUE; i++) {
+            const char* track = queueManager_->getTrackAt(i);
+            if (track && strlen(track) < PATH_LEN) {
+                strncpy(rec.queue[rec.queueCount++], track, PATH_LEN - 1);
+            }
+        }
+    }
+}
+
+bool ResumeJournal::stateChanged(const Record& rec) const {
+    if (rec.playing != record_.playing || rec.source != record_.source ||
+        rec.queueCount != record_.queueCount) {
+        return true;
+    }
+    if (memcmp(&rec.settings, &record_.settings, sizeof(Settings)) != 0) {
+        return true;
+    }
+    if (strcmp(rec.trackPath, record_.trackPath) != 0) {
+        return true;
+    }
+    for (uint8_t i = 0; i < rec.queueCount; i++) {
+        if (strcmp(rec.queue[i], record_.queue[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ResumeJournal::checkpoint() {
+    if (!fileOpen_) return false;
+    captureState(record_);
+    lastCheckpointMs_ = millis();
+    return writeRecord();
+}
+
+void ResumeJournal::update() {
+    if (!fileOpen_ || !playerManager_) return;
+
+    uint32_t now = millis();
+
+    // Hold checkpoints until the resumed track has been seeked, or the saved
+    // position would be overwritten with 0
+    if (resumePending_) {
+        if (now - resumeStartMs_ < RESUME_TIMEOUT_MS) return;
+        Serial.println("[ResumeJournal] Resumed track never started - giving up");
+        if (eventManager_) {
+            eventManager_->off(EventManager::EVENT_PLAYBACK_STARTED, this);
+        }
+        resumePending_ = false;
+    }
+
+    if (now - lastPollMs_ < STATE_POLL_MS) return;
+    lastPollMs_ = now;
+
+    Record next;
+    captureState(next);
+
+    bool changed = stateChanged(next);
+    bool due = next.playing && next.positionMs != record_.positionMs &&
+               (now - lastCheckpointMs_ >= CHECKPOINT_INTERVAL_MS);
+    if (!changed && !due) return;
+
+    record_ = next;
+    lastCheckpointMs_ = now;
+    writeRecord();
+}
+
+// ============================================
+// STORAGE
+// ============================================
+
+bool ResumeJournal::openFile() {
+    if (!SD.exists(JOURNAL_DIR)) {
+        SD.mkdir(JOURNAL_DIR);
+    }
+
+    file_ = SD.open(JOURNAL_PATH, FILE_WRITE);
+    if (!file_) {
+        Serial.println("[ResumeJournal] ERROR: Failed to open journal file");
+        return false;
+    }
+
+    // Preallocate every slot once so checkpoints never change the file size
+    uint32_t fullSize = (uint32_t)SLOT_COUNT * SLOT_SIZE;
+    if (file_.size() < fullSize) {
+        uint8_t zeros[128];
+        memset(zeros, 0, sizeof(zeros));
+        file_.seek(file_.size());
+        uint32_t remaining = fullSize - file_.size();
+        while (remaining > 0) {
+            uint32_t chunk = remaining < sizeof(zeros) ? remaining : sizeof(zeros);
+            if (file_.write(zeros, chunk) != chunk) {
+                Serial.println("[ResumeJournal] ERROR: Failed to preallocate journal");
+                file_.close();
+                return false;
+            }
+            remaining -= chunk;
+        }
+        file_.flush();
+    }
+
+    fileOpen_ = true;
+    return true;
+}
+
+bool ResumeJournal::loadNewest() {
+    Record rec;
+    bool found = false;
+
+    for (uint8_t slot = 0; slot < SLOT_COUNT; slot++) {
+        if (!file_.seek((uint32_t)slot * SLOT_SIZE)) continue;
+        if (file_.read((uint8_t*)&rec, sizeof(rec)) != (int)sizeof(rec)) continue;
+
+        if (rec.magic != MAGIC || rec.version != VERSION || rec.size != sizeof(Record)) continue;
+        if (rec.crc != crc32((const uint8_t*)&rec, offsetof(Record, crc))) continue;
+
+        if (!found || rec.sequence > record_.sequence) {
+            record_ = rec;
+            found = true;
+        }
+    }
+
+    if (found) {
+        // Guard against a record written by a build with longer paths
+        record_.trackPath[PATH_LEN - 1] = '\0';
+        for (uint8_t i = 0; i < MAX_QUEUE; i++) {
+            record_.queue[i][PATH_LEN - 1] = '\0';
+        }
+    }
+    return found;
+}
+
+bool ResumeJournal::writeRecord() {
+    if (!fileOpen_) return false;
+
+    record_.magic = MAGIC;
+    record_.version = VERSION;
+    record_.size = sizeof(Record);
+    record_.sequence = stats_.sequence + 1;
+    record_.crc = crc32((const uint8_t*)&record_, offsetof(Record, crc));
+
+    uint32_t slot = record_.sequence % SLOT_COUNT;
+    uint32_t start = micros();
+
+    bool ok = file_.seek(slot * SLOT_SIZE) &&
+              file_.write((const uint8_t*)&record_, sizeof(Record)) == sizeof(Record);
+    file_.flush();
+
+    uint32_t elapsed = micros() - start;
+    if (elapsed > stats_.maxWriteUs) {
+        stats_.maxWriteUs = elapsed;
+    }
+
+    if (!ok) {
+        stats_.writeErrors++;
+        Serial.println("[ResumeJournal] ERROR: Checkpoint write failed");
+        return false;
+    }
+
+    stats_.sequence = record_.sequence;
+    stats_.checkpoints++;
+    return true;
+}
+
+uint32_t ResumeJournal::crc32(const uint8_t* data, size_t length) {
+    // Bitwise CRC-32 (IEEE) - one 1KB record every few seconds doesn't justify a table
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+class PlayerManager;
+class PlaybackCoordinator;
+class QueueManager;
+class EventManager;
+class FileSource;
+
+/**
+ * ResumeJournal - Power-fail-safe persistence for settings and the playing track
+ *
+ * Saves the user settings (the g_ globals behind the settings pages), the
+ * queue, and the current track with its position, then on boot restores the
+ * settings and resumes the track where it left off.
+ *
+ * Storage: a preallocated file on the SD card split into SLOT_COUNT fixed
+ * slots. Each checkpoint overwrites the next slot in rotation and carries a
+ * sequence number plus CRC32:
+ *   - a write torn by power loss fails its CRC, and the previous slot wins
+ *   - the file never grows, so checkpoints only rewrite data sectors in place
+ *   - consecutive checkpoints land on different sectors (wear spread)
+ * SD rather than EEPROM emulation: a flash sector erase on the Teensy 4 stalls
+ * the CPU with interrupts off long enough to glitch audio.
+ *
+ * Checkpoints: update() writes one every CHECKPOINT_INTERVAL_MS while a track
+ * plays, and immediately when the track, play state or queue changes. A
+ * checkpoint is a single 1KB write from the main loop (~1ms), which the
+ * players' catch-up timing absorbs.
+ *
+ * Resume: the track is replayed through the normal coordinator path, and when
+ * EVENT_PLAYBACK_STARTED fires the player seeks to the saved position with its
+ * fastest engine-specific seek (IAudioPlayer::seekToMs).
+ */
+class ResumeJournal {
+public:
+    static const uint8_t SLOT_COUNT = 8;
+    static const uint16_t SLOT_SIZE = 1024;          // Two SD sectors
+    static const uint8_t PATH_LEN = 128;
+    static const uint8_t MAX_QUEUE = 6;
+    static const uint32_t CHECKPOINT_INTERVAL_MS = 5000;
+
+    /**
+     * Persisted copy of the settings-page globals
+     */
+    struct Settings {
+        uint8_t drumSamplerEnabled;
+        uint8_t crossfeedEnabled;
+        uint8_t reverbEnabled;
+        uint8_t maxLoopsBeforeFade;
+        float fadeDurationSeconds;
+        uint8_t nesFiltersEnabled;
+        uint8_t nesStereoEnabled;
+        uint8_t spcFilterEnabled;
+        uint8_t dualOPL2StereoSplit;
+        uint8_t playbackRatePercent;
+        uint8_t pitchFollowsRate;
+        uint8_t cpuGovernorEnabled;
+        uint8_t loudnessNormalizeOff;   // Inverted so older journals (0) keep the default on
+    };
+
+    struct Stats {
+        uint32_t checkpoints;     // Slots written this session
+        uint32_t writeErrors;
+        uint32_t maxWriteUs;      // Slowest checkpoint write
+        uint32_t sequence;        // Sequence number of the newest slot
+    };
+
+    ResumeJournal();
+    ~ResumeJournal();
+
+    /**
+     * Open (or create) the journal and load the newest valid slot
+     * Call after SD.begin(), before anything reads the settings globals.
+     * @return true if a valid record was found
+     */
+    bool begin();
+
+    /**
+     * Copy the loaded settings into the g_ globals
+     */
+    void applySettings();
+
+    /**
+     * Wire up the playback objects (needed by checkpoints and resume)
+     */
+    void attach(PlayerManager* playerManager, PlaybackCoordinator* coordinator,
+                QueueManager* queueManager, EventManager* eventManager, FileSource* fileSource);
+
+    /**
+     * Restore the queue and start the saved track (seek follows on EVENT_PLAYBACK_STARTED)
+     * @return true if a resume was started
+     */
+    bool resumePlayback();
+
+    /**
+     * Write a checkpoint now (settings pages call this on Save)
+     */
+    bool checkpoint();
+
+    /**
+     * Call from main loop - periodic and on-change checkpoints
+     */
+    void update();
+
+    bool hasResumePoint() const { return loaded_ && record_.playing; }
+    const Stats& getStats() const { return stats_; }
+
+private:
+    static const uint32_t MAGIC = 0x4A52464D;        // "MFRJ"
+    static const uint16_t VERSION = 1;
+
+    struct Record {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t size;
+        uint32_t sequence;
+        Settings settings;
+        uint8_t playing;          // A track was playing (or paused) at this checkpoint
+        uint8_t source;           // FileSource::Source of the track and queue
+        uint8_t queueCount;
+        uint8_t reserved;
+        uint32_t positionMs;
+        char trackPath[PATH_LEN];
+        char queue[MAX_QUEUE][PATH_LEN];
+        uint32_t crc;             // CRC32 of everything above
+    };
+    static_assert(sizeof(Record) <= SLOT_SIZE, "Journal record must fit one slot");
+
+    bool openFile();
+    bool loadNewest();
+    bool writeRecord();
+    void captureSettings(Settings& out) const;
+    void captureState(Record& rec) const;
+    bool stateChanged(const Record& rec) const;
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+    static void onPlaybackStarted(void* context);
+
+    File file_;
+    bool fileOpen_;
+    bool loaded_;
+    Record record_;               // Last record loaded or written
+
+    PlayerManager* playerManager_;
+    PlaybackCoordinator* coordinator_;
+    QueueManager* queueManager_;
+    EventManager* eventManager_;
+    FileSource* fileSource_;
+
+    uint32_t pendingSeekMs_;      // Seek to apply when the resumed track starts
+    char pendingPath_[PATH_LEN];
+    uint32_t lastCheckpointMs_;
+    bool resumePending_;          // Checkpoints held until the resumed track has seeked
+    uint32_t resumeStartMs_;
+    uint32_t lastPollMs_;
+
+    Stats stats_;
+};
+
+extern ResumeJournal* g_resumeJournal;
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "audio_system.h"  // For setFadeGain
 #include "audio_globals.h"  // For persistent audio connections
+#include "load_shedder.h"  // Filter is skipped while shed
 
 // Include the C interface from blargg's library
 #include "External/snes_spc/snes_spc/spc.h"
@@ -14,6 +15,7 @@ SPCPlayer* SPCPlayer::instance_ = nullptr;
 SPCPlayer::SPCPlayer(const PlayerConfig& config)
     : fileSource_(config.fileSource)
     , file_data_(nullptr)
+    , file_copy_(nullptr)
     , file_size_(0)
     , spc_emu_(nullptr)
     , filter_(nullptr)
@@ -127,10 +129,10 @@ SPCPlayer::~SPCPlayer() {
         spc_emu_ = nullptr;
     }
 
-    if (file_data_) {
-        delete[] file_data_;
-        file_data_ = nullptr;
-    }
+    file_view_.reset();
+    delete[] file_copy_;
+    file_copy_ = nullptr;
+    file_data_ = nullptr;
 
     instance_ = nullptr;
     Serial.println("[SPCPlayer] Destructor complete");
@@ -158,58 +160,70 @@ bool SPCPlayer::loadFile(const char* path) {
     state_ = PlayerState::LOADING;
 
     // Free previous file data
-    if (file_data_) {
-        delete[] file_data_;
-        file_data_ = nullptr;
-        file_size_ = 0;
-    }
+    file_view_.reset();
+    delete[] file_copy_;
+    file_copy_ = nullptr;
+    file_data_ = nullptr;
+    file_size_ = 0;
 
     // Save filename
     strncpy(currentFileName_, path, sizeof(currentFileName_) - 1);
     currentFileName_[sizeof(currentFileName_) - 1] = 0;
 
-    // Open file
-    File file = fileSource_->open(path, FILE_READ);
-    if (!file) {
-        // // Serial.printf("ERROR: Failed to open file: %s\n", path);
-        return false;
-    }
+    // Use the file in place from PSRAM when FileSource can hold it (stop/reset
+    // reload the emulator from it), else copy it to the heap
+    file_view_ = fileSource_->openView(path);
+    if (file_view_) {
+        file_size_ = file_view_.size();
+    } else {
+        // Open file
+        File file = fileSource_->open(path, FILE_READ);
+        if (!file) {
+            // // Serial.printf("ERROR: Failed to open file: %s\n", path);
+            return false;
+        }
 
-    // Get file size
-    file_size_ = file.size();
-    // // Serial.printf("File size: %lu bytes\n", file_size_);
+        // Get file size
+        file_size_ = file.size();
+        // // Serial.printf("File size: %lu bytes\n", file_size_);
 
-    // Minimum SPC file size check
-    if (file_size_ < 0x10200) { // Header + RAM + DSP registers minimum
-        // // Serial.println("ERROR: File too small to be a valid SPC");
-        file.close();
-        return false;
-    }
+        // Allocate memory
+        file_copy_ = new uint8_t[file_size_];
+        if (!file_copy_) {
+            // // Serial.println("ERROR: Failed to allocate memory for file");
+            file.close();
+            return false;
+        }
 
-    // Allocate memory
-    file_data_ = new uint8_t[file_size_];
-    if (!file_data_) {
-        // // Serial.println("ERROR: Failed to allocate memory for file");
+        // Read file
+        size_t bytes_read = file.read(file_copy_, file_size_);
         file.close();
-        return false;
-    }
 
-    // Read file
-    size_t bytes_read = file.read(file_data_, file_size_);
-    file.close();
+        if (bytes_read != file_size_) {
+            // // Serial.printf("ERROR: Read %lu bytes, expected %lu\n", bytes_read, file_size_);
+            delete[] file_copy_;
+            file_copy_ = nullptr;
+            return false;
+        }
+    }
 
-    if (bytes_read != file_size_) {
-        // // Serial.printf("ERROR: Read %lu bytes, expected %lu\n", bytes_read, file_size_);
-        delete[] file_data_;
-        file_data_ = nullptr;
+    // Minimum SPC file size check
+    if (file_size_ < 0x10200) { // Header + RAM + DSP registers minimum
+        // // Serial.println("ERROR: File too small to be a valid SPC");
+        file_view_.reset();
+        delete[] file_copy_;
+        file_copy_ = nullptr;
         return false;
     }
+    file_data_ = file_view_ ? file_view_.data() : file_copy_;
 
     // Let the library validate the file - it knows best
     const char* error = spc_load_spc(spc_emu_, file_data_, file_size_);
     if (error) {
         // // Serial.printf("ERROR: Failed to load SPC: %s\n", error);
-        delete[] file_data_;
+        file_view_.reset();
+        delete[] file_copy_;
+        file_copy_ = nullptr;
         file_data_ = nullptr;
         return false;
     }
@@ -565,7 +579,9 @@ void SPCPlayer::fillBuffer() {
         //              g_spcFilterEnabled);
     }
 
-    if (g_spcFilterEnabled && filter_) {
+    // Skipped (setting untouched) while the load shedder needs the headroom
+    bool filterShed = g_loadShedder && g_loadShedder->isShed(LoadShedder::STEP_SPC_FILTER);
+    if (g_spcFilterEnabled && filter_ && !filterShed) {
         // Filter expects same count as spc_play
         spc_filter_run(filter_, spc_buffer, SAMPLES_PER_BLOCK);
     }
@@ -791,8 +807,53 @@ void SPCPlayer::update() {
 uint32_t SPCPlayer::getPositionMs() const {
     if (state_ == PlayerState::IDLE) return 0;
     // Use samples_consumed_ which tracks at 44.1kHz output rate, not samples_played_ at 32kHz
-    // Convert from 44.1kHz samples to milliseconds
-    return (samples_consumed_ * 1000) / (uint32_t)TEENSY_SAMPLE_RATE;
+    // Convert from 44.1kHz samples to milliseconds (64-bit: 32-bit overflows after ~97s)
+    return (uint32_t)(((uint64_t)samples_consumed_ * 1000ULL) / (uint32_t)TEENSY_SAMPLE_RATE);
+}
+
+bool SPCPlayer::seekToMs(uint32_t positionMs) {
+    if ((state_ != PlayerState::PLAYING && state_ != PlayerState::PAUSED) || !spc_emu_) {
+        return false;
+    }
+
+    // samples_played_ counts interleaved samples (2 per stereo frame) at 32kHz
+    uint32_t targetSamples = (uint32_t)(((uint64_t)positionMs * (uint32_t)SPC_SAMPLE_RATE) / 1000ULL) * 2;
+    if (targetSamples >= total_samples_ || targetSamples <= samples_played_) {
+        return false;
+    }
+
+    uint32_t seekStart = micros();
+    PlayerState previousState = state_;
+    state_ = PlayerState::PAUSED;  // ISR outputs silence while we skip
+
+    // spc_skip() runs the SPC700 with the DSP in fast mode - several times faster than play()
+    const char* error = spc_skip(spc_emu_, (int)(targetSamples - samples_played_));
+    if (error) {
+        Serial.printf("[SPCPlayer] Seek failed: %s\n", error);
+        state_ = previousState;
+        return false;
+    }
+    samples_played_ = targetSamples;
+
+    // Drop audio buffered from the old position
+    AudioNoInterrupts();
+    read_pos_ = write_pos_;
+    samples_consumed_ = (uint32_t)(((uint64_t)positionMs * (uint32_t)TEENSY_SAMPLE_RATE) / 1000ULL);
+    AudioInterrupts();
+    resampler_.position = 0.0f;
+    resampler_.prev_l = 0;
+    resampler_.prev_r = 0;
+    if (filter_) {
+        spc_filter_clear(filter_);
+    }
+
+    state_ = previousState;
+    if (state_ == PlayerState::PLAYING) {
+        fillBuffer();
+    }
+
+    Serial.printf("[SPCPlayer] Seek to %lu ms took %lu us\n", positionMs, micros() - seekStart);
+    return true;
 }
 
 uint32_t SPCPlayer::getDurationMs() const {
@@ -37,6 +37,7 @@ public:
 
     uint32_t getDurationMs() const override;
     uint32_t getPositionMs() const override;
+    bool seekToMs(uint32_t positionMs) override;
     float getProgress() const override;
     const char* getFileName() const override { return currentFileName_; }
     FileFormat getFormat() const override { return FileFormat::SPC; }
@@ -103,7 +104,9 @@ private:
 
     // File management
     FileSource* fileSource_;
-    uint8_t* file_data_;
+    const uint8_t* file_data_;  // Into file_view_ (PSRAM) or file_copy_ (heap)
+    FileView file_view_;
+    uint8_t* file_copy_;
     size_t file_size_;
     char currentFileName_[128];
 
@@ -125,12 +128,12 @@ private:
     uint32_t total_samples_;       // Total duration in samples
 
     // Audio routing (from PlayerConfig)
-    AudioMixer4* mixerLeft_;        // Submixers for SPC (channel 1 submixer)
-    AudioMixer4* mixerRight_;       // Submixers for SPC
-    AudioMixer4* mainMixerLeft_;    // Main mixers for line-in control (channel 0 = hardware)
-    AudioMixer4* mainMixerRight_;   // Main mixers for line-in control
-    AudioMixer4* fadeMixerLeft_;
-    AudioMixer4* fadeMixerRight_;
+    AudioMixerStage* mixerLeft_;        // Submixers for SPC (channel 1 submixer)
+    AudioMixerStage* mixerRight_;       // Submixers for SPC
+    AudioMixerStage* mainMixerLeft_;    // Main mixers for line-in control (channel 0 = hardware)
+    AudioMixerStage* mainMixerRight_;   // Main mixers for line-in control
+    AudioMixerStage* fadeMixerLeft_;
+    AudioMixerStage* fadeMixerRight_;
 
     // Audio buffering
     int16_t* ring_buffer_;         // Interleaved stereo buffer
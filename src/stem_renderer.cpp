@@ -0,0 +1,497 @@
+#include "stem_renderer.h"
+#include "file_source.h"
+#include "vgm_file.h"
+#include "nes_apu_emulator.h"
+#include "gameboy_apu.h"
+#include "External/snes_spc/snes_spc/spc.h"
+
+// Static APU instances from main.cpp - AudioStreams cannot be created per export
+extern NESAPUEmulator* g_nesAPU;
+extern GameBoyAPU* g_gbAPU;
+
+static const char* const NES_STEM_NAMES[NESAPUEmulator::STEM_COUNT] = {
+    "pulse1", "pulse2", "triangle", "noise", "dmc"
+};
+
+static const char* const GB_STEM_NAMES[GameBoyAPU::STEM_COUNT] = {
+    "pulse1", "pulse2", "wave", "noise"
+};
+
+static const char* const SPC_STEM_NAMES[spc_voice_count] = {
+    "voice1", "voice2", "voice3", "voice4", "voice5", "voice6", "voice7", "voice8"
+};
+
+StemRenderer::StemRenderer()
+    : stemCount_(0)
+    , writeFailed_(false)
+    , nes_(nullptr)
+    , gb_(nullptr)
+    , frameClockHz_(0)
+    , frameClockAccum_(0)
+    , framesRendered_(0)
+    , error_(nullptr)
+    , progressCallback_(nullptr)
+    , progressUserData_(nullptr)
+    , lastProgressUpdate_(0) {
+}
+
+StemRenderer::~StemRenderer() {
+    closeOutputs();
+}
+
+void StemRenderer::setProgressCallback(ProgressCallback callback, void* userData) {
+    progressCallback_ = callback;
+    progressUserData_ = userData;
+}
+
+bool StemRenderer::isSupported(const char* path) {
+    const char* ext = strrchr(path, '.');
+    if (!ext) return false;
+    return strcasecmp(ext, ".vgm") == 0 || strcasecmp(ext, ".vgz") == 0 ||
+           strcasecmp(ext, ".spc") == 0;
+}
+
+bool StemRenderer::render(const char* path, FileSource* fileSource, const char* outDir) {
+    error_ = nullptr;
+    framesRendered_ = 0;
+    writeFailed_ = false;
+    lastProgressUpdate_ = 0;
+
+    if (!path || !fileSource || !outDir) {
+        error_ = "Invalid arguments";
+        return false;
+    }
+    if (!isSupported(path)) {
+        error_ = "Unsupported file type";
+        return false;
+    }
+
+    uint32_t startTime = millis();
+    const char* ext = strrchr(path, '.');
+    bool ok = (strcasecmp(ext, ".spc") == 0)
+        ? renderSPC(path, fileSource, outDir)
+        : renderVGM(path, fileSource, outDir);
+
+    if (ok) {
+        uint32_t elapsed = millis() - startTime;
+        Serial.printf("[StemRenderer] %u stems + mix, %lu frames in %lu ms -> %s\n",
+                      stemCount_, framesRendered_, elapsed, outDir);
+    } else {
+        Serial.printf("[StemRenderer] ERROR: %s\n", error_ ? error_ : "unknown");
+    }
+    return ok;
+}
+
+// ============================================
+// OUTPUT FILES
+// ============================================
+
+bool StemRenderer::openOutputs(const char* outDir, const char* const* names, uint8_t count,
+                               uint32_t sampleRate) {
+    if (!SD.exists(outDir) && !SD.mkdir(outDir)) {
+        error_ = "Cannot create output folder";
+        return false;
+    }
+
+    char path[160];
+    stemCount_ = count;
+    for (uint8_t i = 0; i < count; i++) {
+        snprintf(path, sizeof(path), "%s/%02u_%s.wav", outDir, i + 1, names[i]);
+        if (!stems_[i].begin(path, 1, sampleRate)) {
+            error_ = "Cannot create stem file";
+            closeOutputs();
+            return false;
+        }
+    }
+
+    snprintf(path, sizeof(path), "%s/mix.wav", outDir);
+    if (!mix_.begin(path, 2, sampleRate)) {
+        error_ = "Cannot create mix file";
+        closeOutputs();
+        return false;
+    }
+    return true;
+}
+
+bool StemRenderer::closeOutputs() {
+    bool ok = true;
+    for (uint8_t i = 0; i < MAX_STEMS; i++) {
+        if (stems_[i].isOpen() && !stems_[i].end()) ok = false;
+    }
+    if (mix_.isOpen() && !mix_.end()) ok = false;
+    return ok;
+}
+
+void StemRenderer::writeFrame(const int16_t* stems, int16_t mixLeft, int16_t mixRight) {
+    for (uint8_t i = 0; i < stemCount_; i++) {
+        if (!stems_[i].writeFrame(stems[i])) writeFailed_ = true;
+    }
+    if (!mix_.writeFrame(mixLeft, mixRight)) writeFailed_ = true;
+    framesRendered_++;
+}
+
+void StemRenderer::reportProgress(uint32_t current, uint32_t total) {
+    if (!progressCallback_) return;
+
+    uint32_t now = millis();
+    if (now - lastProgressUpdate_ < 250) return;
+    lastProgressUpdate_ = now;
+
+    float progress = (total > 0) ? (float)current / (float)total : 0.0f;
+    if (progress > 1.0f) progress = 1.0f;
+    progressCallback_(progress, progressUserData_);
+}
+
+// ============================================
+// VGM (NES APU / GAME BOY DMG)
+// ============================================
+
+bool StemRenderer::renderVGM(const char* path, FileSource* fileSource, const char* outDir) {
+    VGMFile* vgm = new VGMFile();
+    if (!vgm || !vgm->loadFromFile(path, fileSource)) {
+        delete vgm;
+        error_ = "Failed to load VGM";
+        return false;
+    }
+
+    ChipType chipType = vgm->getChipType();
+    bool ok = false;
+    if (chipType == ChipType::NES_APU) {
+        nes_ = g_nesAPU;
+        nes_->beginOfflineRender();
+        frameClockHz_ = NESAPUEmulator::FRAME_COUNTER_HZ;
+        ok = openOutputs(outDir, NES_STEM_NAMES, NESAPUEmulator::STEM_COUNT, VGM_SAMPLE_RATE);
+    } else if (chipType == ChipType::GAMEBOY_DMG) {
+        gb_ = g_gbAPU;
+        gb_->beginOfflineRender();
+        frameClockHz_ = GameBoyAPU::FRAME_SEQUENCER_HZ;
+        ok = openOutputs(outDir, GB_STEM_NAMES, GameBoyAPU::STEM_COUNT, VGM_SAMPLE_RATE);
+    } else {
+        error_ = "No software APU in this VGM";
+    }
+
+    if (ok) {
+        frameClockAccum_ = 0;
+        uint32_t totalSamples = vgm->getTotalSamples();
+        uint8_t cmd;
+
+        // Single pass through the data - loops are not followed
+        while (!vgm->isAtEnd() && !writeFailed_) {
+            if (!vgm->readByte(cmd) || !processVGMCommand(vgm, cmd)) {
+                break;
+            }
+            reportProgress(framesRendered_, totalSamples);
+        }
+
+        if (!closeOutputs() || writeFailed_) {
+            error_ = "SD write failed";
+            ok = false;
+        }
+    }
+
+    closeOutputs();
+    if (nes_) nes_->endOfflineRender();
+    if (gb_) gb_->endOfflineRender();
+    nes_ = nullptr;
+    gb_ = nullptr;
+    delete vgm;
+    return ok;
+}
+
+void StemRenderer::renderVGMSamples(uint32_t count) {
+    int16_t stems[MAX_STEMS];
+    int16_t mixLeft, mixRight;
+
+    for (uint32_t i = 0; i < count && !writeFailed_; i++) {
+        // Frame counter/sequencer normally runs from an IntervalTimer - clock it by sample count
+        frameClockAccum_ += frameClockHz_;
+        if (frameClockAccum_ >= VGM_SAMPLE_RATE) {
+            frameClockAccum_ -= VGM_SAMPLE_RATE;
+            if (nes_) nes_->clockFrameCounter();
+            if (gb_) gb_->clockFrameSequencer();
+        }
+
+        if (nes_) {
+            nes_->renderSample(stems, mixLeft, mixRight);
+        } else {
+            gb_->renderSample(stems, mixLeft, mixRight);
+        }
+        writeFrame(stems, mixLeft, mixRight);
+    }
+}
+
+void StemRenderer::skipBytes(VGMFile* vgm, uint32_t count) {
+    uint8_t dummy;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!vgm->readByte(dummy)) break;
+    }
+}
+
+bool StemRenderer::processVGMCommand(VGMFile* vgm, uint8_t cmd) {
+    uint8_t reg, val, byte1, byte2;
+
+    switch (cmd) {
+        case 0xB3:  // Game Boy DMG write
+            if (!vgm->readByte(reg) || !vgm->readByte(val)) return false;
+            if (gb_) gb_->writeRegister(reg, val);
+            return true;
+
+        case 0xB4:  // NES APU write
+            if (!vgm->readByte(reg) || !vgm->readByte(val)) return false;
+            if (nes_) nes_->writeRegister(reg, val);
+            return true;
+
+        case 0x61:  // Wait n samples
+            if (!vgm->readByte(byte1) || !vgm->readByte(byte2)) return false;
+            renderVGMSamples(byte1 | (byte2 << 8));
+            return true;
+
+        case 0x62:  // Wait 735 samples (1/60 second)
+            renderVGMSamples(735);
+            return true;
+
+        case 0x63:  // Wait 882 samples (1/50 second)
+            renderVGMSamples(882);
+            return true;
+
+        case 0x66:  // End of sound data
+            return false;
+
+        case 0x67: {  // Data block: 0x67 0x66 tt ss ss ss ss [data]
+            uint8_t check, dataType, b[4];
+            if (!vgm->readByte(check) || check != 0x66) return false;
+            if (!vgm->readByte(dataType)) return false;
+            for (int i = 0; i < 4; i++) {
+                if (!vgm->readByte(b[i])) return false;
+            }
+            uint32_t dataSize = b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+
+            if (nes_ && (dataType == 0x07 || dataType == 0xC2)) {
+                loadNESDataBlock(vgm, dataType, dataSize);
+            } else {
+                skipBytes(vgm, dataSize);
+            }
+            return true;
+        }
+
+        case 0x68:  // PCM RAM write (compat byte + 10 bytes)
+            skipBytes(vgm, 11);
+            return true;
+
+        case 0x90: case 0x91: case 0x95:  // DAC stream setup/data/start fast
+            skipBytes(vgm, 4);
+            return true;
+        case 0x92:  // DAC stream frequency
+            skipBytes(vgm, 5);
+            return true;
+        case 0x93:  // DAC stream start
+            skipBytes(vgm, 10);
+            return true;
+        case 0x94:  // DAC stream stop
+            skipBytes(vgm, 1);
+            return true;
+
+        default:
+            break;
+    }
+
+    // Everything else: waits encoded in the command, or other chips' writes (skipped)
+    if (cmd >= 0x70 && cmd <= 0x7F) {
+        renderVGMSamples((cmd & 0x0F) + 1);
+    } else if (cmd >= 0x80 && cmd <= 0x8F) {
+        renderVGMSamples(cmd & 0x0F);  // YM2612 DAC write + wait
+    } else if (cmd >= 0x30 && cmd <= 0x3F) {
+        skipBytes(vgm, 1);
+    } else if ((cmd >= 0x40 && cmd <= 0x4E) || (cmd >= 0x51 && cmd <= 0x5F) ||
+               (cmd >= 0xA0 && cmd <= 0xBF)) {
+        skipBytes(vgm, 2);
+    } else if (cmd == 0x4F || cmd == 0x50) {
+        skipBytes(vgm, 1);
+    } else if (cmd >= 0xC0 && cmd <= 0xDF) {
+        skipBytes(vgm, 3);
+    } else if (cmd >= 0xE0) {
+        skipBytes(vgm, 4);
+    }
+    return true;
+}
+
+void StemRenderer::loadNESDataBlock(VGMFile* vgm, uint8_t dataType, uint32_t dataSize) {
+    // Type 0x07 = DPCM data at start of buffer
+    // Type 0xC2 = NES APU RAM write, first 2 bytes are the start address
+    uint16_t startAddress = 0;
+    uint32_t actualDataSize = dataSize;
+
+    if (dataType == 0xC2) {
+        uint8_t addrLo, addrHi;
+        if (dataSize < 2 || !vgm->readByte(addrLo) || !vgm->readByte(addrHi)) {
+            skipBytes(vgm, dataSize > 2 ? dataSize - 2 : 0);
+            return;
+        }
+        startAddress = addrLo | (addrHi << 8);
+        actualDataSize = dataSize - 2;
+    }
+
+    bool validAddress = (dataType != 0xC2) || (startAddress >= 0xC000);
+    if (actualDataSize == 0 || actualDataSize > 16384 || !validAddress) {
+        skipBytes(vgm, actualDataSize);
+        return;
+    }
+
+    uint8_t* data = new uint8_t[actualDataSize];
+    if (!data) {
+        skipBytes(vgm, actualDataSize);
+        return;
+    }
+
+    bool readSuccess = true;
+    for (uint32_t i = 0; i < actualDataSize; i++) {
+        if (!vgm->readByte(data[i])) {
+            readSuccess = false;
+            break;
+        }
+    }
+
+    if (readSuccess) {
+        if (dataType == 0xC2) {
+            nes_->ensureDPCMBuffer();
+            nes_->loadDPCMDataAtOffset(data, actualDataSize, startAddress - 0xC000);
+        } else {
+            nes_->loadDPCMData(data, actualDataSize);
+        }
+    }
+    delete[] data;
+}
+
+// ============================================
+// SPC (SNES SPC700 / S-DSP)
+// ============================================
+
+void StemRenderer::readSPCLength(const uint8_t* data, size_t size, uint32_t& playSeconds,
+                                 uint32_t& fadeMs) {
+    // Default: 3 minutes play + 10 seconds fade (matches SPCPlayer)
+    playSeconds = 180;
+    fadeMs = 10000;
+
+    if (size < 0x100 || data[0x23] != 26) return;  // No ID666 tag
+
+    // Text format tags have a MM/DD/YYYY date at 0x9E
+    const uint8_t* tag = &data[0x2E];
+    bool textFormat = (data[0x9E + 2] == '/' && data[0x9E + 5] == '/');
+
+    uint32_t seconds, fade;
+    if (textFormat) {
+        char secondsStr[4] = {0};
+        char fadeStr[6] = {0};
+        memcpy(secondsStr, &tag[0x7B], 3);
+        memcpy(fadeStr, &tag[0x7E], 5);
+        seconds = atoi(secondsStr);
+        fade = atoi(fadeStr);
+    } else {
+        memcpy(&seconds, &tag[0x74], 4);
+        memcpy(&fade, &tag[0x78], 4);
+    }
+
+    if (seconds > 0) {
+        playSeconds = seconds;
+        fadeMs = (fade > 0) ? fade : 10000;
+    }
+}
+
+bool StemRenderer::renderSPC(const char* path, FileSource* fileSource, const char* outDir) {
+    File file = fileSource->open(path, FILE_READ);
+    if (!file) {
+        error_ = "Failed to open SPC";
+        return false;
+    }
+
+    size_t fileSize = file.size();
+    if (fileSize < 0x10200) {  // Header + RAM + DSP registers minimum
+        file.close();
+        error_ = "File too small to be a valid SPC";
+        return false;
+    }
+
+    // Song image in PSRAM - only read once at load
+    uint8_t* fileData = (uint8_t*)extmem_malloc(fileSize);
+    bool fileInPSRAM = (fileData != nullptr);
+    if (!fileData) fileData = (uint8_t*)malloc(fileSize);
+    if (!fileData) {
+        file.close();
+        error_ = "Out of memory";
+        return false;
+    }
+    size_t bytesRead = file.read(fileData, fileSize);
+    file.close();
+
+    // Voice tap ring: SPC_TAP_FRAMES frames of 8 voices x L/R
+    size_t tapBytes = SPC_TAP_FRAMES * spc_voice_count * 2 * sizeof(spc_sample_t);
+    spc_sample_t* tap = (spc_sample_t*)extmem_malloc(tapBytes);
+    bool tapInPSRAM = (tap != nullptr);
+    if (!tap) tap = (spc_sample_t*)malloc(tapBytes);
+
+    spc_sample_t* out = (spc_sample_t*)malloc(SPC_BLOCK_FRAMES * 2 * sizeof(spc_sample_t));
+    SNES_SPC* spc = spc_new();
+
+    bool ok = false;
+    if (bytesRead != fileSize) {
+        error_ = "Failed to read SPC";
+    } else if (!tap || !out || !spc) {
+        error_ = "Out of memory";
+    } else if (spc_load_spc(spc, fileData, fileSize) != nullptr) {
+        error_ = "Invalid SPC file";
+    } else if (openOutputs(outDir, SPC_STEM_NAMES, spc_voice_count, SPC_SAMPLE_RATE)) {
+        spc_clear_echo(spc);
+        spc_set_voice_tap(spc, tap, SPC_TAP_FRAMES);  // Frame 0 = first sample after load
+
+        uint32_t playSeconds, fadeMs;
+        readSPCLength(fileData, fileSize, playSeconds, fadeMs);
+        uint32_t fadeStart = playSeconds * SPC_SAMPLE_RATE;
+        uint32_t fadeLength = (uint32_t)(((uint64_t)fadeMs * SPC_SAMPLE_RATE) / 1000);
+        uint32_t totalFrames = fadeStart + fadeLength;
+
+        int16_t stems[MAX_STEMS];
+        ok = true;
+        while (framesRendered_ < totalFrames && !writeFailed_) {
+            if (spc_play(spc, SPC_BLOCK_FRAMES * 2, out) != nullptr) {
+                error_ = "SPC emulation error";
+                ok = false;
+                break;
+            }
+
+            for (int f = 0; f < SPC_BLOCK_FRAMES && framesRendered_ < totalFrames; f++) {
+                // Same linear fade SPCPlayer applies, on stems and mix alike
+                int32_t gain = 256;
+                if (framesRendered_ >= fadeStart) {
+                    gain = 256 - (int32_t)(((uint64_t)(framesRendered_ - fadeStart) * 256) / fadeLength);
+                }
+
+                // Tap frame N lines up with output frame N (DSP extra samples included)
+                const spc_sample_t* voices =
+                    &tap[(framesRendered_ & (SPC_TAP_FRAMES - 1)) * spc_voice_count * 2];
+                for (int v = 0; v < spc_voice_count; v++) {
+                    int32_t mono = ((int32_t)voices[v * 2] + voices[v * 2 + 1]) >> 1;
+                    stems[v] = (int16_t)((mono * gain) >> 8);
+                }
+
+                writeFrame(stems,
+                           (int16_t)((out[f * 2] * gain) >> 8),
+                           (int16_t)((out[f * 2 + 1] * gain) >> 8));
+            }
+            reportProgress(framesRendered_, totalFrames);
+        }
+
+        if (!closeOutputs() || writeFailed_) {
+            if (ok) error_ = "SD write failed";
+            ok = false;
+        }
+    }
+
+    closeOutputs();
+    if (spc) spc_delete(spc);
+    free(out);
+    if (tap) {
+        if (tapInPSRAM) extmem_free(tap); else free(tap);
+    }
+    if (fileInPSRAM) extmem_free(fileData); else free(fileData);
+    return ok;
+}
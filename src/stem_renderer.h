@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include "wav_writer.h"
+
+class FileSource;
+class VGMFile;
+class NESAPUEmulator;
+class GameBoyAPU;
+
+/**
+ * StemRenderer - Single-pass per-channel WAV export for the software APUs
+ *
+ * Synthesizes a track once and writes one mono WAV per channel plus the
+ * stereo mix, instead of replaying the song once per mute mask:
+ *
+ *   NES APU VGM   -> pulse1, pulse2, triangle, noise, dmc   (44.1kHz)
+ *   Game Boy VGM  -> pulse1, pulse2, wave, noise            (44.1kHz)
+ *   SPC           -> voice1 .. voice8                       (32kHz)
+ *
+ * NES/GB stems come from the emulators' renderSample(), which clocks the
+ * channels once and mixes each channel alone alongside the normal mix. SPC
+ * stems come from the DSP voice tap (SPC_DSP::set_voice_tap), so the song is
+ * emulated once and the per-voice outputs are captured as they are summed.
+ *
+ * Stems are dry: NES/GB stems skip the output filters and stereo panning, SPC
+ * stems exclude echo. mix.wav is exactly what playback would produce.
+ *
+ * Output layout: <outDir>/01_<name>.wav ... <outDir>/mix.wav
+ *
+ * Rendering is blocking and borrows the static APU instances from main.cpp
+ * (AudioStreams cannot be created and destroyed at runtime), so it must not
+ * run while a track is playing.
+ */
+class StemRenderer {
+public:
+    typedef void (*ProgressCallback)(float progress, void* userData);
+
+    StemRenderer();
+    ~StemRenderer();
+
+    /**
+     * Check whether a file type can be split into stems (.vgm/.vgz/.spc)
+     * VGM files are additionally checked for an NES or Game Boy APU in render()
+     */
+    static bool isSupported(const char* path);
+
+    /**
+     * Render all stems for a file
+     * @param path Input file path (VGM/VGZ/SPC)
+     * @param fileSource Source to read the input from
+     * @param outDir Output directory on SD card (created if missing)
+     * @return true on success; see getError() on failure
+     */
+    bool render(const char* path, FileSource* fileSource, const char* outDir);
+
+    void setProgressCallback(ProgressCallback callback, void* userData);
+
+    const char* getError() const { return error_; }
+    uint8_t getStemCount() const { return stemCount_; }
+    uint32_t getFramesRendered() const { return framesRendered_; }
+
+    static const uint8_t MAX_STEMS = 8;  // SPC has the most channels
+
+private:
+    static const uint32_t VGM_SAMPLE_RATE = 44100;
+    static const uint32_t SPC_SAMPLE_RATE = 32000;
+    static const int SPC_BLOCK_FRAMES = 512;     // Frames per spc_play() call
+    static const int SPC_TAP_FRAMES = 1024;      // Voice tap ring (> block + DSP extra)
+
+    bool renderVGM(const char* path, FileSource* fileSource, const char* outDir);
+    bool renderSPC(const char* path, FileSource* fileSource, const char* outDir);
+
+    bool openOutputs(const char* outDir, const char* const* names, uint8_t count, uint32_t sampleRate);
+    bool closeOutputs();
+    void writeFrame(const int16_t* stems, int16_t mixLeft, int16_t mixRight);
+
+    // VGM command handling (NES/GB writes, waits, DPCM data blocks; everything else skipped)
+    bool processVGMCommand(VGMFile* vgm, uint8_t cmd);
+    void renderVGMSamples(uint32_t count);
+    void loadNESDataBlock(VGMFile* vgm, uint8_t dataType, uint32_t dataSize);
+    static void skipBytes(VGMFile* vgm, uint32_t count);
+
+    // SPC length from the ID666 tag (same rules as SPCPlayer)
+    static void readSPCLength(const uint8_t* data, size_t size, uint32_t& playSeconds, uint32_t& fadeMs);
+
+    void reportProgress(uint32_t current, uint32_t total);
+
+    WavWriter stems_[MAX_STEMS];
+    WavWriter mix_;
+    uint8_t stemCount_;
+    bool writeFailed_;
+
+    // VGM render state
+    NESAPUEmulator* nes_;
+    GameBoyAPU* gb_;
+    uint32_t frameClockHz_;      // APU frame counter/sequencer rate
+    uint32_t frameClockAccum_;   // Accumulates frameClockHz_ per sample, ticks at 44100
+
+    uint32_t framesRendered_;
+    const char* error_;
+
+    ProgressCallback progressCallback_;
+    void* progressUserData_;
+    uint32_t lastProgressUpdate_;
+};
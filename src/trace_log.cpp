@@ -0,0 +1,290 @@
+#include "trace_log.h"
+#include <SD.h>
+
+// Not cleared at startup - survives a reset. Line-aligned so each Record is
+// exactly one cache line and the per-record flushes can't touch a neighbour.
+DMAMEM TraceLog::Ring TraceLog::ring_ __attribute__((aligned(32)));
+uint32_t TraceLog::readIndex_ = 0;
+uint32_t TraceLog::flushIndex_ = 0;
+bool TraceLog::previousSession_ = false;
+TraceLog::Stats TraceLog::stats_ = {0, 0};
+
+static const uint16_t MAX_DUMP_STRINGS = 128;
+
+// Records from a previous session may hold garbage - only follow pointers into
+// flash or on-chip RAM
+static bool isReadableAddress(uint32_t address) {
+    return (address >= 0x60000000 && address < 0x61000000) ||   // Program flash
+           (address >= 0x20000000 && address < 0x20080000) ||   // DTCM
+           (address >= 0x20200000 && address < 0x20280000);     // OCRAM
+}
+
+bool TraceLog::begin() {
+    // A leftover ring is only trusted if its header survived intact
+    previousSession_ = (ring_.magic == MAGIC && ring_.writeIndex != 0);
+
+    if (!previousSession_) {
+        memset(&ring_, 0, sizeof(ring_));
+        ring_.magic = MAGIC;
+    }
+    ring_.cpuHz = F_CPU_ACTUAL;
+
+    // Don't echo the old session again - it is still there for dump()
+    readIndex_ = ring_.writeIndex;
+    flushIndex_ = readIndex_;
+    stats_.drained = 0;
+    stats_.lost = 0;
+    arm_dcache_flush(&ring_, sizeof(ring_));
+
+    if (previousSession_) {
+        TRACE("[TraceLog] ---- reset: %lu records above are from the previous session ----",
+              ring_.writeIndex);
+    }
+    return previousSession_;
+}
+
+// ============================================
+// WRITE (any context)
+// ============================================
+
+void TraceLog::write(const char* fmt, uint8_t argc, const uint32_t* args) {
+    uint32_t index = __atomic_fetch_add(&ring_.writeIndex, 1, __ATOMIC_RELAXED);
+    Record& rec = ring_.records[index & (RECORD_COUNT - 1)];
+
+    // seq = 0 while the slot is being filled, so a reader never takes a torn record
+    rec.seq = 0;
+    __asm__ volatile("" ::: "memory");
+    rec.cycles = ARM_DWT_CYCCNT;
+    rec.fmt = (uint32_t)(uintptr_t)fmt;
+    rec.argc = argc;
+    for (uint8_t i = 0; i < MAX_ARGS; i++) {
+        rec.args[i] = args[i];
+    }
+    __asm__ volatile("dmb" ::: "memory");
+    rec.seq = index + 1;
+}
+
+void TraceLog::setCpuHz(uint32_t hz) {
+    // Format matched by tools/decode_trace_log.py - keep them in step
+    log("[TraceLog] CPU clock %lu -> %lu MHz", ring_.cpuHz / 1000000, hz / 1000000);
+    ring_.cpuHz = hz;
+}
+
+// ============================================
+// FORMATTING (main loop)
+// ============================================
+
+const char* TraceLog::parseSpec(const char* p, char* spec, size_t specSize, char* conversion) {
+    // p points just past '%'. Flags/width/precision are kept, length modifiers are
+    // dropped (every argument is 32 bits) and re-added by the formatter.
+    size_t n = 0;
+    spec[n++] = '%';
+    while (*p && strchr("-+ #0123456789.", *p)) {
+        if (n < specSize - 3) spec[n++] = *p;
+        p++;
+    }
+    while (*p && strchr("hlzjtL", *p)) {
+        p++;
+    }
+    *conversion = *p;
+    spec[n] = '\0';
+    return *p ? p + 1 : p;
+}
+
+void TraceLog::formatRecord(const Record& rec, char* out, size_t outSize) {
+    if (!isReadableAddress(rec.fmt)) {
+        snprintf(out, outSize, "<bad format 0x%08lx>", (unsigned long)rec.fmt);
+        return;
+    }
+
+    const char* p = (const char*)(uintptr_t)rec.fmt;
+    size_t pos = 0;
+    uint8_t argIndex = 0;
+
+    while (*p && pos < outSize - 1) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        char spec[16];
+        char conv;
+        p = parseSpec(p + 1, spec, sizeof(spec), &conv);
+
+        if (argIndex >= rec.argc) {
+            out[pos++] = '?';
+            continue;
+        }
+        uint32_t arg = rec.args[argIndex++];
+        size_t specLen = strlen(spec);
+        int written = 0;
+
+        switch (conv) {
+            case 'd': case 'i':
+                spec[specLen] = 'l'; spec[specLen + 1] = conv; spec[specLen + 2] = '\0';
+                written = snprintf(out + pos, outSize - pos, spec, (long)(int32_t)arg);
+                break;
+            case 'u': case 'x': case 'X': case 'o':
+                spec[specLen] = 'l'; spec[specLen + 1] = conv; spec[specLen + 2] = '\0';
+                written = snprintf(out + pos, outSize - pos, spec, (unsigned long)arg);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+                float f;
+                memcpy(&f, &arg, 4);
+                spec[specLen] = conv; spec[specLen + 1] = '\0';
+                written = snprintf(out + pos, outSize - pos, spec, (double)f);
+                break;
+            }
+            case 'c':
+                spec[specLen] = 'c'; spec[specLen + 1] = '\0';
+                written = snprintf(out + pos, outSize - pos, spec, (int)arg);
+                break;
+            case 's':
+                spec[specLen] = 's'; spec[specLen + 1] = '\0';
+                written = snprintf(out + pos, outSize - pos, spec,
+                                   isReadableAddress(arg) ? (const char*)(uintptr_t)arg : "(?)");
+                break;
+            case 'p':
+                written = snprintf(out + pos, outSize - pos, "0x%08lx", (unsigned long)arg);
+                break;
+            default:
+                out[pos++] = '?';
+                break;
+        }
+
+        if (written > 0) {
+            pos += (size_t)written;
+            if (pos > outSize - 1) pos = outSize - 1;
+        }
+    }
+    out[pos] = '\0';
+}
+
+void TraceLog::drain(uint16_t maxRecords) {
+    uint32_t end = ring_.writeIndex;
+
+    // Fell more than a ring behind: the oldest pending records are gone
+    if (end - readIndex_ > RECORD_COUNT) {
+        stats_.lost += end - RECORD_COUNT - readIndex_;
+        readIndex_ = end - RECORD_COUNT;
+    }
+
+    for (uint16_t n = 0; n < maxRecords && readIndex_ != end; n++) {
+        const Record& slot = ring_.records[readIndex_ & (RECORD_COUNT - 1)];
+        uint32_t seq = slot.seq;
+        if (seq == 0 || seq < readIndex_ + 1) {
+            break;  // Reserved but not committed yet (writer was preempted) - retry next time
+        }
+
+        Record rec = slot;
+        __asm__ volatile("" ::: "memory");
+        if (seq != readIndex_ + 1 || slot.seq != seq) {
+            // Overwritten by a newer lap while we were behind
+            stats_.lost++;
+            readIndex_++;
+            continue;
+        }
+
+#if DEBUG_TRACE_ECHO
+        char line[160];
+        formatRecord(rec, line, sizeof(line));
+        Serial.println(line);
+#endif
+        readIndex_++;
+        stats_.drained++;
+    }
+
+    // Push drained (committed) slots out to RAM so they survive a reset
+    while (flushIndex_ != readIndex_) {
+        arm_dcache_flush(&ring_.records[flushIndex_ & (RECORD_COUNT - 1)], sizeof(Record));
+        flushIndex_++;
+    }
+    arm_dcache_flush(&ring_, 32);  // Header line (writeIndex)
+}
+
+// ============================================
+// BINARY DUMP
+// ============================================
+
+uint32_t TraceLog::dump(Print& out) {
+    uint32_t end = ring_.writeIndex;
+    uint32_t first = (end > RECORD_COUNT) ? end - RECORD_COUNT : 0;
+    uint32_t count = end - first;
+
+    // String table: every format string used, plus %s arguments, so the dump
+    // decodes without the firmware image
+    uint32_t strings[MAX_DUMP_STRINGS];
+    uint16_t stringCount = 0;
+    auto addString = [&](uint32_t address) {
+        if (!isReadableAddress(address)) return;
+        for (uint16_t i = 0; i < stringCount; i++) {
+            if (strings[i] == address) return;
+        }
+        if (stringCount < MAX_DUMP_STRINGS) strings[stringCount++] = address;
+    };
+
+    for (uint32_t i = first; i < end; i++) {
+        const Record& rec = ring_.records[i & (RECORD_COUNT - 1)];
+        if (rec.seq != i + 1 || !isReadableAddress(rec.fmt)) continue;
+        addString(rec.fmt);
+
+        const char* p = (const char*)(uintptr_t)rec.fmt;
+        uint8_t argIndex = 0;
+        while ((p = strchr(p, '%')) != nullptr) {
+            if (p[1] == '%') { p += 2; continue; }
+            char spec[16];
+            char conv;
+            p = parseSpec(p + 1, spec, sizeof(spec), &conv);
+            if (conv == 's' && argIndex < rec.argc) addString(rec.args[argIndex]);
+            argIndex++;
+        }
+    }
+
+    // Header (little-endian, see tools/decode_trace_log.py)
+    struct {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t cpuHz;
+        uint32_t firstIndex;
+        uint32_t recordCount;
+        uint32_t stringCount;
+    } header = {MAGIC, VERSION, (uint16_t)sizeof(Record), ring_.cpuHz, first, count, stringCount};
+    out.write((const uint8_t*)&header, sizeof(header));
+
+    for (uint16_t i = 0; i < stringCount; i++) {
+        const char* str = (const char*)(uintptr_t)strings[i];
+        uint16_t len = (uint16_t)strnlen(str, 255);
+        out.write((const uint8_t*)&strings[i], 4);
+        out.write((const uint8_t*)&len, 2);
+        out.write((const uint8_t*)str, len);
+    }
+
+    for (uint32_t i = first; i < end; i++) {
+        Record rec = ring_.records[i & (RECORD_COUNT - 1)];
+        out.write((const uint8_t*)&rec, sizeof(rec));
+    }
+
+    return count;
+}
+
+bool TraceLog::dumpToSD(const char* path) {
+    if (SD.exists(path)) {
+        SD.remove(path);
+    }
+    File file = SD.open(path, FILE_WRITE);
+    if (!file) {
+        Serial.printf("[TraceLog] ERROR: Failed to create %s\n", path);
+        return false;
+    }
+
+    uint32_t count = dump(file);
+    file.close();
+    Serial.printf("[TraceLog] Dumped %lu records to %s\n", count, path);
+    return true;
+}
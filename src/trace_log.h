@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+#include "debug_config.h"
+
+/**
+ * TraceLog - Binary deferred-format diagnostics log
+ *
+ * Serial.printf in a timing-sensitive path costs far more than the code being
+ * debugged (formatting plus a blocking write), so turning on a debug print
+ * changes the timing it was meant to observe. A TRACE() call instead stores
+ * the format string pointer, a cycle-counter timestamp and up to four raw
+ * 32-bit arguments into one 32-byte slot of a RAM ring - a handful of stores
+ * and one atomic increment, safe from any ISR priority.
+ *
+ * Formatting happens later:
+ *   - drain() in the main loop's idle time renders pending records as text
+ *     on Serial (when DEBUG_TRACE_ECHO is on)
+ *   - dump() writes the raw ring plus a table of the format strings it uses,
+ *     for tools/decode_trace_log.py to render on the host
+ *
+ * The ring lives in DMAMEM, which the startup code does not clear, so after a
+ * fault and reset the previous session's records are still there and can be
+ * dumped to SD (see dumpToSD()). drain() flushes newly committed slots out of
+ * the data cache, so only the last few records before a crash can be lost.
+ *
+ * Argument rules: integers, pointers, floats/doubles (stored as float) and
+ * %s of string literals only - the string pointer is followed at format time.
+ *
+ * Usage:
+ *   TRACE("VGM: Loaded %lu bytes of YM2612 PCM data", dataSize);
+ */
+class TraceLog {
+public:
+    static const uint16_t RECORD_COUNT = 1024;     // 32KB ring
+    static const uint8_t MAX_ARGS = 4;
+
+    struct Record {
+        uint32_t cycles;                            // ARM_DWT_CYCCNT at the call
+        uint32_t fmt;                               // Format string address (also its ID)
+        uint8_t argc;
+        uint8_t reserved[3];
+        uint32_t args[MAX_ARGS];
+        uint32_t seq;                               // Written last: slot index + 1 when committed
+    };
+    static_assert(sizeof(Record) == 32, "TraceLog::Record must be one cache line");
+
+    struct Stats {
+        uint32_t drained;
+        uint32_t lost;                              // Overwritten before drain() reached them
+    };
+
+    /**
+     * Adopt the ring left over from before a reset, or clear it
+     * @return true if records from the previous session were kept
+     */
+    static bool begin();
+
+    /**
+     * Record a message (any context, including ISRs)
+     */
+    static void write(const char* fmt, uint8_t argc, const uint32_t* args);
+
+    template <typename... Args>
+    static inline void log(const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "TRACE supports at most 4 arguments");
+        uint32_t packed[MAX_ARGS] = {toArg(args)...};
+        write(fmt, sizeof...(Args), packed);
+    }
+
+    /**
+     * Format up to maxRecords pending records (main loop idle time)
+     */
+    static void drain(uint16_t maxRecords = 8);
+
+    /**
+     * Write the binary log (header, string table, records) to any Print
+     * @return number of records written
+     */
+    static uint32_t dump(Print& out);
+
+    /**
+     * Dump to a file on SD
+     */
+    static bool dumpToSD(const char* path);
+
+    /**
+     * Record an ARM clock change (call after set_arm_clock())
+     * Timestamps are cycle counts, so the change is logged as a record the
+     * decoder re-bases on, and the header carries the new clock.
+     */
+    static void setCpuHz(uint32_t hz);
+
+    static bool hasPreviousSession() { return previousSession_; }
+    static uint32_t getWriteCount() { return ring_.writeIndex; }
+    static const Stats& getStats() { return stats_; }
+
+private:
+    static const uint32_t MAGIC = 0x4C544D46;       // "FMTL"
+    static const uint16_t VERSION = 1;
+
+    struct Ring {
+        uint32_t magic;
+        uint32_t cpuHz;
+        uint32_t writeIndex;                        // Next slot to reserve (monotonic, atomic add)
+        uint32_t pad[5];
+        Record records[RECORD_COUNT];
+    };
+
+    // Integers and enums are stored as-is (sign-extended), floats as float bits
+    template <typename T>
+    static inline uint32_t toArg(T v) { return (uint32_t)v; }
+    template <typename T>
+    static inline uint32_t toArg(T* p) { return (uint32_t)(uintptr_t)p; }
+    static inline uint32_t toArg(float v) { uint32_t u; memcpy(&u, &v, 4); return u; }
+    static inline uint32_t toArg(double v) { return toArg((float)v); }
+
+    static const char* parseSpec(const char* p, char* spec, size_t specSize, char* conversion);
+    static void formatRecord(const Record& rec, char* out, size_t outSize);
+
+    static Ring ring_;
+    static uint32_t readIndex_;                     // Next slot drain() will format
+    static uint32_t flushIndex_;                    // Slots below this are flushed from the cache
+    static bool previousSession_;
+    static Stats stats_;
+};
+
+#if DEBUG_TRACE_ENABLED
+  #define TRACE(...) TraceLog::log(__VA_ARGS__)
+#else
+  #define TRACE(...)
+#endif
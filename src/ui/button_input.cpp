@@ -0,0 +1,341 @@
+#include "button_input.h"
+#include "lcd_manager.h"
+#include "../trace_log.h"
+#include <Wire.h>
+
+ButtonInput* ButtonInput::instance_ = nullptr;
+
+ButtonInput::ButtonInput(LCDManager* lcdManager)
+    : lcdManager_(lcdManager)
+    , intPin_(-1)
+    , irqPending_(false)
+    , irqUs_(0)
+    , lastPollMs_(0)
+    , stable_(0)
+    , raw_(0)
+    , lockedMask_(0)
+    , repeatButton_(0)
+    , nextRepeatUs_(0)
+    , head_(0)
+    , tail_(0)
+    , latencyTotalUs_(0) {
+    memset(lockoutUntilUs_, 0, sizeof(lockoutUntilUs_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool ButtonInput::begin(int8_t intPin) {
+    instance_ = this;
+
+    // Everything below is blocking Wire - the LCD queue must not own the bus
+    if (lcdManager_) {
+        lcdManager_->waitBusIdle();
+    }
+
+    // Sequential reads (INTF..GPIOA in one transaction), open-drain INT so the
+    // Teensy pull-up defines the idle level
+    uint8_t iocon;
+    if (!readRegister(REG_IOCON, iocon)) {
+        Serial.println("[ButtonInput] ERROR: MCP23017 not responding");
+        return false;
+    }
+    writeRegister(REG_IOCON, (iocon & ~IOCON_SEQOP) | IOCON_ODR);
+
+    uint8_t captured, current;
+    bool hadInterrupt;
+    if (readPort(captured, current, hadInterrupt)) {
+        raw_ = stable_ = current;
+    }
+
+    if (intPin < 0) {
+        Serial.printf("[ButtonInput] No INT pin - polling every %lu ms\n", POLL_INTERVAL_MS);
+        return false;
+    }
+
+    pinMode(intPin, INPUT_PULLUP);
+    intPin_ = intPin;
+    if (!checkInterruptLine()) {
+        Serial.printf("[ButtonInput] WARNING: MCP23017 INTA not seen on pin %d - polling every %lu ms\n",
+                      intPin, POLL_INTERVAL_MS);
+        intPin_ = -1;
+        return false;
+    }
+
+    // Interrupt on any change of GPA0..GPA4
+    writeRegister(REG_INTCONA, 0x00);
+    writeRegister(REG_GPINTENA, BUTTON_MASK);
+    readPort(captured, current, hadInterrupt);  // Clears anything raised while configuring
+    raw_ = stable_ = current;
+
+    irqPending_ = false;
+    attachInterrupt(digitalPinToInterrupt(intPin), isr, FALLING);
+
+    Serial.printf("[ButtonInput] Interrupt-driven on pin %d\n", intPin);
+    return true;
+}
+
+bool ButtonInput::checkInterruptLine() {
+    // Force INTA active: compare mode against DEFVAL = 0 fires for any released
+    // (pulled-up) button, then check the Teensy pin follows it both ways
+    writeRegister(REG_DEFVALA, 0x00);
+    writeRegister(REG_INTCONA, BUTTON_MASK);
+    writeRegister(REG_GPINTENA, BUTTON_MASK);
+    delayMicroseconds(50);
+    bool asserted = digitalRead(intPin_) == LOW;
+
+    writeRegister(REG_GPINTENA, 0x00);
+    uint8_t captured, current;
+    bool hadInterrupt;
+    readPort(captured, current, hadInterrupt);
+    delayMicroseconds(50);
+    bool released = digitalRead(intPin_) == HIGH;
+
+    return asserted && released;
+}
+
+// ============================================
+// PIN INTERRUPT
+// ============================================
+
+void ButtonInput::isr() {
+    ButtonInput* b = instance_;
+    if (!b) return;
+
+    b->stats_.interrupts++;
+    // Keep the first edge - that is when the user acted
+    if (!b->irqPending_) {
+        b->irqUs_ = micros();
+        b->irqPending_ = true;
+    }
+}
+
+// ============================================
+// MAIN LOOP
+// ============================================
+
+void ButtonInput::service() {
+    bool busBusy = lcdManager_ && lcdManager_->isBusBusy();
+    bool read = false;
+    uint32_t edgeUs = micros();
+
+    if (intPin_ >= 0) {
+        // The level check also catches an edge that fell while INTA was already low
+        if ((irqPending_ || digitalRead(intPin_) == LOW) && !busBusy) {
+            __disable_irq();
+            if (irqPending_) {
+                edgeUs = irqUs_;
+            }
+            irqPending_ = false;
+            __enable_irq();
+            read = true;
+        }
+    } else if (millis() - lastPollMs_ >= POLL_INTERVAL_MS && !busBusy) {
+        lastPollMs_ = millis();
+        read = true;
+    }
+
+    if (read) {
+        uint8_t captured, current;
+        bool hadInterrupt;
+        if (readPort(captured, current, hadInterrupt)) {
+            applyPort(captured, current, hadInterrupt, edgeUs);
+        } else if (intPin_ >= 0) {
+            irqPending_ = true;  // Retry next pass
+        }
+    }
+
+    runTimers(micros());
+}
+
+bool ButtonInput::pop(Event& ev) {
+    if (head_ == tail_) return false;
+    ev = queue_[tail_ & (QUEUE_SIZE - 1)];
+    tail_++;
+    return true;
+}
+
+void ButtonInput::markHandled(const Event& ev) {
+    if (ev.type != PRESS) return;
+
+    uint32_t latency = micros() - ev.timeUs;
+    stats_.handled++;
+    latencyTotalUs_ += latency;
+    stats_.latencyAvgUs = (uint32_t)(latencyTotalUs_ / stats_.handled);
+    if (latency > stats_.latencyMaxUs) {
+        stats_.latencyMaxUs = latency;
+    }
+    if (latency > 50000) {
+        stats_.latencyOver50ms++;
+    }
+    TRACE("[ButtonInput] 0x%02x handled %lu us after edge", ev.button, latency);
+}
+
+void ButtonInput::resync() {
+    if (lcdManager_) {
+        lcdManager_->waitBusIdle();
+    }
+
+    uint8_t captured, current;
+    bool hadInterrupt;
+    irqPending_ = false;
+    if (readPort(captured, current, hadInterrupt)) {
+        raw_ = stable_ = current;
+    }
+    lockedMask_ = 0;
+    repeatButton_ = 0;
+}
+
+// ============================================
+// DEBOUNCE / REPEAT
+// ============================================
+
+void ButtonInput::applyPort(uint8_t captured, uint8_t current, bool hadInterrupt, uint32_t edgeUs) {
+    raw_ = current;
+
+    // Pressed at the edge but already released when we read: still a press.
+    // The release is applied when its debounce lockout ends.
+    uint8_t taps = 0;
+    if (hadInterrupt) {
+        taps = captured & ~current & ~stable_ & ~lockedMask_;
+        for (uint8_t i = 0; i < 5; i++) {
+            uint8_t bit = 1 << i;
+            if (taps & bit) {
+                stats_.tapsRecovered++;
+                setButton(bit, true, edgeUs);
+            }
+        }
+    }
+
+    uint8_t changed = (current ^ stable_) & BUTTON_MASK & ~taps;
+    for (uint8_t i = 0; i < 5; i++) {
+        uint8_t bit = 1 << i;
+        if (!(changed & bit)) continue;
+        if (lockedMask_ & bit) {
+            stats_.bouncesIgnored++;  // Re-checked when the lockout ends
+            continue;
+        }
+        setButton(bit, (current & bit) != 0, edgeUs);
+    }
+}
+
+void ButtonInput::setButton(uint8_t bit, bool down, uint32_t timeUs) {
+    uint8_t index = 0;
+    while (!((1 << index) & bit)) index++;
+
+    if (down) {
+        stable_ |= bit;
+        push(bit, PRESS, timeUs);
+        if (bit & REPEAT_MASK) {
+            repeatButton_ = bit;
+            nextRepeatUs_ = timeUs + REPEAT_DELAY * 1000UL;
+        }
+    } else {
+        stable_ &= ~bit;
+        if (repeatButton_ == bit) {
+            repeatButton_ = 0;
+        }
+    }
+
+    lockoutUntilUs_[index] = timeUs + DEBOUNCE_DELAY * 1000UL;
+    lockedMask_ |= bit;
+}
+
+void ButtonInput::runTimers(uint32_t nowUs) {
+    // Debounce lockouts: adopt whatever the port settled on
+    for (uint8_t i = 0; i < 5 && lockedMask_; i++) {
+        uint8_t bit = 1 << i;
+        if (!(lockedMask_ & bit)) continue;
+        if ((int32_t)(nowUs - lockoutUntilUs_[i]) < 0) continue;
+
+        lockedMask_ &= ~bit;
+        if ((raw_ ^ stable_) & bit) {
+            setButton(bit, (raw_ & bit) != 0, lockoutUntilUs_[i]);
+        }
+    }
+
+    // Auto-repeat on a fixed grid from the press
+    if (repeatButton_ && (stable_ & repeatButton_) && (int32_t)(nowUs - nextRepeatUs_) >= 0) {
+        push(repeatButton_, REPEAT, nextRepeatUs_);
+        nextRepeatUs_ += REPEAT_RATE * 1000UL;
+
+        if ((int32_t)(nowUs - nextRepeatUs_) >= 0) {
+            uint32_t missed = (nowUs - nextRepeatUs_) / (REPEAT_RATE * 1000UL) + 1;
+            stats_.repeatsSkipped += missed;
+            nextRepeatUs_ += missed * REPEAT_RATE * 1000UL;
+        }
+    }
+}
+
+void ButtonInput::push(uint8_t button, EventType type, uint32_t timeUs) {
+    if ((uint8_t)(head_ - tail_) >= QUEUE_SIZE) {
+        stats_.dropped++;
+        return;
+    }
+    Event& ev = queue_[head_ & (QUEUE_SIZE - 1)];
+    ev.button = button;
+    ev.type = type;
+    ev.timeUs = timeUs;
+    head_++;
+
+    if (type == PRESS) {
+        stats_.presses++;
+    } else {
+        stats_.repeats++;
+    }
+}
+
+// ============================================
+// MCP23017 ACCESS (blocking Wire, bus must be idle)
+// ============================================
+
+bool ButtonInput::writeRegister(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(MCP23017_ADDRESS);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+bool ButtonInput::readRegister(uint8_t reg, uint8_t& value) {
+    Wire.beginTransmission(MCP23017_ADDRESS);
+    Wire.write(reg);
+    if (Wire.endTransmission() != 0) return false;
+    if (Wire.requestFrom(MCP23017_ADDRESS, (uint8_t)1) != 1) return false;
+    value = Wire.read();
+    return true;
+}
+
+bool ButtonInput::readPort(uint8_t& captured, uint8_t& current, bool& hadInterrupt) {
+    stats_.portReads++;
+
+    // INTFA, INTFB, INTCAPA, INTCAPB, GPIOA - reading INTCAP/GPIO clears INTA
+    Wire.beginTransmission(MCP23017_ADDRESS);
+    Wire.write(REG_INTFA);
+    if (Wire.endTransmission() != 0 || Wire.requestFrom(MCP23017_ADDRESS, (uint8_t)5) != 5) {
+        stats_.readErrors++;
+        return false;
+    }
+    uint8_t intf = Wire.read();
+    Wire.read();
+    uint8_t intcap = Wire.read();
+    Wire.read();
+    uint8_t gpio = Wire.read();
+
+    // Buttons pull low when pressed; bit order matches BUTTON_SELECT..BUTTON_LEFT
+    hadInterrupt = (intf & BUTTON_MASK) != 0;
+    captured = ~intcap & BUTTON_MASK;
+    current = ~gpio & BUTTON_MASK;
+    return true;
+}
+
+void ButtonInput::printStats() const {
+    Serial.println("=== ButtonInput Stats ===");
+    Serial.printf("Mode: %s\n", intPin_ >= 0 ? "interrupt" : "polling");
+    Serial.printf("Events: %lu presses, %lu repeats, %lu dropped, %lu repeats skipped\n",
+                  stats_.presses, stats_.repeats, stats_.dropped, stats_.repeatsSkipped);
+    Serial.printf("Taps recovered: %lu, bounces ignored: %lu\n",
+                  stats_.tapsRecovered, stats_.bouncesIgnored);
+    Serial.printf("INT edges: %lu, port reads: %lu, read errors: %lu\n",
+                  stats_.interrupts, stats_.portReads, stats_.readErrors);
+    Serial.printf("Press-to-action: avg %lu us, max %lu us, %lu over 50ms (%lu handled)\n",
+                  stats_.latencyAvgUs, stats_.latencyMaxUs, stats_.latencyOver50ms, stats_.handled);
+    Serial.println("=========================");
+}
@@ -0,0 +1,170 @@
+#ifndef BUTTON_INPUT_H
+#define BUTTON_INPUT_H
+
+#include <Arduino.h>
+
+class LCDManager;
+
+// Button timing (shared with ScreenManager)
+#define DEBOUNCE_DELAY 20     // ms a button ignores further edges after an accepted change
+#define REPEAT_DELAY   400    // ms before key repeat starts (hold time)
+#define REPEAT_RATE    80     // ms between repeats (fast scrolling)
+
+/**
+ * ButtonInput - Interrupt-driven RGB LCD shield buttons with a timestamped event queue
+ *
+ * The five buttons are GPA0..GPA4 of the shield's MCP23017 (active low, pulled
+ * up). Adafruit_RGBLCDShield::readButtons() costs five blocking I2C reads per
+ * call, so the old code could only afford it every 50ms - shorter taps were
+ * missed and every poll still stalled the loop.
+ *
+ * Here the MCP23017 raises INTA on any button change. The pin interrupt only
+ * records a micros() timestamp; service() (main loop) then reads INTF, INTCAP
+ * and GPIOA in one transaction once the LCD queue has released the bus.
+ * INTCAP holds the port as it was at the edge, so a tap that is already
+ * released by the time the read happens still produces a press.
+ *
+ * Debounce and auto-repeat run on timestamps, not on loop timing:
+ * - Debounce: after an accepted change a button ignores edges for
+ *   DEBOUNCE_DELAY; its state is re-checked when the lockout ends
+ * - Repeat: UP/DOWN repeat on a fixed grid of press + REPEAT_DELAY +
+ *   n * REPEAT_RATE. A loop stall skips missed repeats instead of bursting
+ *
+ * Wiring: INTA must be jumpered to a Teensy pin (the shield doesn't route it).
+ * begin() forces an interrupt to check the jumper; without it, service()
+ * falls back to reading the port every POLL_INTERVAL_MS (one transaction).
+ *
+ * Latency: call markHandled() after acting on an event. Stats record
+ * edge-to-action time for presses, plus drops (full queue) and recovered taps.
+ *
+ * Usage:
+ *   ButtonInput buttons(lcdManager);
+ *   buttons.begin(BUTTON_INT_PIN);
+ *
+ *   // Main loop
+ *   buttons.service();
+ *   ButtonInput::Event ev;
+ *   while (buttons.pop(ev)) {
+ *       handle(ev.button);
+ *       buttons.markHandled(ev);
+ *   }
+ */
+class ButtonInput {
+public:
+    enum EventType : uint8_t {
+        PRESS,
+        REPEAT
+    };
+
+    struct Event {
+        uint8_t button;          // One BUTTON_* bit
+        EventType type;
+        uint32_t timeUs;         // Edge time (press) or scheduled time (repeat)
+    };
+
+    struct Stats {
+        uint32_t presses;        // PRESS events queued
+        uint32_t repeats;        // REPEAT events queued
+        uint32_t dropped;        // Events lost to a full queue
+        uint32_t tapsRecovered;  // Presses released before the port was read
+        uint32_t bouncesIgnored; // Edges inside a debounce lockout
+        uint32_t repeatsSkipped; // Repeats missed during a loop stall
+        uint32_t interrupts;     // INTA edges
+        uint32_t portReads;      // I2C transactions
+        uint32_t readErrors;
+        uint32_t handled;        // Presses passed to markHandled()
+        uint32_t latencyAvgUs;   // Edge to action
+        uint32_t latencyMaxUs;
+        uint32_t latencyOver50ms;
+    };
+
+    static const uint8_t QUEUE_SIZE = 16;            // Power of 2
+    static const uint32_t POLL_INTERVAL_MS = 50;     // Fallback without the INT jumper
+
+    explicit ButtonInput(LCDManager* lcdManager);
+
+    /**
+     * Configure the MCP23017 port A interrupt and attach the pin interrupt
+     * @param intPin Teensy pin wired to INTA, or -1 to poll
+     * @return true if interrupt mode is active (false = polling fallback)
+     */
+    bool begin(int8_t intPin);
+
+    /**
+     * Read the port if an edge is pending, run debounce/repeat timers (main loop)
+     */
+    void service();
+
+    /**
+     * Take the oldest queued event
+     */
+    bool pop(Event& ev);
+
+    /**
+     * Record press-to-action latency once an event has been acted on
+     */
+    void markHandled(const Event& ev);
+
+    /**
+     * Re-read the port and adopt it as the stable state without queuing
+     * events (after code that read buttons directly, e.g. ModalDialog)
+     */
+    void resync();
+
+    bool isInterruptDriven() const { return intPin_ >= 0; }
+    uint8_t getButtons() const { return stable_; }
+    const Stats& getStats() const { return stats_; }
+    void printStats() const;
+
+private:
+    static const uint8_t MCP23017_ADDRESS = 0x20;
+    static const uint8_t BUTTON_MASK = 0x1F;         // GPA0..GPA4
+    static const uint8_t REPEAT_MASK = 0x0C;         // BUTTON_DOWN | BUTTON_UP
+
+    // MCP23017 registers (IOCON.BANK = 0)
+    static const uint8_t REG_GPINTENA = 0x04;
+    static const uint8_t REG_DEFVALA = 0x06;
+    static const uint8_t REG_INTCONA = 0x08;
+    static const uint8_t REG_IOCON = 0x0A;
+    static const uint8_t REG_INTFA = 0x0E;
+    static const uint8_t REG_GPIOA = 0x12;
+
+    static const uint8_t IOCON_SEQOP = 0x20;
+    static const uint8_t IOCON_ODR = 0x04;
+
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegister(uint8_t reg, uint8_t& value);
+    bool readPort(uint8_t& captured, uint8_t& current, bool& hadInterrupt);
+    bool checkInterruptLine();
+    void applyPort(uint8_t captured, uint8_t current, bool hadInterrupt, uint32_t edgeUs);
+    void setButton(uint8_t bit, bool down, uint32_t timeUs);
+    void runTimers(uint32_t nowUs);
+    void push(uint8_t button, EventType type, uint32_t timeUs);
+
+    static void isr();
+    static ButtonInput* instance_;
+
+    LCDManager* lcdManager_;
+    int8_t intPin_;
+
+    volatile bool irqPending_;
+    volatile uint32_t irqUs_;                        // First edge since the last read
+    uint32_t lastPollMs_;
+
+    uint8_t stable_;                                 // Debounced state (BUTTON_* bits)
+    uint8_t raw_;                                    // Last port read
+    uint32_t lockoutUntilUs_[5];                     // Per button, debounce end
+    uint8_t lockedMask_;
+
+    uint8_t repeatButton_;
+    uint32_t nextRepeatUs_;
+
+    Event queue_[QUEUE_SIZE];
+    uint8_t head_;
+    uint8_t tail_;
+
+    uint64_t latencyTotalUs_;
+    Stats stats_;
+};
+
+#endif // BUTTON_INPUT_H
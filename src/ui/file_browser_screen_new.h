@@ -15,10 +15,14 @@
 #include "../playback_coordinator.h"  // For requestPlay()
 #include "../queue_manager.h"  // For queue operations
 #include "../opl3_synth.h"
+#include "../stem_renderer.h"
 #include <SD.h>
 #include <vector>
 #include "screen_id.h"
 #include "../usb_drive_manager.h"
+#include "../cover_art_cache.h"
+#include "../zip_archive.h"
+#include "../load_shedder.h"
 
 /**
  * FileBrowserScreenNew - File browser using new framework
@@ -60,6 +64,19 @@ private:
     FileSourceType sourceType_;
     bool loadingFloppyFiles_;  // True when waiting for async floppy file list
 
+    // Cover thumbnail panel (FM9 files, right of the list)
+    enum CoverState {
+        COVER_NONE,
+        COVER_LOADING,
+        COVER_SHOWN
+    };
+    static const uint32_t COVER_SERVICE_US = 1000;   // Extraction budget per update()
+    static const int COVER_PREFETCH = 4;             // Files either side of the cursor
+    int coverIndex_;           // Item the panel shows
+    CoverState coverState_;
+    uint32_t coverGeneration_;
+    int coverWantedFor_;       // Item the prefetch list was built around (-1 = rebuild)
+
     // Actions for folders (generic)
     static ItemAction folderActions_[2];
 
@@ -67,7 +84,7 @@ private:
     static ItemAction sdFolderActions_[3];
 
     // Actions for files
-    static ItemAction fileActions_[4];
+    static ItemAction fileActions_[5];
 
     // Actions for USB files (with Refresh like floppy)
     static ItemAction usbFileActions_[3];
@@ -84,7 +101,11 @@ public:
     FileBrowserScreenNew(ScreenContext* context, FileSourceType sourceType)
         : ActionableListScreenBase(context, 20, 5, 1),  // 20 visible items, start at row 5, compact spacing
           sourceType_(sourceType),
-          loadingFloppyFiles_(false) {
+          loadingFloppyFiles_(false),
+          coverIndex_(-1),
+          coverState_(COVER_NONE),
+          coverGeneration_(0),
+          coverWantedFor_(-1) {
 
         // Initialize current path based on source
         currentPath_ = "/";
@@ -154,6 +175,7 @@ public:
             Serial.printf("[FileBrowser] Using static SD cache (source=%d, path=%s, reason=%s)\n",
                          sourceType_, currentPath_.c_str(), reloadReason);
             files_ = sdCache_.files;
+            setCoverDirectory();
         }
 
         // Call base class
@@ -190,6 +212,13 @@ public:
 
         // Call base class
         ActionableListScreenBase::update();
+
+        updateCoverArt();
+    }
+
+    void draw() override {
+        ActionableListScreenBase::draw();
+        drawCoverPanel(true);
     }
 
     // ============================================
@@ -221,7 +250,7 @@ public:
         }
 
         // Fill row background
-        context_->ui->fillGridRect(2, row, 96, 1, bg);
+        context_->ui->fillGridRect(2, row, 66, 1, bg);  // Cover panel to the right
 
         // Draw selection arrow if selected (DOS style)
         if (selected) {
@@ -240,8 +269,8 @@ public:
         snprintf(displayName, sizeof(displayName), "%.38s", file.name.c_str());
         context_->ui->drawText(6, row, displayName, fg, bg);
 
-        // Draw file type
-        if (!file.isDirectory && file.type != "BACK") {
+        // Draw file type (archives too, though they browse like folders)
+        if ((!file.isDirectory || file.type == "ZIP") && file.type != "BACK") {
             context_->ui->drawText(45, row, file.type.c_str(),
                                   selected ? DOS_BLACK : DOS_LIGHT_GRAY, bg);
         }
@@ -300,7 +329,7 @@ public:
             count = 3;
             return floppyFileActions_;
         } else {
-            count = 4;
+            count = 5;
             return fileActions_;
         }
     }
@@ -354,6 +383,8 @@ public:
         } else if (strcmp(actionLabel, "File info") == 0) {
             // FUTURE: Show file info dialog (feature enhancement)
             return ScreenResult::stay();
+        } else if (strcmp(actionLabel, "Export stems") == 0) {
+            return exportStems(itemIndex);
         } else if (strcmp(actionLabel, "Move to SD") == 0) {
             // FUTURE: Implement file transfer to SD (feature enhancement)
             return ScreenResult::stay();
@@ -469,6 +500,102 @@ private:
             loadFloppyDirectory();
         }
 
+        setCoverDirectory();
+    }
+
+    // ============================================
+    // COVER THUMBNAILS
+    // ============================================
+
+    void setCoverDirectory() {
+        coverWantedFor_ = -1;
+        if (!g_coverArtCache) return;
+
+        if (ZipArchive::isArchivePath(currentPath_.c_str())) {
+            // Members would have to be inflated through the archive
+            g_coverArtCache->setDirectory(nullptr, "", "");
+        } else if (sourceType_ == SOURCE_SD) {
+            g_coverArtCache->setDirectory(&SD, "SD", currentPath_.c_str());
+        } else if (sourceType_ == SOURCE_USB && context_->hasUSBDrive() && context_->usbDrive->isDriveReady()) {
+            g_coverArtCache->setDirectory(context_->usbDrive->getFilesystem(), "USB", currentPath_.c_str());
+        } else {
+            // Floppy files can only be read by transferring them
+            g_coverArtCache->setDirectory(nullptr, "", "");
+        }
+    }
+
+    bool hasCover(int itemIndex) const {
+        return itemIndex >= 0 && itemIndex < (int)files_.size() &&
+               !files_[itemIndex].isDirectory && files_[itemIndex].type == "FM9";
+    }
+
+    void updateCoverArt() {
+        if (!g_coverArtCache) return;
+
+        // Prefetch the highlighted file first, then outwards from it
+        if (coverWantedFor_ != selectedIndex_) {
+            coverWantedFor_ = selectedIndex_;
+            g_coverArtCache->clearWanted();
+            for (int distance = 0; distance <= COVER_PREFETCH; distance++) {
+                int below = selectedIndex_ + distance;
+                int above = selectedIndex_ - distance;
+                if (hasCover(below)) {
+                    g_coverArtCache->want(files_[below].name.c_str(), files_[below].size);
+                }
+                if (distance > 0 && hasCover(above)) {
+                    g_coverArtCache->want(files_[above].name.c_str(), files_[above].size);
+                }
+            }
+        }
+
+        // Extraction waits while the load shedder is holding background work back
+        bool deferred = g_loadShedder && g_loadShedder->isShed(LoadShedder::STEP_BACKGROUND);
+        if (g_coverArtCache->isBusy() && !deferred) {
+            g_coverArtCache->service(COVER_SERVICE_US);
+        }
+
+        if (coverIndex_ != selectedIndex_ || coverGeneration_ != g_coverArtCache->getGeneration()) {
+            drawCoverPanel(false);
+        }
+    }
+
+    /**
+     * Thumbnail of the highlighted FM9 at cols 72-78, rows 6-9
+     */
+    void drawCoverPanel(bool force) {
+        if (!g_coverArtCache) return;
+
+        const uint16_t* pixels = nullptr;
+        CoverState state = COVER_NONE;
+        if (hasCover(selectedIndex_)) {
+            const FileEntry& file = files_[selectedIndex_];
+            CoverArtCache::Status status = g_coverArtCache->get(file.name.c_str(), file.size, &pixels);
+            if (status == CoverArtCache::STATUS_READY) {
+                state = COVER_SHOWN;
+            } else if (status == CoverArtCache::STATUS_PENDING) {
+                state = COVER_LOADING;
+            }
+        }
+
+        // Skip redraws that wouldn't change anything (avoids flicker while scrolling)
+        bool changed = force || state != coverState_ ||
+                       (state == COVER_SHOWN && coverIndex_ != selectedIndex_);
+        coverIndex_ = selectedIndex_;
+        coverState_ = state;
+        coverGeneration_ = g_coverArtCache->getGeneration();
+        if (!changed) return;
+
+        context_->ui->fillGridRect(71, 6, 10, 4, DOS_BLUE);
+        if (state == COVER_LOADING) {
+            context_->ui->drawText(71, 7, "Loading...", DOS_LIGHT_GRAY, DOS_BLUE);
+        } else if (state == COVER_SHOWN) {
+            RA8875_SPI1* tft = context_->ui->getTFT();
+            if (tft) {
+                // Centered in the 56x64 pixel cell block
+                tft->drawImage(72 * 8 + 3, 6 * 16 + 7, CoverArtCache::THUMB_SIZE,
+                               CoverArtCache::THUMB_SIZE, pixels);
+            }
+        }
     }
 
     void addBackItem() {
@@ -499,7 +626,7 @@ private:
         // If Audio ISR fires during SD read, SPI bus gets corrupted = LOCKUP
         AudioNoInterrupts();
 
-        File dir = SD.open(currentPath_.c_str());
+        File dir = openDirectory(&SD, currentPath_.c_str());
 
         if (dir && dir.isDirectory()) {
             File entry;
@@ -541,7 +668,7 @@ private:
             return;
         }
 
-        File dir = usbFS->open(currentPath_.c_str());
+        File dir = openDirectory(usbFS, currentPath_.c_str());
         if (dir && dir.isDirectory()) {
             File entry;
             while (entry = dir.openNextFile()) {
@@ -555,6 +682,16 @@ private:
         }
     }
 
+    /**
+     * Open a directory, or a ZIP archive (or a folder inside one) as a directory
+     */
+    File openDirectory(FS* fs, const char* path) {
+        if (ZipArchive::isArchivePath(path)) {
+            return ZipArchive::open(fs, path);
+        }
+        return fs->open(path);
+    }
+
     void addErrorMessage(const char* message) {
         FileEntry errorItem;
         errorItem.name = message;
@@ -627,6 +764,18 @@ private:
 
         bool isDir = entry.isDirectory();
 
+        // ZIP archives browse like folders (not nested inside another archive)
+        if (!isDir && ZipArchive::isArchiveName(name.c_str()) &&
+            !ZipArchive::isArchivePath(currentPath_.c_str())) {
+            FileEntry fe;
+            fe.name = name;
+            fe.isDirectory = true;
+            fe.size = entry.size();
+            fe.type = "ZIP";
+            files_.push_back(fe);
+            return;
+        }
+
         // Check if it's a supported file
         if (isDir || isSupportedFile(name.c_str())) {
             FileEntry fe;
@@ -643,6 +792,7 @@ private:
         lower.toLowerCase();
         return lower.endsWith(".mid") || lower.endsWith(".midi") ||
                lower.endsWith(".smf") || lower.endsWith(".kar") ||
+               lower.endsWith(".rmi") || lower.endsWith(".xmi") ||
                lower.endsWith(".vgm") || lower.endsWith(".vgz") ||
                lower.endsWith(".fm9") ||
                lower.endsWith(".spc") ||
@@ -655,8 +805,11 @@ private:
         lower.toLowerCase();
 
         if (lower.endsWith(".mid") || lower.endsWith(".midi") ||
-            lower.endsWith(".smf") || lower.endsWith(".kar")) {
+            lower.endsWith(".smf") || lower.endsWith(".kar") ||
+            lower.endsWith(".rmi")) {
             return "MIDI";
+        } else if (lower.endsWith(".xmi")) {
+            return "XMI";
         } else if (lower.endsWith(".vgm") || lower.endsWith(".vgz")) {
             return "VGM";
         } else if (lower.endsWith(".fm9")) {
@@ -839,6 +992,58 @@ private:
         return ScreenResult::stay();
     }
 
+    ScreenResult exportStems(int itemIndex) {
+        if (itemIndex < 0 || itemIndex >= (int)files_.size()) {
+            return ScreenResult::stay();
+        }
+
+        const FileEntry& file = files_[itemIndex];
+        if (file.isDirectory || !StemRenderer::isSupported(file.name.c_str())) {
+            context_->ui->showStatusNotification("Stems: VGM (NES/GB) or SPC only", 3000, DOS_WHITE, DOS_RED);
+            return ScreenResult::stay();
+        }
+
+        // Renderer borrows the static APU instances - playback must be stopped
+        if (context_->playerManager &&
+            (context_->playerManager->isPlaying() || context_->playerManager->isPaused())) {
+            context_->ui->showStatusNotification("Stop playback first", 3000, DOS_WHITE, DOS_RED);
+            return ScreenResult::stay();
+        }
+
+        String fullPath;
+        if (currentPath_ == "/") {
+            fullPath = "/" + file.name;
+        } else {
+            fullPath = currentPath_ + "/" + file.name;
+        }
+
+        // Output folder: /STEMS/<name without extension>
+        String baseName = file.name;
+        int dot = baseName.lastIndexOf('.');
+        if (dot > 0) {
+            baseName = baseName.substring(0, dot);
+        }
+        String outDir = "/STEMS/" + baseName;
+
+        // Rendering is blocking (like floppy transfer) - the notification stays up meanwhile
+        context_->ui->showStatusNotification("Rendering stems...", 0, DOS_BLACK, DOS_YELLOW);
+        context_->fileSource->setSource(FileSource::SD_CARD);
+
+        StemRenderer renderer;
+        if (renderer.render(fullPath.c_str(), context_->fileSource, outDir.c_str())) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "%u stems -> %.40s", renderer.getStemCount(), outDir.c_str());
+            context_->ui->showStatusNotification(msg, 3000, DOS_BLACK, DOS_LIGHT_GRAY);
+        } else {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Stems failed: %.40s", renderer.getError());
+            context_->ui->showStatusNotification(msg, 3000, DOS_WHITE, DOS_RED);
+        }
+
+        requestRedraw();
+        return ScreenResult::stay();
+    }
+
     ScreenResult addFolderToQueue(int itemIndex) {
         if (itemIndex < 0 || itemIndex >= (int)files_.size()) {
             return ScreenResult::stay();
@@ -862,7 +1067,7 @@ private:
 
         // Scan folder and add all supported files
         int addedCount = 0;
-        File dir = SD.open(folderPath.c_str());
+        File dir = openDirectory(&SD, folderPath.c_str());
 
         if (dir && dir.isDirectory()) {
             File entry;
@@ -941,11 +1146,12 @@ ActionableListScreenBase::ItemAction FileBrowserScreenNew::sdFolderActions_[3] =
     {"Go back", "Return to parent"}
 };
 
-ActionableListScreenBase::ItemAction FileBrowserScreenNew::fileActions_[4] = {
+ActionableListScreenBase::ItemAction FileBrowserScreenNew::fileActions_[5] = {
     {"Play song", "Play this file"},
     {"Add to queue", "Queue for later"},
     {"Add to playlist", "Save to playlist"},
-    {"File info", "View file details"}
+    {"File info", "View file details"},
+    {"Export stems", "Per-channel WAVs"}
 };
 
 ActionableListScreenBase::ItemAction FileBrowserScreenNew::usbFileActions_[3] = {
@@ -1,5 +1,7 @@
 #include "modal_dialog.h"
 #include "../../dos_colors.h"
+#include "../lcd_manager.h"
+#include "../button_input.h"
 
 // Show modal dialog and wait for user input
 ModalDialog::Result ModalDialog::show(RetroUI* ui,
@@ -37,6 +39,12 @@ ModalDialog::Result ModalDialog::show(RetroUI* ui,
     int selectedButton = 0;  // Default to first button
     uint32_t lastButtonTime = 0;
 
+    // Button reads below use Wire directly - let the LCD queue finish first
+    extern LCDManager* g_lcdManager;
+    if (g_lcdManager) {
+        g_lcdManager->waitBusIdle();
+    }
+
     // Modal loop - block until user makes selection
     bool done = false;
     Result result = RESULT_NONE;
@@ -87,6 +95,12 @@ ModalDialog::Result ModalDialog::show(RetroUI* ui,
         delay(10);
     }
 
+    // The reads above cleared the button interrupt - resync the event queue's state
+    extern ButtonInput* g_buttonInput;
+    if (g_buttonInput) {
+        g_buttonInput->resync();
+    }
+
     // Restore the saved screen region (removes modal without full screen redraw)
     if (savedRegion && savedRegion->isValid()) {
         ui->restoreRegion(savedRegion);
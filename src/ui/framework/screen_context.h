@@ -18,6 +18,7 @@ class PlayerManager;
 class PlaybackCoordinator;
 class QueueManager;
 class StatusBarManager;
+class ButtonInput;
 
 /**
  * ScreenContext - Dependency injection container for all screen dependencies
@@ -46,6 +47,7 @@ struct ScreenContext {
     RetroUI* ui;                            // DOS-style character grid rendering
     Adafruit_RGBLCDShield* lcd;            // 16x2 LCD with buttons (raw access)
     LCDManager* lcdManager;                 // Smart LCD update manager (use this instead of lcd directly)
+    ButtonInput* buttonInput;               // Interrupt-driven button events (use this instead of lcd->readButtons())
 
     // ============================================
     // CORE MANAGERS (required)
@@ -102,6 +104,7 @@ struct ScreenContext {
         : ui(nullptr)
         , lcd(nullptr)
         , lcdManager(nullptr)
+        , buttonInput(nullptr)
         , eventManager(nullptr)
         , screenManager(nullptr)
         , opl3(nullptr)
@@ -128,6 +131,7 @@ struct ScreenContext {
         bool valid = ui != nullptr &&
                      lcd != nullptr &&
                      lcdManager != nullptr &&
+                     buttonInput != nullptr &&
                      eventManager != nullptr &&
                      screenManager != nullptr &&
                      opl3 != nullptr &&
@@ -143,6 +147,7 @@ struct ScreenContext {
             if (!ui) Serial.println("  - ui is nullptr");
             if (!lcd) Serial.println("  - lcd is nullptr");
             if (!lcdManager) Serial.println("  - lcdManager is nullptr");
+            if (!buttonInput) Serial.println("  - buttonInput is nullptr");
             if (!eventManager) Serial.println("  - eventManager is nullptr");
             if (!screenManager) Serial.println("  - screenManager is nullptr");
             if (!opl3) Serial.println("  - opl3 is nullptr");
@@ -70,6 +70,11 @@ Screen* ScreenFactory::createScreen(ScreenID screenID, ScreenContext* context, v
             screen = new VGMOptionsScreenNew(context);
             break;
 
+        case SCREEN_SETTINGS_SYSTEM:
+            logCreation(screenID, "SystemSettingsScreenNew");
+            screen = new SystemSettingsScreenNew(context);
+            break;
+
         case SCREEN_SETTINGS_BLUETOOTH:
             logCreation(screenID, "BluetoothSettingsScreenNew");
             screen = new BluetoothSettingsScreenNew(context);
@@ -193,7 +193,7 @@ protected:
 
     /**
      * Called when settings are saved (override for custom logic)
-     * e.g., Apply settings to hardware, save to EEPROM, etc.
+     * e.g., Apply settings to hardware, checkpoint the resume journal, etc.
      */
     virtual void onSave() {}
 
@@ -206,6 +206,8 @@ void AudioEventHandler::onAudioSettingsChanged(void* userData) {
     // // Serial.print("[AudioEventHandler] Crossfeed preference: ");
     // // Serial.println(g_crossfeedEnabled ? "ENABLED" : "DISABLED");
 
-    // // Serial.print("[AudioEventHandler] Reverb preference: ");
-    // // Serial.println(g_reverbEnabled ? "ENABLED" : "DISABLED");
+    // Apply reverb setting (immediately if MIDI is playing)
+    if (context_->playerManager) {
+        context_->playerManager->setReverbEnabled(g_reverbEnabled);
+    }
 }
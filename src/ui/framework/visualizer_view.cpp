@@ -0,0 +1,154 @@
+#include "visualizer_view.h"
+#include "../../dos_colors.h"
+#include <Arduino.h>
+
+VisualizerView::VisualizerView(RetroUI* ui, AudioAnalyzeVisualizer* analyzer,
+                               int col, int row, int width, int height)
+    : ui_(ui),
+      analyzer_(analyzer),
+      x_(col * 8),
+      y_(row * 16),
+      width_(width * 8),
+      height_(height * 16),
+      mode_(MODE_BARS),
+      active_(false),
+      paused_(false),
+      lastFrameMs_(0),
+      frameIntervalMs_(TARGET_FRAME_MS),
+      avgCostUs_(0) {
+    resetDrawnState();
+}
+
+void VisualizerView::setMode(Mode mode) {
+    mode_ = mode;
+    updateAnalyzerTap();
+}
+
+void VisualizerView::cycleMode() {
+    switch (mode_) {
+        case MODE_OFF:   setMode(MODE_BARS); break;
+        case MODE_BARS:  setMode(MODE_SCOPE); break;
+        case MODE_SCOPE: setMode(MODE_OFF); break;
+    }
+}
+
+void VisualizerView::setActive(bool active) {
+    active_ = active;
+    updateAnalyzerTap();
+}
+
+void VisualizerView::setPaused(bool paused) {
+    if (paused == paused_) return;
+    paused_ = paused;
+    updateAnalyzerTap();
+}
+
+void VisualizerView::updateAnalyzerTap() {
+    if (analyzer_) {
+        analyzer_->setEnabled(active_ && !paused_ && mode_ != MODE_OFF);
+    }
+}
+
+uint32_t VisualizerView::getLoadPermille() const {
+    return frameIntervalMs_ > 0 ? avgCostUs_ / frameIntervalMs_ : 0;
+}
+
+void VisualizerView::resetDrawnState() {
+    for (uint8_t b = 0; b < AudioAnalyzeVisualizer::BANDS; b++) {
+        barHeight_[b] = 0;
+    }
+    for (uint8_t i = 0; i < AudioAnalyzeVisualizer::SCOPE_POINTS; i++) {
+        scopeTop_[i] = 0;
+        scopeHeight_[i] = 0;
+    }
+}
+
+void VisualizerView::draw() {
+    if (!ui_ || mode_ == MODE_OFF) return;
+
+    RA8875_SPI1* tft = ui_->getTFT();
+    if (!tft) return;
+
+    tft->fillRect(x_, y_, width_, height_, DOS_BLACK);
+    resetDrawnState();
+    lastFrameMs_ = 0;  // Draw the first frame on the next update()
+}
+
+void VisualizerView::update() {
+    if (!ui_ || !analyzer_ || !active_ || paused_ || mode_ == MODE_OFF) return;
+
+    uint32_t now = millis();
+    if (now - lastFrameMs_ < frameIntervalMs_) return;
+    lastFrameMs_ = now;
+
+    uint32_t start = micros();
+
+    if (!analyzer_->analyze()) return;
+    if (mode_ == MODE_BARS) {
+        drawBars();
+    } else {
+        drawScope();
+    }
+
+    // Running average cost (1/8 weight) -> shortest interval that stays within budget
+    uint32_t cost = micros() - start;
+    avgCostUs_ = avgCostUs_ + ((int32_t)cost - (int32_t)avgCostUs_) / 8;
+
+    uint32_t interval = avgCostUs_ / BUDGET_PERMILLE;  // us / (permille / 1000) -> ms
+    if (interval < TARGET_FRAME_MS) interval = TARGET_FRAME_MS;
+    if (interval > MAX_FRAME_MS) interval = MAX_FRAME_MS;
+    frameIntervalMs_ = interval;
+}
+
+void VisualizerView::drawBars() {
+    RA8875_SPI1* tft = ui_->getTFT();
+    const uint8_t* levels = analyzer_->getBandLevels();
+
+    int16_t slot = width_ / AudioAnalyzeVisualizer::BANDS;
+    int16_t barW = slot - 2;
+    int16_t bottom = y_ + height_;
+
+    for (uint8_t b = 0; b < AudioAnalyzeVisualizer::BANDS; b++) {
+        int16_t h = (int16_t)((int32_t)levels[b] * height_ / AudioAnalyzeVisualizer::LEVEL_MAX);
+        int16_t old = barHeight_[b];
+        if (h == old) continue;
+
+        int16_t x = x_ + b * slot + 1;
+        if (h > old) {
+            tft->fillRect(x, bottom - h, barW, h - old, DOS_BRIGHT_GREEN);
+        } else {
+            tft->fillRect(x, bottom - old, barW, old - h, DOS_BLACK);
+        }
+        barHeight_[b] = h;
+    }
+}
+
+void VisualizerView::drawScope() {
+    RA8875_SPI1* tft = ui_->getTFT();
+    const int8_t* scope = analyzer_->getScope();
+
+    int16_t mid = y_ + height_ / 2;
+    int16_t halfH = height_ / 2 - 1;
+    uint8_t points = width_ / SCOPE_STEP;
+    if (points > AudioAnalyzeVisualizer::SCOPE_POINTS) points = AudioAnalyzeVisualizer::SCOPE_POINTS;
+
+    int16_t prevY = mid - (int16_t)((int32_t)scope[0] * halfH / 128);
+    for (uint8_t i = 0; i < points; i++) {
+        int16_t y = mid - (int16_t)((int32_t)scope[i] * halfH / 128);
+
+        // Each column is a vertical segment joining the previous point to this one
+        int16_t top = y < prevY ? y : prevY;
+        int16_t h = (y < prevY ? prevY - y : y - prevY) + 1;
+        prevY = y;
+
+        if (top == scopeTop_[i] && h == scopeHeight_[i]) continue;
+
+        int16_t x = x_ + i * SCOPE_STEP;
+        if (scopeHeight_[i] > 0) {
+            tft->fillRect(x, scopeTop_[i], SCOPE_STEP, scopeHeight_[i], DOS_BLACK);
+        }
+        tft->fillRect(x, top, SCOPE_STEP, h, DOS_BRIGHT_CYAN);
+        scopeTop_[i] = top;
+        scopeHeight_[i] = h;
+    }
+}
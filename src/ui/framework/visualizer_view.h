@@ -0,0 +1,108 @@
+#ifndef VISUALIZER_VIEW_H
+#define VISUALIZER_VIEW_H
+
+#include "../../retro_ui.h"
+#include "../../audio_analyze_visualizer.h"
+
+/**
+ * VisualizerView - Spectrum bars or scope trace drawn from AudioAnalyzeVisualizer
+ *
+ * Modes:
+ * - OFF: nothing drawn, the analyzer's ISR tap is disabled
+ * - BARS: 16 log-spaced spectrum bars
+ * - SCOPE: triggered waveform trace
+ *
+ * Drawing is incremental: each bar only fills or clears the strip between its
+ * old and new height, and each scope column is only redrawn when it moved, so
+ * a frame is a handful of RA8875 fillRect commands.
+ *
+ * CPU cap: update() times each frame (analysis + drawing) and stretches the
+ * frame interval so the running average stays under BUDGET_PERMILLE of the
+ * main loop. The frame rate drops before playback timing can suffer. When
+ * the load shedder needs more than that, setPaused() stops it entirely.
+ *
+ * Example:
+ *   VisualizerView viz(ui, &analyzer, 66, 3, 30, 4);
+ *   viz.setMode(VisualizerView::MODE_BARS);
+ *   viz.draw();
+ *   viz.update();  // every screen update
+ */
+class VisualizerView {
+public:
+    enum Mode {
+        MODE_OFF,
+        MODE_BARS,
+        MODE_SCOPE
+    };
+
+    static const uint32_t TARGET_FRAME_MS = 40;      // 25 fps when within budget
+    static const uint32_t MAX_FRAME_MS = 250;
+    static const uint32_t BUDGET_PERMILLE = 30;      // 3% of main-loop time
+
+    /**
+     * Create a visualizer view
+     * @param ui - RetroUI instance
+     * @param analyzer - Analyzer tapping the final mix
+     * @param col, row, width, height - Area in grid coordinates
+     */
+    VisualizerView(RetroUI* ui, AudioAnalyzeVisualizer* analyzer, int col, int row, int width, int height);
+
+    void setMode(Mode mode);
+    Mode getMode() const { return mode_; }
+    bool isVisible() const { return mode_ != MODE_OFF; }
+
+    // Advance OFF -> BARS -> SCOPE -> OFF
+    void cycleMode();
+
+    /**
+     * Enable/disable the analyzer tap (disable while the screen is not shown)
+     */
+    void setActive(bool active);
+
+    /**
+     * Freeze on the last frame and stop the analyzer tap (load shedding).
+     * Drawing is incremental, so unpausing carries on from the frozen frame.
+     */
+    void setPaused(bool paused);
+    bool isPaused() const { return paused_; }
+
+    // Clear the area and draw the current state from scratch
+    void draw();
+
+    // Draw a new frame if one is due (call every screen update)
+    void update();
+
+    // Measured cost of the view as a share of main-loop time (per mille)
+    uint32_t getLoadPermille() const;
+    uint32_t getFrameIntervalMs() const { return frameIntervalMs_; }
+
+private:
+    static const uint8_t SCOPE_STEP = 4;             // Pixels per scope point
+
+    RetroUI* ui_;
+    AudioAnalyzeVisualizer* analyzer_;
+    int16_t x_;
+    int16_t y_;
+    int16_t width_;
+    int16_t height_;
+    Mode mode_;
+    bool active_;
+    bool paused_;
+
+    // Last drawn state (for incremental drawing)
+    int16_t barHeight_[AudioAnalyzeVisualizer::BANDS];
+    int16_t scopeTop_[AudioAnalyzeVisualizer::SCOPE_POINTS];
+    int16_t scopeHeight_[AudioAnalyzeVisualizer::SCOPE_POINTS];
+
+    // Frame pacing / CPU cap
+    uint32_t lastFrameMs_;
+    uint32_t frameIntervalMs_;
+    uint32_t avgCostUs_;
+
+    void resetDrawnState();
+    void updateAnalyzerTap();
+    void drawBars();
+    void drawScope();
+};
+
+#endif // VISUALIZER_VIEW_H
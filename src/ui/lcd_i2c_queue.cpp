@@ -0,0 +1,206 @@
+#include "lcd_i2c_queue.h"
+#include <Wire.h>
+
+LCDI2CQueue* LCDI2CQueue::instance_ = nullptr;
+
+LCDI2CQueue::LCDI2CQueue()
+    : head_(0)
+    , tail_(0)
+    , gpioBase_(0)
+    , lastGpio_(0)
+    , ready_(false)
+    , error_(false) {
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+bool LCDI2CQueue::begin() {
+    if (!syncPortState()) {
+        return false;
+    }
+
+    head_ = tail_ = 0;
+    error_ = false;
+    instance_ = this;
+
+    // Below the audio library's software interrupt - LCD writes can always wait
+    LPI2C1_MIER = 0;
+    attachInterruptVector(IRQ_LPI2C1, isr);
+    NVIC_SET_PRIORITY(IRQ_LPI2C1, 224);
+    NVIC_ENABLE_IRQ(IRQ_LPI2C1);
+
+    ready_ = true;
+    return true;
+}
+
+bool LCDI2CQueue::syncPortState() {
+    // Read the output latch so the blue backlight bit survives our port writes
+    Wire.beginTransmission(MCP23017_ADDRESS);
+    Wire.write(REG_OLATB);
+    if (Wire.endTransmission() != 0) {
+        Serial.println("[LCDI2CQueue] ERROR: MCP23017 not responding");
+        return false;
+    }
+    if (Wire.requestFrom(MCP23017_ADDRESS, (uint8_t)1) != 1) {
+        Serial.println("[LCDI2CQueue] ERROR: Failed to read OLATB");
+        return false;
+    }
+    uint8_t olatb = Wire.read();
+    gpioBase_ = olatb & PIN_BACKLIGHT;
+    lastGpio_ = olatb;
+    return true;
+}
+
+// ============================================
+// ENCODING (main loop)
+// ============================================
+
+uint8_t LCDI2CQueue::nibbleBits(uint8_t nibble) {
+    // D4..D7 are wired to GPB4..GPB1 (reversed)
+    uint8_t bits = 0;
+    if (nibble & 0x01) bits |= 0x10;
+    if (nibble & 0x02) bits |= 0x08;
+    if (nibble & 0x04) bits |= 0x04;
+    if (nibble & 0x08) bits |= 0x02;
+    return bits;
+}
+
+void LCDI2CQueue::push(uint16_t word) {
+    ring_[head_ & (RING_SIZE - 1)] = word;
+    head_ = head_ + 1;
+}
+
+void LCDI2CQueue::queueGpio(uint8_t gpio) {
+    push(CMD_START | (MCP23017_ADDRESS << 1));
+    push(CMD_TRANSMIT | REG_GPIOB);
+    push(CMD_TRANSMIT | gpio);
+    lastGpio_ = gpio;
+}
+
+void LCDI2CQueue::queueNibble(uint8_t nibble, bool rs) {
+    // Data and EN rise together, the HD44780 latches on the falling edge one write later
+    uint8_t gpio = gpioBase_ | (rs ? PIN_RS : 0) | nibbleBits(nibble);
+    queueGpio(gpio | PIN_EN);
+    queueGpio(gpio);
+}
+
+bool LCDI2CQueue::queueByte(uint8_t value, bool rs) {
+    if (!ready_ || bytesFree() == 0) {
+        return false;
+    }
+
+    // RS must be stable before EN rises - only costs a write when RS changes
+    if ((lastGpio_ & PIN_RS) != (rs ? PIN_RS : 0)) {
+        queueGpio(gpioBase_ | (rs ? PIN_RS : 0) | nibbleBits(value >> 4));
+    }
+    queueNibble(value >> 4, rs);
+    queueNibble(value & 0x0F, rs);
+    push(CMD_STOP);
+
+    stats_.bytesQueued++;
+    uint16_t depth = head_ - tail_;
+    if (depth > stats_.maxDepth) {
+        stats_.maxDepth = depth;
+    }
+
+    kick();
+    return true;
+}
+
+bool LCDI2CQueue::resync() {
+    if (!ready_) return false;
+
+    // All or nothing: a partial sequence would leave the nibble phase unknown
+    if (wordsFree() < RESYNC_WORDS) {
+        return false;
+    }
+
+    // 0x3,0x3,0x3,0x2 brings the controller back to 4-bit mode from either nibble phase
+    static const uint8_t syncNibbles[SYNC_NIBBLES] = {0x3, 0x3, 0x3, 0x2};
+    queueGpio(gpioBase_);  // RS and EN low first
+    for (uint8_t i = 0; i < SYNC_NIBBLES; i++) {
+        queueNibble(syncNibbles[i], false);
+        push(CMD_STOP);
+    }
+    kick();
+
+    writeCommand(0x28);  // Function set: 4-bit, 2 lines, 5x8
+    writeCommand(0x0C);  // Display on, cursor off, blink off
+    writeCommand(0x06);  // Entry mode: increment, no shift
+    return true;
+}
+
+uint16_t LCDI2CQueue::bytesFree() const {
+    return wordsFree() / WORDS_PER_BYTE;
+}
+
+void LCDI2CQueue::kick() {
+    // TDF is set whenever the FIFO is below watermark, so this fires immediately
+    LPI2C1_MIER |= LPI2C_MIER_TDIE | LPI2C_MIER_NDIE | LPI2C_MIER_ALIE | LPI2C_MIER_FEIE;
+}
+
+bool LCDI2CQueue::isIdle() {
+    if (!ready_) return true;
+    if (tail_ != head_) return false;
+    if ((LPI2C1_MFSR & 0x07) != 0 || (LPI2C1_MSR & LPI2C_MSR_MBF)) return false;
+
+    // Last STOP is out - hand the bus back to Wire without our error interrupts
+    LPI2C1_MIER = 0;
+    return true;
+}
+
+bool LCDI2CQueue::waitIdle(uint32_t timeoutUs) {
+    uint32_t start = micros();
+    while (!isIdle()) {
+        if (micros() - start > timeoutUs) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LCDI2CQueue::takeError() {
+    if (!error_) return false;
+    error_ = false;
+    return true;
+}
+
+// ============================================
+// LPI2C1 INTERRUPT
+// ============================================
+
+void LCDI2CQueue::isr() {
+    LCDI2CQueue* q = instance_;
+    if (!q) {
+        LPI2C1_MIER = 0;
+        return;
+    }
+
+    uint32_t msr = LPI2C1_MSR;
+    if (msr & (LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF)) {
+        // Drop everything queued - the master sends STOP itself on NAK
+        LPI2C1_MCR |= LPI2C_MCR_RTF;
+        LPI2C1_MSR = LPI2C_MSR_NDF | LPI2C_MSR_ALF | LPI2C_MSR_FEF;
+        q->tail_ = q->head_;
+        q->error_ = true;
+        q->stats_.errors++;
+        LPI2C1_MIER = 0;
+        asm("dsb");
+        return;
+    }
+
+    // Top up the TX FIFO
+    uint16_t tail = q->tail_;
+    uint16_t head = q->head_;
+    while (tail != head && (LPI2C1_MFSR & 0x07) < TX_FIFO_SIZE) {
+        LPI2C1_MTDR = q->ring_[tail & (RING_SIZE - 1)];
+        tail++;
+        q->stats_.wordsSent++;
+    }
+    q->tail_ = tail;
+
+    // Ring drained: stop TDF interrupts, error interrupts stay on until isIdle()
+    if (tail == head) {
+        LPI2C1_MIER &= ~LPI2C_MIER_TDIE;
+    }
+    asm("dsb");
+}
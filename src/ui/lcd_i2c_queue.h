@@ -0,0 +1,136 @@
+#ifndef LCD_I2C_QUEUE_H
+#define LCD_I2C_QUEUE_H
+
+#include <Arduino.h>
+
+/**
+ * LCDI2CQueue - Interrupt-driven I2C transmit queue for the RGB LCD shield
+ *
+ * The shield's HD44780 sits behind an MCP23017 port expander (GPIOB):
+ *   GPB7 = RS, GPB6 = RW, GPB5 = EN, GPB4..GPB1 = D4..D7, GPB0 = blue backlight
+ *
+ * The Adafruit library drives it with one blocking Wire read-modify-write per
+ * pin. This queue instead encodes each LCD byte as a handful of whole-port
+ * GPIOB writes (LPI2C command words) and lets the LPI2C1 interrupt feed them
+ * into the 4-word TX FIFO. Callers only enqueue; a full 2x16 refresh drains in
+ * the background in ~10ms at 400kHz.
+ *
+ * Bus sharing:
+ *   Wire (button reads, lcd->clear()) uses the same LPI2C1 master with blocking
+ *   code. Never call Wire while isIdle() is false - use waitIdle() first.
+ *
+ * Errors:
+ *   A NAK/arbitration loss drops the rest of the queue, which can leave the
+ *   HD44780 between nibbles. takeError() reports it so the owner can resync().
+ */
+class LCDI2CQueue {
+public:
+    static const uint8_t MCP23017_ADDRESS = 0x20;
+
+    struct Stats {
+        uint32_t bytesQueued;    // LCD bytes (commands + characters) enqueued
+        uint32_t wordsSent;      // LPI2C command words pushed by the ISR
+        uint32_t errors;         // NAK / arbitration loss / FIFO errors
+        uint16_t maxDepth;       // Highest ring occupancy (words)
+    };
+
+    LCDI2CQueue();
+
+    /**
+     * Take over LCD writes (call after lcd->begin() and Wire.setClock())
+     * Reads the backlight bit from OLATB once with blocking Wire.
+     * @return false if the port expander does not answer
+     */
+    bool begin();
+
+    /**
+     * Re-read GPIOB's output latch after blocking Wire access to the LCD
+     * (lcd->clear(), setBacklight()). Call only while isIdle().
+     * @return false if the port expander does not answer
+     */
+    bool syncPortState();
+
+    /**
+     * Queue an HD44780 instruction (RS=0) or character (RS=1)
+     * @return false if the ring is full (nothing queued)
+     */
+    bool writeCommand(uint8_t cmd) { return queueByte(cmd, false); }
+    bool writeData(uint8_t ch) { return queueByte(ch, true); }
+    bool setCursor(uint8_t col, uint8_t row) { return writeCommand(0x80 | (row ? 0x40 : 0x00) | (col & 0x3F)); }
+
+    /**
+     * Queue the 4-bit re-sync sequence and display setup (after an error)
+     * @return false if the ring can't hold all of it (nothing queued - retry
+     *         once it drains)
+     */
+    bool resync();
+
+    /**
+     * How many more LCD bytes fit in the ring right now
+     */
+    uint16_t bytesFree() const;
+
+    /**
+     * True when the ring, TX FIFO and bus are all empty (Wire may be used)
+     */
+    bool isIdle();
+
+    /**
+     * Spin until idle (bounded)
+     * @return false on timeout
+     */
+    bool waitIdle(uint32_t timeoutUs = 20000);
+
+    /**
+     * Return and clear the error flag set by the ISR
+     */
+    bool takeError();
+
+    bool isReady() const { return ready_; }
+    const Stats& getStats() const { return stats_; }
+
+private:
+    static const uint16_t RING_SIZE = 1024;          // Power of 2 (words)
+    static const uint8_t WORDS_PER_BYTE = 16;        // Worst case: 5 GPIO writes x 3 + STOP
+    static const uint8_t TX_FIFO_SIZE = 4;           // LPI2C1 master TX FIFO depth
+    static const uint8_t SYNC_NIBBLES = 4;
+    static const uint8_t SETUP_BYTES = 3;            // Function set, display on, entry mode
+    // RS/EN low, then each nibble (2 GPIO writes + STOP), then the setup bytes
+    static const uint16_t RESYNC_WORDS = 3 + SYNC_NIBBLES * 7 + SETUP_BYTES * WORDS_PER_BYTE;
+
+    // LPI2C MTDR command field (bits 10:8)
+    static const uint16_t CMD_TRANSMIT = 0x0000;
+    static const uint16_t CMD_STOP = 0x0200;
+    static const uint16_t CMD_START = 0x0400;
+
+    // MCP23017 register (IOCON.BANK = 0)
+    static const uint8_t REG_GPIOB = 0x13;
+    static const uint8_t REG_OLATB = 0x15;
+
+    // GPIOB bit assignments
+    static const uint8_t PIN_RS = 0x80;
+    static const uint8_t PIN_EN = 0x20;
+    static const uint8_t PIN_BACKLIGHT = 0x01;
+
+    bool queueByte(uint8_t value, bool rs);
+    uint16_t wordsFree() const { return RING_SIZE - (uint16_t)(head_ - tail_); }
+    void queueNibble(uint8_t nibble, bool rs);
+    void queueGpio(uint8_t gpio);
+    void push(uint16_t word);
+    void kick();
+    static uint8_t nibbleBits(uint8_t nibble);
+
+    static void isr();
+    static LCDI2CQueue* instance_;
+
+    uint16_t ring_[RING_SIZE];
+    volatile uint16_t head_;     // Written by loop
+    volatile uint16_t tail_;     // Written by ISR
+    uint8_t gpioBase_;           // Backlight bit to preserve on every GPIOB write
+    uint8_t lastGpio_;           // Last GPIOB value queued
+    bool ready_;
+    volatile bool error_;
+    Stats stats_;
+};
+
+#endif // LCD_I2C_QUEUE_H
@@ -3,23 +3,22 @@
 
 #include <Arduino.h>
 #include <Adafruit_RGBLCDShield.h>
+#include "lcd_i2c_queue.h"
 
 /**
- * LCDManager - Time-sliced LCD update manager with ZERO blocking
+ * LCDManager - Shadow-buffered LCD updates over a background I2C queue
  *
- * Purpose: Eliminate I2C blocking during audio playback by:
- * - Time-slicing: Sends ONE character per update() call
- * - Spacing: Configurable delay between characters (default 1ms)
- * - Dirty checking: Only updates if content changed
- * - Smart clearing: Overwrites with spaces instead of lcd->clear()
+ * Purpose: Keep LCD I2C traffic off the main loop's critical path:
+ * - Shadow buffer: 2x16 cells of what the LCD will show once the queue drains
+ * - Cell diffing: Only changed cells are sent (cursor moves skipped for runs)
+ * - Background transmit: LCDI2CQueue encodes bytes as MCP23017 port writes and
+ *   the LPI2C1 interrupt feeds them to the bus - update() never waits on I2C
  *
- * How Time-Slicing Works:
- * Instead of sending all I2C data in one blocking call:
- *   OLD: setCursor + print(16 chars) = 8ms blocking @ 100kHz
- *   NEW: Each update() sends 1 char (~0.5ms @ 400kHz), waits 3ms, repeat
- *        Spreads across ~100ms total, ~0.5ms blocking per iteration
+ * A full two-line refresh is ~34 LCD bytes and drains in ~10ms at 400kHz while
+ * the loop keeps running, instead of being spread over ~100ms of loop passes.
  *
- * Audio ISR runs every 2.9ms, so 3ms spacing guarantees it can always run!
+ * Bus sharing: button reads (Wire) must not overlap the queue - check
+ * isBusBusy() / call waitBusIdle() before touching lcd-> directly.
  *
  * Usage:
  *   LCDManager lcdMgr(lcd);
@@ -28,60 +27,58 @@
  *   lcdMgr.setLine(0, "Now Playing");
  *   lcdMgr.setLineF(1, "Track %d/%d", current, total);
  *
- *   // Call from main loop - sends ONE char per call (with spacing)
+ *   // Call from main loop - enqueues changed cells, returns immediately
  *   lcdMgr.update();
  */
 class LCDManager {
 private:
     Adafruit_RGBLCDShield* lcd_;
+    LCDI2CQueue i2c_;
 
     // Content tracking (dirty checking)
-    char line0_[17];          // Current content on LCD line 0
-    char line1_[17];          // Current content on LCD line 1
-    char pendingLine0_[17];   // Pending content for line 0
-    char pendingLine1_[17];   // Pending content for line 1
-
-    // Time-slicing state machine
-    enum UpdateState {
-        IDLE,                   // No update in progress
-        SET_CURSOR_LINE0,       // Send setCursor(0, 0)
-        PRINT_LINE0_CHAR,       // Send one character of line 0
-        SET_CURSOR_LINE1,       // Send setCursor(0, 1)
-        PRINT_LINE1_CHAR,       // Send one character of line 1
-        COMPLETE                // Update finished
-    };
-
-    UpdateState state_;
-    int charIndex_;             // Current character being sent (0-15)
-    bool line0NeedsUpdate_;     // Does line 0 need updating?
-    bool line1NeedsUpdate_;     // Does line 1 need updating?
-
-    // Spacing between characters to give audio ISR time
-    uint32_t lastCharSendTime_;
-    static const uint32_t MIN_CHAR_INTERVAL_MS = 3;  // 3ms between chars (audio ISR is every 2.9ms)
+    char shadow_[2][17];      // What the LCD shows once queued writes complete
+    char pending_[2][17];     // Requested content
+
+    // HD44780 address counter after the last queued byte (-1 = unknown)
+    int8_t cursorRow_;
+    int8_t cursorCol_;
+
+    uint32_t cellsSent_;      // Stats: characters sent
+    uint32_t resyncs_;        // Stats: recoveries after I2C errors
+    bool resyncPending_;      // Error seen, re-sync not queued yet (ring full)
+
+    void invalidateShadow() {
+        // 0xFF never matches text, so every cell is resent
+        memset(shadow_[0], 0xFF, 16);
+        memset(shadow_[1], 0xFF, 16);
+        cursorRow_ = -1;
+        cursorCol_ = -1;
+    }
 
 public:
     /**
      * Constructor
-     * @param lcd - Pointer to Adafruit_RGBLCDShield instance
+     * @param lcd - Pointer to Adafruit_RGBLCDShield instance (already begun)
      */
     LCDManager(Adafruit_RGBLCDShield* lcd)
         : lcd_(lcd)
-        , state_(IDLE)
-        , charIndex_(0)
-        , line0NeedsUpdate_(false)
-        , line1NeedsUpdate_(false)
-        , lastCharSendTime_(0)
+        , cursorRow_(-1)
+        , cursorCol_(-1)
+        , cellsSent_(0)
+        , resyncs_(0)
+        , resyncPending_(false)
     {
         // Initialize with spaces
-        memset(line0_, ' ', 16);
-        line0_[16] = '\0';
-        memset(line1_, ' ', 16);
-        line1_[16] = '\0';
-        memset(pendingLine0_, ' ', 16);
-        pendingLine0_[16] = '\0';
-        memset(pendingLine1_, ' ', 16);
-        pendingLine1_[16] = '\0';
+        for (uint8_t row = 0; row < 2; row++) {
+            memset(shadow_[row], ' ', 16);
+            shadow_[row][16] = '\0';
+            memset(pending_[row], ' ', 16);
+            pending_[row][16] = '\0';
+        }
+
+        // LCD content at startup is unknown (splash text) - resend everything
+        invalidateShadow();
+        i2c_.begin();
     }
 
     /**
@@ -92,7 +89,7 @@ public:
     void setLine(uint8_t line, const char* text) {
         if (line > 1 || !text) return;
 
-        char* target = (line == 0) ? pendingLine0_ : pendingLine1_;
+        char* target = pending_[line];
 
         // Copy up to 16 characters
         size_t len = strlen(text);
@@ -106,12 +103,7 @@ public:
         }
         target[16] = '\0';
 
-        // Mark as needing update (will be picked up by next update() call)
-        if (line == 0) {
-            line0NeedsUpdate_ = true;
-        } else {
-            line1NeedsUpdate_ = true;
-        }
+        // Picked up by the next update() call's diff
     }
 
     /**
@@ -146,154 +138,90 @@ public:
     }
 
     /**
-     * Update the LCD - TIME-SLICED with SPACING!
-     * Call this from your main loop. It sends ONE character per call,
-     * with minimum spacing between sends.
-     *
-     * State machine:
-     * 1. IDLE: Check if update needed, start if content changed
-     * 2. SET_CURSOR_LINE0: Send setCursor(0, 0) if line 0 changed
-     * 3. PRINT_LINE0_CHAR: Send 1 char of line 0 (repeats 16 times, 3ms apart)
-     * 4. SET_CURSOR_LINE1: Send setCursor(0, 1) if line 1 changed
-     * 5. PRINT_LINE1_CHAR: Send 1 char of line 1 (repeats 16 times, 3ms apart)
-     * 6. COMPLETE: Finish update, return to IDLE
+     * Update the LCD - call from the main loop
+     * Diffs pending content against the shadow and enqueues changed cells.
+     * Never blocks: if the queue is full the rest is picked up next call.
      *
-     * @return true if actively updating (not idle)
+     * @return true while changes are outstanding or the queue is draining
      */
     bool update() {
-        switch (state_) {
-            case IDLE: {
-                // Check if content actually changed (dirty checking)
-                bool line0Changed = (memcmp(line0_, pendingLine0_, 16) != 0);
-                bool line1Changed = (memcmp(line1_, pendingLine1_, 16) != 0);
-
-                if (!line0Changed && !line1Changed) {
-                    line0NeedsUpdate_ = false;
-                    line1NeedsUpdate_ = false;
-                    return false;  // Nothing to update
-                }
-
-                // Start update
-                if (line0Changed) {
-                    line0NeedsUpdate_ = true;
-                    state_ = SET_CURSOR_LINE0;
-                    charIndex_ = 0;
-                } else if (line1Changed) {
-                    line1NeedsUpdate_ = true;
-                    state_ = SET_CURSOR_LINE1;
-                    charIndex_ = 0;
-                } else {
-                    line0NeedsUpdate_ = false;
-                    line1NeedsUpdate_ = false;
-                }
-                return true;
-            }
+        if (!i2c_.isReady()) return false;
 
-            case SET_CURSOR_LINE0: {
-                // Check spacing (setCursor doesn't need spacing, but keep consistent)
-                uint32_t now = millis();
-                if (now - lastCharSendTime_ < MIN_CHAR_INTERVAL_MS) {
-                    return true;  // Not ready yet, try again next loop
-                }
-
-                // Send setCursor command (~0.5ms blocking @ 400kHz)
-                lcd_->setCursor(0, 0);
-                lastCharSendTime_ = now;
-                state_ = PRINT_LINE0_CHAR;
-                charIndex_ = 0;
+        // A dropped transfer may have split a byte - re-sync and repaint.
+        // Cells queued before the re-sync would be garbled, so wait for room.
+        if (i2c_.takeError()) {
+            resyncPending_ = true;
+        }
+        if (resyncPending_) {
+            if (!i2c_.resync()) {
                 return true;
             }
+            resyncPending_ = false;
+            resyncs_++;
+            invalidateShadow();
+        }
 
-            case PRINT_LINE0_CHAR: {
-                // Check spacing - ensure 3ms between characters
-                uint32_t now = millis();
-                if (now - lastCharSendTime_ < MIN_CHAR_INTERVAL_MS) {
-                    return true;  // Not ready yet, try again next loop
-                }
-
-                // Send ONE character (~0.5ms blocking @ 400kHz)
-                lcd_->write(pendingLine0_[charIndex_]);
-                lastCharSendTime_ = now;
-
-                charIndex_++;
-                if (charIndex_ >= 16) {
-                    // Line 0 complete - copy to current buffer
-                    memcpy(line0_, pendingLine0_, 16);
-                    line0NeedsUpdate_ = false;
-
-                    // Move to line 1 if needed
-                    if (line1NeedsUpdate_) {
-                        state_ = SET_CURSOR_LINE1;
-                        charIndex_ = 0;
-                    } else {
-                        state_ = COMPLETE;
-                    }
+        bool remaining = false;
+        for (uint8_t row = 0; row < 2 && !remaining; row++) {
+            for (uint8_t col = 0; col < 16; col++) {
+                char c = pending_[row][col];
+                if (shadow_[row][col] == c) continue;
+
+                // Cursor move + char must both fit, or wait for the ISR to drain
+                bool needsCursor = (cursorRow_ != row || cursorCol_ != col);
+                if (i2c_.bytesFree() < (needsCursor ? 2 : 1)) {
+                    remaining = true;
+                    break;
                 }
-                return true;
-            }
 
-            case SET_CURSOR_LINE1: {
-                // Check spacing
-                uint32_t now = millis();
-                if (now - lastCharSendTime_ < MIN_CHAR_INTERVAL_MS) {
-                    return true;  // Not ready yet, try again next loop
+                if (needsCursor) {
+                    i2c_.setCursor(col, row);
                 }
+                i2c_.writeData((uint8_t)c);
+                shadow_[row][col] = c;
+                cellsSent_++;
 
-                // Send setCursor command (~0.5ms blocking @ 400kHz)
-                lcd_->setCursor(0, 1);
-                lastCharSendTime_ = now;
-                state_ = PRINT_LINE1_CHAR;
-                charIndex_ = 0;
-                return true;
+                // DDRAM address auto-increments (row 0 runs into 0x10, not row 1)
+                cursorRow_ = row;
+                cursorCol_ = col + 1;
             }
+        }
 
-            case PRINT_LINE1_CHAR: {
-                // Check spacing - ensure 3ms between characters
-                uint32_t now = millis();
-                if (now - lastCharSendTime_ < MIN_CHAR_INTERVAL_MS) {
-                    return true;  // Not ready yet, try again next loop
-                }
-
-                // Send ONE character (~0.5ms blocking @ 400kHz)
-                lcd_->write(pendingLine1_[charIndex_]);
-                lastCharSendTime_ = now;
-
-                charIndex_++;
-                if (charIndex_ >= 16) {
-                    // Line 1 complete - copy to current buffer
-                    memcpy(line1_, pendingLine1_, 16);
-                    line1NeedsUpdate_ = false;
-                    state_ = COMPLETE;
-                }
-                return true;
-            }
+        return remaining || !i2c_.isIdle();
+    }
 
-            case COMPLETE: {
-                // Update finished, return to idle
-                state_ = IDLE;
-                return false;
-            }
+    /**
+     * Check if update is in progress
+     */
+    bool isUpdating() {
+        return resyncPending_ ||
+               memcmp(shadow_[0], pending_[0], 16) != 0 ||
+               memcmp(shadow_[1], pending_[1], 16) != 0 ||
+               !i2c_.isIdle();
+    }
 
-            default:
-                state_ = IDLE;
-                return false;
-        }
+    /**
+     * True while the background queue owns the I2C bus (don't use Wire)
+     */
+    bool isBusBusy() {
+        return !i2c_.isIdle();
     }
 
     /**
-     * Check if update is in progress
+     * Wait for the background queue to release the bus (bounded)
+     * @return false on timeout
      */
-    bool isUpdating() const {
-        return state_ != IDLE;
+    bool waitBusIdle(uint32_t timeoutUs = 20000) {
+        return i2c_.waitIdle(timeoutUs);
     }
 
     /**
-     * Get current content of a line (what's actually on the LCD)
+     * Get current content of a line (what the LCD shows once queued writes finish)
      * @param line - Line number (0 or 1)
      * @return Pointer to line content (null-terminated, 16 chars + null)
      */
     const char* getCurrentLine(uint8_t line) const {
-        return (line == 0) ? line0_ : line1_;
+        return shadow_[line > 1 ? 1 : line];
     }
 
     /**
@@ -301,8 +229,10 @@ public:
      * WARNING: This will block! Only use for screen transitions.
      */
     void finishUpdate() {
+        uint32_t start = millis();
         while (update()) {
-            // Keep calling update() until complete
+            // Keep queueing until the diff is empty and the bus is idle
+            if (millis() - start > 100) break;
         }
     }
 
@@ -311,36 +241,31 @@ public:
      * Use only for screen transitions
      */
     void reset() {
+        // lcd->clear() goes through Wire - the queue must be drained first
+        i2c_.waitIdle();
         lcd_->clear();
+        i2c_.syncPortState();
 
-        memset(line0_, ' ', 16);
-        line0_[16] = '\0';
-        memset(line1_, ' ', 16);
-        line1_[16] = '\0';
-        memset(pendingLine0_, ' ', 16);
-        pendingLine0_[16] = '\0';
-        memset(pendingLine1_, ' ', 16);
-        pendingLine1_[16] = '\0';
-
-        state_ = IDLE;
-        charIndex_ = 0;
-        line0NeedsUpdate_ = false;
-        line1NeedsUpdate_ = false;
-        lastCharSendTime_ = 0;
+        for (uint8_t row = 0; row < 2; row++) {
+            memset(shadow_[row], ' ', 16);
+            memset(pending_[row], ' ', 16);
+        }
+        cursorRow_ = 0;
+        cursorCol_ = 0;
     }
 
     /**
      * Get debug stats
      */
-    void printStats() const {
+    void printStats() {
+        const LCDI2CQueue::Stats& q = i2c_.getStats();
         Serial.println("=== LCDManager Stats ===");
-        Serial.printf("State: %d\n", state_);
-        Serial.printf("Char index: %d/16\n", charIndex_);
-        Serial.printf("Line 0 needs update: %s\n", line0NeedsUpdate_ ? "YES" : "NO");
-        Serial.printf("Line 1 needs update: %s\n", line1NeedsUpdate_ ? "YES" : "NO");
-        Serial.printf("Last char send: %lu ms ago\n", millis() - lastCharSendTime_);
-        Serial.printf("Line 0: '%s'\n", line0_);
-        Serial.printf("Line 1: '%s'\n", line1_);
+        Serial.printf("Queue: %s, max depth %u words\n", i2c_.isIdle() ? "idle" : "busy", q.maxDepth);
+        Serial.printf("Cells sent: %lu, LCD bytes: %lu, I2C words: %lu\n",
+                      cellsSent_, q.bytesQueued, q.wordsSent);
+        Serial.printf("I2C errors: %lu, resyncs: %lu\n", q.errors, resyncs_);
+        Serial.printf("Line 0: '%s'\n", shadow_[0]);
+        Serial.printf("Line 1: '%s'\n", shadow_[1]);
         Serial.println("=======================");
     }
 
@@ -348,7 +273,9 @@ public:
     void setPlaybackMode(bool isPlaying) { (void)isPlaying; }
     void setThrottleInterval(uint32_t intervalMs) { (void)intervalMs; }
     uint32_t getThrottleInterval() const { return 0; }
-    bool isDirty() const { return line0NeedsUpdate_ || line1NeedsUpdate_; }
+    bool isDirty() const {
+        return memcmp(shadow_[0], pending_[0], 16) != 0 || memcmp(shadow_[1], pending_[1], 16) != 0;
+    }
     bool isPlaybackMode() const { return false; }
     void forceNextUpdate() {}
     bool hasScheduledUpdate() const { return false; }
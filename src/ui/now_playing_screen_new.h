@@ -4,6 +4,8 @@
 #include "framework/action_cycling_screen_base.h"
 #include "framework/playback_navigation_handler.h"
 #include "framework/status_bar_manager.h"
+#include "framework/visualizer_view.h"
+#include "../audio_record_mix.h"
 #include "screen_id.h"
 #include "../dos_colors.h"
 #include "../playback_state.h"
@@ -17,6 +19,7 @@
 #include "RA8875_SPI1.h"    // For direct TFT access (cover image)
 #include "lcd_symbols.h"
 #include "../debug_config.h"  // For DEBUG_SERIAL_ENABLED and DEBUG_PERFORMANCE_STATS
+#include "../load_shedder.h"  // Lower refresh / paused visualizer under audio load
 
 /**
  * NowPlayingScreenNew - Real-time playback display using new framework
@@ -24,14 +27,16 @@
  * Features:
  * - File info (name, format, elapsed/total time)
  * - Real-time OPL register stream (format-agnostic visualization)
+ * - Spectrum bars / scope of the final mix (VisualizerView, CPU-capped)
  * - Voice activity stats (2-op, 4-op, drums)
  * - Progress bar
- * - Actions: Stop, Volume, Browse (go back but keep playing)
+ * - Actions: Stop, Browse, Next, Visual (cycle bars/scope/off), Record (final mix to WAV)
  *
  * Performance Optimizations:
  * - Multi-rate updates: 1Hz for progress, 10Hz for register stream
  * - Incremental rendering: only draws changed elements
  * - Waterfall scrolling: draws only 1 new line per update
+ * - Visualizer: incremental column updates, frame rate backs off to stay within budget
  *
  * Framework Usage:
  * - Extends ActionCyclingScreenBase for automatic action cycling
@@ -43,12 +48,14 @@ private:
     enum ActionID {
         ACTION_STOP = 0,
         ACTION_BROWSE = 1,
-        ACTION_NEXT = 2
+        ACTION_NEXT = 2,
+        ACTION_VISUAL = 3,
+        ACTION_RECORD = 4
     };
 
     // Action definitions for ActionCyclingScreenBase (dynamic based on queue state)
-    Action actions_[3];  // Max 3 actions: Stop, Browse, Next
-    int actionCount_;    // Actual count (2-3 depending on queue)
+    Action actions_[5];  // Max 5 actions: Stop, Browse, Next, Visual, Record
+    int actionCount_;    // Actual count (4-5 depending on queue)
 
     int registerScrollOffset_;  // For scrolling through register list
 
@@ -68,6 +75,15 @@ private:
     // Cover image state
     bool hasCoverImage_;             // True if current track has FM9 cover image
 
+    // Spectrum/scope view (created on first draw, needs context_->ui)
+    VisualizerView* visualizer_;
+
+    // Visualizer area inside the Track Info panel (grid coordinates)
+    static const int VIZ_COL = 66;
+    static const int VIZ_ROW = 3;
+    static const int VIZ_WIDTH = 30;
+    static const int VIZ_HEIGHT = 4;
+
 public:
     NowPlayingScreenNew(ScreenContext* context)
         : ActionCyclingScreenBase(context),
@@ -79,7 +95,8 @@ public:
           currentDisplayRow_(14),  // Start at top row
           maxUpdateTime_(0),
           updateCount_(0),
-          hasCoverImage_(false) {
+          hasCoverImage_(false),
+          visualizer_(nullptr) {
         lastTimeString_[0] = '\0';  // Initialize empty for dirty checking
         updateAvailableActions();
     }
@@ -104,11 +121,20 @@ public:
         ActionCyclingScreenBase::onEnter();
     }
 
+    void onExit() override {
+        // Stop the analyzer tap while nothing is drawing it
+        if (visualizer_) {
+            visualizer_->setActive(false);
+        }
+    }
+
     void onDestroy() override {
         // Unregister event handlers
         if (context_ && context_->eventManager) {
             context_->eventManager->offAll(this);
         }
+        delete visualizer_;
+        visualizer_ = nullptr;
     }
 
     // ============================================
@@ -122,6 +148,13 @@ public:
         // Check for cover image before drawing layout
         checkForCoverImage();
 
+        if (!visualizer_) {
+            extern AudioAnalyzeVisualizer mixVisualizer;
+            visualizer_ = new VisualizerView(context_->ui, &mixVisualizer,
+                                             VIZ_COL, VIZ_ROW, VIZ_WIDTH, VIZ_HEIGHT);
+        }
+        visualizer_->setActive(true);
+
         // Draw main window (drawWindow fills the background automatically)
         Serial.println("[NowPlaying] draw: Drawing window");
         context_->ui->drawWindow(0, 0, 100, 30, " NOW PLAYING ", DOS_WHITE, DOS_BLUE);
@@ -169,9 +202,14 @@ public:
         // Multi-rate updates: Different UI elements update at different frequencies
         // This spreads the rendering load across multiple frames instead of doing
         // everything at once, reducing peak CPU usage and audio interference.
+        // The load shedder can stretch the intervals and pause the visualizer.
+        uint32_t rateDivider = 1;
+        if (g_loadShedder && g_loadShedder->isShed(LoadShedder::STEP_DISPLAY_RATE)) {
+            rateDivider = LoadShedder::SHED_DISPLAY_DIVIDER;
+        }
 
         // Progress bar + Time string: 1Hz (1000ms) - Update together since both are 1Hz
-        if (now - lastInfoUpdate_ >= 1000) {
+        if (now - lastInfoUpdate_ >= 1000 * rateDivider) {
             updateFileInfoData();
             updateProgressBarData();
             lastInfoUpdate_ = now;
@@ -179,12 +217,18 @@ public:
         }
 
         // Register stream: 10Hz (100ms) - Fast, smooth scrolling (only draws 1 line!)
-        if (now - lastRegisterUpdate_ >= 100) {
+        if (now - lastRegisterUpdate_ >= 100 * rateDivider) {
             updateOPLRegisterStreamData();
             lastRegisterUpdate_ = now;
             didUpdate = true;
         }
 
+        // Visualizer: paces and budgets itself (25fps, backs off above 3% CPU)
+        if (visualizer_) {
+            visualizer_->setPaused(g_loadShedder && g_loadShedder->isShed(LoadShedder::STEP_VISUALIZER));
+            visualizer_->update();
+        }
+
         // Performance monitoring - track update times
         if (didUpdate) {
             uint32_t updateDuration = micros() - updateStart;
@@ -206,6 +250,11 @@ public:
                 // // Serial.printf("[NowPlaying] Performance: max update time = %.2f ms over last 100 updates\n",
                              maxUpdateTime_ / 1000.0f);
                 maxUpdateTime_ = 0;  // Reset for next 100 updates
+
+                // CPU spent on display I/O over the same window
+                if (context_->ui && context_->ui->getTFT()) {
+                    context_->ui->getTFT()->printStats();
+                }
             }
             #else
             // Still track max time even if not logging
@@ -269,10 +318,18 @@ private:
         String filename = state->getCurrentFile();
         if (filename.length() == 0) filename = "(No file playing)";
 
-        // Center the filename within the panel
-        int panelCenter = panelStartCol + (panelWidth / 2);
-        int nameCol = panelCenter - (filename.length() / 2);
-        if (nameCol < panelStartCol + 2) nameCol = panelStartCol + 2;
+        // Text shares the panel with the visualizer when it is shown
+        int textStartCol = panelStartCol + 2;
+        int textEndCol = (visualizer_ && visualizer_->isVisible()) ? VIZ_COL - 2 : panelStartCol + panelWidth - 2;
+        int textWidth = textEndCol - textStartCol;
+        if ((int)filename.length() > textWidth) {
+            filename = filename.substring(0, textWidth);
+        }
+
+        // Center the filename within the text area
+        int textCenter = textStartCol + (textWidth / 2);
+        int nameCol = textCenter - (filename.length() / 2);
+        if (nameCol < textStartCol) nameCol = textStartCol;
         context_->ui->drawText(nameCol, 4, filename.c_str(), DOS_BRIGHT_CYAN, DOS_BLUE);
 
         // Format and elapsed/total time - center in panel
@@ -285,6 +342,11 @@ private:
                  state->getElapsedTimeString().c_str(),
                  state->getDurationString().c_str());
         context_->ui->drawText(infoCol, 6, infoBuf, DOS_WHITE, DOS_BLUE);
+
+        // drawPanel() cleared the visualizer area
+        if (visualizer_) {
+            visualizer_->draw();
+        }
     }
 
     // Data-only update for file info (just the time string)
@@ -571,6 +633,27 @@ private:
                 }
                 return ScreenResult::stay();  // Stay on Now Playing, new track will load
 
+            case ACTION_VISUAL:
+                // Cycle Bars -> Scope -> Off, full redraw so the track info reflows
+                if (visualizer_) {
+                    visualizer_->cycleMode();
+                    requestRedraw();
+                }
+                return ScreenResult::stay();
+
+            case ACTION_RECORD: {
+                // Toggle recording of the final mix (keeps running across tracks)
+                extern AudioRecordMix mixRecorder;
+                if (mixRecorder.isRecording()) {
+                    mixRecorder.stop();
+                } else {
+                    mixRecorder.start();
+                }
+                updateAvailableActions();
+                requestRedraw();
+                return ScreenResult::stay();
+            }
+
             default:
                 return ScreenResult::stay();
         }
@@ -592,6 +675,15 @@ private:
             actions_[actionCount_++] = {"Next", "Next track", ACTION_NEXT};
         }
 
+        actions_[actionCount_++] = {"Visual", "Bars/Scope/Off", ACTION_VISUAL};
+
+        extern AudioRecordMix mixRecorder;
+        if (mixRecorder.isRecording()) {
+            actions_[actionCount_++] = {"Stop Rec", "Stop recording", ACTION_RECORD};
+        } else {
+            actions_[actionCount_++] = {"Record", "Record mix to WAV", ACTION_RECORD};
+        }
+
         Serial.printf("[NowPlaying] Updated actions: %d available\n", actionCount_);
     }
 };
@@ -19,7 +19,8 @@ enum ScreenID {
     SCREEN_SETTINGS = 106,
     SCREEN_SETTINGS_MIDI = 107,      // MIDI Audio settings sub-screen
     SCREEN_SETTINGS_VGM = 108,       // VGM Looping settings sub-screen
-    SCREEN_SETTINGS_BLUETOOTH = 109  // Bluetooth settings sub-screen
+    SCREEN_SETTINGS_BLUETOOTH = 109, // Bluetooth settings sub-screen
+    SCREEN_SETTINGS_SYSTEM = 110     // System (power) settings sub-screen
 };
 
 #endif // SCREEN_ID_H
@@ -8,6 +8,7 @@
 #include "framework/screen_result.h"
 #include "framework/screen_factory.h"
 #include "framework/status_bar_manager.h"
+#include "button_input.h"
 #include "../retro_ui.h"
 #include <Adafruit_RGBLCDShield.h>
 
@@ -16,7 +17,7 @@
  *
  * Responsibilities:
  * - Screen lifecycle management (create, enter, exit, destroy)
- * - Button input handling with debouncing and auto-repeat
+ * - Dispatching button events (debounce/auto-repeat live in ButtonInput)
  * - Back navigation history
  * - Screen update coordination
  *
@@ -26,11 +27,6 @@
  * - ScreenResult for type-safe navigation
  */
 
-// Button configuration
-#define DEBOUNCE_DELAY 50     // ms to wait for debounce
-#define REPEAT_DELAY   400    // ms before key repeat starts (hold time)
-#define REPEAT_RATE    80     // ms between repeats (fast scrolling)
-
 class ScreenManager {
 private:
     static ScreenManager* instance;
@@ -45,19 +41,6 @@ private:
     ScreenID pendingScreenID_;
     void* pendingParams_;
 
-    // Button handling
-    uint8_t lastButtons_;
-
-    // Auto-repeat state
-    uint8_t repeatButton_;
-    uint32_t buttonPressTime_;
-    uint32_t lastRepeatTime_;
-    bool repeatActive_;
-
-    // Button read throttling (prevent I2C blocking audio)
-    uint32_t lastButtonReadTime_;
-    static const uint32_t BUTTON_READ_INTERVAL = 50;
-
     // Private constructor for singleton
     ScreenManager()
         : currentScreen_(nullptr)
@@ -67,12 +50,6 @@ private:
         , hasPendingNavigation_(false)
         , pendingScreenID_(SCREEN_NONE)
         , pendingParams_(nullptr)
-        , lastButtons_(0)
-        , repeatButton_(0)
-        , buttonPressTime_(0)
-        , lastRepeatTime_(0)
-        , repeatActive_(false)
-        , lastButtonReadTime_(0)
     {}
 
     /**
@@ -203,7 +180,7 @@ public:
     }
 
     /**
-     * Process button input with edge detection and auto-repeat
+     * Update the current screen and dispatch queued button events
      */
     void update() {
         if (!context_ || !context_->lcd) return;
@@ -222,8 +199,6 @@ public:
 
         if (!currentScreen_) return;
 
-        uint32_t now = millis();
-
         // Update RetroUI status notifications (auto-hide after timeout)
         if (context_->ui) {
             context_->ui->updateStatusNotification();
@@ -232,74 +207,19 @@ public:
         // Update current screen
         currentScreen_->update();
 
-        // Throttle button reads to prevent I2C blocking audio
-        if (now - lastButtonReadTime_ < BUTTON_READ_INTERVAL) {
-            return;
-        }
+        // Reads the port only after a button edge (and only while the LCD
+        // queue isn't using the bus)
+        ButtonInput* input = context_->buttonInput;
+        input->service();
 
-        // Read buttons (I2C communication)
-        lastButtonReadTime_ = now;
-        uint8_t buttons = context_->lcd->readButtons();
-
-        // Detect rising edge (button press, not release)
-        uint8_t pressed = buttons & ~lastButtons_;
-
-        if (pressed) {
-            // New button press - handle immediately
-            if (pressed & BUTTON_UP) {
-                processButton(BUTTON_UP);
-                repeatButton_ = BUTTON_UP;
-            } else if (pressed & BUTTON_DOWN) {
-                processButton(BUTTON_DOWN);
-                repeatButton_ = BUTTON_DOWN;
-            } else if (pressed & BUTTON_LEFT) {
-                processButton(BUTTON_LEFT);
-                repeatButton_ = BUTTON_LEFT;
-            } else if (pressed & BUTTON_RIGHT) {
-                processButton(BUTTON_RIGHT);
-                repeatButton_ = BUTTON_RIGHT;
-            } else if (pressed & BUTTON_SELECT) {
-                processButton(BUTTON_SELECT);
-                repeatButton_ = 0;  // SELECT doesn't repeat
-            }
+        ButtonInput::Event ev;
+        while (input->pop(ev)) {
+            processButton(ev.button);
+            input->markHandled(ev);
 
-            // Start auto-repeat timer
-            buttonPressTime_ = now;
-            lastRepeatTime_ = now;
-            repeatActive_ = false;
-        }
-        // Button still held down
-        else if (buttons != 0 && buttons == lastButtons_) {
-            // Only auto-repeat UP/DOWN (navigation buttons)
-            if ((buttons & BUTTON_UP) || (buttons & BUTTON_DOWN)) {
-                uint32_t holdTime = now - buttonPressTime_;
-
-                // Start repeating after REPEAT_DELAY
-                if (!repeatActive_ && holdTime >= REPEAT_DELAY) {
-                    repeatActive_ = true;
-                    lastRepeatTime_ = now;
-                }
-
-                // Send repeat events at REPEAT_RATE
-                if (repeatActive_ && (now - lastRepeatTime_) >= REPEAT_RATE) {
-                    if (buttons & BUTTON_UP) {
-                        processButton(BUTTON_UP);
-                    } else if (buttons & BUTTON_DOWN) {
-                        processButton(BUTTON_DOWN);
-                    }
-                    lastRepeatTime_ = now;
-                }
-            }
-        }
-        // Button released
-        else if (buttons == 0 && lastButtons_ != 0) {
-            // Reset auto-repeat state
-            repeatButton_ = 0;
-            repeatActive_ = false;
+            // Let a requested screen change happen before the next event
+            if (hasPendingNavigation_) break;
         }
-
-        // Update button state for next iteration
-        lastButtons_ = buttons;
     }
 
     /**
@@ -8,6 +8,9 @@
 #include "screen_id.h"
 #include "lcd_symbols.h"
 #include "../dos_colors.h"
+#include "../resume_journal.h"
+#include "../cpu_governor.h"
+#include "../loudness_index.h"
 
 // External global settings from main.cpp
 extern bool g_drumSamplerEnabled;
@@ -15,6 +18,7 @@ extern bool g_crossfeedEnabled;
 extern bool g_reverbEnabled;
 extern uint8_t g_maxLoopsBeforeFade;
 extern float g_fadeDurationSeconds;
+extern bool g_vgmRateLocked;
 
 /**
  * SettingsScreenNew - Main settings menu using new framework
@@ -30,7 +34,7 @@ private:
         ScreenID targetScreen;
     };
 
-    static const int CATEGORY_ITEMS = 4;
+    static const int CATEGORY_ITEMS = 5;
     CategoryItem categories_[CATEGORY_ITEMS];
 
 public:
@@ -41,7 +45,8 @@ public:
         categories_[0] = {" MIDI Audio",       "MIDI playback",   "\x0E", SCREEN_SETTINGS_MIDI};
         categories_[1] = {" VGM Options",      "Video game music","\x0F", SCREEN_SETTINGS_VGM};
         categories_[2] = {" Bluetooth Audio",  "BT connection",   "\x02", SCREEN_SETTINGS_BLUETOOTH};
-        categories_[3] = {" Back to Main Menu","Exit settings",   "\x1B", SCREEN_MAIN_MENU};
+        categories_[3] = {" System",           "Power saving",    "\x04", SCREEN_SETTINGS_SYSTEM};
+        categories_[4] = {" Back to Main Menu","Exit settings",   "\x1B", SCREEN_MAIN_MENU};
     }
 
     // ============================================
@@ -142,7 +147,7 @@ struct MIDIAudioSettings {
 MIDIAudioSettings g_midiAudioSettings = {
     true,  // drumSamplerEnabled
     true,  // crossfeedEnabled
-    true   // reverbEnabled
+    false  // reverbEnabled (OFF by default - see audio_effect_reverb_psram.h)
 };
 
 class MIDIAudioSettingsScreenNew : public SettingsPageBase<MIDIAudioSettings> {
@@ -218,6 +223,15 @@ public:
     // LIFECYCLE
     // ============================================
 
+    void onEnter() override {
+        // Globals may have been restored from the resume journal at boot
+        g_midiAudioSettings.drumSamplerEnabled = g_drumSamplerEnabled;
+        g_midiAudioSettings.crossfeedEnabled = g_crossfeedEnabled;
+        g_midiAudioSettings.reverbEnabled = g_reverbEnabled;
+
+        SettingsPageBase::onEnter();
+    }
+
     void onSave() override {
         // Apply settings to globals
         g_drumSamplerEnabled = temp_.drumSamplerEnabled;
@@ -226,6 +240,11 @@ public:
 
         // // Serial.println("[MIDIAudioSettings] Settings saved and applied!");
 
+        // Persist immediately rather than waiting for the next checkpoint
+        if (g_resumeJournal) {
+            g_resumeJournal->checkpoint();
+        }
+
         // Fire event so audio system can update dynamically
         if (context_->eventManager) {
             context_->eventManager->fire(EventManager::EVENT_AUDIO_SETTINGS_CHANGED);
@@ -240,6 +259,139 @@ const char* MIDIAudioSettingsScreenNew::settingLabels_[3] = {
     "Reverb Effect"
 };
 
+// ============================================
+// SYSTEM SETTINGS - Using SettingsPageBase
+// ============================================
+
+struct SystemSettings {
+    bool cpuGovernorEnabled;      // Scale the ARM clock with load (CpuGovernor)
+    bool loudnessNormalize;       // Per-track gain from the loudness index (LoudnessIndex)
+};
+
+// Global settings instance
+SystemSettings g_systemSettings = {
+    false, // cpuGovernorEnabled (OFF by default - fixed 600MHz)
+    true   // loudnessNormalize (ON by default)
+};
+
+class SystemSettingsScreenNew : public SettingsPageBase<SystemSettings> {
+private:
+    static const char* settingLabels_[2];
+
+public:
+    SystemSettingsScreenNew(ScreenContext* context)
+        : SettingsPageBase(context, &g_systemSettings, 2, 5) {}  // 2 settings, 5 visible items
+
+    // ============================================
+    // SETTINGS PAGE BASE IMPLEMENTATION
+    // ============================================
+
+    void drawSetting(int settingIndex, int row, bool selected) override {
+        if (settingIndex < 0 || settingIndex >= 2) return;
+
+        const char* label = settingLabels_[settingIndex];
+        char valueStr[16];
+
+        switch (settingIndex) {
+            case 0:  // CPU Power Saving
+                if (temp_.cpuGovernorEnabled && g_cpuGovernor) {
+                    snprintf(valueStr, sizeof(valueStr), "ON (%luMHz)", g_cpuGovernor->getMHz());
+                } else {
+                    snprintf(valueStr, sizeof(valueStr), "%s", temp_.cpuGovernorEnabled ? "ON" : "OFF");
+                }
+                break;
+            case 1:  // Loudness Normalize
+                snprintf(valueStr, sizeof(valueStr), "%s", temp_.loudnessNormalize ? "ON" : "OFF");
+                break;
+            default:
+                return;
+        }
+
+        // DOS-style colors
+        uint16_t fg = selected ? DOS_BLACK : DOS_WHITE;
+        uint16_t bg = selected ? DOS_CYAN : DOS_BLUE;
+        uint16_t valueFg = selected ? DOS_BLACK : DOS_YELLOW;
+
+        // Fill row background
+        context_->ui->fillGridRect(4, row, 72, 1, bg);
+
+        // Draw selection arrow if selected
+        if (selected) {
+            context_->ui->drawText(4, row, "\x10", DOS_BLACK, DOS_CYAN);
+        }
+
+        // Draw label
+        context_->ui->drawText(6, row, label, fg, bg);
+
+        // Draw value
+        context_->ui->drawText(60, row, valueStr, valueFg, bg);
+    }
+
+    void adjustSetting(int settingIndex, int delta) override {
+        // Boolean toggle - delta doesn't matter
+        (void)delta;
+
+        switch (settingIndex) {
+            case 0: temp_.cpuGovernorEnabled = !temp_.cpuGovernorEnabled; break;
+            case 1: temp_.loudnessNormalize = !temp_.loudnessNormalize; break;
+        }
+    }
+
+    // ============================================
+    // DISPLAY METHODS
+    // ============================================
+
+    void drawHeader() override {
+        context_->ui->drawWindow(0, 0, 100, 30, " SYSTEM ", DOS_WHITE, DOS_BLUE);
+    }
+
+    const char* getSettingsName() const override {
+        return "System";
+    }
+
+    // ============================================
+    // LIFECYCLE
+    // ============================================
+
+    void onEnter() override {
+        // Globals may have been restored from the resume journal at boot
+        extern bool g_cpuGovernorEnabled;
+        extern bool g_loudnessNormalizeEnabled;
+
+        g_systemSettings.cpuGovernorEnabled = g_cpuGovernorEnabled;
+        g_systemSettings.loudnessNormalize = g_loudnessNormalizeEnabled;
+
+        SettingsPageBase::onEnter();
+    }
+
+    void onSave() override {
+        // Apply settings to globals
+        extern bool g_cpuGovernorEnabled;
+        extern bool g_loudnessNormalizeEnabled;
+
+        g_cpuGovernorEnabled = temp_.cpuGovernorEnabled;
+        if (g_cpuGovernor) {
+            g_cpuGovernor->setEnabled(g_cpuGovernorEnabled);  // Off returns to 600MHz at once
+        }
+
+        g_loudnessNormalizeEnabled = temp_.loudnessNormalize;
+        if (g_loudnessIndex) {
+            g_loudnessIndex->setEnabled(g_loudnessNormalizeEnabled);  // Re-applies to the current track
+        }
+
+        // Persist immediately rather than waiting for the next checkpoint
+        if (g_resumeJournal) {
+            g_resumeJournal->checkpoint();
+        }
+    }
+};
+
+// Static member definitions
+const char* SystemSettingsScreenNew::settingLabels_[2] = {
+    "CPU Power Saving",
+    "Loudness Normalize"
+};
+
 // ============================================
 // VGM OPTIONS SETTINGS - Using SettingsPageBase
 // ============================================
@@ -250,6 +402,9 @@ struct VGMOptionsSettings {
     bool nesFiltersEnabled;       // NES APU output filters
     bool nesStereoEnabled;        // NES APU stereo panning
     bool spcFilterEnabled;        // SPC gaussian filter (for authentic SNES sound)
+    bool dualOPL2StereoSplit;     // Dual OPL2: chip 0 left / chip 1 right (SB Pro style)
+    uint8_t playbackRatePercent;  // 50-200% in 5% steps
+    bool pitchFollowsRate;        // Scale pitch with rate (tape-style)
 };
 
 // Global settings instance
@@ -258,23 +413,26 @@ VGMOptionsSettings g_vgmOptionsSettings = {
     7.0f,  // fadeDurationSeconds (7 seconds default)
     false, // nesFiltersEnabled (OFF by default for raw sound)
     true,  // nesStereoEnabled (ON by default)
-    false  // spcFilterEnabled (OFF by default for raw sound)
+    false, // spcFilterEnabled (OFF by default for raw sound)
+    false, // dualOPL2StereoSplit (OFF by default - both chips centered)
+    100,   // playbackRatePercent (normal speed)
+    false  // pitchFollowsRate (OFF by default - pitch stays put)
 };
 
 class VGMOptionsScreenNew : public SettingsPageBase<VGMOptionsSettings> {
 private:
-    static const char* settingLabels_[5];  // Now 5 settings
+    static const char* settingLabels_[8];  // Now 8 settings
 
 public:
     VGMOptionsScreenNew(ScreenContext* context)
-        : SettingsPageBase(context, &g_vgmOptionsSettings, 5, 5) {}  // 5 settings, 5 visible items
+        : SettingsPageBase(context, &g_vgmOptionsSettings, 8, 5) {}  // 8 settings, 5 visible items
 
     // ============================================
     // SETTINGS PAGE BASE IMPLEMENTATION
     // ============================================
 
     void drawSetting(int settingIndex, int row, bool selected) override {
-        if (settingIndex < 0 || settingIndex >= 5) return;  // Now 5 settings
+        if (settingIndex < 0 || settingIndex >= 8) return;  // Now 8 settings
 
         const char* label = settingLabels_[settingIndex];
         char valueStr[16];
@@ -302,6 +460,20 @@ public:
             case 4:  // SPC Filter
                 snprintf(valueStr, sizeof(valueStr), "%s", temp_.spcFilterEnabled ? "ON" : "OFF");
                 break;
+            case 5:  // Dual OPL2 Stereo
+                snprintf(valueStr, sizeof(valueStr), "%s", temp_.dualOPL2StereoSplit ? "L/R Split" : "Centered");
+                break;
+            case 6:  // Playback Rate
+                if (g_vgmRateLocked && temp_.playbackRatePercent != 100) {
+                    // FM9 audio / DAC pre-render playing - VGMPlayer holds it at 1x
+                    snprintf(valueStr, sizeof(valueStr), "%d%% (1x now)", temp_.playbackRatePercent);
+                } else {
+                    snprintf(valueStr, sizeof(valueStr), "%d%%", temp_.playbackRatePercent);
+                }
+                break;
+            case 7:  // Pitch Follows Rate
+                snprintf(valueStr, sizeof(valueStr), "%s", temp_.pitchFollowsRate ? "ON" : "OFF");
+                break;
             default:
                 return;
         }
@@ -371,6 +543,26 @@ public:
             case 4:  // SPC Filter (ON/OFF toggle)
                 temp_.spcFilterEnabled = !temp_.spcFilterEnabled;
                 break;
+
+            case 5:  // Dual OPL2 Stereo (Centered / L/R Split toggle)
+                temp_.dualOPL2StereoSplit = !temp_.dualOPL2StereoSplit;
+                break;
+
+            case 6:  // Playback Rate (50-200%, 5% steps)
+                if (delta > 0) {
+                    if (temp_.playbackRatePercent < 200) {
+                        temp_.playbackRatePercent += 5;
+                    }
+                } else {
+                    if (temp_.playbackRatePercent > 50) {
+                        temp_.playbackRatePercent -= 5;
+                    }
+                }
+                break;
+
+            case 7:  // Pitch Follows Rate (ON/OFF toggle)
+                temp_.pitchFollowsRate = !temp_.pitchFollowsRate;
+                break;
         }
     }
 
@@ -390,6 +582,27 @@ public:
     // LIFECYCLE
     // ============================================
 
+    void onEnter() override {
+        // Globals may have been restored from the resume journal at boot
+        extern bool g_nesFiltersEnabled;
+        extern bool g_nesStereoEnabled;
+        extern bool g_spcFilterEnabled;
+        extern bool g_dualOPL2StereoSplit;
+        extern uint8_t g_vgmPlaybackRatePercent;
+        extern bool g_vgmPitchFollowsRate;
+
+        g_vgmOptionsSettings.maxLoopsBeforeFade = g_maxLoopsBeforeFade;
+        g_vgmOptionsSettings.fadeDurationSeconds = g_fadeDurationSeconds;
+        g_vgmOptionsSettings.nesFiltersEnabled = g_nesFiltersEnabled;
+        g_vgmOptionsSettings.nesStereoEnabled = g_nesStereoEnabled;
+        g_vgmOptionsSettings.spcFilterEnabled = g_spcFilterEnabled;
+        g_vgmOptionsSettings.dualOPL2StereoSplit = g_dualOPL2StereoSplit;
+        g_vgmOptionsSettings.playbackRatePercent = g_vgmPlaybackRatePercent;
+        g_vgmOptionsSettings.pitchFollowsRate = g_vgmPitchFollowsRate;
+
+        SettingsPageBase::onEnter();
+    }
+
     void onSave() override {
         // Apply settings to globals
         extern uint8_t g_maxLoopsBeforeFade;
@@ -397,24 +610,38 @@ public:
         extern bool g_nesFiltersEnabled;
         extern bool g_nesStereoEnabled;
         extern bool g_spcFilterEnabled;
+        extern bool g_dualOPL2StereoSplit;
+        extern uint8_t g_vgmPlaybackRatePercent;
+        extern bool g_vgmPitchFollowsRate;
 
         g_maxLoopsBeforeFade = temp_.maxLoopsBeforeFade;
         g_fadeDurationSeconds = temp_.fadeDurationSeconds;
         g_nesFiltersEnabled = temp_.nesFiltersEnabled;
         g_nesStereoEnabled = temp_.nesStereoEnabled;
         g_spcFilterEnabled = temp_.spcFilterEnabled;
+        g_dualOPL2StereoSplit = temp_.dualOPL2StereoSplit;  // Applied on next file load
+        g_vgmPlaybackRatePercent = temp_.playbackRatePercent;  // Picked up live by VGMPlayer::update()
+        g_vgmPitchFollowsRate = temp_.pitchFollowsRate;
 
         // // Serial.println("[VGMOptions] Settings saved and applied!");
+
+        // Persist immediately rather than waiting for the next checkpoint
+        if (g_resumeJournal) {
+            g_resumeJournal->checkpoint();
+        }
     }
 };
 
 // Static member definitions
-const char* VGMOptionsScreenNew::settingLabels_[5] = {
+const char* VGMOptionsScreenNew::settingLabels_[8] = {
     "Looping: Fade After",
     "Fade Duration",
     "NES Filters",
     "NES Stereo",
-    "SPC Filter"
+    "SPC Filter",
+    "Dual OPL2 Stereo",
+    "Playback Rate",
+    "Pitch Follows Rate"
 };
 
 #endif // SETTINGS_SCREEN_NEW_H
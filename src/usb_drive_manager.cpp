@@ -1,5 +1,6 @@
 #include "usb_drive_manager.h"
 #include "file_browser.h"
+#include "trace_log.h"
 
 USBDriveManager::USBDriveManager(FileBrowser* browser, USBHost& usbHost, USBHub& hub, USBDrive& drive, USBFilesystem& fs)
   : browser_(browser)
@@ -33,8 +34,8 @@ void USBDriveManager::update() {
   // Debug: Print status every 5 seconds
   static unsigned long lastDebug = 0;
   if (millis() - lastDebug > 5000) {
-    Serial.printf("[USB Debug] myFS_=%d, msDrive1_=%d, driveActive_=%d\n",
-                  (bool)myFS_, (bool)msDrive1_, driveActive_);
+    TRACE("[USB Debug] myFS_=%d, msDrive1_=%d, driveActive_=%d",
+          (bool)myFS_, (bool)msDrive1_, driveActive_);
     lastDebug = millis();
   }
 
@@ -1,6 +1,8 @@
 #include "vgm_file.h"
 #include "file_source.h"
 #include "genesis_board.h"
+#include "audio_globals.h"  // audioClock
+#include "debug_config.h"   // DEBUG_VGM_PLAYBACK
 #include <Arduino.h>  // For extmem_malloc/extmem_free (PSRAM - Teensy core)
 #include "../lib/uzlib/uzlib.h"
 #include <string.h>
@@ -15,6 +17,17 @@ VGMFile::VGMFile()
   , compressedBuffer_(nullptr)
   , streamDictBuffer_(nullptr)
   , decompressorActive_(false)
+  , loopCacheChunkCount_(0)
+  , loopCacheSize_(0)
+  , loopCachePos_(0)
+  , loopCacheReplaying_(false)
+  , loopCacheState_(LOOP_CACHE_IDLE)
+  , lookaheadTail_(0)
+  , lookaheadCount_(0)
+  , seamPending_(false)
+  , seamOffset_(0)
+  , loopEndInData_(0)
+  , readPos_(0)
   , vgmDataSize_(0)
   , dataOffset_(0)
   , currentDataPos_(0)
@@ -31,6 +44,8 @@ VGMFile::VGMFile()
   loopSnapshot_.valid = false;
   loopSnapshot_.dictCopy = nullptr;
   loopSnapshot_.savedBufferData = nullptr;
+  memset(loopCacheChunks_, 0, sizeof(loopCacheChunks_));
+  memset(&lookaheadStats_, 0, sizeof(lookaheadStats_));
 
   // Initialize stream states
   for (int i = 0; i < MAX_STREAMS; i++) {
@@ -46,6 +61,7 @@ VGMFile::VGMFile()
     streams_[i].dataPos = 0;
     streams_[i].loop = false;
     streams_[i].nextUpdateTime = 0;
+    streams_[i].nextUpdateFrac = 0;
   }
 }
 
@@ -80,21 +96,21 @@ void VGMFile::clear() {
     streamDictBuffer_ = nullptr;
   }
 
-  // Free loop snapshot dictionary
-  if (loopSnapshot_.dictCopy) {
-    delete[] loopSnapshot_.dictCopy;
-    loopSnapshot_.dictCopy = nullptr;
-  }
+  // Free loop snapshot dictionary and buffer data
+  freeLoopSnapshot();
 
-  // Free loop snapshot buffer data
-  if (loopSnapshot_.savedBufferData) {
-    delete[] loopSnapshot_.savedBufferData;
-    loopSnapshot_.savedBufferData = nullptr;
-  }
+  // Free loop cache (PSRAM)
+  clearLoopCache();
 
   // Free data bank (PSRAM)
   clearDataBank();
 
+  // Nothing decoded ahead
+  dropLookahead();
+  loopEndInData_ = 0;
+  readPos_ = 0;
+  memset(&lookaheadStats_, 0, sizeof(lookaheadStats_));
+
   // Reset all state
   chipType_ = ChipType::NONE;
   isTempFile_ = false;
@@ -348,8 +364,10 @@ int VGMFile::streamingReadCallback(uzlib_uncomp* uncomp) {
 bool VGMFile::loadVGZStreaming(const char* filename) {
   // Set global instance for callback
   g_streamingVGMFile = this;
-  // Open VGZ file using FileSource (keep it open for streaming)
-  file_ = fileSource_->open(filename, FILE_READ);
+  // Open VGZ file using FileSource (keep it open for streaming) - from PSRAM
+  // if it fits, so inflate refills don't touch the card during playback
+  FileView view = fileSource_->openView(filename);
+  file_ = view ? view.open() : fileSource_->open(filename, FILE_READ);
   if (!file_) {
     // // Serial.print("Could not open VGZ file: ");
     // // Serial.println(filename);
@@ -550,6 +568,7 @@ bool VGMFile::loadVGZStreaming(const char* filename) {
   } else {
     loopOffsetInData_ = 0;
   }
+  setLoopEnd();
 
   // Position ourselves at the start of VGM data
   // We need to skip from wherever we are in the buffer to dataOffset_
@@ -562,7 +581,7 @@ bool VGMFile::loadVGZStreaming(const char* filename) {
     currentDataPos_ = bufferPos_;
     while (currentDataPos_ < dataOffset_) {
       uint8_t dummy;
-      if (!readByte(dummy)) {
+      if (!readSourceByte(dummy)) {
         // // Serial.println("Failed to skip to VGM data start");
         delete[] compressedBuffer_;
         delete[] streamDictBuffer_;
@@ -630,8 +649,10 @@ bool VGMFile::loadVGZStreaming(const char* filename) {
 }
 
 bool VGMFile::loadVGM(const char* filename) {
-  // Open file using FileSource
-  file_ = fileSource_->open(filename, FILE_READ);
+  // Open file using FileSource - from PSRAM if it fits, so loop jumps and
+  // buffer refills don't touch the card during playback
+  FileView view = fileSource_->openView(filename);
+  file_ = view ? view.open() : fileSource_->open(filename, FILE_READ);
   if (!file_) {
     // // Serial.print("Could not open VGM file: ");
     // // Serial.println(filename);
@@ -655,6 +676,12 @@ bool VGMFile::loadVGM(const char* filename) {
     return false;
   }
 
+  // Gzipped data under a .vgm name (deflated .vgm members of a ZIP are served this way)
+  if ((uint8_t)header_.ident[0] == 0x1F && (uint8_t)header_.ident[1] == 0x8B) {
+    file_.close();
+    return loadVGZ(filename);
+  }
+
   // Check VGM signature
   if (memcmp(header_.ident, "Vgm ", 4) != 0) {
     // // Serial.println("Invalid VGM signature");
@@ -722,6 +749,7 @@ bool VGMFile::loadVGM(const char* filename) {
   } else {
     loopOffsetInData_ = 0;
   }
+  setLoopEnd();
 
   // Seek to data start and initialize buffer
   file_.seek(dataOffset_);
@@ -896,7 +924,18 @@ bool VGMFile::refillBufferCompressed() {
   return bufferSize_ > 0;
 }
 
-bool VGMFile::readByte(uint8_t& byte) {
+bool VGMFile::readSourceByte(uint8_t& byte) {
+  // Looping from the PSRAM loop cache - no SD or inflate work
+  if (loopCacheReplaying_) {
+    if (loopCachePos_ >= loopCacheSize_ || currentDataPos_ >= vgmDataSize_) {
+      return false;
+    }
+    byte = loopCacheChunks_[loopCachePos_ / LOOP_CACHE_CHUNK][loopCachePos_ % LOOP_CACHE_CHUNK];
+    loopCachePos_++;
+    currentDataPos_++;
+    return true;
+  }
+
   // Check if we need to refill buffer
   if (bufferPos_ >= bufferSize_) {
     if (!refillBuffer()) {
@@ -918,14 +957,33 @@ bool VGMFile::readByte(uint8_t& byte) {
     captureLoopSnapshot();
   }
 
+  // Start recording the loop section into PSRAM on the first pass
+  if (loopCacheState_ == LOOP_CACHE_IDLE &&
+      hasLoop() &&
+      currentDataPos_ == loopOffsetInData_) {
+    startLoopCache();
+  }
+
   // Read byte
   byte = buffer_[bufferPos_++];
   currentDataPos_++;
 
+  if (loopCacheState_ == LOOP_CACHE_RECORDING) {
+    appendToLoopCache(byte);
+  }
+
   return true;
 }
 
-bool VGMFile::peekByte(uint8_t& byte) {
+bool VGMFile::peekSourceByte(uint8_t& byte) {
+  if (loopCacheReplaying_) {
+    if (loopCachePos_ >= loopCacheSize_ || currentDataPos_ >= vgmDataSize_) {
+      return false;
+    }
+    byte = loopCacheChunks_[loopCachePos_ / LOOP_CACHE_CHUNK][loopCachePos_ % LOOP_CACHE_CHUNK];
+    return true;
+  }
+
   // Check if we need to refill buffer
   if (bufferPos_ >= bufferSize_) {
     if (!refillBuffer()) {
@@ -943,11 +1001,37 @@ bool VGMFile::peekByte(uint8_t& byte) {
   return true;
 }
 
-bool VGMFile::seekToDataPosition(uint32_t position) {
+bool VGMFile::seekSource(uint32_t position) {
   if (position >= vgmDataSize_) {
     return false;
   }
 
+  // Loop point: replay from the PSRAM loop cache when it holds the whole loop section
+  if (hasLoop() && position == loopOffsetInData_) {
+    if (loopCacheState_ == LOOP_CACHE_RECORDING) {
+      // First pass just ended - everything from the loop point onward is captured
+      loopCacheState_ = LOOP_CACHE_READY;
+      freeLoopSnapshot();  // Snapshot is only needed as a fallback
+      #if DEBUG_VGM_PLAYBACK
+      Serial.print("VGM: Loop cache ready (");
+      Serial.print(loopCacheSize_);
+      Serial.println(" bytes in PSRAM)");
+      #endif
+    }
+    if (loopCacheState_ == LOOP_CACHE_READY) {
+      loopCacheReplaying_ = true;
+      loopCachePos_ = 0;
+      currentDataPos_ = position;
+      return true;
+    }
+  } else if (loopCacheState_ == LOOP_CACHE_RECORDING) {
+    // Seeking elsewhere mid-recording leaves a gap - start over next time we pass the loop point
+    clearLoopCache();
+  }
+
+  // Leaving the loop cache (seek to a non-loop position)
+  loopCacheReplaying_ = false;
+
   // For compressed files, we can only seek to the loop point via snapshot
   if (fileMode_ == MODE_COMPRESSED) {
     if (hasLoop() && position == loopOffsetInData_) {
@@ -982,6 +1066,129 @@ bool VGMFile::seekToDataPosition(uint32_t position) {
   return refillBuffer();
 }
 
+// ========== Look-ahead (decoded ahead of the playhead) ==========
+
+bool VGMFile::readByte(uint8_t& byte) {
+  if (seamPending_ && seamOffset_ == 0) {
+    // Reading on past the 0x66 the look-ahead jumped at - it wasn't the loop end,
+    // so go back to the source where the playhead actually is
+    dropLookahead();
+    loopEndInData_ = 0;
+    if (!seekSource(readPos_)) {
+      endOfData_ = true;  // VGZ can only seek to the loop point
+      return false;
+    }
+  }
+
+  if (lookaheadCount_ > 0) {
+    byte = lookahead_[lookaheadTail_];
+    lookaheadTail_ = (lookaheadTail_ + 1) % LOOKAHEAD_SIZE;
+    lookaheadCount_--;
+    if (seamPending_) {
+      seamOffset_--;
+    }
+    readPos_++;
+    return true;
+  }
+
+  // Nothing decoded ahead (prefetch() not in use, or the playhead caught up)
+  if (!readSourceByte(byte)) {
+    return false;
+  }
+  readPos_ = currentDataPos_;
+  lookaheadStats_.directReads++;
+  return true;
+}
+
+bool VGMFile::peekByte(uint8_t& byte) {
+  if (lookaheadCount_ > 0 && !(seamPending_ && seamOffset_ == 0)) {
+    byte = lookahead_[lookaheadTail_];
+    return true;
+  }
+  if (lookaheadCount_ > 0 || seamPending_) {
+    return false;  // Past the loop end - only a seek back to the loop point follows
+  }
+  return peekSourceByte(byte);
+}
+
+bool VGMFile::seekToDataPosition(uint32_t position) {
+  if (position >= vgmDataSize_) {
+    return false;
+  }
+
+  // prefetch() already jumped here - the look-ahead carries on with the loop section
+  if (seamPending_ && seamOffset_ == 0 && position == loopOffsetInData_) {
+    seamPending_ = false;
+    readPos_ = position;
+    lookaheadStats_.seamlessLoops++;
+    return true;
+  }
+
+  // Jumps to the loop point tell us where the loop ends (the next one is decoded ahead)
+  bool loopJump = hasLoop() && position == loopOffsetInData_ && readPos_ > position;
+  if (loopJump) {
+    loopEndInData_ = readPos_;
+    lookaheadStats_.seekedLoops++;
+  }
+
+  // The source has run ahead of the playhead - move it, then forget what it decoded
+  if (!seekSource(position)) {
+    return false;
+  }
+  dropLookahead();
+  readPos_ = position;
+  return true;
+}
+
+void VGMFile::prefetch(uint32_t maxBytes) {
+  while (lookaheadCount_ < LOOKAHEAD_SIZE && maxBytes > 0) {
+    if (loopEndInData_ > 0 && currentDataPos_ == loopEndInData_) {
+      // At the loop end: jump now if the last command really was the 0x66, so the
+      // playhead finds the loop section already here. One seam in flight at a time.
+      if (seamPending_ || lookaheadCount_ == 0) {
+        break;
+      }
+      uint32_t last = (lookaheadTail_ + lookaheadCount_ - 1) % LOOKAHEAD_SIZE;
+      if (lookahead_[last] == 0x66) {
+        if (!seekSource(loopOffsetInData_)) {
+          break;  // Snapshot not ready - the playhead's own jump will retry
+        }
+        seamPending_ = true;
+        seamOffset_ = lookaheadCount_;
+        continue;
+      }
+      loopEndInData_ = 0;  // Not the end after all - let the playhead find it
+    }
+
+    uint8_t byte;
+    if (!readSourceByte(byte)) {
+      break;
+    }
+    lookahead_[(lookaheadTail_ + lookaheadCount_) % LOOKAHEAD_SIZE] = byte;
+    lookaheadCount_++;
+    lookaheadStats_.prefetched++;
+    maxBytes--;
+  }
+}
+
+void VGMFile::dropLookahead() {
+  lookaheadTail_ = 0;
+  lookaheadCount_ = 0;
+  seamPending_ = false;
+  seamOffset_ = 0;
+}
+
+void VGMFile::setLoopEnd() {
+  // The data ends with 0x66 just before the GD3 tag (or at EOF without one);
+  // prefetch() checks for it before jumping
+  uint32_t endInFile = header_.gd3Offset ? 0x14 + header_.gd3Offset : 0x04 + header_.eofOffset;
+  if (hasLoop() && endInFile > dataOffset_ + loopOffsetInData_) {
+    loopEndInData_ = endInFile - dataOffset_;
+  } else {
+    loopEndInData_ = 0;
+  }
+}
+
 String VGMFile::getVersionString() const {
   uint8_t major = (header_.version >> 8) & 0xFF;
   uint8_t minor = header_.version & 0xFF;
@@ -1081,6 +1288,20 @@ void VGMFile::captureLoopSnapshot() {
   // // Serial.println("Loop snapshot captured successfully!");
 }
 
+void VGMFile::freeLoopSnapshot() {
+  if (loopSnapshot_.dictCopy) {
+    delete[] loopSnapshot_.dictCopy;
+    loopSnapshot_.dictCopy = nullptr;
+  }
+  if (loopSnapshot_.savedBufferData) {
+    delete[] loopSnapshot_.savedBufferData;
+    loopSnapshot_.savedBufferData = nullptr;
+  }
+  loopSnapshot_.dictSize = 0;
+  loopSnapshot_.savedBufferSize = 0;
+  loopSnapshot_.valid = false;
+}
+
 bool VGMFile::restoreLoopSnapshot() {
   if (!loopSnapshot_.valid) {
     // // Serial.println("Cannot restore loop: snapshot not valid");
@@ -1174,6 +1395,56 @@ bool VGMFile::restoreLoopSnapshot() {
   return true;
 }
 
+// ========== Loop Cache Implementation (PSRAM-based) ==========
+
+void VGMFile::startLoopCache() {
+  clearLoopCache();
+  loopCacheState_ = LOOP_CACHE_RECORDING;
+}
+
+void VGMFile::appendToLoopCache(uint8_t byte) {
+  uint32_t chunk = loopCacheSize_ / LOOP_CACHE_CHUNK;
+
+  if (chunk >= loopCacheChunkCount_) {
+    // Current chunk is full - allocate the next one (never copies existing data)
+    if (chunk >= LOOP_CACHE_MAX_CHUNKS) {
+      Serial.print("VGM: Loop section exceeds ");
+      Serial.print(LOOP_CACHE_BUDGET / 1024);
+      Serial.println("KB loop cache budget, using snapshot/seek for loops");
+      disableLoopCache();
+      return;
+    }
+
+    loopCacheChunks_[chunk] = (uint8_t*)extmem_malloc(LOOP_CACHE_CHUNK);
+    if (!loopCacheChunks_[chunk]) {
+      Serial.println("VGM: Failed to allocate loop cache in PSRAM, using snapshot/seek for loops");
+      disableLoopCache();
+      return;
+    }
+    loopCacheChunkCount_ = chunk + 1;
+  }
+
+  loopCacheChunks_[chunk][loopCacheSize_ % LOOP_CACHE_CHUNK] = byte;
+  loopCacheSize_++;
+}
+
+void VGMFile::disableLoopCache() {
+  clearLoopCache();
+  loopCacheState_ = LOOP_CACHE_DISABLED;
+}
+
+void VGMFile::clearLoopCache() {
+  for (uint32_t i = 0; i < loopCacheChunkCount_; i++) {
+    extmem_free(loopCacheChunks_[i]);
+    loopCacheChunks_[i] = nullptr;
+  }
+  loopCacheChunkCount_ = 0;
+  loopCacheSize_ = 0;
+  loopCachePos_ = 0;
+  loopCacheReplaying_ = false;
+  loopCacheState_ = LOOP_CACHE_IDLE;
+}
+
 // ========== PCM Data Bank Implementation (PSRAM-based) ==========
 
 bool VGMFile::allocateDataBank() {
@@ -1294,7 +1565,8 @@ void VGMFile::startStream(uint8_t streamID, uint32_t dataStart, uint8_t lengthMo
 
   stream.loop = false;  // VGM spec: streams don't loop by default
   stream.active = true;
-  stream.nextUpdateTime = micros();  // Start immediately
+  stream.nextUpdateTime = audioClock.now();  // Start immediately
+  stream.nextUpdateFrac = 0;
 }
 
 void VGMFile::stopStream(uint8_t streamID) {
@@ -1320,7 +1592,8 @@ void VGMFile::startStreamFast(uint8_t streamID, uint16_t blockID, uint8_t flags)
   // For simplicity, just activate the stream with current settings
   stream.active = true;
   stream.dataPos = 0;
-  stream.nextUpdateTime = micros();
+  stream.nextUpdateTime = audioClock.now();
+  stream.nextUpdateFrac = 0;
 }
 
 void VGMFile::resetStreamPositions() {
@@ -1329,7 +1602,8 @@ void VGMFile::resetStreamPositions() {
   for (int i = 0; i < MAX_STREAMS; i++) {
     if (streams_[i].active) {
       streams_[i].dataPos = 0;
-      streams_[i].nextUpdateTime = micros();
+      streams_[i].nextUpdateTime = audioClock.now();
+      streams_[i].nextUpdateFrac = 0;
       Serial.print("[VGM Stream] Reset stream ");
       Serial.print(i);
       Serial.println(" position to 0");
@@ -1337,23 +1611,27 @@ void VGMFile::resetStreamPositions() {
   }
 }
 
-void VGMFile::updateStreams(GenesisBoard* genesisBoard) {
+void VGMFile::updateStreams(GenesisBoard* genesisBoard, uint8_t ratePercent) {
   // Hardware DAC mode only - pre-rendered DAC handles streams internally
-  if (!genesisBoard || !dataBank_) return;
+  if (!genesisBoard || !dataBank_ || ratePercent == 0) return;
 
-  uint32_t now = micros();
+  // Same clock as the VGM timeline that started the stream (one clock sample per VGM sample)
+  uint32_t now = audioClock.now();
 
   for (int i = 0; i < MAX_STREAMS; i++) {
     StreamState& stream = streams_[i];
 
     if (!stream.active || stream.frequency == 0) continue;
 
-    // Calculate interval in microseconds
-    uint32_t intervalUs = 1000000UL / stream.frequency;
+    // Interval in clock samples, Q16 (an integer microsecond interval ran 22050Hz streams 0.8% fast),
+    // stretched by 100/rate like the timeline's clockPerSample_ so streams stay on the commands
+    uint32_t intervalQ16 = (uint32_t)(((uint64_t)44100 * 100 << 16) / ((uint64_t)stream.frequency * ratePercent));
 
     // Emit as many samples as needed to catch up
     while ((int32_t)(now - stream.nextUpdateTime) >= 0) {
-      stream.nextUpdateTime += intervalUs;
+      uint32_t frac = stream.nextUpdateFrac + (intervalQ16 & 0xFFFF);
+      stream.nextUpdateTime += (intervalQ16 >> 16) + (frac >> 16);
+      stream.nextUpdateFrac = (uint16_t)frac;
 
       // Read next sample from data bank
       uint32_t absolutePos = stream.dataStart + stream.dataPos;
@@ -67,6 +67,14 @@ enum class ChipType {
 
 class VGMFile {
 public:
+  // Look-ahead statistics (what reached the playhead through the look-ahead vs directly)
+  struct LookaheadStats {
+    uint32_t seamlessLoops;   // Loop jumps already decoded ahead - nothing to do at the seam
+    uint32_t seekedLoops;     // Loop jumps that had to seek/restore at the seam
+    uint32_t directReads;     // Bytes read straight from the source (look-ahead empty)
+    uint32_t prefetched;      // Bytes decoded ahead by prefetch()
+  };
+
   VGMFile();
   ~VGMFile();
 
@@ -97,20 +105,42 @@ public:
   uint32_t getDataOffset() const { return dataOffset_; }
   uint32_t getLoopOffsetInData() const { return loopOffsetInData_; }
 
-  // Read next byte from stream (handles buffer refill)
+  // Read next byte from stream (look-ahead first, then buffer refill)
   bool readByte(uint8_t& byte);
 
   // Peek at next byte without advancing
   bool peekByte(uint8_t& byte);
 
   // Seek to position in data stream (relative to data start)
+  // A jump to the loop point that prefetch() already took just continues in the look-ahead
   bool seekToDataPosition(uint32_t position);
 
-  // Get current position in data stream
-  uint32_t getCurrentDataPosition() const { return currentDataPos_; }
+  // Get current position in data stream (the playhead, not the prefetcher)
+  uint32_t getCurrentDataPosition() const { return readPos_; }
+
+  /**
+   * Decode ahead of the playhead into the look-ahead (call outside the timed path)
+   * Buffer refills, inflate and loop jumps happen here instead of mid-burst. At the
+   * loop end (the byte after the final 0x66) it continues from the loop point, so
+   * the player's jump back costs nothing. Without calls, reads go straight to the file.
+   * @param maxBytes Stop after decoding this many bytes (default: fill the look-ahead)
+   */
+  void prefetch(uint32_t maxBytes = LOOKAHEAD_SIZE);
+
+  // Bytes decoded ahead of the playhead
+  uint32_t getLookaheadCount() const { return lookaheadCount_; }
+
+  const LookaheadStats& getLookaheadStats() const { return lookaheadStats_; }
+  void resetLookaheadStats() { memset(&lookaheadStats_, 0, sizeof(lookaheadStats_)); }
+
+  // True once the loop section has been captured in PSRAM and loops replay from memory
+  bool isLoopCacheReady() const { return loopCacheState_ == LOOP_CACHE_READY; }
+
+  // Bytes currently held in the PSRAM loop cache
+  uint32_t getLoopCacheSize() const { return loopCacheSize_; }
 
   // Check if at end of data
-  bool isAtEnd() const { return endOfData_ || currentDataPos_ >= vgmDataSize_; }
+  bool isAtEnd() const { return endOfData_ || readPos_ >= vgmDataSize_; }
 
   // Explicitly mark end of data (for VGZ/FM9 files where size is unknown)
   void markEndOfData() { endOfData_ = true; }
@@ -218,8 +248,10 @@ public:
    * Writes next sample to chip when timing interval elapses
    * Only used for hardware DAC mode - pre-rendered DAC handles streams internally
    * @param genesisBoard Hardware DAC interface
+   * @param ratePercent Playback rate (VGMPlayer::getPlaybackRatePercent()) -
+   *        stream samples are spaced like the command timeline at this rate
    */
-  void updateStreams(class GenesisBoard* genesisBoard);
+  void updateStreams(class GenesisBoard* genesisBoard, uint8_t ratePercent);
 
   /**
    * Reset all stream positions to start (for looping)
@@ -231,6 +263,10 @@ private:
   static const size_t BUFFER_SIZE = 8192;  // 8KB buffer for streaming
   static const size_t COMPRESSED_BUFFER_SIZE = 4096;  // 4KB for compressed input
   static const size_t DICT_SIZE = 32768;  // 32KB LZ77 dictionary for gzip
+  static const size_t LOOP_CACHE_BUDGET = 2097152;  // 2MB max PSRAM for the loop section
+  static const size_t LOOP_CACHE_CHUNK = 65536;     // Loop cache grows in 64KB chunks (no realloc copies)
+  static const size_t LOOP_CACHE_MAX_CHUNKS = LOOP_CACHE_BUDGET / LOOP_CACHE_CHUNK;
+  static const size_t LOOKAHEAD_SIZE = 4096;  // Decoded ahead of the playhead (~90ms of dense DAC data)
 
   // File mode
   enum FileMode {
@@ -251,6 +287,15 @@ private:
     bool valid;                      // Snapshot is ready
   };
 
+  // Loop cache (decompressed bytes from loopOffsetInData_ to end, kept in PSRAM)
+  // First pass records; later loops replay from memory with no SD or inflate work
+  enum LoopCacheState {
+    LOOP_CACHE_IDLE,       // Loop point not reached yet
+    LOOP_CACHE_RECORDING,  // Capturing bytes as they are read on the first pass
+    LOOP_CACHE_READY,      // Complete - loops are served from PSRAM
+    LOOP_CACHE_DISABLED    // Over budget or allocation failed - use snapshot/seek
+  };
+
   VGMHeader header_;
   ChipType chipType_;
 
@@ -271,10 +316,28 @@ private:
   bool decompressorActive_;        // Is decompressor initialized?
   LoopSnapshot loopSnapshot_;      // Saved state at loop point
 
+  // PSRAM loop cache
+  uint8_t* loopCacheChunks_[LOOP_CACHE_MAX_CHUNKS];  // Loop section bytes (chunks allocated in PSRAM)
+  uint32_t loopCacheChunkCount_;   // Chunks currently allocated
+  uint32_t loopCacheSize_;         // Bytes recorded so far
+  uint32_t loopCachePos_;          // Replay position within the loop cache
+  bool loopCacheReplaying_;        // True while reads come from the loop cache
+  LoopCacheState loopCacheState_;
+
+  // Look-ahead ring (filled by prefetch(), drained by readByte())
+  uint8_t lookahead_[LOOKAHEAD_SIZE];
+  uint32_t lookaheadTail_;         // Next byte for the playhead
+  uint32_t lookaheadCount_;        // Bytes decoded ahead
+  bool seamPending_;               // The look-ahead has jumped to the loop point...
+  uint32_t seamOffset_;            // ...after this many more bytes
+  uint32_t loopEndInData_;         // Data position just past the final 0x66 (0 = unknown)
+  uint32_t readPos_;               // Playhead position (currentDataPos_ is the source's)
+  LookaheadStats lookaheadStats_;
+
   // VGM data tracking
   size_t vgmDataSize_;             // Size of VGM command data
   uint32_t dataOffset_;            // Offset to VGM data start in file
-  uint32_t currentDataPos_;        // Current position in data stream (relative to data start)
+  uint32_t currentDataPos_;        // Source position in data stream (relative to data start)
   uint32_t loopOffsetInData_;      // Loop position relative to data start
   bool endOfData_;                 // Explicit end flag (for 0x66 command)
 
@@ -301,7 +364,8 @@ private:
     uint32_t dataLength;      // Length of data
     uint32_t dataPos;         // Current position in stream data
     bool loop;                // Loop when reaching end?
-    uint32_t nextUpdateTime;  // When to write next sample (micros)
+    uint32_t nextUpdateTime;  // When to write next sample (audioClock samples)
+    uint16_t nextUpdateFrac;  // Fraction of a clock sample (Q16)
   };
   static const int MAX_STREAMS = 4;  // Support up to 4 concurrent streams
   StreamState streams_[MAX_STREAMS];
@@ -317,6 +381,20 @@ private:
   bool refillBufferCompressed();  // Decompress next chunk
   void captureLoopSnapshot();     // Save decompressor state at loop point
   bool restoreLoopSnapshot();     // Restore decompressor state for looping
+  void freeLoopSnapshot();        // Release snapshot buffers once the loop cache takes over
+
+  // Look-ahead helpers (the source is what prefetch() and direct reads pull from)
+  bool readSourceByte(uint8_t& byte);  // Next byte from buffer/inflate/loop cache
+  bool peekSourceByte(uint8_t& byte);
+  bool seekSource(uint32_t position);
+  void dropLookahead();
+  void setLoopEnd();                   // Predict the loop end from the GD3/EOF offsets
+
+  // Loop cache helpers (uses PSRAM allocation)
+  void startLoopCache();
+  void appendToLoopCache(uint8_t byte);
+  void disableLoopCache();
+  void clearLoopCache();
   static int streamingReadCallback(uzlib_uncomp* uncomp);  // Callback for uzlib
   uint32_t readLE32(const uint8_t* p);
   uint16_t readLE16(const uint8_t* p);
@@ -1,5 +1,6 @@
 #include "vgm_player.h"
 #include "debug_config.h"  // For DEBUG_SERIAL_ENABLED
+#include "trace_log.h"     // TRACE() for command-stream diagnostics
 #include "audio_system.h"  // For master volume control during fade
 #include "audio_globals.h"  // For audioShield access and persistent audio connections
 #include <SD.h>
@@ -9,6 +10,10 @@
 extern uint8_t g_maxLoopsBeforeFade;
 extern float g_fadeDurationSeconds;
 extern bool g_genesisDACEmulation;
+extern bool g_dualOPL2StereoSplit;
+extern uint8_t g_vgmPlaybackRatePercent;
+extern bool g_vgmPitchFollowsRate;
+extern bool g_vgmRateLocked;
 
 // Static member initialization
 VGMPlayer* VGMPlayer::instance_ = nullptr;
@@ -16,9 +21,8 @@ VGMPlayer* VGMPlayer::instance_ = nullptr;
 // Sample rate for VGM files is always 44100 Hz
 static const uint32_t VGM_SAMPLE_RATE = 44100;
 
-// Use microsecond-accurate timing
-// One sample at 44100 Hz = 22.675737 microseconds
-static const float MICROS_PER_SAMPLE = 1000000.0f / 44100.0f;
+// The timeline runs on audioClock (I2S samples), one clock sample per VGM sample,
+// so chip writes stay locked to the software streams that play alongside them
 
 // Run timer at 5kHz for responsive checking
 static const uint32_t TIMER_PERIOD_US = 200; // 5kHz timer
@@ -29,6 +33,7 @@ VGMPlayer::VGMPlayer(const PlayerConfig& config)
   , gbApu_(config.gbAPU)  // Injected, not owned
   , genesisBoard_(config.genesisBoard)  // Injected, not owned
   , dacPrerenderer_(config.dacPrerenderer)  // Injected, not owned
+  , dacPrerenderCache_(config.dacPrerenderCache)  // Injected, not owned
   , dacPrerenderStream_(config.dacPrerenderStream)  // Injected, not owned
   , fileSource_(config.fileSource)
   , state_(PlayerState::IDLE)
@@ -53,18 +58,28 @@ VGMPlayer::VGMPlayer(const PlayerConfig& config)
   , timerFlag_(false)
   , nextSampleTime_(0)
   , nextSampleTimeF_(0.0)
+  , clockPerSample_(1.0)
+  , pausedAt_(0)
+  , clockStart_(0)
+  , microsStart_(0)
+  , ratePercent_(100)
+  , requestedRatePercent_(100)
+  , rateLocked_(false)
+  , pitchFollowsRate_(false)
   , totalCommands_(0)
   , commandsProcessed_(0)
   , maxProcessTime_(0)
   , hasGenesis_(false)
   , useDACPrerender_(false)  // Will be set in loadFile() based on availability
   , dacPrerendered_(false)   // True if DAC was successfully pre-rendered
+  , dacPrerenderIsTemp_(false)
   , dacCurrentlyEnabled_(false)  // Tracks whether DAC is currently on
   , debugPsgWrites_(0)
   , debugYmPort0Writes_(0)
   , debugYmPort1Writes_(0) {
   instance_ = this;
   memset(currentFileName_, 0, sizeof(currentFileName_));
+  memset(dacPrerenderPath_, 0, sizeof(dacPrerenderPath_));
 
   // // Serial.println("[VGMPlayer] Created with PlayerConfig");
 }
@@ -93,8 +108,8 @@ bool VGMPlayer::loadFile(const char* filename) {
     dacPrerenderStream_->closeFile();
     dacNesMixerLeft_->gain(0, 0.0f);   // Mute DAC on pre-mixer channel 0
     dacNesMixerRight_->gain(0, 0.0f);
-    if (SD.exists("/TEMP/~dac.tmp")) {
-      SD.remove("/TEMP/~dac.tmp");
+    if (dacPrerenderIsTemp_ && SD.exists(dacPrerenderPath_)) {
+      SD.remove(dacPrerenderPath_);
     }
     dacPrerendered_ = false;
     useDACPrerender_ = false;
@@ -196,41 +211,70 @@ bool VGMPlayer::loadFile(const char* filename) {
 
       // Try DAC pre-rendering (preferred for dense PCM timing accuracy)
       if (g_genesisDACEmulation && dacPrerenderer_ && dacPrerenderStream_) {
-        Serial.println("[VGM] Attempting DAC pre-render...");
-
-        // Pre-render the DAC stream to a temp file
-        // This expands all DAC commands to a linear 44.1 kHz sample stream
-        uint32_t prerenderStart = millis();
-
-        if (dacPrerenderer_->preRender(&vgmFile_, "/TEMP/~dac.tmp")) {
-          uint32_t prerenderTime = millis() - prerenderStart;
-          Serial.printf("[VGM] DAC pre-render SUCCESS in %lu ms\n", prerenderTime);
-
-          // CRITICAL: Pre-rendering consumed the entire VGM stream.
-          // For VGZ (compressed) files, we cannot seek back to position 0.
-          // We must reload the VGM file to reset the decompressor state.
-          // This also reloads the data bank which was consumed during pre-render.
-          Serial.println("[VGM] Reloading VGM file after pre-render...");
-          if (!vgmFile_.loadFromFile(filename, fileSource_)) {
-            Serial.println("[VGM] WARNING: Failed to reload VGM file after pre-render!");
-            dacPrerendered_ = false;
+        // A track rendered before (same content, same renderer) loads straight from the cache
+        uint64_t cacheKey = 0;
+        bool cacheable = dacPrerenderCache_ && dacPrerenderCache_->makeKey(filename, fileSource_, cacheKey);
+        if (cacheable && dacPrerenderCache_->lookup(cacheKey, dacPrerenderPath_, sizeof(dacPrerenderPath_))) {
+          if (dacPrerenderStream_->loadFile(dacPrerenderPath_)) {
+            dacPrerenderIsTemp_ = false;
+            useDACPrerender_ = true;
+            dacPrerendered_ = true;
+            Serial.printf("[VGM] Using CACHED pre-rendered DAC (key %lu ms)\n",
+                          dacPrerenderCache_->getStats().lastKeyMs);
           } else {
-            Serial.println("[VGM] VGM file reloaded successfully");
+            Serial.println("[VGM] WARNING: Cached DAC render unreadable - rendering again");
+            dacPrerenderCache_->remove(cacheKey);
+          }
+        }
 
-            // Load the pre-rendered file into the playback stream
-            if (dacPrerenderStream_->loadFile("/TEMP/~dac.tmp")) {
-              useDACPrerender_ = true;
-              dacPrerendered_ = true;
-              Serial.println("[VGM] Using PRE-RENDERED DAC (perfect timing)");
-            } else {
-              Serial.println("[VGM] WARNING: Failed to load pre-rendered DAC file");
+        if (!dacPrerendered_) {
+          Serial.println("[VGM] Attempting DAC pre-render...");
+
+          // Pre-render the DAC stream straight into the cache when possible, else a temp file
+          // This expands all DAC commands to a linear 44.1 kHz sample stream
+          const char* renderPath = cacheable ? dacPrerenderCache_->getRenderPath() : "/TEMP/~dac.tmp";
+          if (cacheable) {
+            dacPrerenderCache_->reserve(DACPrerenderer::HEADER_SIZE + vgmFile_.getTotalSamples() * 2);
+          }
+          uint32_t prerenderStart = millis();
+
+          if (dacPrerenderer_->preRender(&vgmFile_, renderPath)) {
+            uint32_t prerenderTime = millis() - prerenderStart;
+            Serial.printf("[VGM] DAC pre-render SUCCESS in %lu ms\n", prerenderTime);
+
+            strncpy(dacPrerenderPath_, renderPath, sizeof(dacPrerenderPath_) - 1);
+            dacPrerenderPath_[sizeof(dacPrerenderPath_) - 1] = '\0';
+            dacPrerenderIsTemp_ = true;
+            if (cacheable && dacPrerenderCache_->store(cacheKey, dacPrerenderPath_, sizeof(dacPrerenderPath_))) {
+              dacPrerenderIsTemp_ = false;
+            }
+
+            // CRITICAL: Pre-rendering consumed the entire VGM stream.
+            // For VGZ (compressed) files, we cannot seek back to position 0.
+            // We must reload the VGM file to reset the decompressor state.
+            // This also reloads the data bank which was consumed during pre-render.
+            Serial.println("[VGM] Reloading VGM file after pre-render...");
+            if (!vgmFile_.loadFromFile(filename, fileSource_)) {
+              Serial.println("[VGM] WARNING: Failed to reload VGM file after pre-render!");
               dacPrerendered_ = false;
+            } else {
+              Serial.println("[VGM] VGM file reloaded successfully");
+
+              // Load the pre-rendered file into the playback stream
+              if (dacPrerenderStream_->loadFile(dacPrerenderPath_)) {
+                useDACPrerender_ = true;
+                dacPrerendered_ = true;
+                Serial.println("[VGM] Using PRE-RENDERED DAC (perfect timing)");
+              } else {
+                Serial.println("[VGM] WARNING: Failed to load pre-rendered DAC file");
+                dacPrerendered_ = false;
+              }
             }
+          } else {
+            Serial.printf("[VGM] WARNING: DAC pre-render failed: %s\n",
+                          dacPrerenderer_->getError() ? dacPrerenderer_->getError() : "unknown error");
+            dacPrerendered_ = false;
           }
-        } else {
-          Serial.printf("[VGM] WARNING: DAC pre-render failed: %s\n",
-                        dacPrerenderer_->getError() ? dacPrerenderer_->getError() : "unknown error");
-          dacPrerendered_ = false;
         }
       }
 
@@ -325,26 +369,10 @@ bool VGMPlayer::loadFile(const char* filename) {
 
   // Set OPL3 mode if needed (only for OPL chips, not NES APU, Game Boy, or Genesis)
   if (chipType != ChipType::NES_APU && chipType != ChipType::GAMEBOY_DMG && !hasGenesis_) {
-    OPL3Duo* opl = (OPL3Duo*)synth_->getOPL();
-    if (chipType == ChipType::YMF262_OPL3 || chipType == ChipType::DUAL_OPL3) {
-      // Enable OPL3 mode on both chips
-      opl->setOPL3Enabled(0, true);  // Enable OPL3 on chip 0
-      if (chipType == ChipType::DUAL_OPL3) {
-        opl->setOPL3Enabled(1, true);  // Enable OPL3 on chip 1
-        // // Serial.println("Dual OPL3 mode enabled for VGM playback");
-      } else {
-        // // Serial.println("OPL3 mode enabled for VGM playback");
-      }
-    } else {
-      // OPL2 mode - disable OPL3 features
-      opl->setOPL3Enabled(0, false);
-      if (chipType == ChipType::DUAL_OPL2) {
-        opl->setOPL3Enabled(1, false);
-        // // Serial.println("Dual OPL2 mode for VGM playback");
-      } else {
-        // // Serial.println("OPL2 mode for VGM playback");
-      }
-    }
+    // Remapper owns chip mode setup (OPL2/OPL3/dual-OPL2 stereo) and write batching
+    oplRemap_.begin((OPL3Duo*)synth_->getOPL(), chipType,
+                    g_dualOPL2StereoSplit ? OPLRemapper::DualOPL2Stereo::SPLIT
+                                          : OPLRemapper::DualOPL2Stereo::CENTERED);
 
     // CRITICAL: Wait for OPL3 mode change to settle
     // YMF262 datasheet specifies settling time after mode changes (reg 0x05)
@@ -353,6 +381,9 @@ bool VGMPlayer::loadFile(const char* filename) {
     delay(5);  // 5ms settling time
   }
 
+  // Apply rate/pitch to this file's chips (NES/GB frame timers start in play())
+  setPlaybackRate(g_vgmPlaybackRatePercent, g_vgmPitchFollowsRate);
+
   // // Serial.println("\n--- VGM File Ready ---");
   // Serial.print("File: "); // Serial.println(filename);
   // Serial.print("Duration: "); // Serial.print(getDurationMs() / 1000.0f); // Serial.println(" seconds");
@@ -377,11 +408,15 @@ void VGMPlayer::play() {
 
   // Reset playback position (seek to beginning of data)
   vgmFile_.seekToDataPosition(0);
+  vgmFile_.prefetch();
+  vgmFile_.resetLookaheadStats();
   sampleCount_ = 0;
   pendingDelay_ = 0;
   commandsProcessed_ = 0;
-  nextSampleTimeF_ = (double)micros();  // High-precision start time
-  nextSampleTime_ = (uint32_t)nextSampleTimeF_;  // Integer for comparison
+  clockStart_ = audioClock.now();
+  microsStart_ = micros();
+  nextSampleTimeF_ = (double)clockStart_;  // High-precision start time
+  nextSampleTime_ = clockStart_;           // Integer for comparison
 
   // Reset loop/fade state
   loopCount_ = 0;
@@ -450,6 +485,7 @@ void VGMPlayer::pause() {
   }
 
   stopTimer();
+  pausedAt_ = audioClock.now();
   state_ = PlayerState::PAUSED;
   // // Serial.println("VGM playback paused");
 }
@@ -459,6 +495,11 @@ void VGMPlayer::resume() {
     return;
   }
 
+  // Continue from where we paused instead of catching up on the paused time
+  uint32_t pausedFor = audioClock.now() - pausedAt_;
+  nextSampleTimeF_ += pausedFor;
+  nextSampleTime_ = (uint32_t)(uint64_t)(nextSampleTimeF_ + 0.5);
+
   startTimer();
   state_ = PlayerState::PLAYING;
   // // Serial.println("[VGMPlayer] Resumed");
@@ -554,9 +595,9 @@ void VGMPlayer::stop() {
       dacNesMixerLeft_->gain(0, 0.0f);   // DAC on pre-mixer channel 0
       dacNesMixerRight_->gain(0, 0.0f);
 
-      // Delete the temp file
-      if (SD.exists("/TEMP/~dac.tmp")) {
-        SD.remove("/TEMP/~dac.tmp");
+      // Delete the temp file (cached renders stay for the next play)
+      if (dacPrerenderIsTemp_ && SD.exists(dacPrerenderPath_)) {
+        SD.remove(dacPrerenderPath_);
         Serial.println("[VGMPlayer] Deleted temp DAC file");
       }
 
@@ -569,6 +610,7 @@ void VGMPlayer::stop() {
     // OPL3 backend
     // // Serial.println("[VGMPlayer] OPL3 backend - hardware reset");
     synth_->hardwareReset();
+    oplRemap_.reset();  // Chip registers are back to defaults
     // Note: Line-in muting handled by PlayerManager::centralizedStop()
   }
 
@@ -586,6 +628,7 @@ void VGMPlayer::stop() {
   loopCount_ = 0;
   isFinalLoop_ = false;
   loopStartSample_ = 0;
+  g_vgmRateLocked = false;  // Nothing sample-locked is playing any more
 
   state_ = PlayerState::STOPPED;
   // // Serial.println("[VGMPlayer] Stop complete");
@@ -626,7 +669,7 @@ void VGMPlayer::update() {
   // Update Genesis PCM streams if this is a Genesis file (hardware DAC mode)
   // Note: When using pre-rendered DAC, streams are already baked into the file
   if (hasGenesis_ && genesisBoard_ && !useDACPrerender_) {
-    vgmFile_.updateStreams(genesisBoard_);
+    vgmFile_.updateStreams(genesisBoard_, ratePercent_);
   }
 
   // Check if timer has triggered
@@ -637,6 +680,11 @@ void VGMPlayer::update() {
 
   debugUpdateCount++;
 
+  // Pick up rate changes from the VGM options page
+  if (g_vgmPlaybackRatePercent != requestedRatePercent_ || g_vgmPitchFollowsRate != pitchFollowsRate_) {
+    setPlaybackRate(g_vgmPlaybackRatePercent, g_vgmPitchFollowsRate);
+  }
+
   // === Loop Fade-Out Logic ===
   // Check if we need to start or continue fading out on the final loop
   if (isFinalLoop_ && !fadeActive_ && loopDurationSamples_ > 0) {
@@ -688,13 +736,14 @@ void VGMPlayer::update() {
     float fadeFactor = remainingFactor * remainingFactor;
 
     // Apply fade to fade mixer (affects both Bluetooth and line-out)
-    extern AudioMixer4 fadeMixerLeft;
-    extern AudioMixer4 fadeMixerRight;
+    extern AudioMixerStage fadeMixerLeft;
+    extern AudioMixerStage fadeMixerRight;
     AudioSystem::setFadeGain(fadeMixerLeft, fadeMixerRight, fadeFactor);
   }
 
   // Check if it's time to process the next sample(s)
-  uint32_t now = micros();
+  uint32_t now = audioClock.now();
+  uint32_t burstStart = micros();
 
   // Process all samples that are due
   // Add iteration limiter to prevent infinite loops on corrupted VGM files
@@ -702,7 +751,7 @@ void VGMPlayer::update() {
   constexpr uint16_t MAX_ITERATIONS = 500;  // Increased to allow dense register write bursts
   static uint32_t debugMaxIterationsHit = 0;
 
-  while (now >= nextSampleTime_ && iterations < MAX_ITERATIONS) {
+  while ((int32_t)(now - nextSampleTime_) >= 0 && iterations < MAX_ITERATIONS) {
     iterations++;
 
     if (iterations == MAX_ITERATIONS) {
@@ -714,9 +763,10 @@ void VGMPlayer::update() {
       // We're waiting for a delay to complete
       pendingDelay_--;
       sampleCount_++;
-      // Use double precision to avoid truncation error (22.6757 µs, not 22 µs)
-      nextSampleTimeF_ += MICROS_PER_SAMPLE;
-      nextSampleTime_ = (uint32_t)(nextSampleTimeF_ + 0.5);  // Round to nearest
+      // Double precision: off 100% rate a VGM sample is a fractional number of clock samples
+      // Rate changes only alter the spacing of future samples - no jump in time
+      nextSampleTimeF_ += clockPerSample_;
+      nextSampleTime_ = (uint32_t)(uint64_t)(nextSampleTimeF_ + 0.5);  // Round to nearest
 
       if (pendingDelay_ == 0) {
         // Delay complete, process next commands
@@ -756,13 +806,22 @@ void VGMPlayer::update() {
     // Prevent getting stuck if we're way behind (safety check)
     // Increased from 1ms to 5ms to allow dense register write bursts to complete
     // Breaking mid-burst causes partial note configuration = harmonic distortion
-    if (micros() - now > 5000) {
+    if (micros() - burstStart > 5000) {
       debugSkippedTimerTicks++;
       Serial.println("[VGM TIMING WARNING] Spent >5ms processing commands, breaking out");
       break;
     }
   }
 
+  // Decode ahead while nothing is due: refills, inflate and the loop jump happen
+  // here, not between two writes of a burst
+  if ((int32_t)(nextSampleTime_ - audioClock.now()) >= (int32_t)PREFETCH_GAP_SAMPLES) {
+    vgmFile_.prefetch();
+  } else if (vgmFile_.getLookaheadCount() < PREFETCH_LOW_WATER) {
+    // No gap but running low: top up just enough to carry on to the next gap
+    vgmFile_.prefetch(PREFETCH_TOPUP_BYTES);
+  }
+
   // === SYNCHRONIZE DAC STREAM ===
   // Keep pre-rendered DAC stream aligned with our sample position
   if (useDACPrerender_ && dacPrerendered_ && dacPrerenderStream_) {
@@ -789,7 +848,16 @@ void VGMPlayer::update() {
     Serial.printf("  Sample position: %lu / %lu (%.1f%%)\n",
                   sampleCount_, vgmFile_.getTotalSamples(),
                   100.0f * sampleCount_ / vgmFile_.getTotalSamples());
-    Serial.printf("  Timing drift: %ld μs (nextSample - now)\n", (int32_t)(nextSampleTime_ - micros()));
+    Serial.printf("  Timing drift: %ld samples (nextSample - audioClock)\n", (int32_t)(nextSampleTime_ - audioClock.now()));
+    // What the old micros() timeline would have drifted by against the software streams
+    uint32_t clockElapsed = audioClock.now() - clockStart_;
+    double microsElapsed = (double)(uint32_t)(micros() - microsStart_);
+    Serial.printf("  I2S clock vs micros(): %+ld samples over %.0f s\n",
+                  (int32_t)(clockElapsed - (uint32_t)(microsElapsed * VGM_SAMPLE_RATE / 1000000.0)),
+                  microsElapsed / 1000000.0);
+    if (ratePercent_ != 100) {
+      Serial.printf("  Playback rate: %u%% (pitch %s)\n", ratePercent_, pitchFollowsRate_ ? "follows" : "fixed");
+    }
     Serial.printf("  Skipped >1ms breaks: %lu\n", debugSkippedTimerTicks);
     Serial.printf("  MAX_ITERATIONS hits: %lu\n", debugMaxIterationsHit);
     if (useDACPrerender_ && dacPrerendered_ && dacPrerenderStream_) {
@@ -799,6 +867,22 @@ void VGMPlayer::update() {
     } else if (hasGenesis_) {
       Serial.println("  DAC mode: HARDWARE (real-time)");
     }
+    const OPLRemapper::Stats& opl = oplRemap_.getStats();
+    if (opl.writesIn > 0) {
+      Serial.printf("  OPL writes: %lu in, %lu issued, %lu dropped, %lu merged (%lu batches)\n",
+                    opl.writesIn, opl.writesIssued, opl.writesDropped, opl.writesMerged, opl.batches);
+      // Baseline: every write costs the same setChipRegister() bus cycle, so
+      // the writes not issued would have cost the measured average each
+      float writeUs = opl.writesIssued ? opl.busNanos / 1000.0f / opl.writesIssued : 0.0f;
+      Serial.printf("  OPL bus time: %.1f μs (%.2f μs/write), ~%.1f μs saved by dedupe/coalesce%s\n",
+                    opl.busNanos / 1000.0f, writeUs,
+                    writeUs * (opl.writesDropped + opl.writesMerged),
+                    oplRemap_.isSplitStereo() ? " (dual OPL2 split stereo)" : "");
+      oplRemap_.resetStats();
+    }
+    const VGMFile::LookaheadStats& ahead = vgmFile_.getLookaheadStats();
+    Serial.printf("  Look-ahead: %lu bytes ahead, %lu direct reads, loops %lu seamless / %lu seeked\n",
+                  vgmFile_.getLookaheadCount(), ahead.directReads, ahead.seamlessLoops, ahead.seekedLoops);
     Serial.println("========================");
 
     // Reset counters
@@ -828,9 +912,12 @@ void VGMPlayer::processCommands() {
       // This might indicate a problem with the VGM file
       debugCommandLimitHits++;
       Serial.printf("[VGM WARNING] Processed 1000 commands without hitting WAIT - breaking (total hits: %lu)\n", debugCommandLimitHits);
-      return;
+      break;
     }
   }
+
+  // Everything queued above shares one timestamp - issue it as a single batch
+  oplRemap_.flush();
 }
 
 /**
@@ -874,37 +961,37 @@ void VGMPlayer::processCommand() {
   switch (cmd) {
     case 0x5A: // YM3812 write (chip 0)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL2(reg, val, 0);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
     case 0xAA: // YM3812 write (chip 1)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL2(reg, val, 1);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
     case 0x5E: // YMF262 port 0 write (chip 0)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL3Port0(reg, val, 0);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
     case 0xAE: // YMF262 port 0 write (chip 1)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL3Port0(reg, val, 1);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
     case 0x5F: // YMF262 port 1 write (chip 0)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL3Port1(reg, val, 0);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
     case 0xAF: // YMF262 port 1 write (chip 1)
       if (vgmFile_.readByte(reg) && vgmFile_.readByte(val)) {
-        writeOPL3Port1(reg, val, 1);
+        oplRemap_.write(cmd, reg, val);
       }
       break;
 
@@ -975,9 +1062,7 @@ void VGMPlayer::processCommand() {
             if (readSuccess) {
               // Append to Genesis data bank
               vgmFile_.appendToDataBank(blockData, dataSize);
-              Serial.print("VGM: Loaded ");
-              Serial.print(dataSize);
-              Serial.println(" bytes of YM2612 PCM data into data bank");
+              TRACE("VGM: Loaded %lu bytes of YM2612 PCM data into data bank", dataSize);
             } else {
               Serial.println("VGM: Error reading YM2612 PCM data block");
             }
@@ -1444,30 +1529,39 @@ void VGMPlayer::processCommand() {
   }
 }
 
-void VGMPlayer::writeOPL2(uint8_t reg, uint8_t val, uint8_t chip) {
-  // OPL2 mode write to specified chip
-  // For OPL3 Duo, chip 0 is synthUnit 0, chip 1 is synthUnit 1
-  OPL3Duo* opl = (OPL3Duo*)synth_->getOPL();
+void VGMPlayer::setPlaybackRate(uint8_t percent, bool pitchFollowsRate) {
+  if (percent < MIN_RATE_PERCENT) percent = MIN_RATE_PERCENT;
+  if (percent > MAX_RATE_PERCENT) percent = MAX_RATE_PERCENT;
 
-  // Use setChipRegister to write to the specific chip
-  // Register range for OPL2 is 0x00-0xFF (bank 0)
-  opl->setChipRegister(chip & 1, reg, val);
-}
+  requestedRatePercent_ = percent;
+  pitchFollowsRate_ = pitchFollowsRate;
 
-void VGMPlayer::writeOPL3Port0(uint8_t reg, uint8_t val, uint8_t chip) {
-  // OPL3 port 0 (registers 0x00-0xFF, bank 0)
-  OPL3Duo* opl = (OPL3Duo*)synth_->getOPL();
+  // Sample-locked audio streams play at 1x only - see setRateLocked()
+  g_vgmRateLocked = isRateLocked();
+  if (g_vgmRateLocked) percent = 100;
+  ratePercent_ = percent;
 
-  // Use setChipRegister to write to the specific chip
-  opl->setChipRegister(chip & 1, reg, val);
-}
+  float rate = percent / 100.0f;
+  float pitch = pitchFollowsRate ? rate : 1.0f;
+  clockPerSample_ = 100.0 / percent;
 
-void VGMPlayer::writeOPL3Port1(uint8_t reg, uint8_t val, uint8_t chip) {
-  // OPL3 port 1 (registers 0x100-0x1FF, bank 1)
-  OPL3Duo* opl = (OPL3Duo*)synth_->getOPL();
+  // Envelope/sweep/length clocks belong to the song clock, timer periods to pitch
+  // NOTE: Use chip type, NOT pointer checks! APUs are shared resources.
+  ChipType chipType = vgmFile_.getChipType();
+  if (chipType == ChipType::NES_APU && apu_) {
+    apu_->setFrameRateScale(rate);
+    apu_->setPitchScale(pitch);
+  } else if (chipType == ChipType::GAMEBOY_DMG && gbApu_) {
+    gbApu_->setFrameRateScale(rate);
+    gbApu_->setPitchScale(pitch);
+  } else if (!hasGenesis_) {
+    oplRemap_.setPitchScale(pitch);  // Re-pitched at the next wait boundary
+  }
+}
 
-  // For bank 1, add 0x100 to the register
-  opl->setChipRegister(chip & 1, reg | 0x100, val);
+void VGMPlayer::setRateLocked(bool locked) {
+  rateLocked_ = locked;
+  setPlaybackRate(requestedRatePercent_, pitchFollowsRate_);
 }
 
 void VGMPlayer::waitSamples(uint32_t samples) {
@@ -1492,8 +1586,59 @@ uint32_t VGMPlayer::getDurationMs() const {
 }
 
 uint32_t VGMPlayer::getPositionMs() const {
-  // Convert current sample position to milliseconds
-  return (sampleCount_ * 1000UL) / 44100UL;
+  // Convert current sample position to milliseconds (64-bit: 32-bit overflows after ~97s)
+  return (uint32_t)(((uint64_t)sampleCount_ * 1000ULL) / 44100ULL);
+}
+
+bool VGMPlayer::seekToMs(uint32_t positionMs) {
+  if (state_ != PlayerState::PLAYING && state_ != PlayerState::PAUSED) {
+    return false;
+  }
+
+  uint32_t target = (uint32_t)(((uint64_t)positionMs * VGM_SAMPLE_RATE) / 1000ULL);
+  uint32_t total = vgmFile_.getTotalSamples();
+  if (total > 0 && target >= total) {
+    return false;
+  }
+  // Forward only - chip state can't be rewound without replaying from the start
+  if (target <= sampleCount_) {
+    return target == sampleCount_;
+  }
+
+  bool wasPlaying = (state_ == PlayerState::PLAYING);
+  stopTimer();
+  uint32_t seekStart = micros();
+  uint8_t startLoopCount = loopCount_;
+
+  // Fast-forward: every register write still reaches the chips so their state is
+  // exact at the target, but waits are consumed immediately instead of timed
+  while (sampleCount_ < target && !vgmFile_.isAtEnd() && loopCount_ == startLoopCount) {
+    if (pendingDelay_ == 0) {
+      processCommands();
+      continue;
+    }
+    uint32_t step = target - sampleCount_;
+    if (step > pendingDelay_) step = pendingDelay_;
+    pendingDelay_ -= step;
+    sampleCount_ += step;
+  }
+
+  if (useDACPrerender_ && dacPrerendered_ && dacPrerenderStream_) {
+    dacPrerenderStream_->seekToSample(sampleCount_);
+  }
+  vgmFile_.prefetch();
+
+  // Restart the timeline from here
+  nextSampleTime_ = audioClock.now();
+  nextSampleTimeF_ = (double)nextSampleTime_;
+  pausedAt_ = nextSampleTime_;
+  if (wasPlaying) {
+    startTimer();
+  }
+
+  Serial.printf("[VGMPlayer] Seek to %lu ms: %lu samples fast-forwarded in %lu us\n",
+                positionMs, sampleCount_, micros() - seekStart);
+  return sampleCount_ >= target;
 }
 
 void VGMPlayer::printStats() const {
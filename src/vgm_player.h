@@ -4,10 +4,12 @@
 #include <IntervalTimer.h>
 #include "vgm_file.h"
 #include "opl3_synth.h"
+#include "opl_remap.h"
 #include "nes_apu_emulator.h"
 #include "gameboy_apu.h"
 #include "genesis_board.h"
 #include "dac_prerender.h"
+#include "dac_prerender_cache.h"
 #include "audio_stream_dac_prerender.h"
 #include "file_source.h"
 #include "audio_player_interface.h"
@@ -35,6 +37,7 @@ public:
   uint32_t getDurationMs() const override;
   uint32_t getPositionMs() const override;
   float getProgress() const override;
+  bool seekToMs(uint32_t positionMs) override;
   const char* getFileName() const override { return currentFileName_; }
   FileFormat getFormat() const override { return FileFormat::VGM; }
   bool isLooping() const override { return loopEnabled_; }
@@ -46,6 +49,33 @@ public:
   uint32_t getTotalSamples() const { return vgmFile_.getTotalSamples(); }
   uint32_t getCurrentSample() const { return sampleCount_; }
 
+  /**
+   * Set playback rate (50-200%). Scales VGM waits in the sample clock, plus the
+   * NES/GB frame timers. With pitchFollowsRate, the software APUs and OPL F-numbers
+   * are scaled too (tape-style); otherwise pitch stays put. Safe mid-song.
+   */
+  void setPlaybackRate(uint8_t percent, bool pitchFollowsRate);
+  uint8_t getPlaybackRatePercent() const { return ratePercent_; }
+
+  /**
+   * Hold the rate at 100% while a sample-locked stream plays alongside the chips
+   * (FM9 WAV/MP3 audio, Genesis DAC pre-render). Those streams are not resampled,
+   * so any other rate would make setTargetSample() skip them to catch up.
+   * The DAC pre-render locks itself; FM9Player locks for its audio track.
+   */
+  void setRateLocked(bool locked);
+  bool isRateLocked() const { return rateLocked_ || (useDACPrerender_ && dacPrerendered_); }
+
+  static const uint8_t MIN_RATE_PERCENT = 50;
+  static const uint8_t MAX_RATE_PERCENT = 200;
+
+  // Look-ahead refills (VGMFile::prefetch()) wait for a gap this long before the
+  // next due sample. Below PREFETCH_LOW_WATER bytes ahead with no gap, only
+  // PREFETCH_TOPUP_BYTES are decoded - enough to reach the next gap, not the full 4KB
+  static const uint32_t PREFETCH_GAP_SAMPLES = 88;    // 2ms - an SD read or 8KB inflate
+  static const uint32_t PREFETCH_LOW_WATER = 1024;
+  static const uint32_t PREFETCH_TOPUP_BYTES = 128;   // ~2.8ms of dense DAC data
+
 private:
   // Timer management
   static VGMPlayer* instance_;
@@ -59,9 +89,6 @@ private:
   // Command processing
   void processCommands();
   void processCommand();
-  void writeOPL2(uint8_t reg, uint8_t val, uint8_t chip = 0);
-  void writeOPL3Port0(uint8_t reg, uint8_t val, uint8_t chip = 0);
-  void writeOPL3Port1(uint8_t reg, uint8_t val, uint8_t chip = 0);
 
   // Delay handling
   void waitSamples(uint32_t samples);
@@ -69,10 +96,12 @@ private:
 
   // Member variables
   OPL3Synth* synth_;
+  OPLRemapper oplRemap_;  // VGM OPL command -> OPL3 Duo register mapping and batching
   NESAPUEmulator* apu_;  // NES APU emulator (dynamically created for NES APU VGMs only)
   GameBoyAPU* gbApu_;    // Game Boy DMG APU emulator (dynamically created for GB VGMs only)
   GenesisBoard* genesisBoard_;  // Genesis synth board (YM2612 + SN76489)
   DACPrerenderer* dacPrerenderer_;  // DAC pre-renderer for Genesis YM2612 PCM playback
+  DACPrerenderCache* dacPrerenderCache_;  // Cache of pre-rendered DAC files (may be nullptr)
   AudioStreamDACPrerender* dacPrerenderStream_;  // Pre-rendered DAC playback stream
   FileSource* fileSource_;  // Note: VGM streaming not yet implemented for USB/Floppy
   VGMFile vgmFile_;
@@ -80,14 +109,14 @@ private:
   CompletionCallback completionCallback_;  // Called when playback finishes naturally
 
   // Audio routing (from PlayerConfig)
-  AudioMixer4* mixerLeft_;        // Submixers for GB APU/SPC/MOD (channel 1 submixer)
-  AudioMixer4* mixerRight_;       // Submixers for GB APU/SPC/MOD
-  AudioMixer4* dacNesMixerLeft_;  // DAC/NES pre-mixer (ch0=DAC, ch1=NES) - for muting control
-  AudioMixer4* dacNesMixerRight_; // DAC/NES pre-mixer (ch0=DAC, ch1=NES) - for muting control
-  AudioMixer4* mainMixerLeft_;    // Main mixers for line-in control (channel 0 = hardware)
-  AudioMixer4* mainMixerRight_;   // Main mixers for line-in control
-  AudioMixer4* fadeMixerLeft_;
-  AudioMixer4* fadeMixerRight_;
+  AudioMixerStage* mixerLeft_;        // Submixers for GB APU/SPC/MOD (channel 1 submixer)
+  AudioMixerStage* mixerRight_;       // Submixers for GB APU/SPC/MOD
+  AudioMixerStage* dacNesMixerLeft_;  // DAC/NES pre-mixer (ch0=DAC, ch1=NES) - for muting control
+  AudioMixerStage* dacNesMixerRight_; // DAC/NES pre-mixer (ch0=DAC, ch1=NES) - for muting control
+  AudioMixerStage* mainMixerLeft_;    // Main mixers for line-in control (channel 0 = hardware)
+  AudioMixerStage* mainMixerRight_;   // Main mixers for line-in control
+  AudioMixerStage* fadeMixerLeft_;
+  AudioMixerStage* fadeMixerRight_;
 
   // Playback position
   uint32_t sampleCount_;
@@ -105,8 +134,16 @@ private:
   // Timing
   IntervalTimer timer_;
   volatile bool timerFlag_;
-  uint32_t nextSampleTime_;   // Microsecond time when next sample is due (integer for micros() comparison)
-  double nextSampleTimeF_;    // High-precision accumulator in microseconds (avoids truncation error)
+  uint32_t nextSampleTime_;   // audioClock sample when the next VGM sample is due
+  double nextSampleTimeF_;    // High-precision accumulator in audioClock samples (rates are fractional)
+  double clockPerSample_;     // audioClock samples per VGM sample at the current playback rate
+  uint32_t pausedAt_;         // audioClock at pause() - resume() shifts the timeline by the gap
+  uint32_t clockStart_;       // audioClock and micros() at play() (clock drift report)
+  uint32_t microsStart_;
+  uint8_t ratePercent_;       // Current playback rate (100 = normal)
+  uint8_t requestedRatePercent_;  // Rate from the VGM options page (ratePercent_ may be locked to 100)
+  bool rateLocked_;           // External sample-locked stream (FM9 audio)
+  bool pitchFollowsRate_;     // Pitch scaled along with rate
   uint32_t totalCommands_;
 
   // Current file info
@@ -120,6 +157,8 @@ private:
   bool hasGenesis_;  // True if current VGM contains Genesis chips
   bool useDACPrerender_;  // True to use pre-rendered DAC, false to use hardware DAC
   bool dacPrerendered_;   // True if DAC was successfully pre-rendered for current file
+  char dacPrerenderPath_[DACPrerenderCache::PATH_SIZE];  // File dacPrerenderStream_ plays
+  bool dacPrerenderIsTemp_;  // dacPrerenderPath_ is the scratch file (delete when done)
   bool dacCurrentlyEnabled_;  // Tracks current state of DAC (bit 7 of reg 0x2B)
 
   // Debug counters for Genesis write tracking
@@ -0,0 +1,167 @@
+#include "wav_writer.h"
+
+WavWriter::WavWriter()
+    : buffer_(nullptr)
+    , bufferInPSRAM_(false)
+    , bufferPos_(0)
+    , channels_(0)
+    , sampleRate_(0)
+    , framesWritten_(0)
+    , isOpen_(false)
+    , writeError_(false) {
+}
+
+WavWriter::~WavWriter() {
+    if (isOpen_) {
+        end();
+    }
+    if (buffer_) {
+        if (bufferInPSRAM_) {
+            extmem_free(buffer_);
+        } else {
+            free(buffer_);
+        }
+        buffer_ = nullptr;
+    }
+}
+
+bool WavWriter::begin(const char* path, uint8_t channels, uint32_t sampleRate) {
+    if (isOpen_) {
+        end();
+    }
+
+    if (!buffer_) {
+        buffer_ = (int16_t*)extmem_malloc(BUFFER_SAMPLES * sizeof(int16_t));
+        bufferInPSRAM_ = (buffer_ != nullptr);
+        if (!buffer_) {
+            buffer_ = (int16_t*)malloc(BUFFER_SAMPLES * sizeof(int16_t));
+        }
+        if (!buffer_) {
+            Serial.println("[WavWriter] ERROR: Failed to allocate write buffer");
+            return false;
+        }
+    }
+
+    if (SD.exists(path)) {
+        SD.remove(path);
+    }
+
+    file_ = SD.open(path, FILE_WRITE);
+    if (!file_) {
+        Serial.printf("[WavWriter] ERROR: Failed to create %s\n", path);
+        return false;
+    }
+
+    channels_ = channels;
+    sampleRate_ = sampleRate;
+    bufferPos_ = 0;
+    framesWritten_ = 0;
+    writeError_ = false;
+
+    if (!writeHeader(0)) {
+        file_.close();
+        return false;
+    }
+
+    isOpen_ = true;
+    return true;
+}
+
+bool WavWriter::write(const int16_t* frames, uint32_t frameCount) {
+    if (!isOpen_) return false;
+
+    size_t samples = (size_t)frameCount * channels_;
+    while (samples > 0) {
+        size_t chunk = BUFFER_SAMPLES - bufferPos_;
+        if (chunk > samples) chunk = samples;
+
+        memcpy(&buffer_[bufferPos_], frames, chunk * sizeof(int16_t));
+        bufferPos_ += chunk;
+        frames += chunk;
+        samples -= chunk;
+
+        if (bufferPos_ >= BUFFER_SAMPLES && !flush()) {
+            return false;
+        }
+    }
+
+    framesWritten_ += frameCount;
+    return !writeError_;
+}
+
+bool WavWriter::writeFrame(int16_t left, int16_t right) {
+    if (!isOpen_) return false;
+
+    buffer_[bufferPos_++] = left;
+    if (channels_ > 1) {
+        buffer_[bufferPos_++] = right;
+    }
+    framesWritten_++;
+
+    // BUFFER_SAMPLES is even, so a stereo frame never straddles a flush
+    if (bufferPos_ >= BUFFER_SAMPLES) {
+        return flush();
+    }
+    return !writeError_;
+}
+
+bool WavWriter::end() {
+    if (!isOpen_) return false;
+
+    bool ok = flush();
+
+    // Patch RIFF and data chunk sizes now that the length is known
+    uint32_t dataBytes = framesWritten_ * channels_ * sizeof(int16_t);
+    if (!file_.seek(0) || !writeHeader(dataBytes)) {
+        ok = false;
+    }
+
+    file_.close();
+    isOpen_ = false;
+    return ok && !writeError_;
+}
+
+bool WavWriter::flush() {
+    if (bufferPos_ == 0) return true;
+
+    size_t bytes = bufferPos_ * sizeof(int16_t);
+    size_t written = file_.write((const uint8_t*)buffer_, bytes);
+    bufferPos_ = 0;
+
+    if (written != bytes) {
+        writeError_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool WavWriter::writeHeader(uint32_t dataBytes) {
+    uint8_t header[HEADER_SIZE];
+    uint32_t byteRate = sampleRate_ * channels_ * sizeof(int16_t);
+    uint16_t blockAlign = channels_ * sizeof(int16_t);
+    uint32_t riffSize = dataBytes + HEADER_SIZE - 8;
+
+    memcpy(&header[0], "RIFF", 4);
+    memcpy(&header[4], &riffSize, 4);
+    memcpy(&header[8], "WAVE", 4);
+
+    // fmt chunk (PCM)
+    uint32_t fmtSize = 16;
+    uint16_t format = 1;
+    uint16_t channels = channels_;
+    uint16_t bitsPerSample = 16;
+    memcpy(&header[12], "fmt ", 4);
+    memcpy(&header[16], &fmtSize, 4);
+    memcpy(&header[20], &format, 2);
+    memcpy(&header[22], &channels, 2);
+    memcpy(&header[24], &sampleRate_, 4);
+    memcpy(&header[28], &byteRate, 4);
+    memcpy(&header[32], &blockAlign, 2);
+    memcpy(&header[34], &bitsPerSample, 2);
+
+    // data chunk
+    memcpy(&header[36], "data", 4);
+    memcpy(&header[40], &dataBytes, 4);
+
+    return file_.write(header, HEADER_SIZE) == HEADER_SIZE;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SD.h>
+
+/**
+ * WavWriter - Buffered 16-bit PCM WAV file writer for the SD card
+ *
+ * Writes a 44-byte RIFF header up front (sizes zeroed) and patches the sizes
+ * in end(). Samples are staged in a PSRAM buffer (falls back to heap) so the
+ * SD card sees large sequential writes instead of one call per sample.
+ *
+ * Usage:
+ *   WavWriter wav;
+ *   if (wav.begin("/STEMS/song/mix.wav", 2, 44100)) {
+ *       wav.write(frames, frameCount);   // interleaved if stereo
+ *       wav.end();
+ *   }
+ */
+class WavWriter {
+public:
+    WavWriter();
+    ~WavWriter();
+
+    /**
+     * Create (or replace) a WAV file
+     * @param path Output path on SD card
+     * @param channels 1 = mono, 2 = stereo (interleaved L/R)
+     * @param sampleRate Sample rate in Hz
+     * @return true if the file was created and the header written
+     */
+    bool begin(const char* path, uint8_t channels, uint32_t sampleRate);
+
+    /**
+     * Append frames (channels samples per frame, interleaved)
+     * @return true on success, false if the SD write failed
+     */
+    bool write(const int16_t* frames, uint32_t frameCount);
+
+    /**
+     * Append a single frame
+     */
+    bool writeFrame(int16_t left, int16_t right = 0);
+
+    /**
+     * Flush remaining samples, patch the header sizes and close the file
+     * @return true on success
+     */
+    bool end();
+
+    bool isOpen() const { return isOpen_; }
+    uint32_t getFramesWritten() const { return framesWritten_; }
+
+    static const size_t HEADER_SIZE = 44;
+
+private:
+    static const size_t BUFFER_SAMPLES = 4096;  // 8KB staging buffer
+
+    bool flush();
+    bool writeHeader(uint32_t dataBytes);
+
+    File file_;
+    int16_t* buffer_;
+    bool bufferInPSRAM_;
+    size_t bufferPos_;          // Samples currently staged
+    uint8_t channels_;
+    uint32_t sampleRate_;
+    uint32_t framesWritten_;
+    bool isOpen_;
+    bool writeError_;
+};
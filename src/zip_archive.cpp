@@ -0,0 +1,826 @@
+#include "zip_archive.h"
+#include "../lib/uzlib/uzlib.h"
+
+static const uint32_t SIG_LOCAL = 0x04034B50;
+static const uint32_t SIG_CENTRAL = 0x02014B50;
+static const uint32_t SIG_END = 0x06054B50;
+static const uint16_t LOCAL_SIZE = 30;
+static const uint16_t CENTRAL_SIZE = 46;
+static const uint16_t END_SIZE = 22;
+static const uint16_t END_SEARCH = 1024;          // Tail searched for the end record
+static const uint16_t METHOD_STORED = 0;
+static const uint16_t METHOD_DEFLATE = 8;
+static const uint16_t FLAG_ENCRYPTED = 0x0001;
+static const size_t NAME_SIZE = 128;
+static const size_t DICT_SIZE = 32768;            // Deflate window
+static const size_t INPUT_SIZE = 2048;            // Compressed bytes per archive read
+static const size_t SKIP_SIZE = 512;              // Scratch for forward seeks in inflated members
+
+// Header VGMFile sees in front of a deflated .vgm (method 8, no flags or mtime, unknown OS)
+static const uint8_t GZIP_HEADER[10] = { 0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF };
+static const uint8_t GZIP_TRAILER_SIZE = 8;       // CRC32, uncompressed size
+
+// ============================================
+// Central directory index
+// ============================================
+
+struct ZipEntry {
+    uint32_t nameOffset;      // Name within ArchiveIndex::directory ('/' separators)
+    uint16_t nameLength;
+    uint16_t method;
+    uint32_t crc;
+    uint32_t compressedSize;
+    uint32_t size;
+    uint32_t localOffset;     // Local header
+    uint16_t dosTime;
+    uint16_t dosDate;
+};
+
+struct ArchiveIndex {
+    FS* fs;                   // nullptr = free slot
+    char path[ZipArchive::MAX_PATH];
+    uint32_t archiveSize;
+    DateTimeFields modified;
+    uint8_t* directory;       // Central directory as read from the archive
+    ZipEntry* entries;        // Playable members (no directories, encrypted or unsupported entries)
+    uint16_t count;
+    bool inPSRAM;
+    uint8_t users;            // Open directory listings (an index in use is never evicted)
+    uint32_t lastUse;
+};
+
+static ArchiveIndex s_archives[ZipArchive::CACHED_ARCHIVES];
+static uint32_t s_useCounter = 0;
+static ZipArchive::Stats s_stats;
+
+static inline uint16_t le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline const char* entryName(const ArchiveIndex& index, const ZipEntry& entry) {
+    return (const char*)index.directory + entry.nameOffset;
+}
+
+static void* allocate(size_t bytes, bool preferPSRAM, bool& inPSRAM) {
+    void* p = preferPSRAM ? extmem_malloc(bytes) : nullptr;
+    inPSRAM = (p != nullptr);
+    return p ? p : malloc(bytes);
+}
+
+static void release(void* p, bool inPSRAM) {
+    if (!p) return;
+    if (inPSRAM) {
+        extmem_free(p);
+    } else {
+        free(p);
+    }
+}
+
+static void freeIndex(ArchiveIndex& index) {
+    release(index.directory, index.inPSRAM);
+    release(index.entries, index.inPSRAM);
+    memset(&index, 0, sizeof(index));
+}
+
+/**
+ * Length of the "<archive>.zip" part of a path, or -1 if there is none
+ */
+static int archiveEnd(const char* path) {
+    if (!path) return -1;
+    for (const char* p = path; *p; p++) {
+        if (p[0] == '.' && strncasecmp(p, ".zip", 4) == 0 && (p[4] == '\0' || p[4] == '/')) {
+            return (int)(p - path) + 4;
+        }
+    }
+    return -1;
+}
+
+static bool readIndex(ArchiveIndex& index, File& archive) {
+    uint32_t startMs = millis();
+    uint32_t size = index.archiveSize;
+    if (size < END_SIZE) {
+        return false;
+    }
+
+    // End of central directory record: the last 22 bytes unless there's a comment
+    uint8_t tail[END_SEARCH];
+    uint32_t tailBytes = size < END_SEARCH ? size : END_SEARCH;
+    if (!archive.seek(size - tailBytes) || archive.read(tail, tailBytes) != (int)tailBytes) {
+        return false;
+    }
+    int end = -1;
+    for (int i = (int)tailBytes - END_SIZE; i >= 0; i--) {
+        if (le32(tail + i) == SIG_END) {
+            end = i;
+            break;
+        }
+    }
+    if (end < 0) {
+        Serial.printf("[Zip] %s: no central directory (not a zip, or comment over 1KB)\n", index.path);
+        return false;
+    }
+
+    uint16_t total = le16(tail + end + 10);
+    uint32_t dirSize = le32(tail + end + 12);
+    uint32_t dirOffset = le32(tail + end + 16);
+    if (total == 0xFFFF || dirOffset == 0xFFFFFFFF || dirSize > ZipArchive::MAX_DIRECTORY_BYTES ||
+        (uint64_t)dirOffset + dirSize > size) {
+        Serial.printf("[Zip] %s: unsupported archive (ZIP64 or over %lu KB of entries)\n",
+                      index.path, ZipArchive::MAX_DIRECTORY_BYTES / 1024);
+        return false;
+    }
+
+    // Both tables in PSRAM, or both on the heap
+    bool dirInPSRAM = false;
+    bool entriesInPSRAM = false;
+    index.directory = (uint8_t*)allocate(dirSize + 1, true, dirInPSRAM);
+    index.entries = (ZipEntry*)allocate((size_t)(total ? total : 1) * sizeof(ZipEntry), dirInPSRAM, entriesInPSRAM);
+    index.inPSRAM = dirInPSRAM;
+    if (!index.directory || !index.entries || entriesInPSRAM != dirInPSRAM) {
+        release(index.directory, dirInPSRAM);
+        release(index.entries, entriesInPSRAM);
+        index.directory = nullptr;
+        index.entries = nullptr;
+        Serial.printf("[Zip] %s: out of memory for %u entries\n", index.path, total);
+        return false;
+    }
+
+    // One sequential read for the whole directory
+    if (!archive.seek(dirOffset) || archive.read(index.directory, dirSize) != (int)dirSize) {
+        return false;
+    }
+
+    uint32_t pos = 0;
+    for (uint16_t i = 0; i < total; i++) {
+        const uint8_t* h = index.directory + pos;
+        if (pos + CENTRAL_SIZE > dirSize || le32(h) != SIG_CENTRAL) {
+            Serial.printf("[Zip] %s: corrupt central directory\n", index.path);
+            return false;
+        }
+        uint16_t flags = le16(h + 8);
+        uint16_t method = le16(h + 10);
+        uint16_t nameLength = le16(h + 28);
+        uint32_t next = pos + CENTRAL_SIZE + nameLength + le16(h + 30) + le16(h + 32);
+        if (next > dirSize) {
+            Serial.printf("[Zip] %s: corrupt central directory\n", index.path);
+            return false;
+        }
+
+        // Archives made on Windows may use backslashes
+        char* name = (char*)h + CENTRAL_SIZE;
+        for (uint16_t c = 0; c < nameLength; c++) {
+            if (name[c] == '\\') name[c] = '/';
+        }
+
+        bool isDirectory = nameLength == 0 || name[nameLength - 1] == '/';
+        bool supported = !(flags & FLAG_ENCRYPTED) && (method == METHOD_STORED || method == METHOD_DEFLATE) &&
+                         le32(h + 24) != 0xFFFFFFFF && le32(h + 42) != 0xFFFFFFFF;
+        if (!isDirectory && supported) {
+            ZipEntry& entry = index.entries[index.count++];
+            entry.nameOffset = pos + CENTRAL_SIZE;
+            entry.nameLength = nameLength;
+            entry.method = method;
+            entry.dosTime = le16(h + 12);
+            entry.dosDate = le16(h + 14);
+            entry.crc = le32(h + 16);
+            entry.compressedSize = le32(h + 20);
+            entry.size = le32(h + 24);
+            entry.localOffset = le32(h + 42);
+        }
+        pos = next;
+    }
+
+    s_stats.indexed++;
+    s_stats.lastIndexMs = millis() - startMs;
+    Serial.printf("[Zip] Indexed %s: %u members in %lu ms\n", index.path, index.count, s_stats.lastIndexMs);
+    return true;
+}
+
+/**
+ * Cached index of an archive, read on a miss (archive is open for reading)
+ */
+static ArchiveIndex* findIndex(FS* fs, const char* archivePath, File& archive) {
+    uint32_t size = (uint32_t)archive.size();
+    DateTimeFields modified;
+    if (!archive.getModifyTime(modified)) {
+        memset(&modified, 0, sizeof(modified));
+    }
+
+    for (uint8_t i = 0; i < ZipArchive::CACHED_ARCHIVES; i++) {
+        ArchiveIndex& index = s_archives[i];
+        if (index.fs != fs || strcasecmp(index.path, archivePath) != 0) continue;
+
+        if (index.archiveSize == size && memcmp(&index.modified, &modified, sizeof(modified)) == 0) {
+            index.lastUse = ++s_useCounter;
+            s_stats.indexHits++;
+            return &index;
+        }
+        if (index.users == 0) {
+            freeIndex(index);     // Archive changed since it was indexed
+        }
+    }
+
+    // Free slot, else the least recently used one not being listed
+    ArchiveIndex* slot = nullptr;
+    for (uint8_t i = 0; i < ZipArchive::CACHED_ARCHIVES; i++) {
+        ArchiveIndex& index = s_archives[i];
+        if (!index.fs) {
+            slot = &index;
+            break;
+        }
+        if (index.users == 0 && (!slot || index.lastUse < slot->lastUse)) {
+            slot = &index;
+        }
+    }
+    if (!slot) {
+        return nullptr;
+    }
+    freeIndex(*slot);
+
+    slot->fs = fs;
+    snprintf(slot->path, sizeof(slot->path), "%s", archivePath);
+    slot->archiveSize = size;
+    slot->modified = modified;
+    slot->lastUse = ++s_useCounter;
+    if (!readIndex(*slot, archive)) {
+        freeIndex(*slot);
+        return nullptr;
+    }
+    return slot;
+}
+
+static int findEntry(const ArchiveIndex& index, const char* member, size_t memberLength) {
+    for (uint16_t i = 0; i < index.count; i++) {
+        const ZipEntry& entry = index.entries[i];
+        if (entry.nameLength == memberLength && strncasecmp(entryName(index, entry), member, memberLength) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool hasDirectory(const ArchiveIndex& index, const char* dir, size_t dirLength) {
+    for (uint16_t i = 0; i < index.count; i++) {
+        const ZipEntry& entry = index.entries[i];
+        const char* name = entryName(index, entry);
+        if (entry.nameLength > dirLength && name[dirLength] == '/' && strncasecmp(name, dir, dirLength) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================
+// Member and directory files
+// ============================================
+
+/**
+ * File implementation for archive contents
+ *
+ * Members open the archive lazily (listings hand out members that are never
+ * read) and keep their own handle and a copy of their entry, so they stay
+ * valid after the index is evicted.
+ */
+class ZipFileImpl : public FileImpl {
+public:
+    // Member file
+    ZipFileImpl(FS* fs, const char* archivePath, const ZipEntry& entry,
+                const char* name, size_t nameLength, File* archive = nullptr)
+        : kind_(KIND_STORED)
+        , open_(true)
+        , failed_(false)
+        , fs_(fs)
+        , entry_(entry)
+        , dataOffset_(0)
+        , position_(0)
+        , archivePos_(UINT64_MAX)
+        , inflater_(nullptr)
+        , dictionary_(nullptr)
+        , dictInPSRAM_(false)
+        , input_(nullptr)
+        , compressedRead_(0)
+        , inflateDone_(false)
+        , peeked_(-1)
+        , index_(nullptr)
+        , nextEntry_(0) {
+        snprintf(path_, sizeof(path_), "%s", archivePath);
+        setName(name, nameLength);
+        if (archive) {
+            archive_ = *archive;
+        }
+
+        if (entry.method == METHOD_DEFLATE) {
+            bool isVGM = nameLength > 4 && strncasecmp(name + nameLength - 4, ".vgm", 4) == 0;
+            kind_ = isVGM ? KIND_GZIP : KIND_INFLATE;
+        }
+    }
+
+    // Directory listing (prefix is "" for the archive root, else "<dir>/")
+    ZipFileImpl(ArchiveIndex* index, const char* prefix, size_t prefixLength,
+                const char* name, size_t nameLength)
+        : kind_(KIND_DIRECTORY)
+        , open_(true)
+        , failed_(false)
+        , fs_(nullptr)
+        , dataOffset_(0)
+        , position_(0)
+        , archivePos_(UINT64_MAX)
+        , inflater_(nullptr)
+        , dictionary_(nullptr)
+        , dictInPSRAM_(false)
+        , input_(nullptr)
+        , compressedRead_(0)
+        , inflateDone_(false)
+        , peeked_(-1)
+        , index_(index)
+        , nextEntry_(0) {
+        memset(&entry_, 0, sizeof(entry_));
+        size_t length = prefixLength < sizeof(path_) - 1 ? prefixLength : sizeof(path_) - 1;
+        memcpy(path_, prefix, length);
+        path_[length] = '\0';
+        setName(name, nameLength);
+        index_->users++;
+    }
+
+    virtual ~ZipFileImpl() {
+        close();
+    }
+
+    size_t read(void* buf, size_t nbyte) override;
+    size_t write(const void* buf, size_t size) override { return 0; }
+    int available() override;
+    int peek() override;
+    void flush() override {}
+    bool truncate(uint64_t size) override { return false; }
+    bool seek(uint64_t pos, int mode) override;
+    uint64_t position() override { return position_; }
+    uint64_t size() override;
+    void close() override;
+    bool isOpen() override { return open_; }
+    const char* name() override { return name_; }
+    boolean isDirectory() override { return kind_ == KIND_DIRECTORY; }
+    File openNextFile(uint8_t mode) override;
+    void rewindDirectory() override { nextEntry_ = 0; }
+    bool getModifyTime(DateTimeFields& tm) override;
+
+private:
+    enum Kind : uint8_t {
+        KIND_DIRECTORY,
+        KIND_STORED,              // Window onto the archive
+        KIND_GZIP,                // Deflated .vgm framed as a gzip stream
+        KIND_INFLATE              // Inflated on read
+    };
+
+    // Inflater state with a way back to its file (uzlib's callback has no user pointer)
+    struct Inflater {
+        struct uzlib_uncomp d;    // Must stay first
+        ZipFileImpl* owner;
+    };
+
+    static int inflateSourceCallback(struct uzlib_uncomp* d);
+
+    void setName(const char* name, size_t nameLength);
+    bool prepare();
+    bool startInflate();
+    void restartInflate();
+    size_t readArchive(uint64_t offset, uint8_t* out, size_t length);
+    size_t readGzip(uint64_t pos, uint8_t* out, size_t length);
+    size_t inflate(uint8_t* out, size_t length);
+    int refillInput();
+    bool isFirstInDirectory(uint16_t entryIndex, size_t length) const;
+
+    Kind kind_;
+    bool open_;
+    bool failed_;
+    char name_[NAME_SIZE];
+    char path_[ZipArchive::MAX_PATH];     // Archive path (members) or prefix (directories)
+
+    // Members
+    FS* fs_;
+    File archive_;
+    ZipEntry entry_;
+    uint64_t dataOffset_;     // 0 until the local header has been read
+    uint64_t position_;
+    uint64_t archivePos_;     // Where archive_ is positioned
+    Inflater* inflater_;
+    uint8_t* dictionary_;
+    bool dictInPSRAM_;
+    uint8_t* input_;
+    uint32_t compressedRead_;
+    bool inflateDone_;
+    int peeked_;              // Byte inflated by peek() (KIND_INFLATE), else -1
+
+    // Directories
+    ArchiveIndex* index_;
+    uint16_t nextEntry_;
+};
+
+void ZipFileImpl::setName(const char* name, size_t nameLength) {
+    size_t length = nameLength < sizeof(name_) - 1 ? nameLength : sizeof(name_) - 1;
+    memcpy(name_, name, length);
+    name_[length] = '\0';
+}
+
+uint64_t ZipFileImpl::size() {
+    switch (kind_) {
+        case KIND_STORED:
+        case KIND_INFLATE:
+            return entry_.size;
+        case KIND_GZIP:
+            return (uint64_t)entry_.compressedSize + sizeof(GZIP_HEADER) + GZIP_TRAILER_SIZE;
+        default:
+            return 0;
+    }
+}
+
+int ZipFileImpl::available() {
+    if (!open_ || kind_ == KIND_DIRECTORY) return 0;
+    uint64_t remaining = size() - position_;
+    return remaining > 0x7FFFFFFF ? 0x7FFFFFFF : (int)remaining;
+}
+
+void ZipFileImpl::close() {
+    if (!open_) return;
+    open_ = false;
+
+    if (archive_) {
+        archive_.close();
+    }
+    delete inflater_;
+    inflater_ = nullptr;
+    release(dictionary_, dictInPSRAM_);
+    dictionary_ = nullptr;
+    free(input_);
+    input_ = nullptr;
+
+    if (index_) {
+        index_->users--;
+        index_ = nullptr;
+    }
+}
+
+bool ZipFileImpl::getModifyTime(DateTimeFields& tm) {
+    if (kind_ == KIND_DIRECTORY) return false;
+
+    // MS-DOS date and time
+    tm.sec = (entry_.dosTime & 0x1F) * 2;
+    tm.min = (entry_.dosTime >> 5) & 0x3F;
+    tm.hour = entry_.dosTime >> 11;
+    tm.wday = 0;
+    tm.mday = entry_.dosDate & 0x1F;
+    tm.mon = ((entry_.dosDate >> 5) & 0x0F) - 1;
+    tm.year = (entry_.dosDate >> 9) + 80;   // Years since 1900
+    return true;
+}
+
+/**
+ * Open the archive and locate the member's data (first access only)
+ */
+bool ZipFileImpl::prepare() {
+    if (dataOffset_ != 0) return true;
+    if (failed_) return false;
+
+    if (!archive_) {
+        archive_ = fs_->open(path_, FILE_READ);
+        archivePos_ = UINT64_MAX;
+    }
+
+    uint8_t header[LOCAL_SIZE];
+    if (!archive_ || readArchive(entry_.localOffset, header, LOCAL_SIZE) != LOCAL_SIZE ||
+        le32(header) != SIG_LOCAL) {
+        Serial.printf("[Zip] Can't read member %s\n", name_);
+        failed_ = true;
+        return false;
+    }
+    dataOffset_ = (uint64_t)entry_.localOffset + LOCAL_SIZE + le16(header + 26) + le16(header + 28);
+
+    if (kind_ == KIND_INFLATE && !startInflate()) {
+        Serial.printf("[Zip] Out of memory inflating %s\n", name_);
+        failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+size_t ZipFileImpl::readArchive(uint64_t offset, uint8_t* out, size_t length) {
+    if (archivePos_ != offset) {
+        if (!archive_.seek(offset)) {
+            archivePos_ = UINT64_MAX;
+            return 0;
+        }
+    }
+    int bytes = archive_.read(out, length);
+    if (bytes < 0) bytes = 0;
+    archivePos_ = offset + bytes;
+    return bytes;
+}
+
+size_t ZipFileImpl::read(void* buf, size_t nbyte) {
+    if (!open_ || kind_ == KIND_DIRECTORY) return 0;
+
+    uint64_t remaining = size() - position_;
+    if (nbyte > remaining) nbyte = (size_t)remaining;
+    if (nbyte == 0 || !prepare()) return 0;
+
+    uint8_t* out = (uint8_t*)buf;
+    size_t done = 0;
+    switch (kind_) {
+        case KIND_STORED:
+            done = readArchive(dataOffset_ + position_, out, nbyte);
+            break;
+        case KIND_GZIP:
+            done = readGzip(position_, out, nbyte);
+            break;
+        case KIND_INFLATE:
+            if (peeked_ >= 0) {
+                out[done++] = (uint8_t)peeked_;
+                peeked_ = -1;
+            }
+            done += inflate(out + done, nbyte - done);
+            break;
+        default:
+            break;
+    }
+    position_ += done;
+    return done;
+}
+
+int ZipFileImpl::peek() {
+    uint8_t b;
+    if (read(&b, 1) != 1) return -1;
+    position_--;
+    if (kind_ == KIND_INFLATE) {
+        peeked_ = b;      // Already consumed from the inflater
+    }
+    return b;
+}
+
+bool ZipFileImpl::seek(uint64_t pos, int mode) {
+    if (!open_ || kind_ == KIND_DIRECTORY) return false;
+
+    int64_t target = (int64_t)pos;
+    if (mode == SeekCur) {
+        target += (int64_t)position_;
+    } else if (mode == SeekEnd) {
+        target += (int64_t)size();
+    }
+    if (target < 0 || (uint64_t)target > size()) return false;
+    if (kind_ != KIND_INFLATE) {
+        position_ = target;
+        return true;
+    }
+
+    if ((uint64_t)target == position_) return true;
+    if (!prepare()) return false;
+
+    // Where the inflater is (one past position_ if a byte was peeked)
+    uint64_t inflated = position_ + (peeked_ >= 0 ? 1 : 0);
+    peeked_ = -1;
+    if ((uint64_t)target < inflated) {
+        restartInflate();
+        inflated = 0;
+        s_stats.restarts++;
+    }
+
+    uint8_t scratch[SKIP_SIZE];
+    while (inflated < (uint64_t)target) {
+        uint64_t left = (uint64_t)target - inflated;
+        size_t n = inflate(scratch, left < SKIP_SIZE ? (size_t)left : SKIP_SIZE);
+        if (n == 0) {
+            position_ = inflated;
+            return false;
+        }
+        inflated += n;
+    }
+    position_ = target;
+    return true;
+}
+
+size_t ZipFileImpl::readGzip(uint64_t pos, uint8_t* out, size_t length) {
+    const uint64_t dataEnd = sizeof(GZIP_HEADER) + (uint64_t)entry_.compressedSize;
+    uint8_t trailer[GZIP_TRAILER_SIZE] = {
+        (uint8_t)entry_.crc, (uint8_t)(entry_.crc >> 8), (uint8_t)(entry_.crc >> 16), (uint8_t)(entry_.crc >> 24),
+        (uint8_t)entry_.size, (uint8_t)(entry_.size >> 8), (uint8_t)(entry_.size >> 16), (uint8_t)(entry_.size >> 24)
+    };
+
+    size_t done = 0;
+    while (done < length) {
+        uint64_t p = pos + done;
+        if (p < sizeof(GZIP_HEADER)) {
+            out[done++] = GZIP_HEADER[p];
+        } else if (p < dataEnd) {
+            uint64_t left = dataEnd - p;
+            size_t chunk = (length - done) < left ? (length - done) : (size_t)left;
+            size_t bytes = readArchive(dataOffset_ + (p - sizeof(GZIP_HEADER)), out + done, chunk);
+            done += bytes;
+            if (bytes < chunk) break;
+        } else {
+            out[done++] = trailer[p - dataEnd];
+        }
+    }
+    return done;
+}
+
+// ============================================
+// Inflate
+// ============================================
+
+bool ZipFileImpl::startInflate() {
+    inflater_ = new Inflater;
+    dictionary_ = (uint8_t*)allocate(DICT_SIZE, true, dictInPSRAM_);
+    input_ = (uint8_t*)malloc(INPUT_SIZE);
+    if (!inflater_ || !dictionary_ || !input_) {
+        return false;
+    }
+    restartInflate();
+    return true;
+}
+
+void ZipFileImpl::restartInflate() {
+    memset(&inflater_->d, 0, sizeof(inflater_->d));
+    uzlib_uncompress_init(&inflater_->d, dictionary_, DICT_SIZE);
+    inflater_->d.source = nullptr;
+    inflater_->d.source_limit = nullptr;
+    inflater_->d.source_read_cb = inflateSourceCallback;
+    inflater_->owner = this;
+    compressedRead_ = 0;
+    inflateDone_ = false;
+}
+
+int ZipFileImpl::inflateSourceCallback(struct uzlib_uncomp* d) {
+    return reinterpret_cast<Inflater*>(d)->owner->refillInput();
+}
+
+int ZipFileImpl::refillInput() {
+    uint32_t left = entry_.compressedSize - compressedRead_;
+    if (left == 0) return -1;
+
+    size_t length = left < INPUT_SIZE ? left : INPUT_SIZE;
+    size_t bytes = readArchive(dataOffset_ + compressedRead_, input_, length);
+    if (bytes == 0) return -1;
+    compressedRead_ += bytes;
+
+    inflater_->d.source = input_ + 1;
+    inflater_->d.source_limit = input_ + bytes;
+    return input_[0];
+}
+
+size_t ZipFileImpl::inflate(uint8_t* out, size_t length) {
+    if (inflateDone_ || failed_ || length == 0) return 0;
+
+    struct uzlib_uncomp& d = inflater_->d;
+    d.dest_start = out;
+    d.dest = out;
+    d.dest_limit = out + length;
+
+    int res = uzlib_uncompress(&d);
+    size_t produced = d.dest - out;
+    if (res == TINF_DONE) {
+        inflateDone_ = true;
+    } else if (res != TINF_OK) {
+        Serial.printf("[Zip] Inflate error %d in %s\n", res, name_);
+        failed_ = true;
+    }
+    return produced;
+}
+
+// ============================================
+// Directory listing
+// ============================================
+
+bool ZipFileImpl::isFirstInDirectory(uint16_t entryIndex, size_t length) const {
+    const char* name = entryName(*index_, index_->entries[entryIndex]);
+    for (uint16_t i = 0; i < entryIndex; i++) {
+        const ZipEntry& entry = index_->entries[i];
+        if (entry.nameLength > length && strncasecmp(entryName(*index_, entry), name, length) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+File ZipFileImpl::openNextFile(uint8_t mode) {
+    if (!open_ || kind_ != KIND_DIRECTORY) return File();
+
+    size_t prefixLength = strlen(path_);
+    while (nextEntry_ < index_->count) {
+        uint16_t i = nextEntry_++;
+        const ZipEntry& entry = index_->entries[i];
+        const char* name = entryName(*index_, entry);
+        if (entry.nameLength <= prefixLength || strncasecmp(name, path_, prefixLength) != 0) continue;
+
+        const char* rest = name + prefixLength;
+        size_t restLength = entry.nameLength - prefixLength;
+        const char* slash = (const char*)memchr(rest, '/', restLength);
+        if (!slash) {
+            return File(new ZipFileImpl(index_->fs, index_->path, entry, rest, restLength));
+        }
+
+        // A subdirectory - listed once, at its first member
+        size_t childLength = (slash - name) + 1;
+        if (childLength < sizeof(path_) && isFirstInDirectory(i, childLength)) {
+            return File(new ZipFileImpl(index_, name, childLength, rest, slash - rest));
+        }
+    }
+    return File();
+}
+
+// ============================================
+// ZipArchive
+// ============================================
+
+bool ZipArchive::isArchivePath(const char* path) {
+    return archiveEnd(path) >= 0;
+}
+
+bool ZipArchive::isArchiveName(const char* name) {
+    size_t length = name ? strlen(name) : 0;
+    return length > 4 && strcasecmp(name + length - 4, ".zip") == 0;
+}
+
+File ZipArchive::open(FS* fs, const char* path) {
+    int end = archiveEnd(path);
+    if (!fs || end < 0 || end >= MAX_PATH) {
+        return File();
+    }
+
+    char archivePath[MAX_PATH];
+    memcpy(archivePath, path, end);
+    archivePath[end] = '\0';
+
+    File archive = fs->open(archivePath, FILE_READ);
+    if (!archive || archive.isDirectory()) {
+        return File();
+    }
+    ArchiveIndex* index = findIndex(fs, archivePath, archive);
+    if (!index) {
+        return File();
+    }
+
+    const char* member = path + end;
+    while (*member == '/') member++;
+    size_t memberLength = strlen(member);
+    while (memberLength > 0 && member[memberLength - 1] == '/') memberLength--;
+
+    // Last path component, for name()
+    const char* base = member;
+    size_t baseLength = memberLength;
+    if (memberLength == 0) {
+        const char* slash = strrchr(archivePath, '/');
+        base = slash ? slash + 1 : archivePath;
+        baseLength = strlen(base);
+    } else {
+        for (size_t i = 0; i < memberLength; i++) {
+            if (member[i] == '/') {
+                base = member + i + 1;
+                baseLength = memberLength - i - 1;
+            }
+        }
+    }
+
+    if (memberLength == 0) {
+        return File(new ZipFileImpl(index, "", 0, base, baseLength));
+    }
+
+    int entry = findEntry(*index, member, memberLength);
+    if (entry >= 0) {
+        s_stats.membersOpened++;
+        return File(new ZipFileImpl(fs, archivePath, index->entries[entry], base, baseLength, &archive));
+    }
+
+    if (memberLength + 1 < MAX_PATH && hasDirectory(*index, member, memberLength)) {
+        char prefix[MAX_PATH];
+        memcpy(prefix, member, memberLength);
+        prefix[memberLength] = '/';
+        return File(new ZipFileImpl(index, prefix, memberLength + 1, base, baseLength));
+    }
+    return File();
+}
+
+bool ZipArchive::exists(FS* fs, const char* path) {
+    File f = open(fs, path);
+    bool found = f;
+    f.close();
+    return found;
+}
+
+const ZipArchive::Stats& ZipArchive::getStats() {
+    return s_stats;
+}
+
+void ZipArchive::printStats() {
+    Serial.println("=== Zip Stats ===");
+    for (uint8_t i = 0; i < CACHED_ARCHIVES; i++) {
+        if (s_archives[i].fs) {
+            Serial.printf("Cached: %s (%u members)\n", s_archives[i].path, s_archives[i].count);
+        }
+    }
+    Serial.printf("Indexed: %lu (last %lu ms), index hits: %lu\n",
+                  s_stats.indexed, s_stats.lastIndexMs, s_stats.indexHits);
+    Serial.printf("Members opened: %lu, inflate restarts: %lu\n", s_stats.membersOpened, s_stats.restarts);
+    Serial.println("=================");
+}
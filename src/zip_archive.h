@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+/**
+ * ZipArchive - Play files straight out of .zip archives
+ *
+ * VGM sets are distributed as ZIP packs. Rather than unpacking them, a .zip
+ * on the SD card or USB drive is treated as a folder: "/VGM/SONIC.ZIP" lists
+ * the archive's root and "/VGM/SONIC.ZIP/01 Green Hill.vgz" is a track in it.
+ * FileSource::open() routes such paths here, so the players, the queue and
+ * the resume journal use archive paths like any other.
+ *
+ * Index: the central directory is read in one sequential read and kept in
+ * PSRAM for the CACHED_ARCHIVES most recently used archives (keyed by path,
+ * size and modify time), so opening a track in a 500-file pack costs one
+ * archive open plus a local header read - no scan, no temp extraction.
+ *
+ * Members are streamed from the archive:
+ *   - stored: a window onto the archive (seeks are free). VGZ/FM9 members
+ *     are almost always stored, since gzip data doesn't deflate further.
+ *   - deflated .vgm: presented as a gzip stream (a 10-byte header, the raw
+ *     deflate data as a window, and a CRC/size trailer from the central
+ *     directory). VGMFile detects the gzip magic and inflates it once with
+ *     its own streaming decompressor, loop snapshots included - the member
+ *     is never decompressed twice.
+ *   - other deflated members: inflated on read through uzlib (32KB window in
+ *     PSRAM). Seeking forward inflates and discards; seeking backward
+ *     restarts the member from the top.
+ *
+ * Not supported: encrypted members, methods other than stored/deflate,
+ * ZIP64 (archives over 4GB or 65535 entries), archive comments over 1KB,
+ * writing.
+ */
+class ZipArchive {
+public:
+    static const uint8_t CACHED_ARCHIVES = 2;
+    static const uint16_t MAX_PATH = 256;
+    static const uint32_t MAX_DIRECTORY_BYTES = 1024UL * 1024;   // Central directory size limit
+
+    struct Stats {
+        uint32_t indexed;         // Central directories read
+        uint32_t indexHits;       // Opens served from a cached index
+        uint32_t lastIndexMs;     // Time the last index took
+        uint32_t membersOpened;
+        uint32_t restarts;        // Backward seeks in inflated members
+    };
+
+    /**
+     * True if the path is an archive or goes through one ("X.ZIP" or "X.ZIP/...")
+     */
+    static bool isArchivePath(const char* path);
+
+    /**
+     * True if the name is a .zip file
+     */
+    static bool isArchiveName(const char* name);
+
+    /**
+     * Open a path inside an archive
+     * @param fs Filesystem the archive is on
+     * @param path "<archive>.zip" or "<archive>.zip/<dir>" opens a directory
+     *             (isDirectory(), openNextFile()); "<archive>.zip/<member>" a
+     *             read-only member file
+     * @return Invalid File if the archive or member can't be opened
+     */
+    static File open(FS* fs, const char* path);
+
+    /**
+     * Check if a member or directory exists inside an archive
+     */
+    static bool exists(FS* fs, const char* path);
+
+    static const Stats& getStats();
+    static void printStats();
+};
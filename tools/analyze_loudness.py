@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""Measure tracks offline and write them into the device's loudness index.
+
+The device normalizes playback from /FM90S/LOUDNESS.IDX (src/loudness_index.h)
+and measures tracks it has no record for while they play. This tool fills the
+index ahead of time from WAV files - renders of the software engines, or
+/RECORD captures of the device's own output (the only way to get the line-in
+OPL3/Genesis boards off-device). Host records are never overwritten by the
+device.
+
+Loudness is ITU-R BS.1770-4 integrated loudness (K-weighting, 400ms blocks,
+-70 LUFS absolute and -10 LU relative gates); true peak uses 4x oversampling.
+
+Requirements: pip install numpy scipy
+
+Usage:
+    python tools/analyze_loudness.py LOUDNESS.IDX --add render.wav /VGM/SONIC/01.VGZ
+    python tools/analyze_loudness.py LOUDNESS.IDX --add a.wav /MIDI/A.MID --add b.wav /MIDI/B.MID
+    python tools/analyze_loudness.py --measure capture.wav          # print only
+    python tools/analyze_loudness.py LOUDNESS.IDX --list
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+import zlib
+
+import numpy as np
+from scipy.signal import lfilter, resample_poly
+
+MAGIC = 0x494C4D46  # "FMLI"
+VERSION = 1
+HEADER = struct.Struct("<IHH8x")
+RECORD = struct.Struct("<IhhHBBI")
+SOURCE_EMPTY, SOURCE_DEVICE, SOURCE_HOST = 0, 1, 2
+SOURCE_NAMES = {SOURCE_DEVICE: "device", SOURCE_HOST: "host"}
+
+# Must match LoudnessIndex::gainForRecord()
+TARGET_LUFS = -18.0
+TRUE_PEAK_CEILING_DBTP = -1.0
+MAX_GAIN_DB = 5.9
+MIN_GAIN_DB = -12.0
+
+
+def hash_path(path):
+    """FNV-1a over the lower-cased path, never 0 (LoudnessIndex::hashPath)."""
+    h = 0x811C9DC5
+    for c in path.encode("ascii"):
+        if 0x41 <= c <= 0x5A:
+            c += 0x20
+        h = ((h ^ c) * 0x01000193) & 0xFFFFFFFF
+    return h or 1
+
+
+def read_wav(path):
+    """Return (samples as float channels x frames, sample rate)."""
+    with wave.open(path, "rb") as w:
+        width = w.getsampwidth()
+        channels = w.getnchannels()
+        rate = w.getframerate()
+        raw = w.readframes(w.getnframes())
+
+    if width == 2:
+        data = np.frombuffer(raw, dtype="<i2").astype(np.float64) / 32768.0
+    elif width == 3:
+        b = np.frombuffer(raw, dtype=np.uint8).reshape(-1, 3)
+        ints = (b[:, 0].astype(np.int32) | (b[:, 1].astype(np.int32) << 8) | (b[:, 2].astype(np.int32) << 16))
+        ints = np.where(ints & 0x800000, ints - 0x1000000, ints)
+        data = ints.astype(np.float64) / 8388608.0
+    elif width == 4:
+        data = np.frombuffer(raw, dtype="<i4").astype(np.float64) / 2147483648.0
+    else:
+        raise ValueError("%s: unsupported sample width %d" % (path, width))
+
+    return data.reshape(-1, channels).T, rate
+
+
+def k_weighting(rate):
+    """BS.1770 pre-filter (shelf, high-pass) derived for any sample rate."""
+    f0, gain_db, q = 1681.974450955533, 3.999843853973347, 0.7071752369554196
+    k = np.tan(np.pi * f0 / rate)
+    vh = 10.0 ** (gain_db / 20.0)
+    vb = vh ** 0.4996667741545416
+    a0 = 1.0 + k / q + k * k
+    shelf = ([(vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0],
+             [1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0])
+
+    f0, q = 38.13547087602444, 0.5003270373238773
+    k = np.tan(np.pi * f0 / rate)
+    a0 = 1.0 + k / q + k * k
+    highpass = ([1.0, -2.0, 1.0], [1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0])
+    return shelf, highpass
+
+
+def measure(samples, rate):
+    """Return (integrated LUFS or None, true peak dBTP, seconds)."""
+    shelf, highpass = k_weighting(rate)
+    weighted = lfilter(*highpass, lfilter(*shelf, samples, axis=1), axis=1)
+
+    # 100ms sub-block energies summed over channels (weights 1.0 for L/R/mono)
+    step = int(round(rate * 0.1))
+    count = weighted.shape[1] // step
+    sub = (weighted[:, :count * step] ** 2).reshape(weighted.shape[0], count, step).mean(axis=2).sum(axis=0)
+
+    seconds = samples.shape[1] / rate
+    peak = np.abs(resample_poly(samples, 4, 1, axis=1)).max() if samples.size else 0.0
+    true_peak = 20.0 * np.log10(peak) if peak > 0 else -120.0
+
+    if count < 4:
+        return None, true_peak, seconds
+
+    # 400ms gating blocks every 100ms
+    blocks = (sub[:-3] + sub[1:-2] + sub[2:-1] + sub[3:]) / 4.0
+    with np.errstate(divide="ignore"):
+        lufs = -0.691 + 10.0 * np.log10(blocks)
+
+    gated = blocks[lufs >= -70.0]
+    if gated.size == 0:
+        return None, true_peak, seconds
+
+    relative = -0.691 + 10.0 * np.log10(gated.mean()) - 10.0
+    gated = blocks[lufs >= max(relative, -70.0)]
+    integrated = -0.691 + 10.0 * np.log10(gated.mean())
+    return integrated, true_peak, seconds
+
+
+def gain_for(loudness, true_peak):
+    gain = min(TARGET_LUFS - loudness, TRUE_PEAK_CEILING_DBTP - true_peak)
+    return max(MIN_GAIN_DB, min(MAX_GAIN_DB, gain))
+
+
+def load_index(path):
+    """Return the list of record tuples (slot order kept; bad slots are None)."""
+    if not os.path.exists(path):
+        return []
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        return []
+    magic, version, size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or size != RECORD.size:
+        sys.exit("%s: not a version %d loudness index" % (path, VERSION))
+
+    records = []
+    for offset in range(HEADER.size, len(data) - RECORD.size + 1, RECORD.size):
+        rec = RECORD.unpack_from(data, offset)
+        body = data[offset:offset + RECORD.size - 4]
+        valid = rec[4] != SOURCE_EMPTY and rec[0] != 0 and rec[6] == zlib.crc32(body)
+        records.append(rec if valid else None)
+    return records
+
+
+def save_index(path, records):
+    out = bytearray(HEADER.pack(MAGIC, VERSION, RECORD.size))
+    for rec in records:
+        if rec is None:
+            out += bytes(RECORD.size)
+        else:
+            body = RECORD.pack(*rec[:6], 0)[:-4]
+            out += body + struct.pack("<I", zlib.crc32(body))
+    with open(path, "wb") as f:
+        f.write(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("index", nargs="?", help="LOUDNESS.IDX (copied from or to /FM90S on the SD card)")
+    parser.add_argument("--add", nargs=2, action="append", default=[], metavar=("WAV", "DEVICE_PATH"),
+                        help="measure WAV and store it under the path the device plays it from")
+    parser.add_argument("--measure", action="append", default=[], metavar="WAV", help="measure and print only")
+    parser.add_argument("--list", action="store_true", help="print the index")
+    args = parser.parse_args()
+
+    for wav_path in args.measure:
+        samples, rate = read_wav(wav_path)
+        loudness, true_peak, seconds = measure(samples, rate)
+        if loudness is None:
+            print("%s: silent (%.1f dBTP, %.1f s)" % (wav_path, true_peak, seconds))
+        else:
+            print("%s: %.2f LUFS, %.2f dBTP, %.1f s -> %+.1f dB" %
+                  (wav_path, loudness, true_peak, seconds, gain_for(loudness, true_peak)))
+
+    if not args.index:
+        if args.add or args.list:
+            parser.error("an index file is required for --add/--list")
+        return
+
+    records = load_index(args.index)
+
+    for wav_path, device_path in args.add:
+        samples, rate = read_wav(wav_path)
+        loudness, true_peak, seconds = measure(samples, rate)
+        if loudness is None:
+            print("%s: silent - skipped" % wav_path)
+            continue
+
+        h = hash_path(device_path)
+        rec = (h, int(round(loudness * 100)), int(round(max(true_peak, -327.0) * 100)),
+               min(int(seconds), 65535), SOURCE_HOST, 0, 0)
+        slot = next((i for i, r in enumerate(records) if r and r[0] == h), None)
+        if slot is None:
+            slot = next((i for i, r in enumerate(records) if r is None), len(records))
+        if slot == len(records):
+            records.append(rec)
+        else:
+            records[slot] = rec
+        print("%s -> %s: %.2f LUFS, %.2f dBTP -> %+.1f dB" %
+              (wav_path, device_path, loudness, true_peak, gain_for(loudness, true_peak)))
+
+    if args.add:
+        save_index(args.index, records)
+
+    if args.list:
+        for slot, rec in enumerate(records):
+            if rec is None:
+                continue
+            h, loudness, true_peak, seconds, source, _, _ = rec
+            print("%5d  %08x  %7.2f LUFS  %6.2f dBTP  %5d s  %-6s  %+.1f dB" %
+                  (slot, h, loudness / 100.0, true_peak / 100.0, seconds,
+                   SOURCE_NAMES.get(source, "?"), gain_for(loudness / 100.0, true_peak / 100.0)))
+
+
+if __name__ == "__main__":
+    main()
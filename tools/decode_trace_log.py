@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Decode a binary trace log written by TraceLog::dump() (src/trace_log.cpp).
+
+The device stores each TRACE() call as a format-string address plus raw
+32-bit arguments; the dump carries a table of the strings it references, so
+no firmware image is needed to render it.
+
+Usage:
+    python tools/decode_trace_log.py CRASH.TRC
+    python tools/decode_trace_log.py --raw CRASH.TRC     # include ring indices
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x4C544D46  # "FMTL"
+HEADER = struct.Struct("<IHHIIII")
+STRING_HEADER = struct.Struct("<IH")
+RECORD = struct.Struct("<IIB3x4II")
+
+# Logged by TraceLog::setCpuHz() - timestamps after it count at the new clock
+CLOCK_CHANGE_FORMAT = "[TraceLog] CPU clock %lu -> %lu MHz"
+
+SPEC = re.compile(r"%([-+ #0]*)(\d+)?(?:\.(\d+))?(?:hh|h|ll|l|z|j|t|L)?([diouxXeEfFgGcsp%])")
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def to_float(value):
+    return struct.unpack("<f", struct.pack("<I", value))[0]
+
+
+def render(fmt, args, strings):
+    """Apply a C printf format to 32-bit raw arguments the way the device does."""
+    arg_iter = iter(args)
+
+    def replace(match):
+        flags, width, precision, conv = match.groups()
+        if conv == "%":
+            return "%"
+        try:
+            raw = next(arg_iter)
+        except StopIteration:
+            return "?"
+
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        if conv in "di":
+            return (spec + "d") % to_signed(raw)
+        if conv in "uoxX":
+            return (spec + ("d" if conv == "u" else conv)) % raw
+        if conv in "eEfFgG":
+            return (spec + conv) % to_float(raw)
+        if conv == "c":
+            return (spec + "c") % chr(raw & 0xFF)
+        if conv == "s":
+            return (spec + "s") % strings.get(raw, "<str 0x%08x>" % raw)
+        if conv == "p":
+            return "0x%08x" % raw
+        return "?"
+
+    return SPEC.sub(replace, fmt)
+
+
+def decode(data, raw=False):
+    if len(data) < HEADER.size:
+        raise ValueError("file too short for a trace log header")
+
+    magic, version, record_size, cpu_hz, first_index, record_count, string_count = \
+        HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("bad magic 0x%08x (not a TraceLog dump)" % magic)
+    if version != 1 or record_size != RECORD.size:
+        raise ValueError("unsupported version %d / record size %d" % (version, record_size))
+
+    offset = HEADER.size
+    strings = {}
+    for _ in range(string_count):
+        address, length = STRING_HEADER.unpack_from(data, offset)
+        offset += STRING_HEADER.size
+        strings[address] = data[offset:offset + length].decode("latin-1")
+        offset += length
+
+    print("# %d records from index %d, CPU %.0f MHz, %d strings"
+          % (record_count, first_index, cpu_hz / 1e6, string_count))
+
+    # The header holds the clock at dump time. If the CPU governor changed it
+    # during the dump window, records before the first change ran at that
+    # change's old clock.
+    records_offset = offset
+    for i in range(record_count):
+        _, fmt_address, _, a0, _, _, _, _ = RECORD.unpack_from(data, records_offset + i * RECORD.size)
+        if strings.get(fmt_address) == CLOCK_CHANGE_FORMAT:
+            cpu_hz = a0 * 1000000
+            break
+
+    elapsed_ms = 0.0
+    last_cycles = None
+    skipped = 0
+
+    for i in range(record_count):
+        cycles, fmt_address, argc, a0, a1, a2, a3, seq = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+
+        index = first_index + i
+        if seq != index + 1:
+            skipped += 1  # Never committed, or overwritten mid-dump
+            continue
+
+        # 32-bit cycle counter wraps every ~7s at 600MHz - accumulate deltas
+        if last_cycles is not None and cpu_hz:
+            elapsed_ms += ((cycles - last_cycles) & 0xFFFFFFFF) * 1000.0 / cpu_hz
+        last_cycles = cycles
+        ms = elapsed_ms
+
+        fmt = strings.get(fmt_address)
+        if fmt is None:
+            text = "<unknown format 0x%08x> %s" % (fmt_address, [a0, a1, a2, a3][:argc])
+        else:
+            text = render(fmt, [a0, a1, a2, a3][:argc], strings)
+            if fmt == CLOCK_CHANGE_FORMAT:
+                cpu_hz = a1 * 1000000  # Later records run at the new clock
+
+        if raw:
+            print("%10.3f  #%-8d %s" % (ms, index, text))
+        else:
+            print("%10.3f  %s" % (ms, text))
+
+    if skipped:
+        print("# %d uncommitted/overwritten slots skipped" % skipped)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("path", help="binary log from TraceLog::dump()")
+    parser.add_argument("--raw", action="store_true", help="show ring indices")
+    args = parser.parse_args()
+
+    with open(args.path, "rb") as f:
+        data = f.read()
+
+    try:
+        decode(data, raw=args.raw)
+    except ValueError as e:
+        print("error: %s" % e, file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
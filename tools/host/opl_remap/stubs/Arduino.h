@@ -0,0 +1,29 @@
+// Host stand-in for the Teensy core - just what opl_remap.cpp and vgm_file.h use
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef uint8_t byte;
+
+class HardwareSerial {
+ public:
+  template <class T> size_t print(T) { return 0; }
+  template <class T> size_t println(T) { return 0; }
+  size_t println() { return 0; }
+  size_t printf(const char*, ...) { return 0; }
+};
+extern HardwareSerial Serial;
+
+class String {
+ public:
+  String(const char* = "") {}
+};
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+extern volatile uint32_t ARM_DWT_CYCCNT;
+extern uint32_t F_CPU_ACTUAL;
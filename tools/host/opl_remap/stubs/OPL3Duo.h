@@ -0,0 +1,24 @@
+// Host stand-in for ArduinoOPL2's OPL3Duo: records the register file and
+// counts the bus writes OPLRemapper issues
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+class OPL3Duo {
+ public:
+  OPL3Duo() { memset(regs, 0, sizeof(regs)); }
+  void setOPL3Enabled(uint8_t, bool) {}
+  void setChipRegister(uint8_t unit, short reg, uint8_t value) {
+    uint16_t r = reg & 0x1FF;
+    uint8_t low = r & 0xFF;
+    if (low >= 0xB0 && low <= 0xB8 && !(regs[unit][r] & 0x20) && (value & 0x20)) {
+      keyOns++;
+    }
+    regs[unit][r] = value;
+    busWrites++;
+  }
+
+  uint8_t regs[2][512];
+  uint32_t busWrites = 0;
+  uint32_t keyOns = 0;      // Key-on edges (B0-B8 bit 5 going high)
+};
@@ -0,0 +1,8 @@
+// Host stand-in for the SD library - vgm_file.h only needs the File type
+#pragma once
+#include <stdint.h>
+
+class File {
+ public:
+  operator bool() const { return false; }
+};
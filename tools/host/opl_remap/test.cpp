@@ -0,0 +1,133 @@
+// Host harness for OPLRemapper (src/opl_remap.cpp) on a tracker-style stream.
+//
+// Stream model (typical of AdLib tracker / IMF-converted VGMs, which rewrite
+// every channel's registers every tick): 70Hz ticks, 9 channels, 3 minutes.
+// Each tick a channel writes A0/B0 (vibrato changes the F-number on 1 tick in
+// 3) and both operators' 40 (volume slides change it on 1 tick in 8). Note-ons
+// (1 in 6 ticks per channel) reload the full instrument (20/40/60/80/E0 x2,
+// C0) - usually the same instrument as before - then key off + key on via B0.
+//
+// Checked:
+//   - after every flush() the chip's register file equals the raw stream's
+//   - every key-on edge in the raw stream reaches the chip
+//   - the bus write count matches Stats::writesIssued
+// Reported: writes in vs issued/dropped/merged, and issued writes per batch
+// (the group size a grouped bus transaction would have to work with).
+//
+// Build and run (from the repo root):
+//   g++ -std=gnu++17 -O1 -g -fsanitize=address,undefined \
+//       -Itools/host/opl_remap/stubs -Isrc \
+//       tools/host/opl_remap/test.cpp src/opl_remap.cpp \
+//       -o /tmp/opl_remap && /tmp/opl_remap
+//
+// Bus time per write on the board: the VGM timing report (OPL bus time).
+
+#include <Arduino.h>
+#include <OPL3Duo.h>
+#include "opl_remap.h"
+
+HardwareSerial Serial;
+volatile uint32_t ARM_DWT_CYCCNT;
+uint32_t F_CPU_ACTUAL = 600000000;
+
+uint32_t micros() { return 0; }
+uint32_t millis() { return 0; }
+void delay(uint32_t) {}
+
+static int g_failures;
+
+static void check(bool ok, const char* what) {
+  printf("%-58s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) g_failures++;
+}
+
+// The register file the raw stream would leave on chip 0, plus its key-on edges
+struct RawChip {
+  uint8_t regs[256];
+  bool touched[256];
+  uint32_t keyOns;
+};
+
+static RawChip g_raw;
+static uint32_t g_seed = 1;
+
+static uint32_t rnd(uint32_t n) {
+  g_seed = g_seed * 1103515245 + 12345;
+  return (g_seed >> 16) % n;
+}
+
+static void rawWrite(OPLRemapper& r, uint8_t reg, uint8_t val) {
+  if (reg >= 0xB0 && reg <= 0xB8 && !(g_raw.regs[reg] & 0x20) && (val & 0x20)) {
+    g_raw.keyOns++;
+  }
+  g_raw.regs[reg] = val;
+  g_raw.touched[reg] = true;
+  r.write(0x5A, reg, val);
+}
+
+int main() {
+  OPL3Duo opl;
+  OPLRemapper r;
+  r.begin(&opl, ChipType::YM3812_OPL2, OPLRemapper::DualOPL2Stereo::CENTERED);
+
+  static const uint8_t opOff[9] = {0, 1, 2, 8, 9, 10, 16, 17, 18};
+  uint8_t fnum[9], vol[9], inst[9];
+  for (int c = 0; c < 9; c++) {
+    fnum[c] = 0x80 + c * 7;
+    vol[c] = 0x10;
+    inst[c] = rnd(4);
+  }
+
+  const int ticks = 70 * 180;
+  bool regsMatch = true;
+  uint32_t maxBatch = 0;
+
+  for (int t = 0; t < ticks; t++) {
+    for (int c = 0; c < 9; c++) {
+      uint8_t o = opOff[c];
+      if (rnd(6) == 0) {
+        if (rnd(5) == 0) inst[c] = rnd(4);
+        uint8_t i = inst[c];
+        rawWrite(r, 0xB0 + c, 0x11);  // Key off
+        rawWrite(r, 0x20 + o, 0x01 + i); rawWrite(r, 0x23 + o, 0x21 + i);
+        rawWrite(r, 0x40 + o, 0x10 + i); rawWrite(r, 0x43 + o, vol[c]);
+        rawWrite(r, 0x60 + o, 0xF0 + i); rawWrite(r, 0x63 + o, 0xF4);
+        rawWrite(r, 0x80 + o, 0x77);     rawWrite(r, 0x83 + o, 0x77 + i);
+        rawWrite(r, 0xE0 + o, i & 1);    rawWrite(r, 0xE3 + o, 0);
+        rawWrite(r, 0xC0 + c, 0x0E);
+        fnum[c] = 0x40 + rnd(0xC0);
+      }
+      if (rnd(3) == 0) fnum[c] += rnd(2) ? 2 : -2;
+      if (rnd(8) == 0) vol[c] = (vol[c] + 1) & 0x3F;
+      rawWrite(r, 0x40 + o, 0x10 + inst[c]); rawWrite(r, 0x43 + o, vol[c]);
+      rawWrite(r, 0xA0 + c, fnum[c]);        rawWrite(r, 0xB0 + c, 0x31);
+    }
+
+    uint32_t issuedBefore = r.getStats().writesIssued;
+    r.flush();  // 630-sample wait
+    uint32_t batch = r.getStats().writesIssued - issuedBefore;
+    if (batch > maxBatch) maxBatch = batch;
+
+    for (int reg = 0; reg < 256; reg++) {
+      if (g_raw.touched[reg] && opl.regs[0][reg] != g_raw.regs[reg]) regsMatch = false;
+    }
+  }
+
+  const OPLRemapper::Stats& s = r.getStats();
+  printf("  writes in %lu, issued %lu (%.1f%%), dropped %lu, merged %lu\n",
+         (unsigned long)s.writesIn, (unsigned long)s.writesIssued,
+         100.0 * s.writesIssued / s.writesIn,
+         (unsigned long)s.writesDropped, (unsigned long)s.writesMerged);
+  printf("  per tick: %.1f in -> %.1f on the bus, largest batch %lu writes\n",
+         (double)s.writesIn / ticks, (double)s.writesIssued / ticks, (unsigned long)maxBatch);
+
+  check(regsMatch, "chip registers match the raw stream after every flush");
+  // Key off + key on in one slice must not merge into a held note
+  check(opl.keyOns == g_raw.keyOns, "every key-on edge reaches the chip");
+  check(opl.busWrites == s.writesIssued, "bus writes match Stats::writesIssued");
+  check(s.writesIn == s.writesIssued + s.writesDropped + s.writesMerged, "every write issued, dropped or merged");
+  check(s.writesIssued < s.writesIn / 2, "redundant writes kept off the bus");
+
+  printf(g_failures ? "FAILED\n" : "PASS\n");
+  return g_failures ? 1 : 0;
+}
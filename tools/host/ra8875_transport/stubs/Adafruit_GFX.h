@@ -0,0 +1,19 @@
+// Host stand-in: RA8875_SPI1 only needs the base class shape
+#pragma once
+#include <Arduino.h>
+class Adafruit_GFX {
+ public:
+  Adafruit_GFX(int16_t, int16_t) {}
+  virtual ~Adafruit_GFX() {}
+  virtual void drawPixel(int16_t, int16_t, uint16_t) = 0;
+  virtual void drawFastVLine(int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void drawFastHLine(int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void fillRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void fillScreen(uint16_t) {}
+  virtual void drawRect(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void drawLine(int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void drawCircle(int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void fillCircle(int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void drawTriangle(int16_t, int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+  virtual void fillTriangle(int16_t, int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t) {}
+};
@@ -0,0 +1,34 @@
+// Host stand-in for the Teensy core - just what RA8875_SPI1.cpp uses
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef bool boolean;
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+
+class HardwareSerial {
+ public:
+  template <class T> size_t print(T) { return 0; }
+  template <class T> size_t println(T) { return 0; }
+  size_t println() { return 0; }
+  size_t printf(const char*, ...) { return 0; }
+};
+extern HardwareSerial Serial;
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+void __disable_irq();
+void __enable_irq();
+void* extmem_malloc(size_t n);
+void extmem_free(void* p);
+extern volatile uint32_t ARM_DWT_CYCCNT;
+extern uint32_t F_CPU_ACTUAL;
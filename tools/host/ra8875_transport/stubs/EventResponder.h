@@ -0,0 +1,14 @@
+// Host stand-in: the mock SPI records the responder and the test fires it
+#pragma once
+class EventResponder;
+typedef EventResponder& EventResponderRef;
+class EventResponder {
+ public:
+  void setContext(void* c) { ctx_ = c; }
+  void* getContext() { return ctx_; }
+  void attachImmediate(void (*fn)(EventResponderRef)) { fn_ = fn; }
+  void fire() { fn_(*this); }
+ private:
+  void* ctx_ = nullptr;
+  void (*fn_)(EventResponderRef) = nullptr;
+};
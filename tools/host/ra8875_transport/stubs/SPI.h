@@ -0,0 +1,60 @@
+// Host stand-in: a mock SPIClass that records the wire (bytes, CS edges) and
+// answers status/data reads from a scripted busy count
+#pragma once
+#include <Arduino.h>
+#include <EventResponder.h>
+#include <vector>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+struct SPISettings {
+  SPISettings() {}
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+struct MockWire {
+  std::vector<int> log;        // Bytes, CS_LOW / CS_HIGH markers
+  EventResponder* pending = nullptr;
+  bool dmaAvailable = true;
+  int busyReads = 0;           // Reads that still report busy (0xFF)
+  uint32_t dmaTransfers = 0;
+  uint32_t blockingTransfers = 0;
+};
+extern MockWire g_mock;
+enum { CS_LOW = -1, CS_HIGH = -2 };
+
+class SPIClass {
+ public:
+  void begin() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t b) {
+    bool read = prev_ == 0x40 || prev_ == 0xC0;
+    g_mock.log.push_back(b);
+    prev_ = read ? -1 : b;
+    return read ? answer() : 0;
+  }
+  void transfer(const void* buf, void* rx, size_t n) {
+    g_mock.blockingTransfers++;
+    copy(buf, rx, n);
+  }
+  bool transfer(const void* buf, void* rx, size_t n, EventResponderRef e) {
+    if (!g_mock.dmaAvailable) return false;
+    g_mock.dmaTransfers++;
+    copy(buf, rx, n);
+    g_mock.pending = &e;
+    return true;
+  }
+ private:
+  int prev_ = -1;
+  uint8_t answer() {
+    if (g_mock.busyReads > 0) { g_mock.busyReads--; return 0xFF; }
+    return 0x00;
+  }
+  void copy(const void* buf, void* rx, size_t n) {
+    const uint8_t* p = (const uint8_t*)buf;
+    for (size_t i = 0; i < n; i++) g_mock.log.push_back(p[i]);
+    if (rx && n == 2 && (p[0] == 0x40 || p[0] == 0xC0)) ((uint8_t*)rx)[1] = answer();
+  }
+};
+extern SPIClass SPI, SPI1;
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Build tools/host/spc_loop_cache/test.cpp with the idle-loop cache off and on,
+# run both on the same inputs and compare them frame by frame.
+#
+# Usage (from anywhere): tools/host/spc_loop_cache/run.sh [seconds] [file.spc ...]
+set -e
+here=$(cd "$(dirname "$0")" && pwd)
+spc="$here/../../../src/External/snes_spc/snes_spc"
+out=${TMPDIR:-/tmp}/spc_loop_cache
+mkdir -p "$out"
+
+for cache in 0 1; do
+  g++ -std=gnu++17 -O2 -w -DNDEBUG -DSPC_IDLE_LOOP_CACHE=$cache -I"$spc" "$here/test.cpp" \
+      "$spc/SNES_SPC.cpp" "$spc/SNES_SPC_misc.cpp" "$spc/SNES_SPC_state.cpp" "$spc/SPC_DSP.cpp" \
+      -o "$out/spc_lockstep$cache"
+done
+
+echo "cache off:"
+"$out/spc_lockstep0" "$@" > "$out/off.txt"
+echo "cache on:"
+"$out/spc_lockstep1" "$@" > "$out/on.txt"
+
+if cmp -s "$out/off.txt" "$out/on.txt"; then
+  echo "PASS: $(wc -l < "$out/off.txt") frames identical (samples and emulator state)"
+else
+  echo "FAILED: first divergence (input frame sample-hash state-hash):"
+  paste -d '\n' "$out/off.txt" "$out/on.txt" |
+    awk 'NR % 2 { off = $0; next } off != $0 { print "  off: " off; print "  on:  " $0; exit }'
+  exit 1
+fi
@@ -0,0 +1,151 @@
+// Lockstep check for the SPC700 idle-loop cache (SPC_IDLE_LOOP_CACHE in
+// src/External/snes_spc/snes_spc/SPC_CPU.h).
+//
+// Plays each input and prints one line per 2048-sample frame with a hash of
+// the output samples and of the saved emulator state. run.sh builds this twice,
+// with the cache off and on, and diffs the two outputs line by line - the
+// first differing line is the first frame where the cached core diverged.
+//
+// Inputs are .spc files given on the command line (the corpus). Without any,
+// a built-in synthetic driver runs in several variants: it polls T0, T1 (abs
+// address), a port, and a CMP against a port that the host rewrites mid-frame,
+// with different timer targets, T2 enabled and tempos 77-384.
+//
+// Usage: spc_lockstep [seconds] [file.spc ...]   (seconds per input, default 60)
+// Host wall time per input goes to stderr, so it doesn't take part in the diff.
+
+#include "SNES_SPC.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned char g_file[SNES_SPC::spc_file_size];
+
+static uint64_t fnv(uint64_t h, const void* data, size_t size) {
+  const unsigned char* p = (const unsigned char*)data;
+  for (size_t i = 0; i < size; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// SPC700 driver that spends its time in the polling loops the cache skips
+static void buildSyntheticDriver(uint8_t timer0Target, bool timer2) {
+  memset(g_file, 0, sizeof(g_file));
+  memcpy(g_file, "SNES-SPC700 Sound File Data v0.30\x1A\x1A", 35);
+  g_file[0x25] = 0x00;  // PC = 0x0200
+  g_file[0x26] = 0x02;
+  g_file[0x2B] = 0xEF;  // SP
+  unsigned char* ram = g_file + 0x100;
+  unsigned char* dsp = g_file + 0x10100;
+
+  static const unsigned char prog[] = {
+    0x8F, 0x20, 0xFA, 0x8F, 0x10, 0xFB, 0x8F, 0x03, 0xF1,  // T0/T1 targets, start T0+T1
+    0x8F, 0x4C, 0xF2, 0x8F, 0x01, 0xF3,                    // KON voice 0
+    // main (0x020F)
+    0xE4, 0xFD, 0xF0, 0xFC,                                // wait T0
+    0xAB, 0x10,                                            // INC $10
+    0xE4, 0x10,                                            // MOV A,$10
+    0x8F, 0x00, 0xF2, 0xC4, 0xF3,                          // VOLL = A
+    0xE4, 0xF4, 0xF0, 0xFC,                                // wait port0 != 0
+    0x64, 0xF5, 0xF0, 0xFC,                                // wait while A == port1
+    0xEC, 0xFE, 0x00, 0xF0, 0xFB,                          // wait T1 (abs)
+    0x00, 0x00, 0x00, 0x00,                                // NOPs
+    0x2F, 0x00                                             // BRA main (patched below)
+  };
+  memcpy(ram + 0x200, prog, sizeof(prog));
+  int end = 0x200 + sizeof(prog);
+  ram[end - 1] = (unsigned char)(0x20F - end);
+  ram[0x201] = timer0Target;
+  if (timer2) {
+    ram[0x207] = 0x07;  // Start T2 as well
+    ram[0x227] = 0xFF;
+  }
+
+  // Voice 0: one looping BRR block
+  ram[0x300] = 0x00; ram[0x301] = 0x04; ram[0x302] = 0x00; ram[0x303] = 0x04;
+  static const unsigned char brr[] = {0xC3, 0x77, 0x77, 0x77, 0x77, 0x99, 0x99, 0x99, 0x99};
+  memcpy(ram + 0x400, brr, sizeof(brr));
+  ram[0xF1] = 0x80;
+
+  dsp[0x0C] = 0x7F; dsp[0x1C] = 0x7F; dsp[0x00] = 0x7F; dsp[0x01] = 0x7F;
+  dsp[0x02] = 0x00; dsp[0x03] = 0x10; dsp[0x04] = 0; dsp[0x05] = 0;
+  dsp[0x07] = 0x7F; dsp[0x5D] = 0x03; dsp[0x6C] = 0x20; dsp[0x6D] = 0x80;
+}
+
+static bool run(const char* name, long size, int seconds, int tempo, bool drivePorts) {
+  SNES_SPC* spc = new SNES_SPC;
+  spc->init();
+  spc->set_tempo(tempo);
+  if (const char* err = spc->load_spc(g_file, size)) {
+    fprintf(stderr, "%s: %s\n", name, err);
+    delete spc;
+    return false;
+  }
+  spc->clear_echo();
+
+  static short buf[2048];
+  static unsigned char state[SNES_SPC::spc_file_size];
+  auto start = std::chrono::steady_clock::now();
+  int frames = seconds * 32000 / 1024;
+  for (int f = 0; f < frames; f++) {
+    if (drivePorts) {
+      spc->write_port(100 + (f * 37) % 20000, 0, (f % 3) != 0);
+      spc->write_port(25000, 1, (f * 7) & 0xFF);
+    }
+    spc->play(2048, buf);
+    SNES_SPC::init_header(state);
+    spc->save_spc(state);
+    printf("%s %d %016llx %016llx\n", name, f,
+           (unsigned long long)fnv(1469598103934665603ULL, buf, sizeof(buf)),
+           (unsigned long long)fnv(1469598103934665603ULL, state, sizeof(state)));
+  }
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  fprintf(stderr, "%-24s %d s in %.1f ms\n", name, seconds, ms);
+  delete spc;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  int seconds = argc > 1 ? atoi(argv[1]) : 60;
+  if (seconds <= 0) seconds = 60;
+
+  if (argc > 2) {
+    bool ok = true;
+    for (int i = 2; i < argc; i++) {
+      FILE* fp = fopen(argv[i], "rb");
+      if (!fp) {
+        fprintf(stderr, "%s: can't open\n", argv[i]);
+        ok = false;
+        continue;
+      }
+      memset(g_file, 0, sizeof(g_file));
+      long size = (long)fread(g_file, 1, sizeof(g_file), fp);
+      fclose(fp);
+      ok = run(argv[i], size, seconds, SNES_SPC::tempo_unit, false) && ok;
+    }
+    return ok ? 0 : 1;
+  }
+
+  struct Variant {
+    const char* name;
+    uint8_t timer0Target;
+    bool timer2;
+    int tempo;
+  };
+  static const Variant variants[] = {
+    {"synthetic-t0=32",     0x20, false, SNES_SPC::tempo_unit},
+    {"synthetic-t0=1",      0x01, false, SNES_SPC::tempo_unit},
+    {"synthetic-t0=0",      0x00, false, SNES_SPC::tempo_unit},  // 0 = 256 ticks
+    {"synthetic-t2",        0x20, true,  SNES_SPC::tempo_unit},
+    {"synthetic-tempo=77",  0x20, false, 77},
+    {"synthetic-tempo=384", 0x20, false, 384},
+  };
+  for (const Variant& v : variants) {
+    buildSyntheticDriver(v.timer0Target, v.timer2);
+    run(v.name, sizeof(g_file), seconds, v.tempo, true);
+  }
+  return 0;
+}